@@ -0,0 +1,14 @@
+#!/bin/bash
+# compare fix gcmc with partial energies and with full_energy
+# usage: run_gcmc.sh [lmp_exe] [nprocs]
+
+lmp=${1:-lmp_mpi}
+np=${2:-1}
+
+for problem in lj co2; do
+  for full in 0 1; do
+    tag=$problem.full$full.$np
+    mpirun -np $np $lmp -v full $full -log log.$tag -in in.$problem > /dev/null
+    echo "$tag: `grep 'Loop time' log.$tag`"
+  done
+done
@@ -0,0 +1,40 @@
+#!/bin/bash
+# scan OpenMP thread counts with the default and the owner force modes
+# usage: run_owner.sh [lmp_exe] [max_threads]
+
+lmp=`readlink -f $(command -v ${1:-lmp_omp})`
+max=${2:-64}
+here=`pwd`
+
+export OMP_WAIT_POLICY=passive
+
+# average time of one row of the timing breakdown, 0 if not printed
+row() { awk -v k=$1 '$1 == k && $2 == "|" {t = $5} END {print t+0}' log.$tag; }
+
+status=0
+printf "%-8s %4s %-8s %9s %9s %9s %9s %9s\n" \
+  input thr mode loop pair bond kspace modify
+
+# in.lj and in.eam run in the parent dir, where in.eam finds Cu_u3.eam
+
+for input in lj eam peptide; do
+  if [ $input = peptide ]; then dir=.; else dir=..; fi
+  for t in 1 2 4 8 16 32 64; do
+    if [ $t -gt $max ]; then break; fi
+    for mode in private owner; do
+      tag=$input.$t.$mode
+      (cd $dir && env OMP_NUM_THREADS=$t $lmp -sf omp -pk omp $t \
+        force $mode -log $here/log.$tag -in in.$input > /dev/null)
+      if ! grep -q "Total wall time" log.$tag; then
+        echo "$tag: run failed"
+        grep ERROR log.$tag 2> /dev/null
+        status=1
+        continue
+      fi
+      loop=`awk '/^Loop time/ {print $4}' log.$tag`
+      printf "%-8s %4d %-8s %9.3f %9.3f %9.3f %9.3f %9.3f\n" $input $t \
+        $mode $loop `row Pair` `row Bond` `row Kspace` `row Modify`
+    done
+  done
+done
+exit $status
@@ -0,0 +1,30 @@
+#!/bin/bash
+# compare atom sort orderings on the LJ and EAM benchmarks
+# usage: run_sort.sh [lmp_exe] [nprocs] [x y z]
+# if perf is installed, cache misses are recorded as well
+
+lmp=${1:-lmp_mpi}
+np=${2:-1}
+x=${3:-2}
+y=${4:-2}
+z=${5:-2}
+
+perfcmd=""
+if command -v perf > /dev/null; then
+  perfcmd="perf stat -e cache-references,cache-misses,L1-dcache-load-misses -o"
+fi
+
+for problem in lj eam; do
+  for curve in xyz morton hilbert; do
+    tag=$problem.$curve.$np
+    if [ -n "$perfcmd" ]; then
+      mpirun -np $np $perfcmd perf.$tag $lmp -v x $x -v y $y -v z $z \
+        -v curve $curve -log log.$tag -in in.$problem > /dev/null
+    else
+      mpirun -np $np $lmp -v x $x -v y $y -v z $z \
+        -v curve $curve -log log.$tag -in in.$problem > /dev/null
+    fi
+    echo "$tag: `grep 'Loop time' log.$tag`"
+    if [ -f perf.$tag ]; then grep -E 'misses|references' perf.$tag; fi
+  done
+done
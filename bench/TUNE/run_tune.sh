@@ -0,0 +1,21 @@
+#!/bin/bash
+# run a charged LJ fluid with and without fix tune/pppm
+# usage: run_tune.sh [lmp_exe] [nprocs]
+
+lmp=${1:-lmp_mpi}
+np=${2:-1}
+
+status=0
+for tune in 0 1; do
+  tag=pppm.tune$tune.$np
+  mpirun -np $np $lmp -v tune $tune -log log.$tag -in in.pppm > /dev/null
+  if ! grep -q "Total wall time" log.$tag; then
+    echo "$tag: run failed"
+    grep ERROR log.$tag 2> /dev/null
+    status=1
+    continue
+  fi
+  echo "$tag: `grep -c 'Fix tune/pppm: step' log.$tag` cutoff changes"
+  grep 'Loop time' log.$tag
+done
+exit $status
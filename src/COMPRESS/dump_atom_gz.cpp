@@ -25,6 +25,10 @@ DumpAtomGZ::DumpAtomGZ(LAMMPS *lmp, int narg, char **arg) :
 {
   gzFp = NULL;
 
+  // compressed files are written through gzFp, never asynchronously
+
+  async_allow = 0;
+
   if (!compressed)
     error->all(FLERR,"Dump atom/gz only writes compressed files");
 }
@@ -27,6 +27,10 @@ DumpCFGGZ::DumpCFGGZ(LAMMPS *lmp, int narg, char **arg) :
 {
   gzFp = NULL;
 
+  // compressed files are written through gzFp, never asynchronously
+
+  async_allow = 0;
+
   if (!compressed)
     error->all(FLERR,"Dump cfg/gz only writes compressed files");
 }
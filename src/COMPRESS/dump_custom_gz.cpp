@@ -25,6 +25,10 @@ DumpCustomGZ::DumpCustomGZ(LAMMPS *lmp, int narg, char **arg) :
 {
   gzFp = NULL;
 
+  // compressed files are written through gzFp, never asynchronously
+
+  async_allow = 0;
+
   if (!compressed)
     error->all(FLERR,"Dump custom/gz only writes compressed files");
 }
@@ -79,6 +79,7 @@ if (test $1 = "KSPACE") then
   depend OPT
   depend USER-OMP
   depend USER-INTEL
+  depend USER-DIFFRACTION
   depend USER-PHONON
   depend USER-FEP
 fi
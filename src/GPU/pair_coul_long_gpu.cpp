@@ -77,6 +77,7 @@ PairCoulLongGPU::PairCoulLongGPU(LAMMPS *lmp) :
   PairCoulLong(lmp), gpu_mode(GPU_FORCE)
 {
   respa_enable = 0;
+  overlap_enable = 0;
   cpu_time = 0.0;
   GPU_EXTRA::gpu_ready(lmp->modify, lmp->error);
 }
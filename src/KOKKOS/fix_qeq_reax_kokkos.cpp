@@ -63,6 +63,13 @@ FixQEqReaxKokkos(LAMMPS *lmp, int narg, char **arg) :
 
   nmax = nmax = m_cap = 0;
   allocated_flag = 0;
+
+  // only the default separate Jacobi solver with cubic/quadratic
+  // extrapolation is implemented for Kokkos
+
+  if (dualflag || precond != 0 || nextrap_s != 4 || nextrap_t != 3)
+    error->all(FLERR,"Fix qeq/reax/kk does not support "
+               "solver, precond, or extrap keywords");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -619,6 +626,8 @@ void FixQEqReaxKokkos<DeviceType>::cg_solve1()
     DeviceType::fence();
   }
 
+  iter_s = loop;
+
   if (loop >= loopmax && comm->me == 0) {
     char str[128];
     sprintf(str,"Fix qeq/reax cg_solve1 convergence failed after %d iterations "
@@ -764,6 +773,8 @@ void FixQEqReaxKokkos<DeviceType>::cg_solve2()
     DeviceType::fence();
   }
 
+  iter_t = loop;
+
   if (loop >= loopmax && comm->me == 0) {
     char str[128];
     sprintf(str,"Fix qeq/reax cg_solve2 convergence failed after %d iterations "
@@ -43,7 +43,8 @@ using namespace MathConst;
 Ewald::Ewald(LAMMPS *lmp, int narg, char **arg) : KSpace(lmp, narg, arg),
   kxvecs(NULL), kyvecs(NULL), kzvecs(NULL), ug(NULL), eg(NULL), vg(NULL),
   ek(NULL), sfacrl(NULL), sfacim(NULL), sfacrl_all(NULL), sfacim_all(NULL),
-  cs(NULL), sn(NULL), sfacrl_A(NULL), sfacim_A(NULL), sfacrl_A_all(NULL),
+  cs(NULL), sn(NULL), sfac_mc(NULL), sfac_mc_all(NULL), cs_mc(NULL),
+  sn_mc(NULL), sfacrl_A(NULL), sfacim_A(NULL), sfacrl_A_all(NULL),
   sfacim_A_all(NULL), sfacrl_B(NULL), sfacim_B(NULL), sfacrl_B_all(NULL),
   sfacim_B_all(NULL)
 {
@@ -67,6 +68,7 @@ Ewald::Ewald(LAMMPS *lmp, int narg, char **arg) : KSpace(lmp, narg, arg),
   cs = sn = NULL;
 
   kcount = 0;
+  kmax_mc = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -77,6 +79,7 @@ Ewald::~Ewald()
 {
   deallocate();
   if (group_allocate_flag) deallocate_groups();
+  deallocate_mc();
   memory->destroy(ek);
   memory->destroy3d_offset(cs,-kmax_created);
   memory->destroy3d_offset(sn,-kmax_created);
@@ -110,6 +113,10 @@ void Ewald::init()
                  "and slab correction");
   }
 
+  // incremental Monte Carlo energies do not include the slab correction
+
+  mc_enable = (slabflag == 0) ? 1 : 0;
+
   // extract short-range Coulombic cutoff from pair style
 
   triclinic = domain->triclinic;
@@ -1239,6 +1246,10 @@ double Ewald::memory_usage()
   bytes += 4 * kmax3d * sizeof(double);
   bytes += nmax*3 * sizeof(double);
   bytes += 2 * (2*kmax+1)*3*nmax * sizeof(double);
+  if (kmax_mc) {
+    bytes += 2 * (2*kmax3d+2) * sizeof(double);
+    bytes += 2 * 3*(2*kmax_mc+1) * sizeof(double);
+  }
   return bytes;
 }
 
@@ -1491,3 +1502,216 @@ void Ewald::deallocate_groups()
   delete [] sfacrl_B_all;
   delete [] sfacim_B_all;
 }
+
+/* ----------------------------------------------------------------------
+   incremental energies for Monte Carlo moves
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   compute total structure factor of current configuration
+   used as reference for subsequent compute_mc_delta() calls
+------------------------------------------------------------------------- */
+
+void Ewald::setup_mc()
+{
+  // if atom count has changed, update qsum and qsqsum
+
+  if (atom->natoms != natoms_original) {
+    qsum_qsq();
+    natoms_original = atom->natoms;
+  }
+
+  if (kmax != kmax_mc) allocate_mc();
+
+  // extend size of per-atom arrays if necessary
+
+  if (atom->nmax > nmax) {
+    memory->destroy(ek);
+    memory->destroy3d_offset(cs,-kmax_created);
+    memory->destroy3d_offset(sn,-kmax_created);
+    nmax = atom->nmax;
+    memory->create(ek,nmax,3,"ewald:ek");
+    memory->create3d_offset(cs,-kmax,kmax,3,nmax,"ewald:cs");
+    memory->create3d_offset(sn,-kmax,kmax,3,nmax,"ewald:sn");
+    kmax_created = kmax;
+  }
+
+  if (triclinic == 0)
+    eik_dot_r();
+  else
+    eik_dot_r_triclinic();
+
+  MPI_Allreduce(sfacrl,sfacrl_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(sfacim,sfacim_all,kcount,MPI_DOUBLE,MPI_SUM,world);
+
+  // reciprocal unit vector along each box dimension,
+  // same phase convention as eik_dot_r() and eik_dot_r_triclinic()
+
+  for (int ic = 0; ic < 3; ic++) {
+    unitk_mc[ic][0] = unitk_mc[ic][1] = unitk_mc[ic][2] = 0.0;
+    if (triclinic == 0) unitk_mc[ic][ic] = unitk[ic];
+    else {
+      unitk_mc[ic][ic] = 2.0*MY_PI;
+      x2lamdaT(&unitk_mc[ic][0],&unitk_mc[ic][0]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   change in long-range energy if N local charges are moved
+   q = charges, xold = old positions, xnew = new positions
+   xold = NULL for inserted charges, xnew = NULL for deleted charges
+   collective operation, procs without a moved charge pass N = 0
+   returns total change in energy, same on all procs
+------------------------------------------------------------------------- */
+
+double Ewald::compute_mc_delta(int n, double *q, double **xold, double **xnew)
+{
+  int k;
+
+  for (k = 0; k < 2*kcount+2; k++) sfac_mc[k] = 0.0;
+
+  for (int m = 0; m < n; m++) {
+    if (xnew) add_mc_charge(q[m],xnew[m]);
+    if (xold) add_mc_charge(-q[m],xold[m]);
+    if (xnew && !xold) {
+      sfac_mc[2*kcount] += q[m];
+      sfac_mc[2*kcount+1] += q[m]*q[m];
+    } else if (xold && !xnew) {
+      sfac_mc[2*kcount] -= q[m];
+      sfac_mc[2*kcount+1] -= q[m]*q[m];
+    }
+  }
+
+  MPI_Allreduce(sfac_mc,sfac_mc_all,2*kcount+2,MPI_DOUBLE,MPI_SUM,world);
+
+  // difference of |S(k)|^2 sums plus change in self and
+  // neutralizing background terms
+
+  double *dsfacrl = sfac_mc_all;
+  double *dsfacim = &sfac_mc_all[kcount];
+
+  double delta = 0.0;
+  for (k = 0; k < kcount; k++)
+    delta += ug[k] * (dsfacrl[k]*(2.0*sfacrl_all[k] + dsfacrl[k]) +
+                      dsfacim[k]*(2.0*sfacim_all[k] + dsfacim[k]));
+
+  qsum_mc = qsum + sfac_mc_all[2*kcount];
+  qsqsum_mc = qsqsum + sfac_mc_all[2*kcount+1];
+
+  delta -= g_ewald*(qsqsum_mc-qsqsum)/MY_PIS +
+    MY_PI2*(qsum_mc*qsum_mc - qsum*qsum) / (g_ewald*g_ewald*volume);
+
+  return qqrd2e*scale*delta;
+}
+
+/* ----------------------------------------------------------------------
+   long-range energy of the charges inserted or deleted by the last
+     trial move with each other and with their own periodic images
+   part of compute_mc_delta() that does not depend on the other charges
+------------------------------------------------------------------------- */
+
+double Ewald::compute_mc_intra()
+{
+  double *dsfacrl = sfac_mc_all;
+  double *dsfacim = &sfac_mc_all[kcount];
+  double dqsum = sfac_mc_all[2*kcount];
+  double dqsqsum = fabs(sfac_mc_all[2*kcount+1]);
+
+  double energy = 0.0;
+  for (int k = 0; k < kcount; k++)
+    energy += ug[k] * (dsfacrl[k]*dsfacrl[k] + dsfacim[k]*dsfacim[k]);
+
+  energy -= g_ewald*dqsqsum/MY_PIS +
+    MY_PI2*dqsum*dqsum / (g_ewald*g_ewald*volume);
+
+  return qqrd2e*scale*energy;
+}
+
+/* ----------------------------------------------------------------------
+   accept last trial move passed to compute_mc_delta()
+   update total structure factor and charge sums
+------------------------------------------------------------------------- */
+
+void Ewald::accept_mc()
+{
+  for (int k = 0; k < kcount; k++) {
+    sfacrl_all[k] += sfac_mc_all[k];
+    sfacim_all[k] += sfac_mc_all[kcount+k];
+  }
+
+  qsum = qsum_mc;
+  qsqsum = qsqsum_mc;
+  q2 = qsqsum * force->qqrd2e;
+}
+
+/* ----------------------------------------------------------------------
+   add structure factor contribution of charge q at position x
+------------------------------------------------------------------------- */
+
+void Ewald::add_mc_charge(double q, double *x)
+{
+  int ic,m;
+
+  for (ic = 0; ic < 3; ic++) {
+    double phase = unitk_mc[ic][0]*x[0] + unitk_mc[ic][1]*x[1] +
+      unitk_mc[ic][2]*x[2];
+    cs_mc[ic][0] = 1.0;
+    sn_mc[ic][0] = 0.0;
+    cs_mc[ic][1] = cos(phase);
+    sn_mc[ic][1] = sin(phase);
+    for (m = 2; m <= kmax_mc; m++) {
+      cs_mc[ic][m] = cs_mc[ic][m-1]*cs_mc[ic][1] - sn_mc[ic][m-1]*sn_mc[ic][1];
+      sn_mc[ic][m] = sn_mc[ic][m-1]*cs_mc[ic][1] + cs_mc[ic][m-1]*sn_mc[ic][1];
+    }
+    for (m = 1; m <= kmax_mc; m++) {
+      cs_mc[ic][-m] = cs_mc[ic][m];
+      sn_mc[ic][-m] = -sn_mc[ic][m];
+    }
+  }
+
+  double *dsfacrl = sfac_mc;
+  double *dsfacim = &sfac_mc[kcount];
+
+  int kx,ky,kz;
+  double cypz,sypz;
+
+  for (int k = 0; k < kcount; k++) {
+    kx = kxvecs[k];
+    ky = kyvecs[k];
+    kz = kzvecs[k];
+    cypz = cs_mc[1][ky]*cs_mc[2][kz] - sn_mc[1][ky]*sn_mc[2][kz];
+    sypz = sn_mc[1][ky]*cs_mc[2][kz] + cs_mc[1][ky]*sn_mc[2][kz];
+    dsfacrl[k] += q*(cs_mc[0][kx]*cypz - sn_mc[0][kx]*sypz);
+    dsfacim[k] += q*(sn_mc[0][kx]*cypz + cs_mc[0][kx]*sypz);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   allocate Monte Carlo memory that depends on # of K-vectors
+------------------------------------------------------------------------- */
+
+void Ewald::allocate_mc()
+{
+  deallocate_mc();
+
+  kmax_mc = kmax;
+  sfac_mc = new double[2*kmax3d+2];
+  sfac_mc_all = new double[2*kmax3d+2];
+  memory->create2d_offset(cs_mc,3,-kmax_mc,kmax_mc,"ewald:cs_mc");
+  memory->create2d_offset(sn_mc,3,-kmax_mc,kmax_mc,"ewald:sn_mc");
+}
+
+/* ----------------------------------------------------------------------
+   deallocate Monte Carlo memory that depends on # of K-vectors
+------------------------------------------------------------------------- */
+
+void Ewald::deallocate_mc()
+{
+  delete [] sfac_mc;
+  delete [] sfac_mc_all;
+  memory->destroy2d_offset(cs_mc,-kmax_mc);
+  memory->destroy2d_offset(sn_mc,-kmax_mc);
+  sfac_mc = sfac_mc_all = NULL;
+  kmax_mc = 0;
+}
@@ -35,6 +35,11 @@ class Ewald : public KSpace {
 
   void compute_group_group(int, int, int);
 
+  void setup_mc();
+  double compute_mc_delta(int, double *, double **, double **);
+  double compute_mc_intra();
+  void accept_mc();
+
  protected:
   int kxmax,kymax,kzmax;
   int kcount,kmax,kmax3d,kmax_created;
@@ -50,6 +55,14 @@ class Ewald : public KSpace {
   double *sfacrl,*sfacim,*sfacrl_all,*sfacim_all;
   double ***cs,***sn;
 
+  // incremental energies for Monte Carlo moves
+
+  int kmax_mc;
+  double unitk_mc[3][3];           // reciprocal unit vectors in box coords
+  double *sfac_mc,*sfac_mc_all;    // structure factor change of a trial move
+  double **cs_mc,**sn_mc;
+  double qsum_mc,qsqsum_mc;        // charge sums after a trial move
+
   // group-group interactions
 
   int group_allocate_flag;
@@ -74,6 +87,12 @@ class Ewald : public KSpace {
   void slabcorr_groups(int,int,int);
   void allocate_groups();
   void deallocate_groups();
+
+  // Monte Carlo moves
+
+  void allocate_mc();
+  void deallocate_mc();
+  void add_mc_charge(double, double *);
 };
 
 }
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 #include "fft3d.h"
 #include "remap.h"
 
@@ -34,6 +35,14 @@
 #define MIN(A,B) ((A) < (B) ? (A) : (B))
 #define MAX(A,B) ((A) > (B) ? (A) : (B))
 
+static void set_extent(int *, int, int, int, int, int, int,
+                       int, int, int, int, int, int, int);
+static void free_pipeline(struct fft_plan_3d *);
+static void fft_1d_chunk(FFT_DATA *, int, int, struct fft_chunk_1d *,
+                         struct fft_plan_3d *);
+static void fft_pipeline_pass(FFT_DATA **, FFT_DATA **, int, int, int,
+                              struct fft_plan_3d *);
+
 /* ----------------------------------------------------------------------
    Data layout for 3d FFTs:
 
@@ -73,6 +82,13 @@ void fft_3d(FFT_DATA *in, FFT_DATA *out, int flag, struct fft_plan_3d *plan)
 #endif
   FFT_DATA *data,*copy;
 
+  // pipelined FFTs are done as a multi-field FFT of a single field
+
+  if (plan->nchunk) {
+    fft_3d_multi(&in,&out,1,flag,plan);
+    return;
+  }
+
   // system specific constants
 
 #if defined(FFT_FFTW3)
@@ -267,6 +283,7 @@ struct fft_plan_3d *fft_3d_create_plan(
   int third_ilo,third_ihi,third_jlo,third_jhi,third_klo,third_khi;
   int out_size,first_size,second_size,third_size,copy_size,scratch_size;
   int np1,np2,ip1,ip2;
+  int i;
 
   // query MPI info
 
@@ -341,6 +358,11 @@ struct fft_plan_3d *fft_3d_create_plan(
                            usecollective);
   if (plan->mid1_plan == NULL) return NULL;
 
+  set_extent(plan->remap_ext[0],
+             first_ilo,first_ihi,first_jlo,first_jhi,first_klo,first_khi,
+             second_ilo,second_ihi,second_jlo,second_jhi,
+             second_klo,second_khi,1);
+
   // 1d FFTs along mid axis
 
   plan->length2 = nmid;
@@ -382,11 +404,23 @@ struct fft_plan_3d *fft_3d_create_plan(
                          third_ilo,third_ihi,2,1,0,FFT_PRECISION,usecollective);
   if (plan->mid2_plan == NULL) return NULL;
 
+  set_extent(plan->remap_ext[1],
+             second_jlo,second_jhi,second_klo,second_khi,
+             second_ilo,second_ihi,
+             third_jlo,third_jhi,third_klo,third_khi,
+             third_ilo,third_ihi,1);
+
   // 1d FFTs along slow axis
 
   plan->length3 = nslow;
   plan->total3 = (third_ihi-third_ilo+1) * (third_jhi-third_jlo+1) * nslow;
 
+  set_extent(plan->remap_ext[2],
+             third_klo,third_khi,third_ilo,third_ihi,
+             third_jlo,third_jhi,
+             out_klo,out_khi,out_ilo,out_ihi,
+             out_jlo,out_jhi,(permute+1)%3);
+
   // remap from 3rd FFT to final distribution
   //  not needed if permute = 2 and third indices = out indices on all procs
 
@@ -468,6 +502,19 @@ struct fft_plan_3d *fft_3d_create_plan(
 
   *nbuf = copy_size + scratch_size;
 
+  // pipelining is off until requested by fft_3d_pipeline()
+
+  plan->comm = comm;
+  plan->nchunk = 0;
+  plan->nfield = 0;
+  for (i = 0; i < 3; i++) {
+    plan->chunk_plan[i] = NULL;
+    plan->chunk[i] = NULL;
+  }
+  plan->work_size = MAX(first_size,MAX(second_size,third_size));
+  plan->work = NULL;
+  plan->chunk_in = NULL;
+
   if (copy_size) {
     plan->copy = (FFT_DATA *) malloc(copy_size*sizeof(FFT_DATA));
     if (plan->copy == NULL) return NULL;
@@ -648,6 +695,8 @@ struct fft_plan_3d *fft_3d_create_plan(
 
 void fft_3d_destroy_plan(struct fft_plan_3d *plan)
 {
+  free_pipeline(plan);
+
   if (plan->pre_plan) remap_3d_destroy_plan(plan->pre_plan);
   if (plan->mid1_plan) remap_3d_destroy_plan(plan->mid1_plan);
   if (plan->mid2_plan) remap_3d_destroy_plan(plan->mid2_plan);
@@ -876,3 +925,391 @@ void fft_1d_only(FFT_DATA *data, int nsize, int flag, struct fft_plan_3d *plan)
     }
   }
 }
+
+/* ----------------------------------------------------------------------
+   Set up pipelined 3d FFTs for a plan
+
+   Arguments:
+   plan         plan returned by previous call to fft_3d_create_plan
+   nchunk       # of chunks each remap between 1d FFTs is split into,
+                  0 = no pipelining
+   nfield       max # of fields transformed together by fft_3d_multi()
+
+   each remap after a set of 1d FFTs is split into nchunk remaps of
+     slabs along the slowest-varying index of its input layout
+   the remap of chunk k is started with nonblocking messages right after
+     the 1d FFTs on chunk k, so it overlaps with the 1d FFTs on chunk k+1
+   must be called by all procs of the plan
+   return 1 if successful, 0 if out of memory
+------------------------------------------------------------------------- */
+
+int fft_3d_pipeline(struct fft_plan_3d *plan, int nchunk, int nfield)
+{
+  int i,ipass,ichunk,lo,hi,nmid,nslow,length;
+  int *ext;
+  struct fft_chunk_1d *chunk;
+  struct remap_plan_3d *remap;
+
+  free_pipeline(plan);
+  if (nchunk <= 0) return 1;
+  if (nfield <= 0) nfield = 1;
+
+  plan->nchunk = nchunk;
+  plan->nfield = nfield;
+
+  for (ipass = 0; ipass < 3; ipass++) {
+    ext = plan->remap_ext[ipass];
+    if (ipass == 0) length = plan->length1;
+    else if (ipass == 1) length = plan->length2;
+    else length = plan->length3;
+
+    // 1d FFTs of each chunk = lines in a slab of the slow index
+
+    nmid = MAX(0,ext[3]-ext[2]+1);
+    nslow = MAX(0,ext[5]-ext[4]+1);
+
+    plan->chunk[ipass] = (struct fft_chunk_1d *)
+      malloc(nchunk*sizeof(struct fft_chunk_1d));
+    if (plan->chunk[ipass] == NULL) return 0;
+
+    for (ichunk = 0; ichunk < nchunk; ichunk++) {
+      chunk = &plan->chunk[ipass][ichunk];
+      lo = ichunk*nslow/nchunk;
+      hi = (ichunk+1)*nslow/nchunk - 1;
+      chunk->offset = length*nmid*lo;
+      chunk->nlines = nmid*(hi-lo+1);
+      if (chunk->nlines == 0) continue;
+
+#if defined(FFT_MKL)
+      DftiCreateDescriptor(&(chunk->handle),FFT_MKL_PREC,DFTI_COMPLEX,1,
+                           (MKL_LONG)length);
+      DftiSetValue(chunk->handle,DFTI_NUMBER_OF_TRANSFORMS,
+                   (MKL_LONG)chunk->nlines);
+      DftiSetValue(chunk->handle,DFTI_PLACEMENT,DFTI_INPLACE);
+      DftiSetValue(chunk->handle,DFTI_INPUT_DISTANCE,(MKL_LONG)length);
+      DftiSetValue(chunk->handle,DFTI_OUTPUT_DISTANCE,(MKL_LONG)length);
+      DftiCommitDescriptor(chunk->handle);
+#elif defined(FFT_FFTW3)
+      chunk->plan_forward =
+        FFTW_API(plan_many_dft)(1,&length,chunk->nlines,
+                                NULL,&length,1,length,
+                                NULL,&length,1,length,
+                                FFTW_FORWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+      chunk->plan_backward =
+        FFTW_API(plan_many_dft)(1,&length,chunk->nlines,
+                                NULL,&length,1,length,
+                                NULL,&length,1,length,
+                                FFTW_BACKWARD,FFTW_ESTIMATE | FFTW_UNALIGNED);
+#endif
+    }
+
+    // remap of each chunk, no remap after 3rd FFTs if no post_plan
+    // remap plan creation is collective, so empty chunks get a plan too
+
+    if (ipass == 2 && plan->post_plan == NULL) continue;
+
+    plan->chunk_plan[ipass] = (struct remap_plan_3d **)
+      malloc(nchunk*sizeof(struct remap_plan_3d *));
+    if (plan->chunk_plan[ipass] == NULL) return 0;
+    for (ichunk = 0; ichunk < nchunk; ichunk++)
+      plan->chunk_plan[ipass][ichunk] = NULL;
+
+    for (ichunk = 0; ichunk < nchunk; ichunk++) {
+      lo = ext[4] + ichunk*nslow/nchunk;
+      hi = ext[4] + (ichunk+1)*nslow/nchunk - 1;
+      remap = remap_3d_create_plan(plan->comm,
+                                   ext[0],ext[1],ext[2],ext[3],lo,hi,
+                                   ext[6],ext[7],ext[8],ext[9],
+                                   ext[10],ext[11],2,ext[12],0,
+                                   FFT_PRECISION,0);
+      if (remap == NULL) return 0;
+      plan->chunk_plan[ipass][ichunk] = remap;
+      if (!remap_3d_setup_nonblocking(remap,nfield,ichunk)) return 0;
+    }
+  }
+
+  // 2 work buffers per field for remap results, so no remap is in place
+  // 3 sets of ptrs for chunks in flight and remap targets
+
+  plan->work = (FFT_DATA **) malloc(2*nfield*sizeof(FFT_DATA *));
+  plan->chunk_in = (FFT_SCALAR **) malloc(3*nfield*sizeof(FFT_SCALAR *));
+  if (plan->work == NULL || plan->chunk_in == NULL) return 0;
+  for (i = 0; i < 2*nfield; i++) plan->work[i] = NULL;
+
+  for (i = 0; i < 2*nfield; i++) {
+    plan->work[i] = (FFT_DATA *) malloc(plan->work_size*sizeof(FFT_DATA));
+    if (plan->work[i] == NULL) return 0;
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   Perform 3d FFTs of several fields with the same layout at once
+
+   Arguments:
+   in           starting address of input data of each field on this proc
+   out          starting address of where output data of each field
+                  will be placed (can be same as in)
+   nfield       # of fields
+   flag         1 for forward FFT, -1 for inverse FFT
+   plan         plan returned by previous call to fft_3d_create_plan
+
+   without pipelining, each field is transformed by fft_3d()
+   with pipelining, each remap between 1d FFTs sends data of all fields
+     for a proc in one message, with up to nfield of fft_3d_pipeline()
+     fields per batch
+------------------------------------------------------------------------- */
+
+void fft_3d_multi(FFT_DATA **in, FFT_DATA **out, int nfield, int flag,
+                  struct fft_plan_3d *plan)
+{
+  int i,ifield,num;
+  FFT_SCALAR norm;
+  FFT_DATA **data,**dest,**bufa,**bufb;
+
+  if (plan->nchunk == 0) {
+    for (ifield = 0; ifield < nfield; ifield++)
+      fft_3d(in[ifield],out[ifield],flag,plan);
+    return;
+  }
+
+  if (nfield > plan->nfield) {
+    for (ifield = 0; ifield < nfield; ifield += plan->nfield)
+      fft_3d_multi(&in[ifield],&out[ifield],
+                   MIN(plan->nfield,nfield-ifield),flag,plan);
+    return;
+  }
+
+  // pre-remap to prepare for 1st FFTs if needed
+  // remap results alternate between 2 work buffers
+
+  bufa = plan->work;
+  bufb = plan->work + plan->nfield;
+
+  if (plan->pre_plan) {
+    for (ifield = 0; ifield < nfield; ifield++)
+      remap_3d((FFT_SCALAR *) in[ifield], (FFT_SCALAR *) bufa[ifield],
+               (FFT_SCALAR *) plan->scratch, plan->pre_plan);
+    data = bufa;
+    dest = bufb;
+  } else {
+    data = in;
+    dest = bufa;
+  }
+
+  // 1d FFTs along fast axis overlapped with 1st mid-remap
+
+  fft_pipeline_pass(data,dest,nfield,flag,0,plan);
+  data = dest;
+  dest = (data == bufa) ? bufb : bufa;
+
+  // 1d FFTs along mid axis overlapped with 2nd mid-remap
+
+  fft_pipeline_pass(data,dest,nfield,flag,1,plan);
+  data = dest;
+
+  // 1d FFTs along slow axis overlapped with post-remap if needed
+  // else data is already in output layout
+
+  if (plan->post_plan) fft_pipeline_pass(data,out,nfield,flag,2,plan);
+  else {
+    fft_pipeline_pass(data,NULL,nfield,flag,2,plan);
+    for (ifield = 0; ifield < nfield; ifield++)
+      memcpy(out[ifield],data[ifield],plan->total3*sizeof(FFT_DATA));
+  }
+
+  // scaling if required
+
+  if (flag == 1 && plan->scaled) {
+    norm = plan->norm;
+    num = plan->normnum;
+    for (ifield = 0; ifield < nfield; ifield++) {
+#if defined(FFT_FFTW3)
+      FFT_SCALAR *out_ptr = (FFT_SCALAR *) out[ifield];
+#endif
+      for (i = 0; i < num; i++) {
+#if defined(FFT_FFTW3)
+        *(out_ptr++) *= norm;
+        *(out_ptr++) *= norm;
+#elif defined(FFT_MKL)
+        out[ifield][i] *= norm;
+#else
+        out[ifield][i].re *= norm;
+        out[ifield][i].im *= norm;
+#endif
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store in/out extents and permutation of a remap between 1d FFTs
+------------------------------------------------------------------------- */
+
+static void set_extent(int *ext,
+                       int in_ilo, int in_ihi, int in_jlo, int in_jhi,
+                       int in_klo, int in_khi,
+                       int out_ilo, int out_ihi, int out_jlo, int out_jhi,
+                       int out_klo, int out_khi, int permute)
+{
+  ext[0] = in_ilo;
+  ext[1] = in_ihi;
+  ext[2] = in_jlo;
+  ext[3] = in_jhi;
+  ext[4] = in_klo;
+  ext[5] = in_khi;
+  ext[6] = out_ilo;
+  ext[7] = out_ihi;
+  ext[8] = out_jlo;
+  ext[9] = out_jhi;
+  ext[10] = out_klo;
+  ext[11] = out_khi;
+  ext[12] = permute;
+}
+
+/* ----------------------------------------------------------------------
+   free all memory of pipelined FFTs and turn pipelining off
+------------------------------------------------------------------------- */
+
+static void free_pipeline(struct fft_plan_3d *plan)
+{
+  int i,ipass,ichunk;
+
+  for (ipass = 0; ipass < 3; ipass++) {
+    if (plan->chunk_plan[ipass]) {
+      for (ichunk = 0; ichunk < plan->nchunk; ichunk++)
+        if (plan->chunk_plan[ipass][ichunk])
+          remap_3d_destroy_plan(plan->chunk_plan[ipass][ichunk]);
+      free(plan->chunk_plan[ipass]);
+      plan->chunk_plan[ipass] = NULL;
+    }
+
+    if (plan->chunk[ipass]) {
+#if defined(FFT_MKL) || defined(FFT_FFTW3)
+      for (ichunk = 0; ichunk < plan->nchunk; ichunk++) {
+        struct fft_chunk_1d *chunk = &plan->chunk[ipass][ichunk];
+        if (chunk->nlines == 0) continue;
+#if defined(FFT_MKL)
+        DftiFreeDescriptor(&(chunk->handle));
+#else
+        FFTW_API(destroy_plan)(chunk->plan_forward);
+        FFTW_API(destroy_plan)(chunk->plan_backward);
+#endif
+      }
+#endif
+      free(plan->chunk[ipass]);
+      plan->chunk[ipass] = NULL;
+    }
+  }
+
+  if (plan->work) {
+    for (i = 0; i < 2*plan->nfield; i++)
+      if (plan->work[i]) free(plan->work[i]);
+    free(plan->work);
+    plan->work = NULL;
+  }
+  if (plan->chunk_in) free(plan->chunk_in);
+  plan->chunk_in = NULL;
+
+  plan->nchunk = 0;
+  plan->nfield = 0;
+}
+
+/* ----------------------------------------------------------------------
+   perform the 1d FFTs of one chunk of 1st, 2nd, or 3rd set of FFTs
+------------------------------------------------------------------------- */
+
+static void fft_1d_chunk(FFT_DATA *data, int flag, int ipass,
+                         struct fft_chunk_1d *chunk, struct fft_plan_3d *plan)
+{
+  if (chunk->nlines == 0) return;
+
+  FFT_DATA *ptr = &data[chunk->offset];
+
+#if defined(FFT_MKL)
+  if (flag == -1)
+    DftiComputeForward(chunk->handle,ptr);
+  else
+    DftiComputeBackward(chunk->handle,ptr);
+#elif defined(FFT_FFTW2)
+  fftw_plan theplan;
+  int length;
+  if (ipass == 0) {
+    length = plan->length1;
+    theplan = (flag == -1) ? plan->plan_fast_forward : plan->plan_fast_backward;
+  } else if (ipass == 1) {
+    length = plan->length2;
+    theplan = (flag == -1) ? plan->plan_mid_forward : plan->plan_mid_backward;
+  } else {
+    length = plan->length3;
+    theplan = (flag == -1) ? plan->plan_slow_forward : plan->plan_slow_backward;
+  }
+  fftw(theplan,chunk->nlines,ptr,1,length,NULL,0,0);
+#elif defined(FFT_FFTW3)
+  if (flag == -1)
+    FFTW_API(execute_dft)(chunk->plan_forward,ptr,ptr);
+  else
+    FFTW_API(execute_dft)(chunk->plan_backward,ptr,ptr);
+#else
+  kiss_fft_cfg cfg;
+  int length;
+  if (ipass == 0) {
+    length = plan->length1;
+    cfg = (flag == -1) ? plan->cfg_fast_forward : plan->cfg_fast_backward;
+  } else if (ipass == 1) {
+    length = plan->length2;
+    cfg = (flag == -1) ? plan->cfg_mid_forward : plan->cfg_mid_backward;
+  } else {
+    length = plan->length3;
+    cfg = (flag == -1) ? plan->cfg_slow_forward : plan->cfg_slow_backward;
+  }
+  int total = chunk->nlines*length;
+  for (int offset = 0; offset < total; offset += length)
+    kiss_fft(cfg,&ptr[offset],&ptr[offset]);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   perform 1st, 2nd, or 3rd set of 1d FFTs chunk by chunk on all fields
+   remap of each chunk into dest is started right after its 1d FFTs
+     and completed after the 1d FFTs of the next chunk
+   no remap if dest = NULL
+------------------------------------------------------------------------- */
+
+static void fft_pipeline_pass(FFT_DATA **data, FFT_DATA **dest, int nfield,
+                              int flag, int ipass, struct fft_plan_3d *plan)
+{
+  int ichunk,ifield;
+  int nchunk = plan->nchunk;
+  struct fft_chunk_1d *chunk = plan->chunk[ipass];
+  struct remap_plan_3d **remap = plan->chunk_plan[ipass];
+  FFT_SCALAR **cur = plan->chunk_in;
+  FFT_SCALAR **prev = plan->chunk_in + nfield;
+  FFT_SCALAR **out = plan->chunk_in + 2*nfield;
+  FFT_SCALAR **tmp;
+
+  if (dest == NULL) {
+    for (ichunk = 0; ichunk < nchunk; ichunk++)
+      for (ifield = 0; ifield < nfield; ifield++)
+        fft_1d_chunk(data[ifield],flag,ipass,&chunk[ichunk],plan);
+    return;
+  }
+
+  for (ifield = 0; ifield < nfield; ifield++)
+    out[ifield] = (FFT_SCALAR *) dest[ifield];
+
+  for (ichunk = 0; ichunk < nchunk; ichunk++) {
+    for (ifield = 0; ifield < nfield; ifield++) {
+      fft_1d_chunk(data[ifield],flag,ipass,&chunk[ichunk],plan);
+      cur[ifield] = (FFT_SCALAR *) &data[ifield][chunk[ichunk].offset];
+    }
+    remap_3d_start(cur,nfield,remap[ichunk]);
+    if (ichunk) remap_3d_finish(prev,out,nfield,remap[ichunk-1]);
+    tmp = prev;
+    prev = cur;
+    cur = tmp;
+  }
+
+  remap_3d_finish(prev,out,nfield,remap[nchunk-1]);
+}
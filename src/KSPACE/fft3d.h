@@ -116,6 +116,19 @@ typedef struct kiss_fft_state* kiss_fft_cfg;
 
 // -------------------------------------------------------------------------
 
+// 1d FFTs on one chunk of a pencil layout, for pipelined 3d FFTs
+
+struct fft_chunk_1d {
+  int offset;                       // 1st element of chunk in data
+  int nlines;                       // # of 1d FFTs in chunk
+#if defined(FFT_MKL)
+  DFTI_DESCRIPTOR *handle;
+#elif defined(FFT_FFTW3)
+  FFTW_API(plan) plan_forward;
+  FFTW_API(plan) plan_backward;
+#endif
+};
+
 // details of how to do a 3d FFT
 
 struct fft_plan_3d {
@@ -133,6 +146,19 @@ struct fft_plan_3d {
   int normnum;                      // # of values to rescale
   double norm;                      // normalization factor for rescaling
 
+                                    // pipelined FFTs, see fft_3d_pipeline()
+  MPI_Comm comm;                    // procs which own the data
+  int nchunk;                       // # of chunks per remap, 0 = none
+  int nfield;                       // max # of fields in fft_3d_multi()
+  int remap_ext[3][13];             // in/out extents and permute of
+                                    //   mid1, mid2, post remap
+  struct remap_plan_3d **chunk_plan[3];  // remap of each chunk after
+                                         //   1st,2nd,3rd FFTs
+  struct fft_chunk_1d *chunk[3];    // 1d FFTs of each chunk
+  int work_size;                    // size of each work buffer
+  FFT_DATA **work;                  // 2*nfield buffers for remap results
+  FFT_SCALAR **chunk_in;            // 2*nfield ptrs to chunks in flight
+
                                     // system specific 1d FFT info
 #if defined(FFT_MKL)
   DFTI_DESCRIPTOR *handle_fast;
@@ -174,6 +200,8 @@ extern "C" {
   void factor(int, int *, int *);
   void bifactor(int, int *, int *);
   void fft_1d_only(FFT_DATA *, int, int, struct fft_plan_3d *);
+  int fft_3d_pipeline(struct fft_plan_3d *, int, int);
+  void fft_3d_multi(FFT_DATA **, FFT_DATA **, int, int, struct fft_plan_3d *);
 }
 
 /* ERROR/WARNING messages:
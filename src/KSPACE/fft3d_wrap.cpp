@@ -47,9 +47,30 @@ void FFT3d::compute(FFT_SCALAR *in, FFT_SCALAR *out, int flag)
   fft_3d((FFT_DATA *) in,(FFT_DATA *) out,flag,plan);
 }
 
+/* ----------------------------------------------------------------------
+   transform nfield fields at once, see fft_3d_multi()
+------------------------------------------------------------------------- */
+
+void FFT3d::compute_multi(FFT_SCALAR **in, FFT_SCALAR **out, int nfield,
+                          int flag)
+{
+  fft_3d_multi((FFT_DATA **) in,(FFT_DATA **) out,nfield,flag,plan);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FFT3d::timing1d(FFT_SCALAR *in, int nsize, int flag)
 {
   fft_1d_only((FFT_DATA *) in,nsize,flag,plan);
 }
+
+/* ----------------------------------------------------------------------
+   split remaps into nchunk pipelined chunks, 0 = no pipelining
+   nfield = max # of fields passed to compute_multi() at once
+------------------------------------------------------------------------- */
+
+void FFT3d::setup_pipeline(int nchunk, int nfield)
+{
+  if (!fft_3d_pipeline(plan,nchunk,nfield))
+    error->one(FLERR,"Could not set up pipelined 3d FFT");
+}
@@ -25,7 +25,9 @@ class FFT3d : protected Pointers {
         int,int,int,int,int,int,int,int,int *,int);
   ~FFT3d();
   void compute(FFT_SCALAR *, FFT_SCALAR *, int);
+  void compute_multi(FFT_SCALAR **, FFT_SCALAR **, int, int);
   void timing1d(FFT_SCALAR *, int, int);
+  void setup_pipeline(int, int);
 
  private:
   struct fft_plan_3d *plan;
@@ -43,4 +45,10 @@ The FFT setup for the PPPM solver failed, typically due
 to lack of memory.  This is an unusual error.  Check the
 size of the FFT grid you are requesting.
 
+E: Could not set up pipelined 3d FFT
+
+The chunked remaps and work buffers for pipelined FFTs could not be
+allocated, typically due to lack of memory.  Use fewer chunks with
+the kspace_modify pipeline keyword or turn pipelining off.
+
 */
@@ -0,0 +1,307 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <mpi.h>
+#include <string.h>
+#include <stdlib.h>
+#include "fix_tune_pppm.h"
+#include "pppm.h"
+#include "update.h"
+#include "comm.h"
+#include "neighbor.h"
+#include "neigh_request.h"
+#include "force.h"
+#include "pair.h"
+#include "timer.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+#define NSCAN 10          // # of trial cutoffs scanned by the cost model
+#define MAXRATIO 1.25     // max factor by which cutoff changes at once
+
+/* ---------------------------------------------------------------------- */
+
+FixTunePPPM::FixTunePPPM(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg)
+{
+  if (narg < 4) error->all(FLERR,"Illegal fix tune/pppm command");
+
+  vector_flag = 1;
+  size_vector = 4;
+  global_freq = 1;
+  extvector = 0;
+
+  nevery = force->inumeric(FLERR,arg[3]);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix tune/pppm command");
+
+  cutmin = cutmax = -1.0;
+  tol = 0.02;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"min") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/pppm command");
+      cutmin = force->numeric(FLERR,arg[iarg+1]);
+      if (cutmin <= 0.0) error->all(FLERR,"Illegal fix tune/pppm command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"max") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/pppm command");
+      cutmax = force->numeric(FLERR,arg[iarg+1]);
+      if (cutmax <= 0.0) error->all(FLERR,"Illegal fix tune/pppm command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"tol") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/pppm command");
+      tol = force->numeric(FLERR,arg[iarg+1]);
+      if (tol < 0.0) error->all(FLERR,"Illegal fix tune/pppm command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix tune/pppm command");
+  }
+
+  if (cutmin > 0.0 && cutmax > 0.0 && cutmin > cutmax)
+    error->all(FLERR,"Illegal fix tune/pppm command");
+
+  // force_reneighbor so pre_exchange() can trigger a rebuild
+  //   on the step after the cutoff is changed
+
+  force_reneighbor = 1;
+  next_reneighbor = -1;
+
+  pppm = NULL;
+  p_cutoff = NULL;
+  firstflag = 1;
+  nchange = 0;
+  cut_new = 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixTunePPPM::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTunePPPM::init()
+{
+  pppm = dynamic_cast<PPPM *>(force->kspace);
+  if (!pppm) error->all(FLERR,"Fix tune/pppm requires a PPPM kspace style");
+  if (pppm->user_grid())
+    error->all(FLERR,"Fix tune/pppm cannot be used with "
+               "kspace_modify gewald or mesh");
+  if (!timer->has_normal())
+    error->all(FLERR,"Fix tune/pppm requires timer level normal or full");
+  if (lmp->kokkos)
+    error->all(FLERR,"Fix tune/pppm is not compatible with KOKKOS");
+
+  int itmp;
+  p_cutoff = NULL;
+  if (force->pair) p_cutoff = (double *) force->pair->extract("cut_coul",itmp);
+  if (!p_cutoff)
+    error->all(FLERR,"Fix tune/pppm requires a pair style "
+               "with a Coulomb cutoff");
+
+  // default bounds are relative to the cutoff the run starts with
+
+  if (cutmin < 0.0) cutmin = 0.5 * (*p_cutoff);
+  if (cutmax < 0.0) cutmax = 2.0 * (*p_cutoff);
+  if (cutmin > cutmax) error->all(FLERR,"Illegal fix tune/pppm command");
+}
+
+/* ----------------------------------------------------------------------
+   Timer and Neighbor counters are reset at start of each run
+   first end_of_step() of the run only records a baseline
+------------------------------------------------------------------------- */
+
+void FixTunePPPM::setup(int vflag)
+{
+  firstflag = 1;
+  next_reneighbor = -1;
+}
+
+/* ----------------------------------------------------------------------
+   measure cost of pair, neighbor, comm, and kspace since last measurement
+   choose Coulomb cutoff that minimizes the modeled cost per timestep
+------------------------------------------------------------------------- */
+
+void FixTunePPPM::end_of_step()
+{
+  double wall[4];
+  wall[0] = timer->get_wall(Timer::PAIR);
+  wall[1] = timer->get_wall(Timer::NEIGH);
+  wall[2] = timer->get_wall(Timer::COMM);
+  wall[3] = timer->get_wall(Timer::KSPACE);
+
+  bigint ntimestep = update->ntimestep;
+
+  if (firstflag) {
+    firstflag = 0;
+    laststep = ntimestep;
+    lastcalls = neighbor->ncalls;
+    for (int m = 0; m < 4; m++) lastwall[m] = wall[m];
+    return;
+  }
+
+  // need at least 1 build so the neighbor cost is represented
+
+  bigint nsteps = ntimestep - laststep;
+  bigint nbuild = neighbor->ncalls - lastcalls;
+  if (nsteps <= 0 || nbuild < 1) return;
+
+  double delta[4],all[4];
+  for (int m = 0; m < 4; m++) delta[m] = wall[m] - lastwall[m];
+  MPI_Allreduce(delta,all,4,MPI_DOUBLE,MPI_SUM,world);
+  for (int m = 0; m < 4; m++) all[m] /= comm->nprocs;
+
+  laststep = ntimestep;
+  lastcalls = neighbor->ncalls;
+  for (int m = 0; m < 4; m++) lastwall[m] = wall[m];
+
+  // per-step cost of each section
+  // skin and list lifetime do not change with the Coulomb cutoff,
+  //   so neighbor cost per step scales like pair cost
+
+  double cut = *p_cutoff;
+  double cutneigh = neighbor->cutneighmax;
+  double tpair = all[0] / nsteps;
+  double tneigh = all[1] / nsteps;
+  double tcomm = all[2] / nsteps;
+  double tkspace = all[3] / nsteps;
+  double ngrid = pppm->estimate_ngrid(cut);
+  if (ngrid <= 0.0) return;
+
+  // scan trial cutoffs within bounds and MAXRATIO of current cutoff
+  // only adopt new cutoff if predicted gain exceeds tol
+  // skip trials for which PPPM could not set up a grid, e.g. too large
+  // estimate_ngrid() is collective, all procs scan the same trials
+
+  double lo = MAX(cutmin,cut/MAXRATIO);
+  double hi = MIN(cutmax,cut*MAXRATIO);
+
+  double cost0 = tpair + tneigh + tcomm + tkspace;
+  double costbest = cost0;
+  double cutbest = cut;
+
+  if (hi > lo) {
+    for (int i = 0; i <= NSCAN; i++) {
+      double trial = lo + i*(hi-lo)/NSCAN;
+      double ntrial = pppm->estimate_ngrid(trial);
+      if (ntrial < 0.0) continue;
+      double c = cost(trial-cut+cutneigh,cutneigh,ntrial/ngrid,
+                      tpair,tneigh,tcomm,tkspace);
+      if (c < costbest) {
+        costbest = c;
+        cutbest = trial;
+      }
+    }
+  }
+
+  if (cost0 - costbest <= tol*cost0) return;
+
+  nchange++;
+  print_change(cutbest,pppm->estimate_ngrid(cutbest));
+
+  // new cutoff is applied in pre_exchange() of next step,
+  //   which forces a reneighboring with the new cutoffs
+
+  cut_new = cutbest;
+  next_reneighbor = ntimestep + 1;
+}
+
+/* ----------------------------------------------------------------------
+   apply new cutoff on the reneighboring step requested by end_of_step()
+   PPPM::init() re-derives G-ewald and grid from the accuracy,
+     pair init() rebuilds cutoffs and tables for the new G-ewald
+   neighbor lists are kept, only their cutoffs change as for fix tune/skin
+------------------------------------------------------------------------- */
+
+void FixTunePPPM::pre_exchange()
+{
+  if (update->ntimestep != next_reneighbor) return;
+  next_reneighbor = -1;
+
+  *p_cutoff = cut_new;
+
+  force->kspace->init();
+
+  // pair init() also issues the pair neighbor list requests again,
+  //   discard them so the next run does not see them twice
+
+  int nrequest = neighbor->nrequest;
+  force->pair->init();
+  for (int i = nrequest; i < neighbor->nrequest; i++) {
+    delete neighbor->requests[i];
+    neighbor->requests[i] = NULL;
+  }
+  neighbor->nrequest = nrequest;
+
+  neighbor->reset_cutoffs();
+  comm->setup();
+  neighbor->setup_bins();
+  force->kspace->setup_grid();
+
+  // timers of steps before the change do not describe the new cutoff
+
+  firstflag = 1;
+}
+
+/* ----------------------------------------------------------------------
+   modeled wall time per step for a neighbor cutoff of rc,
+     given measurements at rc0 and ratio of PPPM grid points
+   pair and neighbor cost scale with # of pairs ~ (rc)^3
+   comm cost scales with ghost shell thickness ~ rc
+   kspace cost scales with # of grid points
+   assumes the Coulomb cutoff is the largest force cutoff
+------------------------------------------------------------------------- */
+
+double FixTunePPPM::cost(double rc, double rc0, double gridratio,
+                         double tpair, double tneigh, double tcomm,
+                         double tkspace)
+{
+  double g = rc / rc0;
+  double g3 = g*g*g;
+  return (tpair + tneigh)*g3 + tcomm*g + tkspace*gridratio;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTunePPPM::print_change(double cutbest, double ngrid)
+{
+  if (comm->me) return;
+
+  char str[256];
+  sprintf(str,"Fix tune/pppm: step " BIGINT_FORMAT
+          " Coulomb cutoff %g -> %g grid points %g -> %g\n",
+          update->ntimestep,*p_cutoff,cutbest,
+          (double) pppm->nx_pppm*pppm->ny_pppm*pppm->nz_pppm,ngrid);
+  if (screen) fputs(str,screen);
+  if (logfile) fputs(str,logfile);
+}
+
+/* ----------------------------------------------------------------------
+   return current Coulomb cutoff, G-ewald, # of grid points, or # of changes
+------------------------------------------------------------------------- */
+
+double FixTunePPPM::compute_vector(int i)
+{
+  if (i == 0) return *p_cutoff;
+  if (i == 1) return force->kspace->g_ewald;
+  if (i == 2)
+    return (double) pppm->nx_pppm*pppm->ny_pppm*pppm->nz_pppm;
+  return (double) nchange;
+}
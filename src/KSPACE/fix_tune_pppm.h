@@ -0,0 +1,93 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(tune/pppm,FixTunePPPM)
+
+#else
+
+#ifndef LMP_FIX_TUNE_PPPM_H
+#define LMP_FIX_TUNE_PPPM_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixTunePPPM : public Fix {
+ public:
+  FixTunePPPM(class LAMMPS *, int, char **);
+  ~FixTunePPPM() {}
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  void pre_exchange();
+  double compute_vector(int);
+
+ private:
+  double cutmin,cutmax;         // bounds on Coulomb cutoff, -1 = not set
+  double tol;                   // min fractional gain to change cutoff
+
+  class PPPM *pppm;
+  double *p_cutoff;             // Coulomb cutoff stored in pair style
+
+  int firstflag;                // 1 if next end_of_step() sets baseline
+  bigint laststep;              // timestep of last measurement
+  bigint lastcalls;             // neighbor->ncalls at last measurement
+  double lastwall[4];           // Pair,Neigh,Comm,Kspace timers at last meas
+  double cut_new;               // cutoff to apply in pre_exchange()
+  int nchange;                  // # of times cutoff was changed
+
+  double cost(double, double, double, double, double, double, double);
+  void print_change(double, double);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Fix tune/pppm requires a PPPM kspace style
+
+Only kspace style pppm and styles derived from it, such as
+pppm/tip4p or pppm/cg, provide the grid estimate used by the
+cost model.
+
+E: Fix tune/pppm cannot be used with kspace_modify gewald or mesh
+
+The cutoff can only be traded against the grid size if LAMMPS
+chooses the G-ewald parameter and the grid from the accuracy.
+
+E: Fix tune/pppm requires timer level normal or full
+
+The cost model uses the Pair, Neigh, Comm, and Kspace timers which
+are not accumulated with timer level off or loop.
+
+E: Fix tune/pppm is not compatible with KOKKOS
+
+Self-explanatory.
+
+E: Fix tune/pppm requires a pair style with a Coulomb cutoff
+
+The pair style must support extracting its cut_coul parameter.
+
+*/
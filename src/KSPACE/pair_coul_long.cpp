@@ -47,6 +47,7 @@ using namespace LAMMPS_NS;
 PairCoulLong::PairCoulLong(LAMMPS *lmp) : Pair(lmp)
 {
   ewaldflag = pppmflag = 1;
+  overlap_enable = 1;
   ftable = NULL;
   qdist = 0.0;
 }
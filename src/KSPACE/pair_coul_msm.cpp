@@ -40,6 +40,7 @@ PairCoulMSM::PairCoulMSM(LAMMPS *lmp) : PairCoulLong(lmp)
 {
   ewaldflag = pppmflag = 0;
   msmflag = 1;
+  overlap_enable = 0;
 }
 
 /* ---------------------------------------------------------------------- */
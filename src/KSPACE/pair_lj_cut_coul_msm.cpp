@@ -43,6 +43,7 @@ PairLJCutCoulMSM::PairLJCutCoulMSM(LAMMPS *lmp) : PairLJCutCoulLong(lmp)
 {
   ewaldflag = pppmflag = 0;
   msmflag = 1;
+  overlap_enable = 0;
   nmax = 0;
   ftmp = NULL;
 }
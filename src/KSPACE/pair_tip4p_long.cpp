@@ -53,6 +53,7 @@ PairTIP4PLong::PairTIP4PLong(LAMMPS *lmp) : PairCoulLong(lmp)
   tip4pflag = 1;
   single_enable = 0;
   respa_enable = 0;
+  overlap_enable = 0;
 
   nmax = 0;
   hneigh = NULL;
@@ -68,7 +68,8 @@ PPPM::PPPM(LAMMPS *lmp, int narg, char **arg) : KSpace(lmp, narg, arg),
   factors(NULL), density_brick(NULL), vdx_brick(NULL), vdy_brick(NULL), vdz_brick(NULL),
   u_brick(NULL), v0_brick(NULL), v1_brick(NULL), v2_brick(NULL), v3_brick(NULL),
   v4_brick(NULL), v5_brick(NULL), greensfn(NULL), vg(NULL), fkx(NULL), fky(NULL),
-  fkz(NULL), density_fft(NULL), work1(NULL), work2(NULL), gf_b(NULL), rho1d(NULL),
+  fkz(NULL), density_fft(NULL), work1(NULL), work2(NULL), work3(NULL),
+  work4(NULL), gf_b(NULL), rho1d(NULL),
   rho_coeff(NULL), drho1d(NULL), drho_coeff(NULL), sf_precoeff1(NULL), sf_precoeff2(NULL),
   sf_precoeff3(NULL), sf_precoeff4(NULL), sf_precoeff5(NULL), sf_precoeff6(NULL),
   acons(NULL), density_A_brick(NULL), density_B_brick(NULL), density_A_fft(NULL),
@@ -100,6 +101,7 @@ PPPM::PPPM(LAMMPS *lmp, int narg, char **arg) : KSpace(lmp, narg, arg),
   v0_brick = v1_brick = v2_brick = v3_brick = v4_brick = v5_brick = NULL;
   greensfn = NULL;
   work1 = work2 = NULL;
+  work3 = work4 = NULL;
   vg = NULL;
   fkx = fky = fkz = NULL;
 
@@ -826,6 +828,18 @@ void PPPM::allocate()
                    nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                    0,0,&tmp,collective_flag);
 
+  // pipelined FFTs, fft2 batches the 3 ik field components
+
+  if (fft_pipeline) {
+    fft1->setup_pipeline(fft_pipeline,1);
+    if (differentiation_flag == 1) fft2->setup_pipeline(fft_pipeline,1);
+    else {
+      memory->create(work3,2*nfft_both,"pppm:work3");
+      memory->create(work4,2*nfft_both,"pppm:work4");
+      fft2->setup_pipeline(fft_pipeline,3);
+    }
+  }
+
   remap = new Remap(lmp,world,
                     nxlo_in,nxhi_in,nylo_in,nyhi_in,nzlo_in,nzhi_in,
                     nxlo_fft,nxhi_fft,nylo_fft,nyhi_fft,nzlo_fft,nzhi_fft,
@@ -875,6 +889,8 @@ void PPPM::deallocate()
   memory->destroy(greensfn);
   memory->destroy(work1);
   memory->destroy(work2);
+  memory->destroy(work3);
+  memory->destroy(work4);
   memory->destroy(vg);
 
   if (triclinic == 0) {
@@ -973,6 +989,19 @@ void PPPM::deallocate_peratom()
 ------------------------------------------------------------------------- */
 
 void PPPM::set_grid_global()
+{
+  int flag = compute_grid_global();
+  if (flag == 1) error->all(FLERR,"Could not compute grid size");
+  if (flag == 2) error->all(FLERR,"PPPM grid is too large");
+}
+
+/* ----------------------------------------------------------------------
+   determine G-ewald and global grid size for current cutoff and accuracy
+   return 0 if successful, 1 if no grid size meets the accuracy,
+     2 if the grid is too large in one or more dimensions
+------------------------------------------------------------------------- */
+
+int PPPM::compute_grid_global()
 {
   // use xprd,yprd,zprd (even if triclinic, and then scale later)
   // adjust z dimension for 2d slab PPPM
@@ -1045,7 +1074,7 @@ void PPPM::set_grid_global()
         // too many loops have been performed
 
         if (df_kspace <= accuracy) break;
-        if (count > 500) error->all(FLERR, "Could not compute grid size");
+        if (count > 500) return 1;
         h *= 0.95;
         h_x = h_y = h_z = h;
       }
@@ -1116,8 +1145,51 @@ void PPPM::set_grid_global()
     h_z = 1.0/tmp[2];
   }
 
-  if (nx_pppm >= OFFSET || ny_pppm >= OFFSET || nz_pppm >= OFFSET)
-    error->all(FLERR,"PPPM grid is too large");
+  if (nx_pppm >= OFFSET || ny_pppm >= OFFSET || nz_pppm >= OFFSET) return 2;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   return # of global grid points set_grid_global() would choose
+     to reach the current accuracy with a real-space Coulomb cutoff cut
+   return -1 if no valid grid exists for cut, instead of an error
+   cutoff, g_ewald, and grid settings are restored afterwards
+   used by fix tune/pppm to model the KSpace cost of a different cutoff
+------------------------------------------------------------------------- */
+
+double PPPM::estimate_ngrid(double cut)
+{
+  double cutoff_save = cutoff;
+  double g_ewald_save = g_ewald;
+  int nx_save = nx_pppm;
+  int ny_save = ny_pppm;
+  int nz_save = nz_pppm;
+  double hx_save = h_x;
+  double hy_save = h_y;
+  double hz_save = h_z;
+  int fft_save[6];
+  fft_save[0] = nxlo_fft; fft_save[1] = nxhi_fft;
+  fft_save[2] = nylo_fft; fft_save[3] = nyhi_fft;
+  fft_save[4] = nzlo_fft; fft_save[5] = nzhi_fft;
+
+  cutoff = cut;
+  double ngrid_trial = -1.0;
+  if (compute_grid_global() == 0)
+    ngrid_trial = (double) nx_pppm * ny_pppm * nz_pppm;
+
+  cutoff = cutoff_save;
+  g_ewald = g_ewald_save;
+  nx_pppm = nx_save;
+  ny_pppm = ny_save;
+  nz_pppm = nz_save;
+  h_x = hx_save;
+  h_y = hy_save;
+  h_z = hz_save;
+  nxlo_fft = fft_save[0]; nxhi_fft = fft_save[1];
+  nylo_fft = fft_save[2]; nyhi_fft = fft_save[3];
+  nzlo_fft = fft_save[4]; nzhi_fft = fft_save[5];
+
+  return ngrid_trial;
 }
 
 /* ----------------------------------------------------------------------
@@ -2067,6 +2139,13 @@ void PPPM::poisson_ik()
 
   if (evflag_atom) poisson_peratom();
 
+  // pipelined FFTs transform all 3 gradients at once
+
+  if (fft_pipeline) {
+    poisson_ik_batch();
+    return;
+  }
+
   // triclinic system
 
   if (triclinic) {
@@ -2142,6 +2221,61 @@ void PPPM::poisson_ik()
       }
 }
 
+/* ----------------------------------------------------------------------
+   FFT-based Poisson solver for ik with pipelined FFTs
+   gradients in all 3 dims are transformed by one multi-field FFT,
+     so each remap moves all 3 components in one message per proc
+------------------------------------------------------------------------- */
+
+void PPPM::poisson_ik_batch()
+{
+  int i,j,k,n;
+
+  // compute -ik*V(k) in each of 3 dims
+  // for triclinic, k-vectors are stored per FFT grid point
+
+  n = 0;
+  if (triclinic) {
+    for (i = 0; i < nfft; i++) {
+      work2[n] = fkx[i]*work1[n+1];
+      work2[n+1] = -fkx[i]*work1[n];
+      work3[n] = fky[i]*work1[n+1];
+      work3[n+1] = -fky[i]*work1[n];
+      work4[n] = fkz[i]*work1[n+1];
+      work4[n+1] = -fkz[i]*work1[n];
+      n += 2;
+    }
+  } else {
+    for (k = nzlo_fft; k <= nzhi_fft; k++)
+      for (j = nylo_fft; j <= nyhi_fft; j++)
+        for (i = nxlo_fft; i <= nxhi_fft; i++) {
+          work2[n] = fkx[i]*work1[n+1];
+          work2[n+1] = -fkx[i]*work1[n];
+          work3[n] = fky[j]*work1[n+1];
+          work3[n+1] = -fky[j]*work1[n];
+          work4[n] = fkz[k]*work1[n+1];
+          work4[n+1] = -fkz[k]*work1[n];
+          n += 2;
+        }
+  }
+
+  FFT_SCALAR *field[3] = {work2,work3,work4};
+  fft2->compute_multi(field,field,3,-1);
+
+  // FFT leaves data in 3d brick decomposition
+  // copy it into inner portion of vdx,vdy,vdz arrays
+
+  n = 0;
+  for (k = nzlo_in; k <= nzhi_in; k++)
+    for (j = nylo_in; j <= nyhi_in; j++)
+      for (i = nxlo_in; i <= nxhi_in; i++) {
+        vdx_brick[k][j][i] = work2[n];
+        vdy_brick[k][j][i] = work3[n];
+        vdz_brick[k][j][i] = work4[n];
+        n += 2;
+      }
+}
+
 /* ----------------------------------------------------------------------
    FFT-based Poisson solver for ik for a triclinic system
 ------------------------------------------------------------------------- */
@@ -49,6 +49,10 @@ class PPPM : public KSpace {
 
   virtual void compute_group_group(int, int, int);
 
+  double estimate_ngrid(double);   // # of grid points for a trial cutoff,
+                                   // -1 if no valid grid
+  int user_grid() const { return gridflag || gewaldflag; }
+
  protected:
   int me,nprocs;
   int nfactors;
@@ -77,6 +81,7 @@ class PPPM : public KSpace {
   double *fkx,*fky,*fkz;
   FFT_SCALAR *density_fft;
   FFT_SCALAR *work1,*work2;
+  FFT_SCALAR *work3,*work4;         // extra fields for batched ik FFTs
 
   double *gf_b;
   FFT_SCALAR **rho1d,**rho_coeff,**drho1d,**drho_coeff;
@@ -106,6 +111,7 @@ class PPPM : public KSpace {
   double alpha;                // geometric factor
 
   void set_grid_global();
+  int compute_grid_global();
   void set_grid_local();
   void adjust_gewald();
   double newton_raphson_f();
@@ -160,6 +166,7 @@ class PPPM : public KSpace {
   void setup_triclinic();
   void compute_gf_ik_triclinic();
   void poisson_ik_triclinic();
+  void poisson_ik_batch();
   void poisson_groups_triclinic();
 
   // group-group interactions
@@ -253,6 +253,11 @@ struct remap_plan_3d *remap_3d_create_plan(
   plan = (struct remap_plan_3d *) malloc(sizeof(struct remap_plan_3d));
   if (plan == NULL) return NULL;
   plan->usecollective = usecollective;
+  plan->nfield = 0;
+  plan->tag = 0;
+  plan->sendbuf_all = NULL;
+  plan->recvbuf_all = NULL;
+  plan->send_request = NULL;
 
   // store parameters in local data structs
 
@@ -646,6 +651,12 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
       free(plan->commringlist);
   }
 
+  // free nonblocking buffers
+
+  if (plan->sendbuf_all) free(plan->sendbuf_all);
+  if (plan->recvbuf_all) free(plan->recvbuf_all);
+  if (plan->send_request) free(plan->send_request);
+
   // free internal arrays
 
   if (plan->nsend || plan->self) {
@@ -671,6 +682,152 @@ void remap_3d_destroy_plan(struct remap_plan_3d *plan)
   free(plan);
 }
 
+/* ----------------------------------------------------------------------
+   Prepare a point-to-point remap plan for nonblocking use
+
+   Arguments:
+   plan         plan returned by previous call to remap_3d_create_plan
+                  with usecollective = 0
+   nfield       max # of fields moved together by remap_3d_start()
+   tag          MPI tag of messages, so several nonblocking remaps
+                  of the same procs can be in flight at once
+
+   return 1 if successful, 0 if out of memory or plan is collective
+------------------------------------------------------------------------- */
+
+int remap_3d_setup_nonblocking(struct remap_plan_3d *plan, int nfield, int tag)
+{
+  int i,nrecv,size;
+
+  if (plan->usecollective || nfield <= 0) return 0;
+
+  if (plan->sendbuf_all) free(plan->sendbuf_all);
+  if (plan->recvbuf_all) free(plan->recvbuf_all);
+  if (plan->send_request) free(plan->send_request);
+  plan->sendbuf_all = NULL;
+  plan->recvbuf_all = NULL;
+  plan->send_request = NULL;
+
+  plan->nfield = nfield;
+  plan->tag = tag;
+
+  // every send needs its own buffer space until it completes
+
+  size = 0;
+  for (i = 0; i < plan->nsend; i++) size += plan->send_size[i];
+  if (size) {
+    plan->sendbuf_all =
+      (FFT_SCALAR *) malloc(nfield*size*sizeof(FFT_SCALAR));
+    plan->send_request =
+      (MPI_Request *) malloc(plan->nsend*sizeof(MPI_Request));
+    if (plan->sendbuf_all == NULL || plan->send_request == NULL) return 0;
+  }
+
+  // recv buffer includes self data as last entry
+
+  nrecv = plan->nrecv + plan->self;
+  size = 0;
+  for (i = 0; i < nrecv; i++) size += plan->recv_size[i];
+  if (size) {
+    plan->recvbuf_all =
+      (FFT_SCALAR *) malloc(nfield*size*sizeof(FFT_SCALAR));
+    if (plan->recvbuf_all == NULL) return 0;
+  }
+
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   Start a nonblocking 3d remap of nfield fields with the same layout
+
+   Arguments:
+   in           starting address of input data of each field on this proc
+   nfield       # of fields, at most nfield of remap_3d_setup_nonblocking()
+   plan         plan prepared by remap_3d_setup_nonblocking()
+
+   all messages are posted, data of all fields for one proc is packed
+     into a single message, field after field
+   in must not be changed until remap_3d_finish() returns
+------------------------------------------------------------------------- */
+
+void remap_3d_start(FFT_SCALAR **in, int nfield, struct remap_plan_3d *plan)
+{
+  int isend,irecv,ifield,size;
+  FFT_SCALAR *buf;
+
+  // post all recvs
+
+  for (irecv = 0; irecv < plan->nrecv; irecv++)
+    MPI_Irecv(&plan->recvbuf_all[nfield*plan->recv_bufloc[irecv]],
+              nfield*plan->recv_size[irecv],MPI_FFT_SCALAR,
+              plan->recv_proc[irecv],plan->tag,plan->comm,
+              &plan->request[irecv]);
+
+  // pack and post all sends
+
+  buf = plan->sendbuf_all;
+  for (isend = 0; isend < plan->nsend; isend++) {
+    size = plan->send_size[isend];
+    for (ifield = 0; ifield < nfield; ifield++)
+      plan->pack(&in[ifield][plan->send_offset[isend]],&buf[ifield*size],
+                 &plan->packplan[isend]);
+    MPI_Isend(buf,nfield*size,MPI_FFT_SCALAR,plan->send_proc[isend],
+              plan->tag,plan->comm,&plan->send_request[isend]);
+    buf += nfield*size;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Complete a nonblocking 3d remap started by remap_3d_start()
+
+   Arguments:
+   in           same input addresses as passed to remap_3d_start()
+   out          starting address of output data of each field on this proc,
+                  must not overlap with in
+   nfield       same # of fields as passed to remap_3d_start()
+   plan         plan passed to remap_3d_start()
+
+   self data is copied while messages from other procs are in flight
+------------------------------------------------------------------------- */
+
+void remap_3d_finish(FFT_SCALAR **in, FFT_SCALAR **out, int nfield,
+                     struct remap_plan_3d *plan)
+{
+  int i,isend,irecv,ifield,size;
+  FFT_SCALAR *buf;
+
+  // copy in -> recvbuf -> out for self data
+
+  if (plan->self) {
+    isend = plan->nsend;
+    irecv = plan->nrecv;
+    size = plan->recv_size[irecv];
+    buf = &plan->recvbuf_all[nfield*plan->recv_bufloc[irecv]];
+    for (ifield = 0; ifield < nfield; ifield++) {
+      plan->pack(&in[ifield][plan->send_offset[isend]],&buf[ifield*size],
+                 &plan->packplan[isend]);
+      plan->unpack(&buf[ifield*size],&out[ifield][plan->recv_offset[irecv]],
+                   &plan->unpackplan[irecv]);
+    }
+  }
+
+  // unpack all messages from recvbuf -> out as they arrive
+
+  for (i = 0; i < plan->nrecv; i++) {
+    MPI_Waitany(plan->nrecv,plan->request,&irecv,MPI_STATUS_IGNORE);
+    size = plan->recv_size[irecv];
+    buf = &plan->recvbuf_all[nfield*plan->recv_bufloc[irecv]];
+    for (ifield = 0; ifield < nfield; ifield++)
+      plan->unpack(&buf[ifield*size],&out[ifield][plan->recv_offset[irecv]],
+                   &plan->unpackplan[irecv]);
+  }
+
+  // sendbuf can only be reused once all sends are complete
+
+  if (plan->nsend)
+    MPI_Waitall(plan->nsend,plan->send_request,MPI_STATUSES_IGNORE);
+}
+
 /* ----------------------------------------------------------------------
    collide 2 sets of indices to determine overlap
    compare bounds of block1 with block2 to see if they overlap
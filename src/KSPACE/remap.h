@@ -48,6 +48,11 @@ struct remap_plan_3d {
   int usecollective;                // use collective or point-to-point MPI
   int commringlen;                  // length of commringlist
   int *commringlist;                // ranks on communication ring of this plan
+  int nfield;                       // max # of fields in nonblocking remap
+  int tag;                          // MPI tag of nonblocking messages
+  FFT_SCALAR *sendbuf_all;          // buffer for all nonblocking sends
+  FFT_SCALAR *recvbuf_all;          // buffer for all nonblocking recvs
+  MPI_Request *send_request;        // MPI request for each posted send
 };
 
 // collision between 2 regions
@@ -66,5 +71,9 @@ struct remap_plan_3d *remap_3d_create_plan(MPI_Comm,
                                            int, int, int, int, int, int,
                                            int, int, int, int, int);
 void remap_3d_destroy_plan(struct remap_plan_3d *);
+int remap_3d_setup_nonblocking(struct remap_plan_3d *, int, int);
+void remap_3d_start(FFT_SCALAR **, int, struct remap_plan_3d *);
+void remap_3d_finish(FFT_SCALAR **, FFT_SCALAR **, int,
+                     struct remap_plan_3d *);
 int remap_3d_collide(struct extent_3d *,
                      struct extent_3d *, struct extent_3d *);
@@ -34,6 +34,7 @@
 #include "random_park.h"
 #include "force.h"
 #include "pair.h"
+#include "pair_hybrid.h"
 #include "bond.h"
 #include "angle.h"
 #include "dihedral.h"
@@ -71,7 +72,8 @@ enum{ATOM,MOLECULE};
 FixGCMC::FixGCMC(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg),
   idregion(NULL), full_flag(0), ngroups(0), groupstrings(NULL), ngrouptypes(0), grouptypestrings(NULL),
-  grouptypebits(NULL), grouptypes(NULL), local_gas_list(NULL), atom_coord(NULL), random_equal(NULL), random_unequal(NULL), 
+  grouptypebits(NULL), grouptypes(NULL), local_gas_list(NULL), atom_coord(NULL),
+  binhead(NULL), binnext(NULL), random_equal(NULL), random_unequal(NULL), 
   coords(NULL), imageflags(NULL), fixrigid(NULL), fixshake(NULL), idrigid(NULL), idshake(NULL)
 {
   if (narg < 11) error->all(FLERR,"Illegal fix gcmc command");
@@ -219,6 +221,10 @@ FixGCMC::FixGCMC(LAMMPS *lmp, int narg, char **arg) :
 
   gcmc_nmax = 0;
   local_gas_list = NULL;
+
+  kspace_flag = false;
+  nbinx = nbiny = nbinz = 0;
+  maxbin = maxbinatom = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -383,6 +389,8 @@ FixGCMC::~FixGCMC()
   delete random_unequal;
 
   memory->destroy(local_gas_list);
+  memory->destroy(binhead);
+  memory->destroy(binnext);
   memory->destroy(atom_coord);
   memory->destroy(coords);
   memory->destroy(imageflags);
@@ -427,16 +435,33 @@ void FixGCMC::init()
   triclinic = domain->triclinic;
 
   // decide whether to switch to the full_energy option
+  // KSpace energy changes of moved, inserted or deleted charges
+  //   can be computed incrementally if the KSpace style supports it
+
+  // partial pair energies come from pair->single(), which needs
+  //   a pairwise style, for hybrid styles every sub-style must support it
+
+  kspace_flag = false;
+  if (!full_flag && force->kspace && force->kspace->mc_enable)
+    kspace_flag = true;
+
+  int single_flag = 0;
+  if (force->pair && force->pair->single_enable &&
+      force->pair->manybody_flag == 0) single_flag = 1;
+  if (single_flag && force->pair_match("hybrid",0)) {
+    PairHybrid *hybrid = (PairHybrid *) force->pair;
+    for (int m = 0; m < hybrid->nstyles; m++)
+      if (hybrid->styles[m]->single_enable == 0 ||
+          hybrid->special_lj[m] || hybrid->special_coul[m]) single_flag = 0;
+  }
 
   if (!full_flag) {
-    if ((force->kspace) ||
-        (force->pair == NULL) ||
-        (force->pair->single_enable == 0) ||
-        (force->pair_match("hybrid",0)) ||
-        (force->pair_match("eam",0)) ||
+    if ((force->kspace && !kspace_flag) ||
+        (single_flag == 0) ||
         (force->pair->tail_flag)
         ) {
       full_flag = true;
+      kspace_flag = false;
       if (comm->me == 0)
         error->warning(FLERR,"Fix gcmc using full_energy option");
     }
@@ -739,6 +764,9 @@ void FixGCMC::pre_exchange()
 
   } else {
 
+    bin_atoms();
+    if (kspace_flag) force->kspace->setup_mc();
+
     if (mode == MOLECULE) {
       for (int i = 0; i < ncycles; i++) {
         int random_int_fraction =
@@ -779,16 +807,17 @@ void FixGCMC::attempt_atomic_translation()
   int i = pick_random_gas_atom();
 
   int success = 0;
+  double **x = atom->x;
+  double energy_before = 0.0;
+  double coord[3];
   if (i >= 0) {
-    double **x = atom->x;
-    double energy_before = energy(i,ngcmc_type,-1,x[i]);
+    energy_before = energy(i,ngcmc_type,-1,x[i]);
     if (overlap_flag && energy_before > MAXENERGYTEST)
         error->warning(FLERR,"Energy of old configuration in "
                        "fix gcmc is > MAXENERGYTEST.");
     double rsq = 1.1;
     double rx,ry,rz;
     rx = ry = rz = 0.0;
-    double coord[3];
     while (rsq > 1.0) {
       rx = 2*random_unequal->uniform() - 1.0;
       ry = 2*random_unequal->uniform() - 1.0;
@@ -814,8 +843,21 @@ void FixGCMC::attempt_atomic_translation()
     }
     if (!domain->inside_nonperiodic(coord))
       error->one(FLERR,"Fix gcmc put atom outside box");
+  }
+
+  // long-range energy change is a collective operation
 
-    double energy_after = energy(i,ngcmc_type,-1,coord);
+  double kspace_energy = 0.0;
+  if (kspace_flag) {
+    int n = (i >= 0) ? 1 : 0;
+    double qi = (i >= 0) ? atom->q[i] : 0.0;
+    double *xold = (i >= 0) ? x[i] : NULL;
+    double *xnew = coord;
+    kspace_energy = force->kspace->compute_mc_delta(n,&qi,&xold,&xnew);
+  }
+
+  if (i >= 0) {
+    double energy_after = energy(i,ngcmc_type,-1,coord) + kspace_energy;
 
     if (energy_after < MAXENERGYTEST &&
         random_unequal->uniform() <
@@ -831,6 +873,7 @@ void FixGCMC::attempt_atomic_translation()
   MPI_Allreduce(&success,&success_all,1,MPI_INT,MPI_MAX,world);
 
   if (success_all) {
+    if (kspace_flag) force->kspace->accept_mc();
     if (triclinic) domain->x2lamda(atom->nlocal);
     domain->pbc();
     comm->exchange();
@@ -838,6 +881,7 @@ void FixGCMC::attempt_atomic_translation()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    bin_atoms();
     ntranslation_successes += 1.0;
   }
 }
@@ -854,8 +898,20 @@ void FixGCMC::attempt_atomic_deletion()
   int i = pick_random_gas_atom();
 
   int success = 0;
+  double deletion_energy = 0.0;
+  if (i >= 0) deletion_energy = energy(i,ngcmc_type,-1,atom->x[i]);
+
+  // long-range energy change is a collective operation
+  // deletion_energy is the negative of the energy change
+
+  if (kspace_flag) {
+    int n = (i >= 0) ? 1 : 0;
+    double qi = (i >= 0) ? atom->q[i] : 0.0;
+    double *xold = (i >= 0) ? atom->x[i] : NULL;
+    deletion_energy -= force->kspace->compute_mc_delta(n,&qi,&xold,NULL);
+  }
+
   if (i >= 0) {
-    double deletion_energy = energy(i,ngcmc_type,-1,atom->x[i]);
     if (random_unequal->uniform() <
         ngas*exp(beta*deletion_energy)/(zz*volume)) {
       atom->avec->copy(atom->nlocal-1,i,1);
@@ -868,6 +924,7 @@ void FixGCMC::attempt_atomic_deletion()
   MPI_Allreduce(&success,&success_all,1,MPI_INT,MPI_MAX,world);
 
   if (success_all) {
+    if (kspace_flag) force->kspace->accept_mc();
     atom->natoms--;
     if (atom->tag_enable) {
       if (atom->map_style) atom->map_init();
@@ -877,6 +934,7 @@ void FixGCMC::attempt_atomic_deletion()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    bin_atoms();
     ndeletion_successes += 1.0;
   }
 }
@@ -940,21 +998,37 @@ void FixGCMC::attempt_atomic_insertion()
         lamda[2] >= sublo[2] && lamda[2] < subhi[2]) proc_flag = 1;
   }
 
+  // store charge of trial atom in first unused slot,
+  //   so pair->single() sees it
+
   int success = 0;
+  double insertion_energy = 0.0;
   if (proc_flag) {
     int ii = -1;
-    if (charge_flag) {
+    if (atom->q_flag) {
       ii = atom->nlocal + atom->nghost;
       if (ii >= atom->nmax) atom->avec->grow(0);
-      atom->q[ii] = charge;
+      atom->q[ii] = charge_flag ? charge : 0.0;
     }
-    double insertion_energy = energy(ii,ngcmc_type,-1,coord);
+    insertion_energy = energy(ii,ngcmc_type,-1,coord);
+  }
+
+  // long-range energy change is a collective operation
+
+  if (kspace_flag) {
+    int n = proc_flag ? 1 : 0;
+    double qi = charge_flag ? charge : 0.0;
+    double *xnew = coord;
+    insertion_energy += force->kspace->compute_mc_delta(n,&qi,NULL,&xnew);
+  }
 
+  if (proc_flag) {
     if (insertion_energy < MAXENERGYTEST &&
         random_unequal->uniform() <
         zz*volume*exp(-beta*insertion_energy)/(ngas+1)) {
       atom->avec->create_atom(ngcmc_type,coord);
       int m = atom->nlocal - 1;
+      if (charge_flag) atom->q[m] = charge;
       
       // add to groups
       // optionally add to type-based groups
@@ -978,6 +1052,7 @@ void FixGCMC::attempt_atomic_insertion()
   MPI_Allreduce(&success,&success_all,1,MPI_INT,MPI_MAX,world);
 
   if (success_all) {
+    if (kspace_flag) force->kspace->accept_mc();
     atom->natoms++;
     if (atom->tag_enable) {
       atom->tag_extend();
@@ -988,6 +1063,7 @@ void FixGCMC::attempt_atomic_insertion()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    bin_atoms();
     ninsertion_successes += 1.0;
   }
 }
@@ -1057,6 +1133,9 @@ void FixGCMC::attempt_molecule_translation()
   }
 
   double energy_after = 0.0;
+  double qmc[natoms_per_molecule];
+  double *xoldmc[natoms_per_molecule],*xnewmc[natoms_per_molecule];
+  int n = 0;
   for (int i = 0; i < nlocal; i++) {
     if (atom->molecule[i] == translation_molecule) {
       coord[0] = x[i][0] + com_displace[0];
@@ -1065,12 +1144,27 @@ void FixGCMC::attempt_molecule_translation()
       if (!domain->inside_nonperiodic(coord))
         error->one(FLERR,"Fix gcmc put atom outside box");
       energy_after += energy(i,atom->type[i],translation_molecule,coord);
+      if (kspace_flag) {
+        atom_coord[n][0] = coord[0];
+        atom_coord[n][1] = coord[1];
+        atom_coord[n][2] = coord[2];
+        qmc[n] = atom->q[i];
+        xoldmc[n] = x[i];
+        xnewmc[n] = atom_coord[n];
+      }
+      n++;
     }
   }
 
   double energy_after_sum = 0.0;
   MPI_Allreduce(&energy_after,&energy_after_sum,1,MPI_DOUBLE,MPI_SUM,world);
 
+  // long-range energy change of all charges of the molecule
+
+  if (kspace_flag)
+    energy_after_sum +=
+      force->kspace->compute_mc_delta(n,qmc,xoldmc,xnewmc);
+
   if (energy_after_sum < MAXENERGYTEST &&
       random_equal->uniform() <
       exp(beta*(energy_before_sum - energy_after_sum))) {
@@ -1081,6 +1175,7 @@ void FixGCMC::attempt_molecule_translation()
         x[i][2] += com_displace[2];
       }
     }
+    if (kspace_flag) force->kspace->accept_mc();
     if (triclinic) domain->x2lamda(atom->nlocal);
     domain->pbc();
     comm->exchange();
@@ -1088,6 +1183,7 @@ void FixGCMC::attempt_molecule_translation()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    bin_atoms();
     ntranslation_successes += 1.0;
   }
 }
@@ -1143,6 +1239,8 @@ void FixGCMC::attempt_molecule_rotation()
   double **x = atom->x;
   imageint *image = atom->image;
   double energy_after = 0.0;
+  double qmc[natoms_per_molecule];
+  double *xoldmc[natoms_per_molecule],*xnewmc[natoms_per_molecule];
   int n = 0;
   for (int i = 0; i < nlocal; i++) {
     if (mask[i] & molecule_group_bit) {
@@ -1162,6 +1260,11 @@ void FixGCMC::attempt_molecule_rotation()
       if (!domain->inside(xtmp))
         error->one(FLERR,"Fix gcmc put atom outside box");
       energy_after += energy(i,atom->type[i],rotation_molecule,xtmp);
+      if (kspace_flag) {
+        qmc[n] = atom->q[i];
+        xoldmc[n] = x[i];
+        xnewmc[n] = atom_coord[n];
+      }
       n++;
     }
   }
@@ -1169,9 +1272,16 @@ void FixGCMC::attempt_molecule_rotation()
   double energy_after_sum = 0.0;
   MPI_Allreduce(&energy_after,&energy_after_sum,1,MPI_DOUBLE,MPI_SUM,world);
 
+  // long-range energy change of all charges of the molecule
+
+  if (kspace_flag)
+    energy_after_sum +=
+      force->kspace->compute_mc_delta(n,qmc,xoldmc,xnewmc);
+
   if (energy_after_sum < MAXENERGYTEST &&
       random_equal->uniform() <
       exp(beta*(energy_before_sum - energy_after_sum))) {
+    if (kspace_flag) force->kspace->accept_mc();
     int n = 0;
     for (int i = 0; i < nlocal; i++) {
       if (mask[i] & molecule_group_bit) {
@@ -1190,6 +1300,7 @@ void FixGCMC::attempt_molecule_rotation()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    bin_atoms();
     nrotation_successes += 1.0;
   }
 }
@@ -1208,8 +1319,26 @@ void FixGCMC::attempt_molecule_deletion()
 
   double deletion_energy_sum = molecule_energy(deletion_molecule);
 
+  // long-range energy change of all charges of the molecule,
+  //   without their energy with each other, like the pair energy
+
+  if (kspace_flag) {
+    double qmc[natoms_per_molecule];
+    double *xoldmc[natoms_per_molecule];
+    int n = 0;
+    for (int i = 0; i < atom->nlocal; i++)
+      if (atom->molecule[i] == deletion_molecule) {
+        qmc[n] = atom->q[i];
+        xoldmc[n++] = atom->x[i];
+      }
+    deletion_energy_sum -=
+      force->kspace->compute_mc_delta(n,qmc,xoldmc,NULL) +
+      force->kspace->compute_mc_intra();
+  }
+
   if (random_equal->uniform() <
       ngas*exp(beta*deletion_energy_sum)/(zz*volume*natoms_per_molecule)) {
+    if (kspace_flag) force->kspace->accept_mc();
     int i = 0;
     while (i < atom->nlocal) {
       if (atom->molecule[i] == deletion_molecule) {
@@ -1224,6 +1353,7 @@ void FixGCMC::attempt_molecule_deletion()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    bin_atoms();
     ndeletion_successes += 1.0;
   }
 }
@@ -1296,6 +1426,9 @@ void FixGCMC::attempt_molecule_insertion()
 
   double insertion_energy = 0.0;
   bool procflag[natoms_per_molecule];
+  double qmc[natoms_per_molecule];
+  double *xnewmc[natoms_per_molecule];
+  int n = 0;
 
   for (int i = 0; i < natoms_per_molecule; i++) {
     MathExtra::matvec(rotmat,onemols[imol]->x[i],atom_coord[i]);
@@ -1334,6 +1467,10 @@ void FixGCMC::attempt_molecule_insertion()
         atom->q[ii] = onemols[imol]->q[i];
       }
       insertion_energy += energy(ii,onemols[imol]->type[i],-1,xtmp);
+      if (kspace_flag) {
+        qmc[n] = onemols[imol]->qflag ? onemols[imol]->q[i] : 0.0;
+        xnewmc[n++] = atom_coord[i];
+      }
     }
   }
 
@@ -1341,10 +1478,20 @@ void FixGCMC::attempt_molecule_insertion()
   MPI_Allreduce(&insertion_energy,&insertion_energy_sum,1,
                 MPI_DOUBLE,MPI_SUM,world);
 
+  // long-range energy change of all charges of the molecule,
+  //   without their energy with each other, like the pair energy
+
+  if (kspace_flag)
+    insertion_energy_sum +=
+      force->kspace->compute_mc_delta(n,qmc,NULL,xnewmc) -
+      force->kspace->compute_mc_intra();
+
   if (insertion_energy_sum < MAXENERGYTEST &&
       random_equal->uniform() < zz*volume*natoms_per_molecule*
       exp(-beta*insertion_energy_sum)/(ngas + natoms_per_molecule)) {
-      
+
+    if (kspace_flag) force->kspace->accept_mc();
+
     tagint maxmol = 0;
     for (int i = 0; i < atom->nlocal; i++) maxmol = MAX(maxmol,atom->molecule[i]);
     tagint maxmol_all;
@@ -1415,6 +1562,7 @@ void FixGCMC::attempt_molecule_insertion()
     comm->borders();
     if (triclinic) domain->lamda2x(atom->nlocal+atom->nghost);
     update_gas_atoms_list();
+    bin_atoms();
     ninsertion_successes += 1.0;
   }
 }
@@ -2113,16 +2261,17 @@ void FixGCMC::attempt_molecule_insertion_full()
 
 /* ----------------------------------------------------------------------
    compute particle's interaction energy with the rest of the system
+   only loop over atoms in the bins surrounding coord
 ------------------------------------------------------------------------- */
 
 double FixGCMC::energy(int i, int itype, tagint imolecule, double *coord)
 {
   double delx,dely,delz,rsq;
+  int ibin[3];
 
   double **x = atom->x;
   int *type = atom->type;
   tagint *molecule = atom->molecule;
-  int nall = atom->nlocal + atom->nghost;
   pair = force->pair;
   cutsq = force->pair->cutsq;
 
@@ -2132,28 +2281,40 @@ double FixGCMC::energy(int i, int itype, tagint imolecule, double *coord)
 
   double total_energy = 0.0;
 
-  for (int j = 0; j < nall; j++) {
-
-    if (i == j) continue;
-    if (mode == MOLECULE)
-      if (imolecule == molecule[j]) continue;
-
-    delx = coord[0] - x[j][0];
-    dely = coord[1] - x[j][1];
-    delz = coord[2] - x[j][2];
-    rsq = delx*delx + dely*dely + delz*delz;
-    int jtype = type[j];
-
-    // if overlap check requested, if overlap,
-    // return signal value for energy 
-
-    if (overlap_flag && rsq < overlap_cutoffsq)
-      return MAXENERGYSIGNAL;
-    
-    if (rsq < cutsq[itype][jtype])
-      total_energy +=
-        pair->single(i,j,itype,jtype,rsq,factor_coul,factor_lj,fpair);
-  }
+  coord2bin(coord,ibin);
+  int ixlo = MAX(ibin[0]-1,0);
+  int ixhi = MIN(ibin[0]+1,nbinx-1);
+  int iylo = MAX(ibin[1]-1,0);
+  int iyhi = MIN(ibin[1]+1,nbiny-1);
+  int izlo = MAX(ibin[2]-1,0);
+  int izhi = MIN(ibin[2]+1,nbinz-1);
+
+  for (int iz = izlo; iz <= izhi; iz++)
+    for (int iy = iylo; iy <= iyhi; iy++)
+      for (int ix = ixlo; ix <= ixhi; ix++)
+        for (int j = binhead[(iz*nbiny + iy)*nbinx + ix]; j >= 0;
+             j = binnext[j]) {
+
+          if (i == j) continue;
+          if (mode == MOLECULE)
+            if (imolecule == molecule[j]) continue;
+
+          delx = coord[0] - x[j][0];
+          dely = coord[1] - x[j][1];
+          delz = coord[2] - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+          int jtype = type[j];
+
+          // if overlap check requested, if overlap,
+          // return signal value for energy
+
+          if (overlap_flag && rsq < overlap_cutoffsq)
+            return MAXENERGYSIGNAL;
+
+          if (rsq < cutsq[itype][jtype])
+            total_energy +=
+              pair->single(i,j,itype,jtype,rsq,factor_coul,factor_lj,fpair);
+        }
 
   return total_energy;
 }
@@ -2199,29 +2360,47 @@ double FixGCMC::energy_full()
   // if overlap check requested, if overlap,
   // return signal value for energy 
 
+  // only loop over atoms in the bins surrounding each owned atom
+
   if (overlap_flag) {
     int overlaptestall;
     int overlaptest = 0;
     double delx,dely,delz,rsq;
     double **x = atom->x;
     tagint *molecule = atom->molecule;
-    int nall = atom->nlocal + atom->nghost;
+    int ibin[3];
+
+    bin_atoms();
+
     for (int i = 0; i < atom->nlocal; i++) {
       if (mode == MOLECULE) imolecule = molecule[i];
-      for (int j = i+1; j < nall; j++) {
-        if (mode == MOLECULE)
-          if (imolecule == molecule[j]) continue;
-      
-        delx = x[i][0] - x[j][0];
-        dely = x[i][1] - x[j][1];
-        delz = x[i][2] - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-      
-        if (rsq < overlap_cutoffsq) {
-          overlaptest = 1;
-          break;
-        }
-      }
+      coord2bin(x[i],ibin);
+      int ixlo = MAX(ibin[0]-1,0);
+      int ixhi = MIN(ibin[0]+1,nbinx-1);
+      int iylo = MAX(ibin[1]-1,0);
+      int iyhi = MIN(ibin[1]+1,nbiny-1);
+      int izlo = MAX(ibin[2]-1,0);
+      int izhi = MIN(ibin[2]+1,nbinz-1);
+
+      for (int iz = izlo; iz <= izhi && !overlaptest; iz++)
+        for (int iy = iylo; iy <= iyhi && !overlaptest; iy++)
+          for (int ix = ixlo; ix <= ixhi && !overlaptest; ix++)
+            for (int j = binhead[(iz*nbiny + iy)*nbinx + ix]; j >= 0;
+                 j = binnext[j]) {
+              if (j <= i) continue;
+              if (mode == MOLECULE)
+                if (imolecule == molecule[j]) continue;
+
+              delx = x[i][0] - x[j][0];
+              dely = x[i][1] - x[j][1];
+              delz = x[i][2] - x[j][2];
+              rsq = delx*delx + dely*dely + delz*delz;
+
+              if (rsq < overlap_cutoffsq) {
+                overlaptest = 1;
+                break;
+              }
+            }
       if (overlaptest) break;
     }
     MPI_Allreduce(&overlaptest, &overlaptestall, 1,
@@ -2411,6 +2590,104 @@ void FixGCMC::update_gas_atoms_list()
   ngas_before -= ngas_local;
 }
 
+/* ----------------------------------------------------------------------
+   bin owned and ghost atoms into a regular grid spanning their extent
+   bins are at least as large as the pair and overlap cutoffs,
+     so all interactions of a point are within its own and adjacent bins
+   # of bins is limited to roughly the # of atoms,
+     since bins are rebuilt after every accepted move
+------------------------------------------------------------------------- */
+
+void FixGCMC::bin_atoms()
+{
+  double **x = atom->x;
+  int nall = atom->nlocal + atom->nghost;
+
+  double cutbin = 0.0;
+  if (overlap_flag) cutbin = sqrt(overlap_cutoffsq);
+  if (!full_flag) cutbin = MAX(cutbin,force->pair->cutforce);
+
+  // extent of owned+ghost atoms
+
+  double lo[3],hi[3];
+  lo[0] = lo[1] = lo[2] = 0.0;
+  hi[0] = hi[1] = hi[2] = 0.0;
+  if (nall) {
+    for (int k = 0; k < 3; k++) lo[k] = hi[k] = x[0][k];
+    for (int i = 1; i < nall; i++)
+      for (int k = 0; k < 3; k++) {
+        lo[k] = MIN(lo[k],x[i][k]);
+        hi[k] = MAX(hi[k],x[i][k]);
+      }
+  }
+
+  int nbin[3];
+  double prd[3];
+  bigint nbins = 1;
+  for (int k = 0; k < 3; k++) {
+    prd[k] = hi[k] - lo[k];
+    if (cutbin > 0.0 && prd[k] > cutbin)
+      nbin[k] = static_cast<int> (prd[k]/cutbin);
+    else nbin[k] = 1;
+    nbins *= nbin[k];
+  }
+
+  // coarsen bins until their count is comparable to the # of atoms
+
+  while (nbins > MAX(nall,1) && nbins > 1) {
+    nbins = 1;
+    for (int k = 0; k < 3; k++) {
+      nbin[k] = MAX(nbin[k]/2,1);
+      nbins *= nbin[k];
+    }
+  }
+
+  nbinx = nbin[0];
+  nbiny = nbin[1];
+  nbinz = nbin[2];
+  for (int k = 0; k < 3; k++) {
+    binlo[k] = lo[k];
+    bininv[k] = (prd[k] > 0.0) ? nbin[k]/prd[k] : 0.0;
+  }
+
+  if (nbins > maxbin) {
+    maxbin = nbins;
+    memory->destroy(binhead);
+    memory->create(binhead,maxbin,"gcmc:binhead");
+  }
+  if (atom->nmax > maxbinatom) {
+    maxbinatom = atom->nmax;
+    memory->destroy(binnext);
+    memory->create(binnext,maxbinatom,"gcmc:binnext");
+  }
+
+  for (int m = 0; m < nbins; m++) binhead[m] = -1;
+
+  // add atoms in reverse order, so each bin lists them in ascending order
+
+  int ibin[3];
+  for (int i = nall-1; i >= 0; i--) {
+    coord2bin(x[i],ibin);
+    int m = (ibin[2]*nbiny + ibin[1])*nbinx + ibin[0];
+    binnext[i] = binhead[m];
+    binhead[m] = i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   bin indices of a point, points outside the grid map to the nearest bin
+------------------------------------------------------------------------- */
+
+void FixGCMC::coord2bin(double *x, int *ibin)
+{
+  ibin[0] = static_cast<int> ((x[0]-binlo[0])*bininv[0]);
+  ibin[1] = static_cast<int> ((x[1]-binlo[1])*bininv[1]);
+  ibin[2] = static_cast<int> ((x[2]-binlo[2])*bininv[2]);
+  ibin[0] = MAX(MIN(ibin[0],nbinx-1),0);
+  ibin[1] = MAX(MIN(ibin[1],nbiny-1),0);
+  ibin[2] = MAX(MIN(ibin[2],nbinz-1),0);
+}
+
 /* ----------------------------------------------------------------------
   return acceptance ratios
 ------------------------------------------------------------------------- */
@@ -2435,6 +2712,7 @@ double FixGCMC::compute_vector(int n)
 double FixGCMC::memory_usage()
 {
   double bytes = gcmc_nmax * sizeof(int);
+  bytes += (maxbin + maxbinatom) * sizeof(int);
   return bytes;
 }
 
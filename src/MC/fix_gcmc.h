@@ -53,6 +53,7 @@ class FixGCMC : public Fix {
   tagint pick_random_gas_molecule();
   void toggle_intramolecular(int);
   void update_gas_atoms_list();
+  void bin_atoms();
   double compute_vector(int);
   double memory_usage();
   void write_restart(FILE *);
@@ -74,6 +75,7 @@ class FixGCMC : public Fix {
   bool pressure_flag;       // true if user specified reservoir pressure
   bool charge_flag;         // true if user specified atomic charge
   bool full_flag;           // true if doing full system energy calculations
+  bool kspace_flag;         // true if KSpace energy changes are incremental
 
   int natoms_per_molecule;  // number of atoms in each gas molecule
 
@@ -114,6 +116,15 @@ class FixGCMC : public Fix {
   imageint imagezero;
   double overlap_cutoffsq; // square distance cutoff for overlap 
   int overlap_flag;
+
+  // bins of owned+ghost atoms for local energies and overlap checks
+
+  int nbinx,nbiny,nbinz;    // # of bins in each dim
+  int maxbin,maxbinatom;    // allocated size of binhead and binnext
+  int *binhead;             // index of first atom in each bin
+  int *binnext;             // index of next atom in same bin
+  double binlo[3];          // lower corner of bin grid
+  double bininv[3];         // inverse bin size in each dim
   
   double energy_intra;
 
@@ -136,6 +147,7 @@ class FixGCMC : public Fix {
   class Compute *c_pe;
 
   void options(int, char **);
+  void coord2bin(double *, int *);
 };
 
 }
@@ -37,7 +37,12 @@ using namespace LAMMPS_NS;
 /* ---------------------------------------------------------------------- */
 
 DumpAtomMPIIO::DumpAtomMPIIO(LAMMPS *lmp, int narg, char **arg) :
-  DumpAtom(lmp, narg, arg) {}
+  DumpAtom(lmp, narg, arg)
+{
+  // MPI-IO files are written by write() of this class, never asynchronously
+
+  async_allow = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
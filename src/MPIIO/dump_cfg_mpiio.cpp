@@ -57,7 +57,12 @@ enum{INT,DOUBLE,STRING,BIGINT};   // same as in DumpCustom
 /* ---------------------------------------------------------------------- */
 
 DumpCFGMPIIO::DumpCFGMPIIO(LAMMPS *lmp, int narg, char **arg) :
-  DumpCFG(lmp, narg, arg) {}
+  DumpCFG(lmp, narg, arg)
+{
+  // MPI-IO files are written by write() of this class, never asynchronously
+
+  async_allow = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -59,7 +59,12 @@ enum{INT,DOUBLE,STRING,BIGINT};    // same as in DumpCustom
 /* ---------------------------------------------------------------------- */
 
 DumpCustomMPIIO::DumpCustomMPIIO(LAMMPS *lmp, int narg, char **arg) :
-  DumpCustom(lmp, narg, arg) {}
+  DumpCustom(lmp, narg, arg)
+{
+  // MPI-IO files are written by write() of this class, never asynchronously
+
+  async_allow = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -28,7 +28,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-PairLJCutOpt::PairLJCutOpt(LAMMPS *lmp) : PairLJCut(lmp) {}
+PairLJCutOpt::PairLJCutOpt(LAMMPS *lmp) : PairLJCut(lmp)
+{
+  mixed_enable = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -41,10 +41,6 @@ using namespace LAMMPS_NS;
 using namespace FixConst;
 using namespace MathConst;
 
-// allocate space for static class variable
-
-FixRigidSmall *FixRigidSmall::frsptr;
-
 #define MAXLINE 1024
 #define CHUNK 1024
 #define ATTRIBUTE_PERBODY 20
@@ -72,7 +68,7 @@ FixRigidSmall::FixRigidSmall(LAMMPS *lmp, int narg, char **arg) :
   xcmimage(NULL), displace(NULL), eflags(NULL), orient(NULL), dorient(NULL), 
   avec_ellipsoid(NULL), avec_line(NULL), avec_tri(NULL), counts(NULL), 
   itensor(NULL), mass_body(NULL), langextra(NULL), random(NULL), id_dilate(NULL), 
-  onemols(NULL), hash(NULL), bbox(NULL), ctr(NULL), idclose(NULL), rsqclose(NULL)
+  onemols(NULL), hash(NULL)
 {
   int i;
 
@@ -1413,8 +1409,7 @@ void FixRigidSmall::set_v()
 
 void FixRigidSmall::create_bodies()
 {
-  int i,m,n;
-  double unwrap[3];
+  int i,m;
 
   // error check on image flags of atoms in rigid bodies
 
@@ -1440,275 +1435,227 @@ void FixRigidSmall::create_bodies()
   if (flagall) error->all(FLERR,"Fix rigid/small atom has non-zero image flag "
                           "in a non-periodic dimension");
 
-  // allocate buffer for passing messages around ring of procs
-  // percount = max number of values to put in buffer for each of ncount
+  // allocate buffer for input to rendezvous comm
+  // ncount = # of my atoms in bodies
 
   int ncount = 0;
   for (i = 0; i < nlocal; i++)
     if (mask[i] & groupbit) ncount++;
 
-  int percount = 5;
-  double *buf;
-  memory->create(buf,ncount*percount,"rigid/small:buf");
-
-  // create map hash for storing unique molecule IDs of my atoms
-  // key = molecule ID
-  // value = index into per-body data structure
-  // n = # of entries in hash
+  int *proclist;
+  memory->create(proclist,ncount,"rigid/small:proclist");
+  InRvous *inbuf = (InRvous *)
+    memory->smalloc((bigint) ncount*sizeof(InRvous),"rigid/small:inbuf");
 
-  hash = new std::map<tagint,int>();
-  hash->clear();
-
-  // setup hash
-  // key = body ID
-  // value = index into N-length data structure
-  // n = count of unique bodies my atoms are part of
+  // setup buf to pass to rendezvous comm
+  // one InRvous datum for each constituent atom
+  // datum = me, local index, atomID, bodyID, unwrapped coords
+  // owning proc for each datum = random hash of bodyID
 
+  double **x = atom->x;
+  tagint *tag = atom->tag;
   tagint *molecule = atom->molecule;
 
-  n = 0;
+  m = 0;
   for (i = 0; i < nlocal; i++) {
     if (!(mask[i] & groupbit)) continue;
-    if (hash->find(molecule[i]) == hash->end()) (*hash)[molecule[i]] = n++;
+    proclist[m] = molecule[i] % nprocs;
+    inbuf[m].me = me;
+    inbuf[m].ilocal = i;
+    inbuf[m].atomID = tag[i];
+    inbuf[m].bodyID = molecule[i];
+    domain->unmap(x[i],image[i],inbuf[m].x);
+    m++;
   }
 
-  // bbox = bounding box of each rigid body my atoms are part of
+  // perform rendezvous operation
+  // each proc owns random subset of bodies
+  // receives all atoms in those bodies
+  // func = compute bbox of each body, find atom closest to geometric center
 
-  memory->create(bbox,n,6,"rigid/small:bbox");
+  char *buf;
+  int nreturn = comm->rendezvous(ncount,proclist,(char *) inbuf,
+                                 sizeof(InRvous),rendezvous_body,
+                                 buf,sizeof(OutRvous),(void *) this);
+  OutRvous *outbuf = (OutRvous *) buf;
 
-  for (i = 0; i < n; i++) {
-    bbox[i][0] = bbox[i][2] = bbox[i][4] = BIG;
-    bbox[i][1] = bbox[i][3] = bbox[i][5] = -BIG;
-  }
-
-  // pack my atoms into buffer as molecule ID, unwrapped coords
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
 
-  double **x = atom->x;
+  // set bodytag of all owned atoms based on outbuf info for constituent atoms
 
-  m = 0;
-  for (i = 0; i < nlocal; i++) {
-    if (!(mask[i] & groupbit)) continue;
-    domain->unmap(x[i],image[i],unwrap);
-    buf[m++] = molecule[i];
-    buf[m++] = unwrap[0];
-    buf[m++] = unwrap[1];
-    buf[m++] = unwrap[2];
-  }
-
-  // pass buffer around ring of procs
-  // func = update bbox with atom coords from every proc
-  // when done, have full bbox for every rigid body my atoms are part of
-
-  frsptr = this;
-  comm->ring(m,sizeof(double),buf,1,ring_bbox,NULL);
-
-  // check if any bbox is size 0.0, meaning rigid body is a single particle
+  for (i = 0; i < nlocal; i++)
+    if (!(mask[i] & groupbit)) bodytag[i] = 0;
 
-  flag = 0;
-  for (i = 0; i < n; i++)
-    if (bbox[i][0] == bbox[i][1] && bbox[i][2] == bbox[i][3] &&
-        bbox[i][4] == bbox[i][5]) flag = 1;
-  MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_SUM,world);
-  if (flagall)
-    error->all(FLERR,"One or more rigid bodies are a single particle");
+  for (m = 0; m < nreturn; m++)
+    bodytag[outbuf[m].ilocal] = outbuf[m].atomID;
 
-  // ctr = center pt of each rigid body my atoms are part of
+  memory->sfree(outbuf);
 
-  memory->create(ctr,n,6,"rigid/small:bbox");
+  // maxextent = max of rsqfar across all procs
+  // if defined, include molecule->maxextent
 
-  for (i = 0; i < n; i++) {
-    ctr[i][0] = 0.5 * (bbox[i][0] + bbox[i][1]);
-    ctr[i][1] = 0.5 * (bbox[i][2] + bbox[i][3]);
-    ctr[i][2] = 0.5 * (bbox[i][4] + bbox[i][5]);
+  MPI_Allreduce(&rsqfar,&maxextent,1,MPI_DOUBLE,MPI_MAX,world);
+  maxextent = sqrt(maxextent);
+  if (onemols) {
+    for (int i = 0; i < nmol; i++)
+      maxextent = MAX(maxextent,onemols[i]->maxextent);
   }
+}
 
-  // idclose = ID of atom in body closest to center pt (smaller ID if tied)
-  // rsqclose = distance squared from idclose to center pt
+/* ----------------------------------------------------------------------
+   process rigid bodies assigned to me
+   inbuf = list of N InRvous datums, one per constituent atom
+   return OutRvous datum with body ID = idclose to each atom's owner
+   rsqfar = max extent of my bodies, stored in caller class
+------------------------------------------------------------------------- */
 
-  memory->create(idclose,n,"rigid/small:idclose");
-  memory->create(rsqclose,n,"rigid/small:rsqclose");
+int FixRigidSmall::rendezvous_body(int n, char *inbuf,
+                                   int &rflag, int *&proclist, char *&outbuf,
+                                   void *ptr)
+{
+  int i,m;
+  double delx,dely,delz,rsq;
+  int *iclose;
+  tagint *idclose;
+  double *x,*xown,*rsqclose;
+  double **bbox,**ctr;
 
-  for (i = 0; i < n; i++) rsqclose[i] = BIG;
+  FixRigidSmall *frsptr = (FixRigidSmall *) ptr;
+  Memory *memory = frsptr->memory;
+  Error *error = frsptr->error;
+  MPI_Comm world = frsptr->world;
 
-  // pack my atoms into buffer as molecule ID, atom ID, unwrapped coords
+  // setup hash
+  // use STL map instead of atom->map
+  //   b/c know nothing about body ID values specified by user
+  // ncount = number of bodies assigned to me
+  // key = body ID
+  // value = index into Ncount-length data structure
 
-  tagint *tag = atom->tag;
+  InRvous *in = (InRvous *) inbuf;
+  std::map<tagint,int> hash;
+  tagint id;
 
-  m = 0;
-  for (i = 0; i < nlocal; i++) {
-    if (!(mask[i] & groupbit)) continue;
-    domain->unmap(x[i],image[i],unwrap);
-    buf[m++] = molecule[i];
-    buf[m++] = ubuf(tag[i]).d;
-    buf[m++] = unwrap[0];
-    buf[m++] = unwrap[1];
-    buf[m++] = unwrap[2];
+  int ncount = 0;
+  for (i = 0; i < n; i++) {
+    id = in[i].bodyID;
+    if (hash.find(id) == hash.end()) hash[id] = ncount++;
   }
 
-  // pass buffer around ring of procs
-  // func = update idclose,rsqclose with atom IDs from every proc
-  // when done, have idclose for every rigid body my atoms are part of
-
-  frsptr = this;
-  comm->ring(m,sizeof(double),buf,2,ring_nearest,NULL);
+  // bbox = bounding box of each rigid body
 
-  // set bodytag of all owned atoms, based on idclose
-  // find max value of rsqclose across all procs
+  memory->create(bbox,ncount,6,"rigid/small:bbox");
 
-  double rsqmax = 0.0;
-  for (i = 0; i < nlocal; i++) {
-    bodytag[i] = 0;
-    if (!(mask[i] & groupbit)) continue;
-    m = hash->find(molecule[i])->second;
-    bodytag[i] = idclose[m];
-    rsqmax = MAX(rsqmax,rsqclose[m]);
+  for (m = 0; m < ncount; m++) {
+    bbox[m][0] = bbox[m][2] = bbox[m][4] = BIG;
+    bbox[m][1] = bbox[m][3] = bbox[m][5] = -BIG;
   }
 
-  // pack my atoms into buffer as bodytag of owning atom, unwrapped coords
-
-  m = 0;
-  for (i = 0; i < nlocal; i++) {
-    if (!(mask[i] & groupbit)) continue;
-    domain->unmap(x[i],image[i],unwrap);
-    buf[m++] = ubuf(bodytag[i]).d;
-    buf[m++] = unwrap[0];
-    buf[m++] = unwrap[1];
-    buf[m++] = unwrap[2];
+  for (i = 0; i < n; i++) {
+    m = hash.find(in[i].bodyID)->second;
+    x = in[i].x;
+    bbox[m][0] = MIN(bbox[m][0],x[0]);
+    bbox[m][1] = MAX(bbox[m][1],x[0]);
+    bbox[m][2] = MIN(bbox[m][2],x[1]);
+    bbox[m][3] = MAX(bbox[m][3],x[1]);
+    bbox[m][4] = MIN(bbox[m][4],x[2]);
+    bbox[m][5] = MAX(bbox[m][5],x[2]);
   }
 
-  // pass buffer around ring of procs
-  // func = update rsqfar for atoms belonging to bodies I own
-  // when done, have rsqfar for all atoms in bodies I own
+  // check if any bbox is size 0.0, meaning rigid body is a single particle
+  // all procs invoke the callback, so collective error check is safe
 
-  rsqfar = 0.0;
-  frsptr = this;
-  comm->ring(m,sizeof(double),buf,3,ring_farthest,NULL);
+  int flag = 0;
+  for (m = 0; m < ncount; m++)
+    if (bbox[m][0] == bbox[m][1] && bbox[m][2] == bbox[m][3] &&
+        bbox[m][4] == bbox[m][5]) flag = 1;
+  int flagall;
+  MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_SUM,world);
+  if (flagall)
+    error->all(FLERR,"One or more rigid bodies are a single particle");
 
-  // find maxextent of rsqfar across all procs
-  // if defined, include molecule->maxextent
+  // ctr = geometric center pt of each rigid body
 
-  MPI_Allreduce(&rsqfar,&maxextent,1,MPI_DOUBLE,MPI_MAX,world);
-  maxextent = sqrt(maxextent);
-  if (onemols) {
-    for (int i = 0; i < nmol; i++)
-      maxextent = MAX(maxextent,onemols[i]->maxextent);
-  }
+  memory->create(ctr,ncount,3,"rigid/small:ctr");
 
-  // clean up
+  for (m = 0; m < ncount; m++) {
+    ctr[m][0] = 0.5 * (bbox[m][0] + bbox[m][1]);
+    ctr[m][1] = 0.5 * (bbox[m][2] + bbox[m][3]);
+    ctr[m][2] = 0.5 * (bbox[m][4] + bbox[m][5]);
+  }
 
-  delete hash;
-  memory->destroy(buf);
-  memory->destroy(bbox);
-  memory->destroy(ctr);
-  memory->destroy(idclose);
-  memory->destroy(rsqclose);
-}
+  // idclose = atomID closest to center point of body (smaller ID if tied)
+  // rsqclose = distance squared from idclose to center pt
+  // iclose = index in inbuf of idclose
 
-/* ----------------------------------------------------------------------
-   process rigid body atoms from another proc
-   update bounding box for rigid bodies my atoms are part of
-------------------------------------------------------------------------- */
+  memory->create(idclose,ncount,"rigid/small:idclose");
+  memory->create(iclose,ncount,"rigid/small:iclose");
+  memory->create(rsqclose,ncount,"rigid/small:rsqclose");
+  for (m = 0; m < ncount; m++) rsqclose[m] = BIG;
 
-void FixRigidSmall::ring_bbox(int n, char *cbuf)
-{
-  std::map<tagint,int> *hash = frsptr->hash;
-  double **bbox = frsptr->bbox;
+  for (i = 0; i < n; i++) {
+    m = hash.find(in[i].bodyID)->second;
+    x = in[i].x;
+    delx = x[0] - ctr[m][0];
+    dely = x[1] - ctr[m][1];
+    delz = x[2] - ctr[m][2];
+    rsq = delx*delx + dely*dely + delz*delz;
+    if (rsq <= rsqclose[m]) {
+      if (rsq == rsqclose[m] && in[i].atomID > idclose[m]) continue;
+      iclose[m] = i;
+      idclose[m] = in[i].atomID;
+      rsqclose[m] = rsq;
+    }
+  }
 
-  double *buf = (double *) cbuf;
-  int ndatums = n/4;
+  // compute rsqfar for all bodies I own
+  // rsqfar = max distance from idclose atom to any other atom in body
 
-  int j,imol;
-  double *x;
+  double rsqfar = 0.0;
 
-  int m = 0;
-  for (int i = 0; i < ndatums; i++, m += 4) {
-    imol = static_cast<int> (buf[m]);
-    if (hash->find(imol) != hash->end()) {
-      j = hash->find(imol)->second;
-      x = &buf[m+1];
-      bbox[j][0] = MIN(bbox[j][0],x[0]);
-      bbox[j][1] = MAX(bbox[j][1],x[0]);
-      bbox[j][2] = MIN(bbox[j][2],x[1]);
-      bbox[j][3] = MAX(bbox[j][3],x[1]);
-      bbox[j][4] = MIN(bbox[j][4],x[2]);
-      bbox[j][5] = MAX(bbox[j][5],x[2]);
-    }
+  for (i = 0; i < n; i++) {
+    m = hash.find(in[i].bodyID)->second;
+    xown = in[iclose[m]].x;
+    x = in[i].x;
+    delx = x[0] - xown[0];
+    dely = x[1] - xown[1];
+    delz = x[2] - xown[2];
+    rsq = delx*delx + dely*dely + delz*delz;
+    rsqfar = MAX(rsqfar,rsq);
   }
-}
-
-/* ----------------------------------------------------------------------
-   process rigid body atoms from another proc
-   update nearest atom to body center for rigid bodies my atoms are part of
-------------------------------------------------------------------------- */
 
-void FixRigidSmall::ring_nearest(int n, char *cbuf)
-{
-  std::map<tagint,int> *hash = frsptr->hash;
-  double **ctr = frsptr->ctr;
-  tagint *idclose = frsptr->idclose;
-  double *rsqclose = frsptr->rsqclose;
+  frsptr->rsqfar = rsqfar;
 
-  double *buf = (double *) cbuf;
-  int ndatums = n/5;
+  // return ID of closest atom as body ID to owner of each atom
 
-  int j,imol;
-  tagint tag;
-  double delx,dely,delz,rsq;
-  double *x;
+  int nout = n;
+  memory->create(proclist,nout,"rigid/small:proclist");
+  OutRvous *out = (OutRvous *)
+    memory->smalloc((bigint) nout*sizeof(OutRvous),"rigid/small:out");
 
-  int m = 0;
-  for (int i = 0; i < ndatums; i++, m += 5) {
-    imol = static_cast<int> (buf[m]);
-    if (hash->find(imol) != hash->end()) {
-      j = hash->find(imol)->second;
-      tag = (tagint) ubuf(buf[m+1]).i;
-      x = &buf[m+2];
-      delx = x[0] - ctr[j][0];
-      dely = x[1] - ctr[j][1];
-      delz = x[2] - ctr[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
-      if (rsq <= rsqclose[j]) {
-        if (rsq == rsqclose[j] && tag > idclose[j]) continue;
-        idclose[j] = tag;
-        rsqclose[j] = rsq;
-      }
-    }
+  for (i = 0; i < nout; i++) {
+    proclist[i] = in[i].me;
+    out[i].ilocal = in[i].ilocal;
+    m = hash.find(in[i].bodyID)->second;
+    out[i].atomID = idclose[m];
   }
-}
 
-/* ----------------------------------------------------------------------
-   process rigid body atoms from another proc
-   update rsqfar = distance from owning atom to other atom
-------------------------------------------------------------------------- */
+  outbuf = (char *) out;
 
-void FixRigidSmall::ring_farthest(int n, char *cbuf)
-{
-  double **x = frsptr->atom->x;
-  imageint *image = frsptr->atom->image;
-  int nlocal = frsptr->atom->nlocal;
+  // clean up
+  // comm->rendezvous() will free proclist and outbuf
 
-  double *buf = (double *) cbuf;
-  int ndatums = n/4;
+  memory->destroy(bbox);
+  memory->destroy(ctr);
+  memory->destroy(idclose);
+  memory->destroy(iclose);
+  memory->destroy(rsqclose);
 
-  int iowner;
-  tagint tag;
-  double delx,dely,delz,rsq;
-  double *xx;
-  double unwrap[3];
+  // flag = 2: new outbuf
 
-  int m = 0;
-  for (int i = 0; i < ndatums; i++, m += 4) {
-    tag = (tagint) ubuf(buf[m]).i;
-    iowner = frsptr->atom->map(tag);
-    if (iowner < 0 || iowner >= nlocal) continue;
-    frsptr->domain->unmap(x[iowner],image[iowner],unwrap);
-    xx = &buf[m+1];
-    delx = xx[0] - unwrap[0];
-    dely = xx[1] - unwrap[1];
-    delz = xx[2] - unwrap[2];
-    rsq = delx*delx + dely*dely + delz*delz;
-    frsptr->rsqfar = MAX(frsptr->rsqfar,rsq);
-  }
+  rflag = 2;
+  return nout;
 }
 
 /* ----------------------------------------------------------------------
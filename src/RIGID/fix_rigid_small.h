@@ -31,10 +31,6 @@ class FixRigidSmall : public Fix {
   friend class ComputeRigidLocal;
 
  public:
-  // static variable for ring communication callback to access class data
-
-  static FixRigidSmall *frsptr;
-
   FixRigidSmall(class LAMMPS *, int, char **);
   virtual ~FixRigidSmall();
   virtual int setmask();
@@ -178,15 +174,22 @@ class FixRigidSmall : public Fix {
   class Molecule **onemols;
   int nmol;
 
-  // class data used by ring communication callbacks
+  // class data used by rendezvous communication in create_bodies()
 
   std::map<tagint,int> *hash;
-  double **bbox;
-  double **ctr;
-  tagint *idclose;
-  double *rsqclose;
   double rsqfar;
 
+  struct InRvous {
+    int me,ilocal;
+    tagint atomID,bodyID;
+    double x[3];
+  };
+
+  struct OutRvous {
+    int ilocal;
+    tagint atomID;
+  };
+
   void image_shift();
   void set_xv();
   void set_v();
@@ -197,11 +200,9 @@ class FixRigidSmall : public Fix {
   void grow_body();
   void reset_atom2body();
 
-  // callback functions for ring communication
+  // callback function for rendezvous communication
 
-  static void ring_bbox(int, char *);
-  static void ring_nearest(int, char *);
-  static void ring_farthest(int, char *);
+  static int rendezvous_body(int, char *, int &, int *&, char *&, void *);
 
   // debug
 
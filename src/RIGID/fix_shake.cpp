@@ -39,10 +39,6 @@ using namespace LAMMPS_NS;
 using namespace FixConst;
 using namespace MathConst;
 
-// allocate space for static class variable
-
-FixShake *FixShake::fsptr;
-
 #define BIG 1.0e20
 #define MASSDELTA 0.1
 
@@ -684,10 +680,9 @@ int FixShake::dof(int igroup)
 void FixShake::find_clusters()
 {
   int i,j,m,n,imol,iatom;
-  int flag,flag_all,nbuf,size;
+  int flag,flag_all;
   tagint tagprev;
   double massone;
-  tagint *buf;
   
   if (me == 0 && screen) {
     if (!rattle) fprintf(screen,"Finding SHAKE clusters ...\n");
@@ -710,12 +705,10 @@ void FixShake::find_clusters()
   int nlocal = atom->nlocal;
   int angles_allow = atom->avec->angles_allow;
 
-  // setup ring of procs
+  // setup owning proc of each atom ID in rendezvous decomposition
+  // used to route partner info from each atom to its bond partners
 
-  int next = me + 1;
-  int prev = me -1;
-  if (next == nprocs) next = 0;
-  if (prev < 0) prev = nprocs - 1;
+  atom_owners();
 
   // -----------------------------------------------------
   // allocate arrays for self (1d) and bond partners (2d)
@@ -787,13 +780,13 @@ void FixShake::find_clusters()
   // -----------------------------------------------------
 
   // fill in mask, type, massflag, bondtype if own bond partner
-  // info to store in buf for each off-proc bond = nper = 6
-  //   2 atoms IDs in bond, space for mask, type, massflag, bondtype
-  // nbufmax = largest buffer needed to hold info from any proc
+  // for off-proc partners, set bondtype if I store the bond
+  //   and send my own info to the partner instead
+  // since bond partners are symmetric, each atom receives
+  //   mask, type, massflag, bondtype from each of its off-proc partners
+  // nsend = # of datums to send, one for each off-proc bond partner
 
-  int nper = 6;
-
-  nbuf = 0;
+  int nsend = 0;
   for (i = 0; i < nlocal; i++) {
     for (j = 0; j < npartner[i]; j++) {
       partner_mask[i][j] = 0;
@@ -816,52 +809,58 @@ void FixShake::find_clusters()
           n = bondtype_findset(m,tag[i],partner_tag[i][j],0);
           if (n) partner_bondtype[i][j] = n;
         }
-      } else nbuf += nper;
+      } else {
+        partner_bondtype[i][j] = bondtype_findset(i,tag[i],partner_tag[i][j],0);
+        nsend++;
+      }
     }
   }
 
-  memory->create(buf,nbuf,"shake:buf");
-
-  // fill buffer with info
+  PartnerInfo *pinfo = (PartnerInfo *)
+    memory->smalloc((bigint) nsend*sizeof(PartnerInfo),"shake:pinfo");
 
-  size = 0;
+  nsend = 0;
   for (i = 0; i < nlocal; i++) {
     for (j = 0; j < npartner[i]; j++) {
       m = atom->map(partner_tag[i][j]);
-      if (m < 0 || m >= nlocal) {
-        buf[size] = tag[i];
-        buf[size+1] = partner_tag[i][j];
-        buf[size+2] = 0;
-        buf[size+3] = 0;
-        buf[size+4] = 0;
-        n = bondtype_findset(i,tag[i],partner_tag[i][j],0);
-        if (n) buf[size+5] = n;
-        else buf[size+5] = 0;
-        size += nper;
+      if (m >= 0 && m < nlocal) continue;
+      pinfo[nsend].atomID = partner_tag[i][j];
+      pinfo[nsend].partnerID = tag[i];
+      pinfo[nsend].mask = mask[i];
+      pinfo[nsend].type = type[i];
+      pinfo[nsend].massflag = 0;
+      if (nmass) {
+        if (rmass) massone = rmass[i];
+        else massone = mass[type[i]];
+        pinfo[nsend].massflag = masscheck(massone);
       }
+      pinfo[nsend].bondtype = partner_bondtype[i][j];
+      nsend++;
     }
   }
 
-  // cycle buffer around ring of procs back to self
+  char *buf;
+  int nreturn = send_to_owners(nsend,(char *) pinfo,sizeof(PartnerInfo),
+                               rendezvous_partners_info,buf);
+  PartnerInfo *poutbuf = (PartnerInfo *) buf;
+  memory->sfree(pinfo);
 
-  fsptr = this;
-  comm->ring(size,sizeof(tagint),buf,1,ring_bonds,buf);
+  // store partner info sent to me
+  // bondtype may already be set if I store the bond
 
-  // store partner info returned to me
-
-  m = 0;
-  while (m < size) {
-    i = atom->map(buf[m]);
+  for (m = 0; m < nreturn; m++) {
+    i = atom->map(poutbuf[m].atomID);
     for (j = 0; j < npartner[i]; j++)
-      if (buf[m+1] == partner_tag[i][j]) break;
-    partner_mask[i][j] = buf[m+2];
-    partner_type[i][j] = buf[m+3];
-    partner_massflag[i][j] = buf[m+4];
-    partner_bondtype[i][j] = buf[m+5];
-    m += nper;
+      if (poutbuf[m].partnerID == partner_tag[i][j]) break;
+    if (j == npartner[i]) continue;
+    partner_mask[i][j] = poutbuf[m].mask;
+    partner_type[i][j] = poutbuf[m].type;
+    partner_massflag[i][j] = poutbuf[m].massflag;
+    if (partner_bondtype[i][j] == 0)
+      partner_bondtype[i][j] = poutbuf[m].bondtype;
   }
 
-  memory->destroy(buf);
+  memory->sfree(poutbuf);
 
   // error check for unfilled partner info
   // if partner_type not set, is an error
@@ -939,52 +938,48 @@ void FixShake::find_clusters()
   // -----------------------------------------------------
 
   // fill in partner_nshake if own bond partner
-  // info to store in buf for each off-proc bond =
-  //   2 atoms IDs in bond, space for nshake value
-  // nbufmax = largest buffer needed to hold info from any proc
+  // else send my nshake value to each off-proc bond partner
 
-  nbuf = 0;
+  nsend = 0;
   for (i = 0; i < nlocal; i++) {
     for (j = 0; j < npartner[i]; j++) {
       m = atom->map(partner_tag[i][j]);
       if (m >= 0 && m < nlocal) partner_nshake[i][j] = nshake[m];
-      else nbuf += 3;
+      else nsend++;
     }
   }
 
-  memory->create(buf,nbuf,"shake:buf");
+  NShakeInfo *ninfo = (NShakeInfo *)
+    memory->smalloc((bigint) nsend*sizeof(NShakeInfo),"shake:ninfo");
 
-  // fill buffer with info
-
-  size = 0;
+  nsend = 0;
   for (i = 0; i < nlocal; i++) {
     for (j = 0; j < npartner[i]; j++) {
       m = atom->map(partner_tag[i][j]);
-      if (m < 0 || m >= nlocal) {
-        buf[size] = tag[i];
-        buf[size+1] = partner_tag[i][j];
-        size += 3;
-      }
+      if (m >= 0 && m < nlocal) continue;
+      ninfo[nsend].atomID = partner_tag[i][j];
+      ninfo[nsend].partnerID = tag[i];
+      ninfo[nsend].nshake = nshake[i];
+      nsend++;
     }
   }
 
-  // cycle buffer around ring of procs back to self
+  nreturn = send_to_owners(nsend,(char *) ninfo,sizeof(NShakeInfo),
+                           rendezvous_nshake,buf);
+  NShakeInfo *noutbuf = (NShakeInfo *) buf;
+  memory->sfree(ninfo);
 
-  fsptr = this;
-  comm->ring(size,sizeof(tagint),buf,2,ring_nshake,buf);
+  // store partner nshake values sent to me
 
-  // store partner info returned to me
-  
-  m = 0;
-  while (m < size) {
-    i = atom->map(buf[m]);
+  for (m = 0; m < nreturn; m++) {
+    i = atom->map(noutbuf[m].atomID);
     for (j = 0; j < npartner[i]; j++)
-      if (buf[m+1] == partner_tag[i][j]) break;
-    partner_nshake[i][j] = buf[m+2];
-    m += 3;
+      if (noutbuf[m].partnerID == partner_tag[i][j]) break;
+    if (j == npartner[i]) continue;
+    partner_nshake[i][j] = noutbuf[m].nshake;
   }
 
-  memory->destroy(buf);
+  memory->sfree(noutbuf);
 
   // -----------------------------------------------------
   // error checks
@@ -1073,11 +1068,9 @@ void FixShake::find_clusters()
   // -----------------------------------------------------
 
   // fill in shake arrays for each bond partner I own
-  // info to store in buf for each off-proc bond =
-  //   all values from shake_flag, shake_atom, shake_type
-  // nbufmax = largest buffer needed to hold info from any proc
+  // else send shake info to each off-proc bond partner
 
-  nbuf = 0;
+  nsend = 0;
   for (i = 0; i < nlocal; i++) {
     if (shake_flag[i] == 0) continue;
     for (j = 0; j < npartner[i]; j++) {
@@ -1092,41 +1085,54 @@ void FixShake::find_clusters()
         shake_type[m][0] = shake_type[i][0];
         shake_type[m][1] = shake_type[i][1];
         shake_type[m][2] = shake_type[i][2];
-      } else nbuf += 9;
+      } else nsend++;
     }
   }
 
-  memory->create(buf,nbuf,"shake:buf");
+  ShakeInfo *sinfo = (ShakeInfo *)
+    memory->smalloc((bigint) nsend*sizeof(ShakeInfo),"shake:sinfo");
 
-  // fill buffer with info
-
-  size = 0;
+  nsend = 0;
   for (i = 0; i < nlocal; i++) {
     if (shake_flag[i] == 0) continue;
     for (j = 0; j < npartner[i]; j++) {
       if (partner_shake[i][j] == 0) continue;
       m = atom->map(partner_tag[i][j]);
-      if (m < 0 || m >= nlocal) {
-        buf[size] = partner_tag[i][j];
-        buf[size+1] = shake_flag[i];
-        buf[size+2] = shake_atom[i][0];
-        buf[size+3] = shake_atom[i][1];
-        buf[size+4] = shake_atom[i][2];
-        buf[size+5] = shake_atom[i][3];
-        buf[size+6] = shake_type[i][0];
-        buf[size+7] = shake_type[i][1];
-        buf[size+8] = shake_type[i][2];
-        size += 9;
-      }
+      if (m >= 0 && m < nlocal) continue;
+      sinfo[nsend].atomID = partner_tag[i][j];
+      sinfo[nsend].shake_flag = shake_flag[i];
+      sinfo[nsend].shake_atom[0] = shake_atom[i][0];
+      sinfo[nsend].shake_atom[1] = shake_atom[i][1];
+      sinfo[nsend].shake_atom[2] = shake_atom[i][2];
+      sinfo[nsend].shake_atom[3] = shake_atom[i][3];
+      sinfo[nsend].shake_type[0] = shake_type[i][0];
+      sinfo[nsend].shake_type[1] = shake_type[i][1];
+      sinfo[nsend].shake_type[2] = shake_type[i][2];
+      nsend++;
     }
   }
 
-  // cycle buffer around ring of procs back to self
+  nreturn = send_to_owners(nsend,(char *) sinfo,sizeof(ShakeInfo),
+                           rendezvous_shake,buf);
+  ShakeInfo *soutbuf = (ShakeInfo *) buf;
+  memory->sfree(sinfo);
 
-  fsptr = this;
-  comm->ring(size,sizeof(tagint),buf,3,ring_shake,NULL);
+  // store shake info sent to me
 
-  memory->destroy(buf);
+  for (m = 0; m < nreturn; m++) {
+    i = atom->map(soutbuf[m].atomID);
+    shake_flag[i] = soutbuf[m].shake_flag;
+    shake_atom[i][0] = soutbuf[m].shake_atom[0];
+    shake_atom[i][1] = soutbuf[m].shake_atom[1];
+    shake_atom[i][2] = soutbuf[m].shake_atom[2];
+    shake_atom[i][3] = soutbuf[m].shake_atom[3];
+    shake_type[i][0] = soutbuf[m].shake_type[0];
+    shake_type[i][1] = soutbuf[m].shake_type[1];
+    shake_type[i][2] = soutbuf[m].shake_type[2];
+  }
+
+  memory->sfree(soutbuf);
+  delete procowner;
 
   // -----------------------------------------------------
   // free local memory
@@ -1205,95 +1211,149 @@ void FixShake::find_clusters()
 }
 
 /* ----------------------------------------------------------------------
-   when receive buffer, scan bond partner IDs for atoms I own
-   if I own partner:
-     fill in mask and type and massflag
-     search for bond with 1st atom and fill in bondtype
+   setup owning proc of each atom ID in rendezvous decomposition
+   each atom ID is sent to proc it hashes to
+   procowner = map of atom IDs to owning procs, stored by rendezvous procs
 ------------------------------------------------------------------------- */
 
-void FixShake::ring_bonds(int ndatum, char *cbuf)
+void FixShake::atom_owners()
 {
-  Atom *atom = fsptr->atom;
-  double *rmass = atom->rmass;
-  double *mass = atom->mass;
-  int *mask = atom->mask;
-  int *type = atom->type;
+  tagint *tag = atom->tag;
   int nlocal = atom->nlocal;
-  int nmass = fsptr->nmass;
 
-  tagint *buf = (tagint *) cbuf;
-  int m,n;
-  double massone;
+  int *proclist;
+  memory->create(proclist,nlocal,"shake:proclist");
+  IDRvous *idbuf = (IDRvous *)
+    memory->smalloc((bigint) nlocal*sizeof(IDRvous),"shake:idbuf");
 
-  for (int i = 0; i < ndatum; i += 6) {
-    m = atom->map(buf[i+1]);
-    if (m >= 0 && m < nlocal) {
-      buf[i+2] = mask[m];
-      buf[i+3] = type[m];
-      if (nmass) {
-        if (rmass) massone = rmass[m];
-        else massone = mass[type[m]];
-        buf[i+4] = fsptr->masscheck(massone);
-      }
-      if (buf[i+5] == 0) {
-        n = fsptr->bondtype_findset(m,buf[i],buf[i+1],0);
-        if (n) buf[i+5] = n;
-      }
-    }
+  for (int i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    idbuf[i].me = me;
+    idbuf[i].atomID = tag[i];
   }
+
+  procowner = new std::map<tagint,int>();
+
+  char *buf;
+  comm->rendezvous(nlocal,proclist,(char *) idbuf,sizeof(IDRvous),
+                   rendezvous_ids,buf,0,(void *) this);
+
+  memory->destroy(proclist);
+  memory->sfree(idbuf);
 }
 
 /* ----------------------------------------------------------------------
-   when receive buffer, scan bond partner IDs for atoms I own
-   if I own partner, fill in nshake value
+   send N datums of byte size to the procs that own the atom ID
+     each datum starts with
+   each datum is routed via the rendezvous proc the atom ID hashes to
+   callback = rendezvous function that looks up the owning proc
+   outbuf = datums received by me, caller must free with memory->sfree()
+   return # of datums received
 ------------------------------------------------------------------------- */
 
-void FixShake::ring_nshake(int ndatum, char *cbuf)
+int FixShake::send_to_owners(int n, char *inbuf, int size,
+                             int (*callback)(int, char *, int &, int *&,
+                                             char *&, void *),
+                             char *&outbuf)
 {
-  Atom *atom = fsptr->atom;
-  int nlocal = atom->nlocal;
+  int *proclist;
+  memory->create(proclist,n,"shake:proclist");
+  for (int i = 0; i < n; i++)
+    proclist[i] = *((tagint *) &inbuf[(bigint) i*size]) % nprocs;
 
-  int *nshake = fsptr->nshake;
-
-  tagint *buf = (tagint *) cbuf;
-  int m;
+  int nreturn = comm->rendezvous(n,proclist,inbuf,size,callback,
+                                 outbuf,size,(void *) this);
 
-  for (int i = 0; i < ndatum; i += 3) {
-    m = atom->map(buf[i+1]);
-    if (m >= 0 && m < nlocal) buf[i+2] = nshake[m];
-  }
+  memory->destroy(proclist);
+  return nreturn;
 }
 
 /* ----------------------------------------------------------------------
-   when receive buffer, scan bond partner IDs for atoms I own
-   if I own partner, fill in nshake value
+   callback from comm->rendezvous() in atom_owners()
+   inbuf = list of (owning proc, atom ID), store them in procowner
+   no data is sent back
 ------------------------------------------------------------------------- */
 
-void FixShake::ring_shake(int ndatum, char *cbuf)
+int FixShake::rendezvous_ids(int n, char *inbuf,
+                             int &flag, int *&proclist, char *&outbuf,
+                             void *ptr)
 {
-  Atom *atom = fsptr->atom;
-  int nlocal = atom->nlocal;
+  FixShake *fsptr = (FixShake *) ptr;
+  std::map<tagint,int> *procowner = fsptr->procowner;
 
-  int *shake_flag = fsptr->shake_flag;
-  tagint **shake_atom = fsptr->shake_atom;
-  int **shake_type = fsptr->shake_type;
+  IDRvous *in = (IDRvous *) inbuf;
+  for (int i = 0; i < n; i++) (*procowner)[in[i].atomID] = in[i].me;
 
-  tagint *buf = (tagint *) cbuf;
-  int m;
+  flag = 0;
+  return 0;
+}
 
-  for (int i = 0; i < ndatum; i += 9) {
-    m = atom->map(buf[i]);
-    if (m >= 0 && m < nlocal) {
-      shake_flag[m] = buf[i+1];
-      shake_atom[m][0] = buf[i+2];
-      shake_atom[m][1] = buf[i+3];
-      shake_atom[m][2] = buf[i+4];
-      shake_atom[m][3] = buf[i+5];
-      shake_type[m][0] = buf[i+6];
-      shake_type[m][1] = buf[i+7];
-      shake_type[m][2] = buf[i+8];
-    }
+/* ----------------------------------------------------------------------
+   look up owning proc of the atom ID that starts each datum in inbuf
+   size = byte size of each datum
+   set proclist to owning procs, compress inbuf in place
+   datums with an unknown atom ID are dropped
+   return # of datums to send on
+------------------------------------------------------------------------- */
+
+int FixShake::owner_procs(int n, char *inbuf, int size, int *&proclist)
+{
+  std::map<tagint,int>::iterator it;
+  tagint atomID;
+
+  memory->create(proclist,n,"shake:proclist");
+
+  int nout = 0;
+  for (int i = 0; i < n; i++) {
+    atomID = *((tagint *) &inbuf[(bigint) i*size]);
+    it = procowner->find(atomID);
+    if (it == procowner->end()) continue;
+    proclist[nout] = it->second;
+    if (nout < i) memcpy(&inbuf[(bigint) nout*size],
+                         &inbuf[(bigint) i*size],size);
+    nout++;
   }
+
+  return nout;
+}
+
+/* ----------------------------------------------------------------------
+   callbacks from comm->rendezvous() in find_clusters()
+   send partner info, nshake values, shake info to owning procs
+   outbuf = same as inbuf
+------------------------------------------------------------------------- */
+
+int FixShake::rendezvous_partners_info(int n, char *inbuf,
+                                       int &flag, int *&proclist,
+                                       char *&outbuf, void *ptr)
+{
+  FixShake *fsptr = (FixShake *) ptr;
+  int nout = fsptr->owner_procs(n,inbuf,sizeof(PartnerInfo),proclist);
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
+}
+
+int FixShake::rendezvous_nshake(int n, char *inbuf,
+                                int &flag, int *&proclist,
+                                char *&outbuf, void *ptr)
+{
+  FixShake *fsptr = (FixShake *) ptr;
+  int nout = fsptr->owner_procs(n,inbuf,sizeof(NShakeInfo),proclist);
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
+}
+
+int FixShake::rendezvous_shake(int n, char *inbuf,
+                               int &flag, int *&proclist,
+                               char *&outbuf, void *ptr)
+{
+  FixShake *fsptr = (FixShake *) ptr;
+  int nout = fsptr->owner_procs(n,inbuf,sizeof(ShakeInfo),proclist);
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
 }
 
 /* ----------------------------------------------------------------------
@@ -21,6 +21,7 @@ FixStyle(shake,FixShake)
 #define LMP_FIX_SHAKE_H
 
 #include "fix.h"
+#include <map>
 
 namespace LAMMPS_NS {
 
@@ -131,13 +132,47 @@ class FixShake : public Fix {
   int bondtype_findset(int, tagint, tagint, int);
   int angletype_findset(int, tagint, tagint, int);
 
-  // static variable for ring communication callback to access class data
-  // callback functions for ring communication
+  // data used by rendezvous comm in find_clusters()
 
-  static FixShake *fsptr;
-  static void ring_bonds(int, char *);
-  static void ring_nshake(int, char *);
-  static void ring_shake(int, char *);
+  std::map<tagint,int> *procowner;   // owning proc of each atom ID
+
+  struct IDRvous {
+    int me;
+    tagint atomID;
+  };
+
+  // each datum sent to an atom's owner starts with its atom ID
+
+  struct PartnerInfo {
+    tagint atomID,partnerID;
+    int mask,type,massflag,bondtype;
+  };
+
+  struct NShakeInfo {
+    tagint atomID,partnerID;
+    int nshake;
+  };
+
+  struct ShakeInfo {
+    tagint atomID;
+    tagint shake_atom[4];
+    int shake_flag;
+    int shake_type[3];
+  };
+
+  void atom_owners();
+  int send_to_owners(int, char *, int,
+                     int (*)(int, char *, int &, int *&, char *&, void *),
+                     char *&);
+  int owner_procs(int, char *, int, int *&);
+
+  // callback functions for rendezvous communication
+
+  static int rendezvous_ids(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_partners_info(int, char *, int &, int *&, char *&,
+                                      void *);
+  static int rendezvous_nshake(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_shake(int, char *, int &, int *&, char *&, void *);
 };
 
 }
@@ -35,6 +35,8 @@ using namespace LAMMPS_NS;
 #define MAXLINE 1024
 #define MAXWORD 3
 
+enum{NESTED,FLAT,ADJOINT};
+
 /* ---------------------------------------------------------------------- */
 
 PairSNAP::PairSNAP(LAMMPS *lmp) : Pair(lmp)
@@ -85,6 +87,8 @@ PairSNAP::PairSNAP(LAMMPS *lmp) : Pair(lmp)
   i_zarray_i =NULL;
 
   use_shared_arrays = 0;
+  kernel_style = NESTED;
+  beta = NULL;
 
 #ifdef TIMING_INFO
   timers[0] = 0;
@@ -111,6 +115,7 @@ PairSNAP::~PairSNAP()
     memory->destroy(wjelem);
     memory->destroy(coeffelem);
   }
+  memory->destroy(beta);
 
   // Need to set this because restart not handled by PairHybrid
 
@@ -152,7 +157,9 @@ PairSNAP::~PairSNAP()
 
 void PairSNAP::compute(int eflag, int vflag)
 {
-  if (use_optimized)
+  if (kernel_style != NESTED)
+    compute_flat(eflag, vflag);
+  else if (use_optimized)
     compute_optimized(eflag, vflag);
   else
     compute_regular(eflag, vflag);
@@ -302,6 +309,144 @@ void PairSNAP::compute_regular(int eflag, int vflag)
 }
 
 
+/* ----------------------------------------------------------------------
+   This version uses the flattened SNA kernel
+   kernel flat: per-neighbor dBi/dRj contracted with the coefficients
+   kernel adjoint: Yi = sum_k beta_k dBi_k/dUi formed once per atom,
+     then dEi/dRj = dUi/dRj . Yi, so dBi/dRj is never formed
+   ---------------------------------------------------------------------- */
+
+void PairSNAP::compute_flat(int eflag, int vflag)
+{
+  int i,j,jnum,ninside;
+  double delx,dely,delz,evdwl,rsq;
+  double fij[3];
+  int *jlist,*numneigh,**firstneigh;
+  evdwl = 0.0;
+
+  if (eflag || vflag) ev_setup(eflag,vflag);
+  else evflag = vflag_fdotr = 0;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int newton_pair = force->newton_pair;
+  class SNA* snaptr = sna[0];
+
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  for (int ii = 0; ii < list->inum; ii++) {
+    i = list->ilist[ii];
+
+    const double xtmp = x[i][0];
+    const double ytmp = x[i][1];
+    const double ztmp = x[i][2];
+    const int itype = type[i];
+    const int ielem = map[itype];
+    const double radi = radelem[ielem];
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    snaptr->grow_rij(jnum);
+
+    ninside = 0;
+    for (int jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+      delx = x[j][0] - xtmp;
+      dely = x[j][1] - ytmp;
+      delz = x[j][2] - ztmp;
+      rsq = delx*delx + dely*dely + delz*delz;
+      int jtype = type[j];
+      int jelem = map[jtype];
+
+      if (rsq < cutsq[itype][jtype]&&rsq>1e-20) {
+	snaptr->rij[ninside][0] = delx;
+	snaptr->rij[ninside][1] = dely;
+	snaptr->rij[ninside][2] = delz;
+	snaptr->inside[ninside] = j;
+	snaptr->wj[ninside] = wjelem[jelem];
+	snaptr->rcutij[ninside] = (radi + radelem[jelem])*rcutfac;
+	ninside++;
+      }
+    }
+
+    // compute Ui for atom I, Zi and Bi only where needed
+    // Bi is needed for the energy and for gamma != 1
+
+    double* coeffi = coeffelem[ielem];
+    const int bflag = (eflag || !gammaoneflag);
+
+    snaptr->compute_ui_flat(ninside);
+    if (kernel_style == FLAT || bflag) snaptr->compute_zi_flat();
+    if (bflag) snaptr->compute_bi_flat();
+
+    // beta_k = dEi/dBi_k
+
+    for (int k = 1; k <= ncoeff; k++) {
+      if (gammaoneflag) beta[k-1] = coeffi[k];
+      else beta[k-1] = coeffi[k]*gamma*pow(snaptr->blist[k-1],gamma-1.0);
+    }
+
+    if (kernel_style == ADJOINT) snaptr->compute_yi_flat(beta);
+
+    // for neighbors of I within cutoff:
+    // Fij = dEi/dRj = -dEi/dRi => add to Fi, subtract from Fj
+
+    for (int jj = 0; jj < ninside; jj++) {
+      int j = snaptr->inside[jj];
+      snaptr->compute_duidrj_flat(snaptr->rij[jj],
+                                  snaptr->wj[jj],snaptr->rcutij[jj]);
+
+      if (kernel_style == ADJOINT) snaptr->compute_deidrj_flat(fij);
+      else {
+        snaptr->compute_dbidrj_flat();
+        fij[0] = 0.0;
+        fij[1] = 0.0;
+        fij[2] = 0.0;
+        for (int k = 0; k < ncoeff; k++) {
+          fij[0] += beta[k]*snaptr->dblist[k][0];
+          fij[1] += beta[k]*snaptr->dblist[k][1];
+          fij[2] += beta[k]*snaptr->dblist[k][2];
+        }
+      }
+
+      f[i][0] += fij[0];
+      f[i][1] += fij[1];
+      f[i][2] += fij[2];
+      f[j][0] -= fij[0];
+      f[j][1] -= fij[1];
+      f[j][2] -= fij[2];
+
+      if (evflag)
+	ev_tally_xyz(i,j,nlocal,newton_pair,0.0,0.0,
+		     fij[0],fij[1],fij[2],
+		     snaptr->rij[jj][0],snaptr->rij[jj][1],
+		     snaptr->rij[jj][2]);
+    }
+
+    if (eflag) {
+
+      // evdwl = energy of atom I, sum over coeffs_k * Bi_k
+
+      evdwl = coeffi[0];
+      if (gammaoneflag)
+	for (int k = 1; k <= ncoeff; k++)
+	  evdwl += coeffi[k]*snaptr->blist[k-1];
+      else
+      	for (int k = 1; k <= ncoeff; k++)
+      	  evdwl += coeffi[k]*pow(snaptr->blist[k-1],gamma);
+      ev_tally_full(i,2.0*evdwl,0.0,0.0,delx,dely,delz);
+    }
+
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
 /* ----------------------------------------------------------------------
    This version is optimized for threading, micro-load balancing
    ---------------------------------------------------------------------- */
@@ -1228,6 +1373,7 @@ void PairSNAP::settings(int narg, char **arg)
   use_shared_arrays=-1;
   do_load_balance = 0;
   use_optimized = 1;
+  kernel_style = NESTED;
 
   // optional arguments
 
@@ -1247,6 +1393,14 @@ void PairSNAP::settings(int narg, char **arg)
       use_optimized=force->inumeric(FLERR,arg[++i]);
       continue;
     }
+    if (strcmp(arg[i],"kernel")==0) {
+      i++;
+      if (strcmp(arg[i],"nested")==0) kernel_style = NESTED;
+      else if (strcmp(arg[i],"flat")==0) kernel_style = FLAT;
+      else if (strcmp(arg[i],"adjoint")==0) kernel_style = ADJOINT;
+      else error->all(FLERR,"Illegal pair_style command");
+      continue;
+    }
     if (strcmp(arg[i],"shared")==0) {
       use_shared_arrays=force->inumeric(FLERR,arg[++i]);
       continue;
@@ -1311,6 +1465,15 @@ void PairSNAP::settings(int narg, char **arg)
 	do_load_balance ||
 	schedule_user)
       error->all(FLERR,"Illegal pair_style command");
+
+  // the flattened kernels run one SNA instance per MPI task
+
+  if (kernel_style != NESTED)
+    if (nthreads > 1 ||
+	use_shared_arrays ||
+	do_load_balance ||
+	schedule_user)
+      error->all(FLERR,"Illegal pair_style command");
 }
 
 /* ----------------------------------------------------------------------
@@ -1414,6 +1577,8 @@ void PairSNAP::coeff(int narg, char **arg)
 		       rmin0,switchflag,bzeroflag);
     if (!use_shared_arrays)
       sna[tid]->grow_rij(nmax);
+    if (kernel_style != NESTED)
+      sna[tid]->init_flat();
   }
 
   if (ncoeff != sna[0]->ncoeff) {
@@ -1421,6 +1586,9 @@ void PairSNAP::coeff(int narg, char **arg)
     error->all(FLERR,"Incorrect SNAP parameter file");
   }
 
+  memory->destroy(beta);
+  memory->create(beta,ncoeff,"pair:beta");
+
   // Calculate maximum cutoff for all elements
 
   rcutmax = 0.0;
@@ -1728,6 +1896,7 @@ double PairSNAP::memory_usage()
   bytes += nmax*sizeof(int);
   bytes += (2*ncoeff+1)*sizeof(double);
   bytes += (ncoeff*3)*sizeof(double);
+  bytes += ncoeff*sizeof(double);
   bytes += sna[0]->memory_usage()*nthreads;
   return bytes;
 }
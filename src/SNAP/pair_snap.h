@@ -31,6 +31,7 @@ public:
   void compute(int, int);
   void compute_regular(int, int);
   void compute_optimized(int, int);
+  void compute_flat(int, int);
   void settings(int, char **);
   void coeff(int, char **);
   void init_style();
@@ -72,6 +73,8 @@ protected:
 
   int use_optimized;
   int use_shared_arrays;
+  int kernel_style;             // NESTED, FLAT or ADJOINT SNA kernel
+  double *beta;                 // dEi/dBi for the flattened kernels
 
   int i_max;
   int i_neighmax;
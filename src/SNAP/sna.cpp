@@ -143,6 +143,22 @@ SNA::SNA(LAMMPS* lmp, double rfac0_in,
   nmax = 0;
   idxj = NULL;
 
+  flat_flag = 0;
+  idxu_block = NULL;
+  idxcg_block = NULL;
+  idxz_block = NULL;
+  idxz = NULL;
+  idxb_block = NULL;
+  idxb = NULL;
+  cglist = NULL;
+  ulisttot_r = ulisttot_i = NULL;
+  ulist_r = ulist_i = NULL;
+  zlist_r = zlist_i = NULL;
+  ylist_r = ylist_i = NULL;
+  dulist_r = dulist_i = NULL;
+  blist = NULL;
+  dblist = NULL;
+
   if (bzero_flag) {
     double www = wself*wself*wself;
     for(int j = 0; j <= twojmax; j++)
@@ -175,6 +191,7 @@ SNA::~SNA()
     memory->destroy(dbvec);
   }
   delete[] idxj;
+  destroy_flat_arrays();
 }
 
 void SNA::build_indexlist()
@@ -283,6 +300,24 @@ void SNA::init()
 {
   init_clebsch_gordan();
   init_rootpqarray();
+
+  // copy Clebsch-Gordan coefficients into flat blocks,
+  // zero entries with m outside 0..j are never touched by cgarray
+
+  if (flat_flag) {
+    for (int j1 = 0; j1 <= twojmax; j1++)
+      for (int j2 = 0; j2 <= twojmax; j2++)
+        for (int j = abs(j1 - j2); j <= MIN(twojmax, j1 + j2); j += 2) {
+          int idxcg = idxcg_block[j1][j2][j];
+          for (int m1 = 0; m1 <= j1; m1++)
+            for (int m2 = 0; m2 <= j2; m2++) {
+              int m = (2*m1 - j1 + 2*m2 - j2 + j) / 2;
+              if (m < 0 || m > j) cglist[idxcg] = 0.0;
+              else cglist[idxcg] = cgarray[j1][j2][j][m1][m2];
+              idxcg++;
+            }
+        }
+  }
 }
 
 
@@ -1477,6 +1512,749 @@ void SNA::compute_duarray(double x, double y, double z,
       }
 }
 
+/* ----------------------------------------------------------------------
+   enable the flattened kernel
+   must be called before init() so that cglist gets filled
+------------------------------------------------------------------------- */
+
+void SNA::init_flat()
+{
+  if (diagonalstyle != 3)
+    error->all(FLERR,"Flattened SNAP kernel requires diagonalstyle 3");
+  if (flat_flag) return;
+  flat_flag = 1;
+  build_flat_indexlist();
+}
+
+/* ----------------------------------------------------------------------
+   build index lists and allocate flat arrays for the flattened kernel
+   U(j,ma,mb) is stored at idxu_block[j] + (j+1)*mb + ma
+   CG(j1,j2,j,m1,m2) is stored at idxcg_block[j1][j2][j] + (j2+1)*m1 + m2
+   Z(j1,j2,j,ma,mb) is stored for j1 >= j2 and 2*mb <= j only,
+     idxz[] holds the loop bounds of the CG double sum for each element
+   B(j1,j2,j) is stored in the same order as bvec for diagonalstyle 3
+------------------------------------------------------------------------- */
+
+void SNA::build_flat_indexlist()
+{
+  int jdim = twojmax + 1;
+
+  memory->create(idxu_block, jdim, "sna:idxu_block");
+  idxu_max = 0;
+  for (int j = 0; j <= twojmax; j++) {
+    idxu_block[j] = idxu_max;
+    idxu_max += (j+1)*(j+1);
+  }
+
+  memory->create(idxcg_block, jdim, jdim, jdim, "sna:idxcg_block");
+  idxcg_max = 0;
+  for (int j1 = 0; j1 <= twojmax; j1++)
+    for (int j2 = 0; j2 <= twojmax; j2++)
+      for (int j = abs(j1 - j2); j <= MIN(twojmax, j1 + j2); j += 2) {
+        idxcg_block[j1][j2][j] = idxcg_max;
+        idxcg_max += (j1+1)*(j2+1);
+      }
+
+  idxb_max = 0;
+  for (int j1 = 0; j1 <= twojmax; j1++)
+    for (int j2 = 0; j2 <= j1; j2++)
+      for (int j = abs(j1 - j2); j <= MIN(twojmax, j1 + j2); j += 2)
+        if (j >= j1) idxb_max++;
+
+  idxb = new SNA_BINDICES[idxb_max];
+  memory->create(idxb_block, jdim, jdim, jdim, "sna:idxb_block");
+
+  int idxb_count = 0;
+  for (int j1 = 0; j1 <= twojmax; j1++)
+    for (int j2 = 0; j2 <= j1; j2++)
+      for (int j = abs(j1 - j2); j <= MIN(twojmax, j1 + j2); j += 2)
+        if (j >= j1) {
+          idxb[idxb_count].j1 = j1;
+          idxb[idxb_count].j2 = j2;
+          idxb[idxb_count].j = j;
+          idxb_block[j1][j2][j] = idxb_count;
+          idxb_count++;
+        }
+
+  idxz_max = 0;
+  for (int j1 = 0; j1 <= twojmax; j1++)
+    for (int j2 = 0; j2 <= j1; j2++)
+      for (int j = j1 - j2; j <= MIN(twojmax, j1 + j2); j += 2)
+        for (int mb = 0; 2*mb <= j; mb++)
+          idxz_max += j+1;
+
+  idxz = new SNA_ZINDICES[idxz_max];
+  memory->create(idxz_block, jdim, jdim, jdim, "sna:idxz_block");
+
+  int idxz_count = 0;
+  for (int j1 = 0; j1 <= twojmax; j1++)
+    for (int j2 = 0; j2 <= j1; j2++)
+      for (int j = j1 - j2; j <= MIN(twojmax, j1 + j2); j += 2) {
+        idxz_block[j1][j2][j] = idxz_count;
+
+        // ma1 + ma2 = ma + (j1+j2-j)/2, same for mb,
+        // with 0 <= ma1 <= j1 and 0 <= ma2 <= j2
+
+        for (int mb = 0; 2*mb <= j; mb++)
+          for (int ma = 0; ma <= j; ma++) {
+            SNA_ZINDICES &z = idxz[idxz_count];
+            z.j1 = j1;
+            z.j2 = j2;
+            z.j = j;
+            z.ma1min = MAX(0, (2*ma - j - j2 + j1) / 2);
+            z.ma2max = (2*ma - j - (2*z.ma1min - j1) + j2) / 2;
+            z.na = MIN(j1, (2*ma - j + j2 + j1) / 2) - z.ma1min + 1;
+            z.mb1min = MAX(0, (2*mb - j - j2 + j1) / 2);
+            z.mb2max = (2*mb - j - (2*z.mb1min - j1) + j2) / 2;
+            z.nb = MIN(j1, (2*mb - j + j2 + j1) / 2) - z.mb1min + 1;
+            z.jju = idxu_block[j] + (j+1)*mb + ma;
+            idxz_count++;
+          }
+      }
+
+  memory->create(cglist, idxcg_max, "sna:cglist");
+  memory->create(ulisttot_r, idxu_max, "sna:ulisttot");
+  memory->create(ulisttot_i, idxu_max, "sna:ulisttot");
+  memory->create(ulist_r, idxu_max, "sna:ulist");
+  memory->create(ulist_i, idxu_max, "sna:ulist");
+  memory->create(dulist_r, idxu_max, 3, "sna:dulist");
+  memory->create(dulist_i, idxu_max, 3, "sna:dulist");
+  memory->create(ylist_r, idxu_max, "sna:ylist");
+  memory->create(ylist_i, idxu_max, "sna:ylist");
+  memory->create(zlist_r, idxz_max, "sna:zlist");
+  memory->create(zlist_i, idxz_max, "sna:zlist");
+  memory->create(blist, idxb_max, "sna:blist");
+  memory->create(dblist, idxb_max, 3, "sna:dblist");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void SNA::destroy_flat_arrays()
+{
+  memory->destroy(idxu_block);
+  memory->destroy(idxcg_block);
+  memory->destroy(idxz_block);
+  memory->destroy(idxb_block);
+  delete[] idxz;
+  delete[] idxb;
+
+  memory->destroy(cglist);
+  memory->destroy(ulisttot_r);
+  memory->destroy(ulisttot_i);
+  memory->destroy(ulist_r);
+  memory->destroy(ulist_i);
+  memory->destroy(dulist_r);
+  memory->destroy(dulist_i);
+  memory->destroy(ylist_r);
+  memory->destroy(ylist_i);
+  memory->destroy(zlist_r);
+  memory->destroy(zlist_i);
+  memory->destroy(blist);
+  memory->destroy(dblist);
+}
+
+/* ----------------------------------------------------------------------
+   compute Ui by summing over neighbors j, flat version
+------------------------------------------------------------------------- */
+
+void SNA::compute_ui_flat(int jnum)
+{
+  double rsq, r, x, y, z, z0, theta0;
+
+  for (int j = 0; j <= twojmax; j++) {
+    int jju = idxu_block[j];
+    for (int mb = 0; mb <= j; mb++)
+      for (int ma = 0; ma <= j; ma++) {
+        ulisttot_r[jju] = (ma == mb) ? wself : 0.0;
+        ulisttot_i[jju] = 0.0;
+        jju++;
+      }
+  }
+
+  for (int j = 0; j < jnum; j++) {
+    x = rij[j][0];
+    y = rij[j][1];
+    z = rij[j][2];
+    rsq = x * x + y * y + z * z;
+    r = sqrt(rsq);
+
+    theta0 = (r - rmin0) * rfac0 * MY_PI / (rcutij[j] - rmin0);
+    z0 = r / tan(theta0);
+
+    compute_uarray_flat(x, y, z, z0, r);
+
+    double sfac = compute_sfac(r, rcutij[j]) * wj[j];
+    for (int jju = 0; jju < idxu_max; jju++) {
+      ulisttot_r[jju] += sfac * ulist_r[jju];
+      ulisttot_i[jju] += sfac * ulist_i[jju];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute Zi from Ui, flat version
+   z(j1,j2,j,ma,mb) = sum_ma1,mb1 CG(ma1,ma2) CG(mb1,mb2)
+                      u(j1,ma1,mb1) u(j2,ma2,mb2)
+   for j1 >= j2 and 2*mb <= j, the remaining elements follow by symmetry
+------------------------------------------------------------------------- */
+
+void SNA::compute_zi_flat()
+{
+  for (int jjz = 0; jjz < idxz_max; jjz++) {
+    const int j1 = idxz[jjz].j1;
+    const int j2 = idxz[jjz].j2;
+    const int j = idxz[jjz].j;
+    const int ma1min = idxz[jjz].ma1min;
+    const int ma2max = idxz[jjz].ma2max;
+    const int mb1min = idxz[jjz].mb1min;
+    const int mb2max = idxz[jjz].mb2max;
+    const int na = idxz[jjz].na;
+    const int nb = idxz[jjz].nb;
+
+    const double *cgblock = cglist + idxcg_block[j1][j2][j];
+
+    double ztmp_r = 0.0;
+    double ztmp_i = 0.0;
+
+    int jju1 = idxu_block[j1] + (j1+1)*mb1min;
+    int jju2 = idxu_block[j2] + (j2+1)*mb2max;
+    int icgb = mb1min*(j2+1) + mb2max;
+
+    for (int ib = 0; ib < nb; ib++) {
+      double suma1_r = 0.0;
+      double suma1_i = 0.0;
+
+      const double *u1_r = &ulisttot_r[jju1];
+      const double *u1_i = &ulisttot_i[jju1];
+      const double *u2_r = &ulisttot_r[jju2];
+      const double *u2_i = &ulisttot_i[jju2];
+
+      int ma1 = ma1min;
+      int ma2 = ma2max;
+      int icga = ma1min*(j2+1) + ma2max;
+
+      for (int ia = 0; ia < na; ia++) {
+        suma1_r += cgblock[icga] *
+          (u1_r[ma1] * u2_r[ma2] - u1_i[ma1] * u2_i[ma2]);
+        suma1_i += cgblock[icga] *
+          (u1_r[ma1] * u2_i[ma2] + u1_i[ma1] * u2_r[ma2]);
+        ma1++;
+        ma2--;
+        icga += j2;
+      }
+
+      ztmp_r += cgblock[icgb] * suma1_r;
+      ztmp_i += cgblock[icgb] * suma1_i;
+
+      jju1 += j1 + 1;
+      jju2 -= j2 + 1;
+      icgb += j2;
+    }
+
+    zlist_r[jjz] = ztmp_r;
+    zlist_i[jjz] = ztmp_i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute Bi from Ui and Zi, flat version
+------------------------------------------------------------------------- */
+
+void SNA::compute_bi_flat()
+{
+  for (int jjb = 0; jjb < idxb_max; jjb++) {
+    const int j1 = idxb[jjb].j1;
+    const int j2 = idxb[jjb].j2;
+    const int j = idxb[jjb].j;
+
+    int jjz = idxz_block[j1][j2][j];
+    int jju = idxu_block[j];
+    double sumzu = 0.0;
+
+    for (int mb = 0; 2*mb < j; mb++)
+      for (int ma = 0; ma <= j; ma++) {
+        sumzu += ulisttot_r[jju] * zlist_r[jjz] +
+          ulisttot_i[jju] * zlist_i[jjz];
+        jjz++;
+        jju++;
+      }
+
+    // for j even, special treatment for middle column
+
+    if (j%2 == 0) {
+      const int mb = j/2;
+      for (int ma = 0; ma < mb; ma++) {
+        sumzu += ulisttot_r[jju] * zlist_r[jjz] +
+          ulisttot_i[jju] * zlist_i[jjz];
+        jjz++;
+        jju++;
+      }
+      sumzu += 0.5 * (ulisttot_r[jju] * zlist_r[jjz] +
+                      ulisttot_i[jju] * zlist_i[jjz]);
+    }
+
+    blist[jjb] = 2.0 * sumzu;
+    if (bzero_flag) blist[jjb] -= bzero[j];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute Yi = sum_jjb beta(jjb) dB(jjb)/dU, flat version
+   each Z element is formed on the fly and added to the unique
+   Y(j,ma,mb) element it contributes to, weighted by the beta of
+   every bispectrum component in which it appears
+   after this, dEi/dRj = 2 Re sum Conj(dU(j,ma,mb)/dRj) Y(j,ma,mb)
+   needs no per-neighbor dBi/dRj, see compute_deidrj_flat()
+------------------------------------------------------------------------- */
+
+void SNA::compute_yi_flat(const double *beta)
+{
+  double betaj;
+
+  for (int jju = 0; jju < idxu_max; jju++) {
+    ylist_r[jju] = 0.0;
+    ylist_i[jju] = 0.0;
+  }
+
+  for (int jjz = 0; jjz < idxz_max; jjz++) {
+    const int j1 = idxz[jjz].j1;
+    const int j2 = idxz[jjz].j2;
+    const int j = idxz[jjz].j;
+    const int ma1min = idxz[jjz].ma1min;
+    const int ma2max = idxz[jjz].ma2max;
+    const int mb1min = idxz[jjz].mb1min;
+    const int mb2max = idxz[jjz].mb2max;
+    const int na = idxz[jjz].na;
+    const int nb = idxz[jjz].nb;
+
+    const double *cgblock = cglist + idxcg_block[j1][j2][j];
+
+    double ztmp_r = 0.0;
+    double ztmp_i = 0.0;
+
+    int jju1 = idxu_block[j1] + (j1+1)*mb1min;
+    int jju2 = idxu_block[j2] + (j2+1)*mb2max;
+    int icgb = mb1min*(j2+1) + mb2max;
+
+    for (int ib = 0; ib < nb; ib++) {
+      double suma1_r = 0.0;
+      double suma1_i = 0.0;
+
+      const double *u1_r = &ulisttot_r[jju1];
+      const double *u1_i = &ulisttot_i[jju1];
+      const double *u2_r = &ulisttot_r[jju2];
+      const double *u2_i = &ulisttot_i[jju2];
+
+      int ma1 = ma1min;
+      int ma2 = ma2max;
+      int icga = ma1min*(j2+1) + ma2max;
+
+      for (int ia = 0; ia < na; ia++) {
+        suma1_r += cgblock[icga] *
+          (u1_r[ma1] * u2_r[ma2] - u1_i[ma1] * u2_i[ma2]);
+        suma1_i += cgblock[icga] *
+          (u1_r[ma1] * u2_i[ma2] + u1_i[ma1] * u2_r[ma2]);
+        ma1++;
+        ma2--;
+        icga += j2;
+      }
+
+      ztmp_r += cgblock[icgb] * suma1_r;
+      ztmp_i += cgblock[icgb] * suma1_i;
+
+      jju1 += j1 + 1;
+      jju2 -= j2 + 1;
+      icgb += j2;
+    }
+
+    // z(j1,j2,j) appears in B(j1,j2,j) and, via the j1fac and j2fac
+    // terms of compute_dbidrj(), in B(j,j2,j1) or B(j2,j,j1)
+
+    if (j >= j1) {
+      const int jjb = idxb_block[j1][j2][j];
+      if (j1 == j) {
+        if (j2 == j) betaj = 3*beta[jjb];
+        else betaj = 2*beta[jjb];
+      } else betaj = beta[jjb];
+    } else if (j >= j2) {
+      const int jjb = idxb_block[j][j2][j1];
+      if (j2 == j) betaj = 2*beta[jjb]*(j1+1)/(j+1.0);
+      else betaj = beta[jjb]*(j1+1)/(j+1.0);
+    } else {
+      const int jjb = idxb_block[j2][j][j1];
+      betaj = beta[jjb]*(j1+1)/(j+1.0);
+    }
+
+    const int jju = idxz[jjz].jju;
+    ylist_r[jju] += betaj * ztmp_r;
+    ylist_i[jju] += betaj * ztmp_i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   calculate derivative of Ui w.r.t. atom j, flat version
+------------------------------------------------------------------------- */
+
+void SNA::compute_duidrj_flat(double* rij, double wj, double rcut)
+{
+  double rsq, r, x, y, z, z0, theta0, cs, sn;
+  double dz0dr;
+
+  x = rij[0];
+  y = rij[1];
+  z = rij[2];
+  rsq = x * x + y * y + z * z;
+  r = sqrt(rsq);
+  double rscale0 = rfac0 * MY_PI / (rcut - rmin0);
+  theta0 = (r - rmin0) * rscale0;
+  cs = cos(theta0);
+  sn = sin(theta0);
+  z0 = r * cs / sn;
+  dz0dr = z0 / r - (r*rscale0) * (rsq + z0 * z0) / rsq;
+
+  compute_duarray_flat(x, y, z, z0, r, dz0dr, wj, rcut);
+}
+
+/* ----------------------------------------------------------------------
+   calculate derivative of Bi w.r.t. atom j, flat version
+   same three-term symmetric sum as compute_dbidrj()
+------------------------------------------------------------------------- */
+
+void SNA::compute_dbidrj_flat()
+{
+  for (int jjb = 0; jjb < idxb_max; jjb++) {
+    const int j1 = idxb[jjb].j1;
+    const int j2 = idxb[jjb].j2;
+    const int j = idxb[jjb].j;
+
+    double *dbdr = dblist[jjb];
+    dbdr[0] = 0.0;
+    dbdr[1] = 0.0;
+    dbdr[2] = 0.0;
+
+    // three terms: Conj(dudr(j))*z(j1,j2,j), Conj(dudr(j1))*z(j,j2,j1)
+    // and Conj(dudr(j2))*z(j,j1,j2) using j >= j1 >= j2
+
+    const int jt[3] = {j, j1, j2};
+    const int jjzt[3] = {idxz_block[j1][j2][j],
+                         idxz_block[j][j2][j1],
+                         idxz_block[j][j1][j2]};
+    const double fac[3] = {1.0, (j+1)/(j1+1.0), (j+1)/(j2+1.0)};
+
+    for (int it = 0; it < 3; it++) {
+      const int jj = jt[it];
+      int jjz = jjzt[it];
+      int jju = idxu_block[jj];
+      double sumzdu_r[3] = {0.0, 0.0, 0.0};
+
+      for (int mb = 0; 2*mb < jj; mb++)
+        for (int ma = 0; ma <= jj; ma++) {
+          for (int k = 0; k < 3; k++)
+            sumzdu_r[k] += dulist_r[jju][k] * zlist_r[jjz] +
+              dulist_i[jju][k] * zlist_i[jjz];
+          jjz++;
+          jju++;
+        }
+
+      // for jj even, handle middle column
+
+      if (jj%2 == 0) {
+        const int mb = jj/2;
+        for (int ma = 0; ma < mb; ma++) {
+          for (int k = 0; k < 3; k++)
+            sumzdu_r[k] += dulist_r[jju][k] * zlist_r[jjz] +
+              dulist_i[jju][k] * zlist_i[jjz];
+          jjz++;
+          jju++;
+        }
+        for (int k = 0; k < 3; k++)
+          sumzdu_r[k] += 0.5 * (dulist_r[jju][k] * zlist_r[jjz] +
+                                dulist_i[jju][k] * zlist_i[jjz]);
+      }
+
+      for (int k = 0; k < 3; k++)
+        dbdr[k] += 2.0 * sumzdu_r[k] * fac[it];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   calculate dEi/dRj = 2 Re sum Conj(dU(j,ma,mb)/dRj) Y(j,ma,mb)
+   requires compute_yi_flat() and compute_duidrj_flat()
+------------------------------------------------------------------------- */
+
+void SNA::compute_deidrj_flat(double* dedr)
+{
+  for (int k = 0; k < 3; k++)
+    dedr[k] = 0.0;
+
+  for (int j = 0; j <= twojmax; j++) {
+    int jju = idxu_block[j];
+
+    for (int mb = 0; 2*mb < j; mb++)
+      for (int ma = 0; ma <= j; ma++) {
+        for (int k = 0; k < 3; k++)
+          dedr[k] += dulist_r[jju][k] * ylist_r[jju] +
+            dulist_i[jju][k] * ylist_i[jju];
+        jju++;
+      }
+
+    // for j even, handle middle column
+
+    if (j%2 == 0) {
+      const int mb = j/2;
+      for (int ma = 0; ma < mb; ma++) {
+        for (int k = 0; k < 3; k++)
+          dedr[k] += dulist_r[jju][k] * ylist_r[jju] +
+            dulist_i[jju][k] * ylist_i[jju];
+        jju++;
+      }
+      for (int k = 0; k < 3; k++)
+        dedr[k] += 0.5 * (dulist_r[jju][k] * ylist_r[jju] +
+                          dulist_i[jju][k] * ylist_i[jju]);
+    }
+  }
+
+  for (int k = 0; k < 3; k++)
+    dedr[k] *= 2.0;
+}
+
+/* ----------------------------------------------------------------------
+   compute Wigner U-functions for one neighbor, flat version
+------------------------------------------------------------------------- */
+
+void SNA::compute_uarray_flat(double x, double y, double z,
+                              double z0, double r)
+{
+  double r0inv;
+  double a_r, b_r, a_i, b_i;
+  double rootpq;
+
+  // compute Cayley-Klein parameters for unit quaternion
+
+  r0inv = 1.0 / sqrt(r * r + z0 * z0);
+  a_r = r0inv * z0;
+  a_i = -r0inv * z;
+  b_r = r0inv * y;
+  b_i = -r0inv * x;
+
+  // VMK Section 4.8.2
+
+  ulist_r[0] = 1.0;
+  ulist_i[0] = 0.0;
+
+  for (int j = 1; j <= twojmax; j++) {
+    int jju = idxu_block[j];
+    int jjup = idxu_block[j-1];
+
+    // fill in left side of matrix layer from previous layer
+
+    for (int mb = 0; 2*mb <= j; mb++) {
+      ulist_r[jju] = 0.0;
+      ulist_i[jju] = 0.0;
+
+      for (int ma = 0; ma < j; ma++) {
+        rootpq = rootpqarray[j - ma][j - mb];
+        ulist_r[jju] += rootpq *
+          (a_r * ulist_r[jjup] + a_i * ulist_i[jjup]);
+        ulist_i[jju] += rootpq *
+          (a_r * ulist_i[jjup] - a_i * ulist_r[jjup]);
+
+        rootpq = rootpqarray[ma + 1][j - mb];
+        ulist_r[jju+1] = -rootpq *
+          (b_r * ulist_r[jjup] + b_i * ulist_i[jjup]);
+        ulist_i[jju+1] = -rootpq *
+          (b_r * ulist_i[jjup] - b_i * ulist_r[jjup]);
+        jju++;
+        jjup++;
+      }
+      jju++;
+    }
+
+    // copy left side to right side with inversion symmetry VMK 4.4(2)
+    // u[ma-j][mb-j] = (-1)^(ma-mb)*Conj([u[ma][mb])
+
+    jju = idxu_block[j];
+    jjup = jju + (j+1)*(j+1) - 1;
+    int mbpar = 1;
+    for (int mb = 0; 2*mb <= j; mb++) {
+      int mapar = mbpar;
+      for (int ma = 0; ma <= j; ma++) {
+        if (mapar == 1) {
+          ulist_r[jjup] = ulist_r[jju];
+          ulist_i[jjup] = -ulist_i[jju];
+        } else {
+          ulist_r[jjup] = -ulist_r[jju];
+          ulist_i[jjup] = ulist_i[jju];
+        }
+        mapar = -mapar;
+        jju++;
+        jjup--;
+      }
+      mbpar = -mbpar;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   compute derivatives of Wigner U-functions for one neighbor,
+   flat version, see compute_duarray()
+------------------------------------------------------------------------- */
+
+void SNA::compute_duarray_flat(double x, double y, double z,
+                               double z0, double r, double dz0dr,
+                               double wj, double rcut)
+{
+  double r0inv;
+  double a_r, a_i, b_r, b_i;
+  double da_r[3], da_i[3], db_r[3], db_i[3];
+  double dz0[3], dr0inv[3], dr0invdr;
+  double rootpq;
+
+  double rinv = 1.0 / r;
+  double ux = x * rinv;
+  double uy = y * rinv;
+  double uz = z * rinv;
+
+  r0inv = 1.0 / sqrt(r * r + z0 * z0);
+  a_r = z0 * r0inv;
+  a_i = -z * r0inv;
+  b_r = y * r0inv;
+  b_i = -x * r0inv;
+
+  dr0invdr = -pow(r0inv, 3.0) * (r + z0 * dz0dr);
+
+  dr0inv[0] = dr0invdr * ux;
+  dr0inv[1] = dr0invdr * uy;
+  dr0inv[2] = dr0invdr * uz;
+
+  dz0[0] = dz0dr * ux;
+  dz0[1] = dz0dr * uy;
+  dz0[2] = dz0dr * uz;
+
+  for (int k = 0; k < 3; k++) {
+    da_r[k] = dz0[k] * r0inv + z0 * dr0inv[k];
+    da_i[k] = -z * dr0inv[k];
+  }
+
+  da_i[2] += -r0inv;
+
+  for (int k = 0; k < 3; k++) {
+    db_r[k] = y * dr0inv[k];
+    db_i[k] = -x * dr0inv[k];
+  }
+
+  db_i[0] += -r0inv;
+  db_r[1] += r0inv;
+
+  ulist_r[0] = 1.0;
+  ulist_i[0] = 0.0;
+  for (int k = 0; k < 3; k++) {
+    dulist_r[0][k] = 0.0;
+    dulist_i[0][k] = 0.0;
+  }
+
+  for (int j = 1; j <= twojmax; j++) {
+    int jju = idxu_block[j];
+    int jjup = idxu_block[j-1];
+
+    for (int mb = 0; 2*mb <= j; mb++) {
+      ulist_r[jju] = 0.0;
+      ulist_i[jju] = 0.0;
+      for (int k = 0; k < 3; k++) {
+        dulist_r[jju][k] = 0.0;
+        dulist_i[jju][k] = 0.0;
+      }
+
+      for (int ma = 0; ma < j; ma++) {
+        rootpq = rootpqarray[j - ma][j - mb];
+        ulist_r[jju] += rootpq *
+          (a_r * ulist_r[jjup] + a_i * ulist_i[jjup]);
+        ulist_i[jju] += rootpq *
+          (a_r * ulist_i[jjup] - a_i * ulist_r[jjup]);
+
+        for (int k = 0; k < 3; k++) {
+          dulist_r[jju][k] +=
+            rootpq * (da_r[k] * ulist_r[jjup] +
+                      da_i[k] * ulist_i[jjup] +
+                      a_r * dulist_r[jjup][k] +
+                      a_i * dulist_i[jjup][k]);
+          dulist_i[jju][k] +=
+            rootpq * (da_r[k] * ulist_i[jjup] -
+                      da_i[k] * ulist_r[jjup] +
+                      a_r * dulist_i[jjup][k] -
+                      a_i * dulist_r[jjup][k]);
+        }
+
+        rootpq = rootpqarray[ma + 1][j - mb];
+        ulist_r[jju+1] = -rootpq *
+          (b_r * ulist_r[jjup] + b_i * ulist_i[jjup]);
+        ulist_i[jju+1] = -rootpq *
+          (b_r * ulist_i[jjup] - b_i * ulist_r[jjup]);
+
+        for (int k = 0; k < 3; k++) {
+          dulist_r[jju+1][k] =
+            -rootpq * (db_r[k] * ulist_r[jjup] +
+                       db_i[k] * ulist_i[jjup] +
+                       b_r * dulist_r[jjup][k] +
+                       b_i * dulist_i[jjup][k]);
+          dulist_i[jju+1][k] =
+            -rootpq * (db_r[k] * ulist_i[jjup] -
+                       db_i[k] * ulist_r[jjup] +
+                       b_r * dulist_i[jjup][k] -
+                       b_i * dulist_r[jjup][k]);
+        }
+        jju++;
+        jjup++;
+      }
+      jju++;
+    }
+
+    jju = idxu_block[j];
+    jjup = jju + (j+1)*(j+1) - 1;
+    int mbpar = 1;
+    for (int mb = 0; 2*mb <= j; mb++) {
+      int mapar = mbpar;
+      for (int ma = 0; ma <= j; ma++) {
+        if (mapar == 1) {
+          ulist_r[jjup] = ulist_r[jju];
+          ulist_i[jjup] = -ulist_i[jju];
+          for (int k = 0; k < 3; k++) {
+            dulist_r[jjup][k] = dulist_r[jju][k];
+            dulist_i[jjup][k] = -dulist_i[jju][k];
+          }
+        } else {
+          ulist_r[jjup] = -ulist_r[jju];
+          ulist_i[jjup] = ulist_i[jju];
+          for (int k = 0; k < 3; k++) {
+            dulist_r[jjup][k] = -dulist_r[jju][k];
+            dulist_i[jjup][k] = dulist_i[jju][k];
+          }
+        }
+        mapar = -mapar;
+        jju++;
+        jjup--;
+      }
+      mbpar = -mbpar;
+    }
+  }
+
+  double sfac = compute_sfac(r, rcut);
+  double dsfac = compute_dsfac(r, rcut);
+
+  sfac *= wj;
+  dsfac *= wj;
+
+  for (int jju = 0; jju < idxu_max; jju++) {
+    dulist_r[jju][0] = dsfac * ulist_r[jju] * ux + sfac * dulist_r[jju][0];
+    dulist_i[jju][0] = dsfac * ulist_i[jju] * ux + sfac * dulist_i[jju][0];
+    dulist_r[jju][1] = dsfac * ulist_r[jju] * uy + sfac * dulist_r[jju][1];
+    dulist_i[jju][1] = dsfac * ulist_i[jju] * uy + sfac * dulist_i[jju][1];
+    dulist_r[jju][2] = dsfac * ulist_r[jju] * uz + sfac * dulist_r[jju][2];
+    dulist_i[jju][2] = dsfac * ulist_i[jju] * uz + sfac * dulist_i[jju][2];
+  }
+}
+
 /* ----------------------------------------------------------------------
    memory usage of arrays
 ------------------------------------------------------------------------- */
@@ -1492,6 +2270,15 @@ double SNA::memory_usage()
   bytes += jdim * jdim * jdim * 3 * sizeof(double);
   bytes += ncoeff * sizeof(double);
   bytes += jdim * jdim * jdim * jdim * jdim * sizeof(complex<double>);
+  if (flat_flag) {
+    bytes += 3 * jdim * jdim * jdim * sizeof(int);
+    bytes += idxcg_max * sizeof(double);
+    bytes += 12 * idxu_max * sizeof(double);
+    bytes += 2 * idxz_max * sizeof(double);
+    bytes += idxz_max * sizeof(SNA_ZINDICES);
+    bytes += 4 * idxb_max * sizeof(double);
+    bytes += idxb_max * sizeof(SNA_BINDICES);
+  }
   return bytes;
 }
 
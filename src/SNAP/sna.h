@@ -28,6 +28,14 @@ struct SNA_LOOPINDICES {
   int j1, j2, j;
 };
 
+struct SNA_ZINDICES {
+  int j1, j2, j, ma1min, ma2max, mb1min, mb2max, na, nb, jju;
+};
+
+struct SNA_BINDICES {
+  int j1, j2, j;
+};
+
 class SNA : protected Pointers {
 
 public:
@@ -59,6 +67,17 @@ public:
   double compute_sfac(double, double);
   double compute_dsfac(double, double);
 
+  // flattened kernel, diagonalstyle = 3 only
+
+  void init_flat();
+  void compute_ui_flat(int);
+  void compute_zi_flat();
+  void compute_bi_flat();
+  void compute_yi_flat(const double *);
+  void compute_duidrj_flat(double*, double, double);
+  void compute_dbidrj_flat();
+  void compute_deidrj_flat(double*);
+
 #ifdef TIMING_INFO
   double* timers;
   timespec starttime, endtime;
@@ -84,6 +103,12 @@ public:
   double***** zarray_r_b, ***** zarray_i_b;
   double*** uarray_r, *** uarray_i;
 
+  // flat arrays for the flattened kernel,
+  // U and dU/dr stored as (j,mb,ma) blocks, Z and B in index list order
+
+  double* blist;
+  double** dblist;
+
 private:
   double rmin0, rfac0;
 
@@ -101,6 +126,27 @@ private:
   double**** duarray_r, **** duarray_i;
   double**** dbarray;
 
+  // index lists and flat arrays for the flattened kernel
+
+  int flat_flag;
+  int* idxu_block;
+  int idxu_max;
+  int*** idxcg_block;
+  int idxcg_max;
+  int*** idxz_block;
+  SNA_ZINDICES* idxz;
+  int idxz_max;
+  int*** idxb_block;
+  SNA_BINDICES* idxb;
+  int idxb_max;
+
+  double* cglist;
+  double* ulisttot_r, * ulisttot_i;
+  double* ulist_r, * ulist_i;
+  double* zlist_r, * zlist_i;
+  double* ylist_r, * ylist_i;
+  double** dulist_r, ** dulist_i;
+
   static const int nmaxfactorial = 167;
   static const double nfac_table[];
   double factorial(int);
@@ -124,6 +170,12 @@ private:
   int compute_ncoeff();
   void compute_duarray(double, double, double,
                        double, double, double, double, double);
+  void build_flat_indexlist();
+  void destroy_flat_arrays();
+  void compute_uarray_flat(double, double, double,
+                           double, double);
+  void compute_duarray_flat(double, double, double,
+                            double, double, double, double, double);
 
   // if number of atoms are small use per atom arrays
   // for twojmax arrays, rij, inside, bvec
@@ -149,6 +201,11 @@ private:
 
 /* ERROR/WARNING messages:
 
+E: Flattened SNAP kernel requires diagonalstyle 3
+
+The flat index lists only cover the j1 >= j2, j >= j1 ordering
+of bispectrum components used by diagonalstyle 3.
+
 E: Invalid argument to factorial %d
 
 N must be >= 0 and <= 167, otherwise the factorial result is too
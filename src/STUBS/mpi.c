@@ -244,6 +244,7 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype datatype,
 
 int MPI_Wait(MPI_Request *request, MPI_Status *status)
 {
+  if (*request == MPI_REQUEST_NULL) return 0;
   printf("MPI Stub WARNING: Should not wait on message from self\n");
   return 0;
 }
@@ -252,6 +253,10 @@ int MPI_Wait(MPI_Request *request, MPI_Status *status)
 
 int MPI_Waitall(int n, MPI_Request *request, MPI_Status *status)
 {
+  int i;
+  for (i = 0; i < n; i++)
+    if (request[i] != MPI_REQUEST_NULL) break;
+  if (i == n) return 0;
   printf("MPI Stub WARNING: Should not wait on message from self\n");
   return 0;
 }
@@ -51,6 +51,8 @@ extern "C" {
 
 #define MPI_ANY_SOURCE -1
 #define MPI_STATUS_IGNORE NULL
+#define MPI_STATUSES_IGNORE NULL
+#define MPI_REQUEST_NULL 0
 
 #define MPI_Comm int
 #define MPI_Request int
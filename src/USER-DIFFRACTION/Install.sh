@@ -0,0 +1,57 @@
+# Install/unInstall package files in LAMMPS
+# mode = 0/1/2 for uninstall/install/update
+
+mode=$1
+
+# enforce using portable C locale
+LC_ALL=C
+export LC_ALL
+
+# arg1 = file, arg2 = file it depends on
+
+action () {
+  if (test $mode = 0) then
+    rm -f ../$1
+  elif (! cmp -s $1 ../$1) then
+    if (test -z "$2" || test -e ../$2) then
+      cp $1 ..
+      if (test $mode = 2) then
+        echo "  updating src/$1"
+      fi
+    fi
+  elif (test -n "$2") then
+    if (test ! -e ../$2) then
+      rm -f ../$1
+    fi
+  fi
+}
+
+# step 1: process all files
+# the NUFFT evaluation needs the 3d FFTs from the KSPACE package
+
+action compute_saed.cpp
+action compute_saed.h
+action compute_saed_consts.h
+action compute_xrd.cpp
+action compute_xrd.h
+action compute_xrd_consts.h
+action fix_saed_vtk.cpp
+action fix_saed_vtk.h
+action diffraction_nufft.cpp fft3d_wrap.h
+action diffraction_nufft.h fft3d_wrap.h
+
+# step 2: enable the nufft keyword of compute xrd and saed
+# only when the NUFFT files are installed
+
+if (test -e ../Makefile.package) then
+  sed -i -e 's/[^ \t]*DIFFRACTION_NUFFT[^ \t]* //' ../Makefile.package
+  if (test $mode != 0 && test -e ../diffraction_nufft.h) then
+    sed -i -e 's|^PKG_INC =[ \t]*|&-DLMP_DIFFRACTION_NUFFT |' ../Makefile.package
+  fi
+fi
+
+# force rebuild of files with LMP_DIFFRACTION_NUFFT switch
+
+if (test $mode != 0) then
+  touch ../compute_saed.cpp ../compute_xrd.cpp
+fi
@@ -32,6 +32,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifdef LMP_DIFFRACTION_NUFFT
+#include "diffraction_nufft.h"
+#endif
+
 using namespace LAMMPS_NS;
 using namespace MathConst;
 
@@ -49,7 +53,7 @@ static const char cite_compute_saed_c[] =
 /* ---------------------------------------------------------------------- */
 
 ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
-  Compute(lmp, narg, arg), ztype(NULL), store_tmp(NULL)
+  Compute(lmp, narg, arg), ztype(NULL), store_tmp(NULL), nufft(NULL)
 {
   if (lmp->citeme) lmp->citeme->add(cite_compute_saed_c);
 
@@ -101,6 +105,7 @@ ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
   manual = false;
   double manual_double=0;
   echo = false;
+  nufft_tol = 0.0;
 
   // Process optional args
   while (iarg < narg) {
@@ -144,6 +149,17 @@ ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
       manual_double = 1;
       iarg += 1;
 
+    } else if (strcmp(arg[iarg],"nufft") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal Compute SAED Command");
+      nufft_tol = atof(arg[iarg+1]);
+      if (nufft_tol < 0.0 || nufft_tol >= 1.0)
+        error->all(FLERR,"Compute SAED: nufft tolerance must be >= 0 and < 1");
+#ifndef LMP_DIFFRACTION_NUFFT
+      if (nufft_tol > 0.0)
+        error->all(FLERR,"Compute SAED nufft requires the KSPACE package");
+#endif
+      iarg += 2;
+
     } else error->all(FLERR,"Illegal Compute SAED Command");
   }
 
@@ -273,6 +289,16 @@ ComputeSAED::ComputeSAED(LAMMPS *lmp, int narg, char **arg) :
   saed_var[7] = c[2];
   saed_var[8] = dR_Ewald;
   saed_var[9] = manual_double;
+
+#ifdef LMP_DIFFRACTION_NUFFT
+  if (nufft_tol > 0.0) {
+    nufft = new DiffractionNUFFT(lmp,Knmax,dK,nufft_tol);
+    if (me == 0 && screen && echo)
+      fprintf(screen,"Compute SAED nufft grid = %d %d %d, "
+              "spreading half-width = %d\n",
+              nufft->ngrid[0],nufft->ngrid[1],nufft->ngrid[2],nufft->msp);
+  }
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -282,6 +308,9 @@ ComputeSAED::~ComputeSAED()
   memory->destroy(vector);
   memory->destroy(store_tmp);
   delete ztype;
+#ifdef LMP_DIFFRACTION_NUFFT
+  delete nufft;
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -337,6 +366,10 @@ void ComputeSAED::init()
   }
   if (n != nRows)  error->all(FLERR,"Compute SAED Nrows inconsistent");
 
+#ifdef LMP_DIFFRACTION_NUFFT
+  if (nufft) nufft->setup(nRows,store_tmp);
+#endif
+
 }
 
 /* ---------------------------------------------------------------------- */
@@ -418,6 +451,8 @@ void ComputeSAED::compute_vector()
   int m = 0;
   double frac = 0.1;
 
+  if (nufft) nufft_structure_factor(Fvec,xlocal,typelocal,offset);
+  else {
 #if defined(_OPENMP)
 #pragma omp parallel default(none) shared(offset,ASFSAED,typelocal,xlocal,Fvec,m,frac)
 #endif
@@ -489,6 +524,7 @@ void ComputeSAED::compute_vector()
     } // End of pragma omp for region
     delete [] f;
   }
+  }
 
   double *scratch = new double[2*nRows];
 
@@ -508,6 +544,9 @@ void ComputeSAED::compute_vector()
   bytes += 3.0 * nlocalgroup * sizeof(double); // xlocal
   bytes += nlocalgroup * sizeof(int); // typelocal
   bytes += 3.0 * nRows * sizeof(int); // store_temp
+#ifdef LMP_DIFFRACTION_NUFFT
+  if (nufft) bytes += nufft->memory_usage();
+#endif
 
   if (me == 0 && echo) {
     if (screen)
@@ -532,7 +571,59 @@ double ComputeSAED::memory_usage()
   bytes += 3.0 * nlocalgroup * sizeof(double); // xlocal
   bytes += nlocalgroup * sizeof(int); // typelocal
   bytes += 3.0 * nRows * sizeof(int); // store_temp
+#ifdef LMP_DIFFRACTION_NUFFT
+  if (nufft) bytes += nufft->memory_usage();
+#endif
 
   return bytes;
 }
 
+/* ----------------------------------------------------------------------
+   structure factor of the RELPs this proc owns on the NUFFT grid
+   per-type sums from the NUFFT, weighted by the ASF
+   Fvec entries of RELPs owned by other procs are set to zero
+------------------------------------------------------------------------- */
+
+void ComputeSAED::nufft_structure_factor(double *Fvec, double *xlocal,
+                                         int *typelocal, int offset)
+{
+  for (int n = 0; n < 2*nRows; n++) Fvec[n] = 0.0;
+
+#ifdef LMP_DIFFRACTION_NUFFT
+  nufft->compute(nlocalgroup,xlocal,typelocal,ntypes);
+
+  double *f = new double[ntypes];
+  double K[3];
+  double **sfac = nufft->sfac;
+
+  for (int m = 0; m < nufft->nrelp; m++) {
+    int n = nufft->relp[m];
+    K[0] = store_tmp[3*n+0] * dK[0];
+    K[1] = store_tmp[3*n+1] * dK[1];
+    K[2] = store_tmp[3*n+2] * dK[2];
+
+    double dinv2 = (K[0] * K[0] + K[1] * K[1] + K[2] * K[2]);
+    double SinTheta_lambda = 0.5*sqrt(dinv2);
+
+    for (int ii = 0; ii < ntypes; ii++){
+      f[ii] = 0;
+      for (int C = 0; C < 5; C++){
+        int D = C + offset;
+        f[ii] += ASFSAED[ztype[ii]][D] * exp(-1*ASFSAED[ztype[ii]][5+D] * SinTheta_lambda * SinTheta_lambda);
+      }
+    }
+
+    double Fatom1 = 0.0;
+    double Fatom2 = 0.0;
+    for (int ii = 0; ii < ntypes; ii++) {
+      Fatom1 += f[ii] * sfac[ii][2*m];
+      Fatom2 += f[ii] * sfac[ii][2*m+1];
+    }
+    Fvec[2*n] = Fatom1;
+    Fvec[2*n+1] = Fatom2;
+  }
+
+  delete [] f;
+#endif
+}
+
@@ -55,6 +55,11 @@ class ComputeSAED : public Compute {
   int nlocalgroup;
   int *store_tmp;
 
+  double nufft_tol;          // NUFFT accuracy, 0 = direct sum
+  class DiffractionNUFFT *nufft;
+
+  void nufft_structure_factor(double *, double *, int *, int);
+
 };
 
 }
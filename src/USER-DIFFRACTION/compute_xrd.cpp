@@ -31,6 +31,10 @@
 #include "memory.h"
 #include "error.h"
 #include <stdio.h>
+
+#ifdef LMP_DIFFRACTION_NUFFT
+#include "diffraction_nufft.h"
+#endif
 #include <string.h>
 
 using namespace LAMMPS_NS;
@@ -50,7 +54,7 @@ static const char cite_compute_xrd_c[] =
 /* ---------------------------------------------------------------------- */
 
 ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
-  Compute(lmp, narg, arg), ztype(NULL), store_tmp(NULL)
+  Compute(lmp, narg, arg), ztype(NULL), store_tmp(NULL), nufft(NULL)
 {
   if (lmp->citeme) lmp->citeme->add(cite_compute_xrd_c);
 
@@ -102,6 +106,7 @@ ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
   LP = 1;
   manual = false;
   echo = false;
+  nufft_tol = 0.0;
 
   // Process optional args
   while (iarg < narg) {
@@ -147,6 +152,17 @@ ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
       manual = true;
       iarg += 1;
 
+    } else if (strcmp(arg[iarg],"nufft") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal Compute XRD Command");
+      nufft_tol = atof(arg[iarg+1]);
+      if (nufft_tol < 0.0 || nufft_tol >= 1.0)
+        error->all(FLERR,"Compute XRD: nufft tolerance must be >= 0 and < 1");
+#ifndef LMP_DIFFRACTION_NUFFT
+      if (nufft_tol > 0.0)
+        error->all(FLERR,"Compute XRD nufft requires the KSPACE package");
+#endif
+      iarg += 2;
+
     } else error->all(FLERR,"Illegal Compute XRD Command");
   }
 
@@ -239,6 +255,16 @@ ComputeXRD::ComputeXRD(LAMMPS *lmp, int narg, char **arg) :
 
   memory->create(array,size_array_rows,size_array_cols,"xrd:array");
   memory->create(store_tmp,3*size_array_rows,"xrd:store_tmp");
+
+#ifdef LMP_DIFFRACTION_NUFFT
+  if (nufft_tol > 0.0) {
+    nufft = new DiffractionNUFFT(lmp,Knmax,dK,nufft_tol);
+    if (me == 0 && screen && echo)
+      fprintf(screen,"Compute XRD nufft grid = %d %d %d, "
+              "spreading half-width = %d\n",
+              nufft->ngrid[0],nufft->ngrid[1],nufft->ngrid[2],nufft->msp);
+  }
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -248,6 +274,9 @@ ComputeXRD::~ComputeXRD()
   memory->destroy(array);
   memory->destroy(store_tmp);
   delete ztype;
+#ifdef LMP_DIFFRACTION_NUFFT
+  delete nufft;
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -290,6 +319,22 @@ void ComputeXRD::init()
  if (n != size_array_rows)
      error->all(FLERR,"Compute XRD compute_array() rows mismatch");
 
+#ifdef LMP_DIFFRACTION_NUFFT
+  // hand the RELPs to the NUFFT in (h,k,l) = (i,j,k) order
+
+  if (nufft) {
+    int *hkl;
+    memory->create(hkl,3*size_array_rows,"xrd:hkl");
+    for (n = 0; n < size_array_rows; n++) {
+      hkl[3*n] = store_tmp[3*n+2];
+      hkl[3*n+1] = store_tmp[3*n+1];
+      hkl[3*n+2] = store_tmp[3*n];
+    }
+    nufft->setup(size_array_rows,hkl);
+    memory->destroy(hkl);
+  }
+#endif
+
 }
 
 /* ---------------------------------------------------------------------- */
@@ -353,6 +398,8 @@ void ComputeXRD::compute_array()
   int m = 0;
   double frac = 0.1;
 
+  if (nufft) nufft_structure_factor(Fvec,xlocal,typelocal);
+  else {
 #if defined(_OPENMP)
 #pragma omp parallel default(none) shared(typelocal,xlocal,Fvec,m,frac,ASFXRD)
 #endif
@@ -492,6 +539,7 @@ void ComputeXRD::compute_array()
     } // End of if LP=1 check
     delete [] f;
   } // End of pragma omp parallel region
+  }
 
   double *scratch = new double[2*size_array_rows];
 
@@ -511,6 +559,9 @@ void ComputeXRD::compute_array()
   bytes += 3.0 * nlocalgroup * sizeof(double); // xlocal
   bytes += nlocalgroup * sizeof(int); // typelocal
   bytes += 3.0 * size_array_rows * sizeof(int); // store_temp
+#ifdef LMP_DIFFRACTION_NUFFT
+  if (nufft) bytes += nufft->memory_usage();
+#endif
 
   if (me == 0 && echo) {
     if (screen)
@@ -535,7 +586,69 @@ double ComputeXRD::memory_usage()
   bytes += nlocalgroup * sizeof(int); // typelocal
   bytes += ntypes * sizeof(double); // f
   bytes += 3.0 * size_array_rows * sizeof(int); // store_temp
+#ifdef LMP_DIFFRACTION_NUFFT
+  if (nufft) bytes += nufft->memory_usage();
+#endif
 
   return bytes;
 }
 
+/* ----------------------------------------------------------------------
+   structure factor of the RELPs this proc owns on the NUFFT grid
+   per-type sums from the NUFFT, weighted by the ASF and LP factor
+   Fvec entries of RELPs owned by other procs are set to zero
+------------------------------------------------------------------------- */
+
+void ComputeXRD::nufft_structure_factor(double *Fvec, double *xlocal,
+                                        int *typelocal)
+{
+  for (int n = 0; n < 2*size_array_rows; n++) Fvec[n] = 0.0;
+
+#ifdef LMP_DIFFRACTION_NUFFT
+  nufft->compute(nlocalgroup,xlocal,typelocal,ntypes);
+
+  double *f = new double[ntypes];
+  double K[3];
+  double **sfac = nufft->sfac;
+
+  for (int m = 0; m < nufft->nrelp; m++) {
+    int n = nufft->relp[m];
+    K[0] = store_tmp[3*n+2] * dK[0];
+    K[1] = store_tmp[3*n+1] * dK[1];
+    K[2] = store_tmp[3*n] * dK[2];
+
+    double dinv2 = (K[0] * K[0] + K[1] * K[1] + K[2] * K[2]);
+    double SinTheta_lambda = 0.5*sqrt(dinv2);
+
+    for (int ii = 0; ii < ntypes; ii++){
+      f[ii] = 0;
+      for (int C = 0; C < 8 ; C+=2){
+        f[ii] += ASFXRD[ztype[ii]][C] * exp(-1 * ASFXRD[ztype[ii]][C+1] * SinTheta_lambda * SinTheta_lambda );
+      }
+      f[ii] += ASFXRD[ztype[ii]][8];
+    }
+
+    double sqrt_lp = 1.0;
+    if (LP == 1) {
+      double SinTheta = SinTheta_lambda * lambda;
+      double ang = asin( SinTheta );
+      double Cos2Theta = cos( 2 * ang);
+      double CosTheta = cos( ang );
+      sqrt_lp = sqrt( (1 + Cos2Theta * Cos2Theta) /
+                      ( CosTheta * SinTheta * SinTheta) );
+    }
+
+    double Fatom1 = 0.0;
+    double Fatom2 = 0.0;
+    for (int ii = 0; ii < ntypes; ii++) {
+      Fatom1 += f[ii] * sfac[ii][2*m];
+      Fatom2 += f[ii] * sfac[ii][2*m+1];
+    }
+    Fvec[2*n] = Fatom1 * sqrt_lp;
+    Fvec[2*n+1] = Fatom2 * sqrt_lp;
+  }
+
+  delete [] f;
+#endif
+}
+
@@ -52,6 +52,11 @@ class ComputeXRD : public Compute {
   int radflag;
   int *store_tmp;
 
+  double nufft_tol;          // NUFFT accuracy, 0 = direct sum
+  class DiffractionNUFFT *nufft;
+
+  void nufft_structure_factor(double *, double *, int *);
+
 };
 
 }
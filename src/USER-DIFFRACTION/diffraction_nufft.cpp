@@ -0,0 +1,429 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Gaussian gridding type-1 NUFFT, see Greengard and Lee,
+   SIAM Review, 46, 443 (2004)
+------------------------------------------------------------------------- */
+
+#include <mpi.h>
+#include <math.h>
+#include <string.h>
+#include "diffraction_nufft.h"
+#include "fft3d_wrap.h"
+#include "math_const.h"
+#include "comm.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+#define OVERSAMPLE 2.0
+#define MINSPREAD 2
+#define MAXSPREAD 16
+#define DELTA 16384
+
+/* ----------------------------------------------------------------------
+   knmax = largest |h|,|k|,|l| that will be requested
+   dK = reciprocal lattice spacing, tol = requested relative accuracy
+------------------------------------------------------------------------- */
+
+DiffractionNUFFT::DiffractionNUFFT(LAMMPS *lmp, int *knmax, double *dKin,
+                                   double tol) : Pointers(lmp)
+{
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+
+  // truncating the Gaussian after msp grid points on each side gives
+  // an error of about exp(-msp pi (1 - 1/(2R-1))) for oversampling R
+
+  msp = static_cast<int>
+    (ceil(-log(tol) / (MY_PI * (1.0 - 1.0/(2.0*OVERSAMPLE-1.0)))));
+  msp = MAX(msp,MINSPREAD);
+  msp = MIN(msp,MAXSPREAD);
+
+  // nmode = # of Fourier modes that must be resolved, |h| <= nmode/2 - 1
+  // tau from the oversampling actually realized on a factorable grid
+
+  bigint ntotal = 1;
+  for (int d = 0; d < 3; d++) {
+    dK[d] = dKin[d];
+    int nmode = 2*knmax[d] + 2;
+    ngrid[d] = factorable(static_cast<int> (OVERSAMPLE*nmode));
+    ngrid[d] = MAX(ngrid[d],factorable(2*msp));
+    double ratio = static_cast<double> (ngrid[d]) / nmode;
+    tau[d] = MY_PI * msp / (nmode * nmode * ratio * (ratio - 0.5));
+    delgrid[d] = MY_2PI / ngrid[d];
+    ntotal *= ngrid[d];
+  }
+
+  // distribute grid as x pencils over a 2d grid of procs in y,z
+
+  procs2grid2d(nprocs,ngrid[1],ngrid[2],&npey,&npez);
+  int me_y = me % npey;
+  int me_z = me / npey;
+  nylo = me_y*ngrid[1]/npey;
+  nyhi = (me_y+1)*ngrid[1]/npey - 1;
+  nzlo = me_z*ngrid[2]/npez;
+  nzhi = (me_z+1)*ngrid[2]/npez - 1;
+
+  bigint nlocal = (bigint) ngrid[0] * (nyhi-nylo+1) * (nzhi-nzlo+1);
+  if (2*nlocal > MAXSMALLINT || ntotal <= 0)
+    error->one(FLERR,"Diffraction nufft grid is too large");
+  nbrick = nlocal;
+
+  memory->create(yowner,ngrid[1],"nufft:yowner");
+  memory->create(zowner,ngrid[2],"nufft:zowner");
+  for (int i = 0; i < npey; i++)
+    for (int m = i*ngrid[1]/npey; m < (i+1)*ngrid[1]/npey; m++)
+      yowner[m] = i;
+  for (int i = 0; i < npez; i++)
+    for (int m = i*ngrid[2]/npez; m < (i+1)*ngrid[2]/npez; m++)
+      zowner[m] = i;
+
+  memory->create(grid,2*nbrick,"nufft:grid");
+
+  int tmp;
+  fft = new FFT3d(lmp,world,ngrid[0],ngrid[1],ngrid[2],
+                  0,ngrid[0]-1,nylo,nyhi,nzlo,nzhi,
+                  0,ngrid[0]-1,nylo,nyhi,nzlo,nzhi,
+                  0,0,&tmp,0);
+
+  nrelp = 0;
+  relp = NULL;
+  relp_index = NULL;
+  relp_scale = NULL;
+  sfac = NULL;
+  ntypes_alloc = 0;
+
+  maxsend = maxrecv = 0;
+  sendbuf = recvbuf = NULL;
+  memory->create(sendcounts,nprocs,"nufft:sendcounts");
+  memory->create(senddispls,nprocs,"nufft:senddispls");
+  memory->create(recvcounts,nprocs,"nufft:recvcounts");
+  memory->create(recvdispls,nprocs,"nufft:recvdispls");
+}
+
+/* ---------------------------------------------------------------------- */
+
+DiffractionNUFFT::~DiffractionNUFFT()
+{
+  delete fft;
+  memory->destroy(grid);
+  memory->destroy(yowner);
+  memory->destroy(zowner);
+  memory->destroy(relp);
+  memory->destroy(relp_index);
+  memory->destroy(relp_scale);
+  memory->destroy(sfac);
+  memory->destroy(sendbuf);
+  memory->destroy(recvbuf);
+  memory->destroy(sendcounts);
+  memory->destroy(senddispls);
+  memory->destroy(recvcounts);
+  memory->destroy(recvdispls);
+}
+
+/* ----------------------------------------------------------------------
+   select the nrows RELPs (h,k,l) in hkl whose grid point I own
+   S(h) = sum_j exp(+i h phi_j) is the forward FFT at mode -h
+   store deconvolution of the Gaussian for each of them
+------------------------------------------------------------------------- */
+
+void DiffractionNUFFT::setup(int nrows, int *hkl)
+{
+  nrelp = 0;
+  for (int n = 0; n < nrows; n++) {
+    int my = (ngrid[1] - hkl[3*n+1]) % ngrid[1];
+    int mz = (ngrid[2] - hkl[3*n+2]) % ngrid[2];
+    if (my >= nylo && my <= nyhi && mz >= nzlo && mz <= nzhi) nrelp++;
+  }
+
+  memory->destroy(relp);
+  memory->destroy(relp_index);
+  memory->destroy(relp_scale);
+  memory->create(relp,nrelp,"nufft:relp");
+  memory->create(relp_index,nrelp,"nufft:relp_index");
+  memory->create(relp_scale,nrelp,"nufft:relp_scale");
+
+  double norm = 1.0;
+  for (int d = 0; d < 3; d++) norm *= sqrt(MY_PI/tau[d]) / ngrid[d];
+
+  int nyloc = nyhi - nylo + 1;
+  int m = 0;
+  for (int n = 0; n < nrows; n++) {
+    int h = hkl[3*n];
+    int k = hkl[3*n+1];
+    int l = hkl[3*n+2];
+    int mx = (ngrid[0] - h) % ngrid[0];
+    int my = (ngrid[1] - k) % ngrid[1];
+    int mz = (ngrid[2] - l) % ngrid[2];
+    if (my < nylo || my > nyhi || mz < nzlo || mz > nzhi) continue;
+    relp[m] = n;
+    relp_index[m] = ((mz-nzlo)*nyloc + (my-nylo))*ngrid[0] + mx;
+    relp_scale[m] = norm * exp(h*h*tau[0] + k*k*tau[1] + l*l*tau[2]);
+    m++;
+  }
+
+  // sfac is re-allocated in compute() once ntypes is known
+
+  memory->destroy(sfac);
+  sfac = NULL;
+  ntypes_alloc = 0;
+}
+
+/* ----------------------------------------------------------------------
+   compute per-type structure factors of n atoms with coords x
+   and types 1 to ntypes, result in sfac for the RELPs I own
+------------------------------------------------------------------------- */
+
+void DiffractionNUFFT::compute(int n, double *x, int *type, int ntypes)
+{
+  if (ntypes != ntypes_alloc) {
+    memory->destroy(sfac);
+    memory->create(sfac,ntypes,2*nrelp,"nufft:sfac");
+    ntypes_alloc = ntypes;
+  }
+
+  // skip spreading and FFT for types not present in the group
+
+  int *count = new int[ntypes];
+  int *allcount = new int[ntypes];
+  for (int t = 0; t < ntypes; t++) count[t] = 0;
+  for (int i = 0; i < n; i++) count[type[i]-1]++;
+  MPI_Allreduce(count,allcount,ntypes,MPI_INT,MPI_SUM,world);
+
+  int nrecv = route(n,x,type);
+
+  for (int t = 0; t < ntypes; t++) {
+    if (allcount[t] == 0) {
+      for (int m = 0; m < 2*nrelp; m++) sfac[t][m] = 0.0;
+      continue;
+    }
+    spread(nrecv,t+1);
+    fft->compute(grid,grid,1);
+    for (int m = 0; m < nrelp; m++) {
+      int idx = relp_index[m];
+      sfac[t][2*m] = relp_scale[m] * grid[2*idx];
+      sfac[t][2*m+1] = relp_scale[m] * grid[2*idx+1];
+    }
+  }
+
+  delete [] count;
+  delete [] allcount;
+}
+
+/* ----------------------------------------------------------------------
+   send phases of each atom to all procs whose pencil overlaps its
+   Gaussian footprint, return # of atoms received into recvbuf
+   each atom is packed as 3 phases in [0,2pi) and its type
+------------------------------------------------------------------------- */
+
+int DiffractionNUFFT::route(int n, double *x, int *type)
+{
+  int i,j,k,d,m,iy,iz,proc;
+  double phi[3];
+  int ylist[2*MAXSPREAD],zlist[2*MAXSPREAD];
+  int ny,nz;
+
+  for (proc = 0; proc < nprocs; proc++) sendcounts[proc] = 0;
+
+  // two passes: 1st counts, 2nd packs
+
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) {
+      int nsend = 0;
+      for (proc = 0; proc < nprocs; proc++) {
+        senddispls[proc] = nsend;
+        nsend += sendcounts[proc];
+        sendcounts[proc] = 0;
+      }
+      if (nsend > maxsend) {
+        maxsend = nsend + DELTA;
+        memory->destroy(sendbuf);
+        memory->create(sendbuf,maxsend,"nufft:sendbuf");
+      }
+    }
+
+    for (i = 0; i < n; i++) {
+      for (d = 0; d < 3; d++) {
+        phi[d] = fmod(MY_2PI*dK[d]*x[3*i+d],MY_2PI);
+        if (phi[d] < 0.0) phi[d] += MY_2PI;
+      }
+
+      // distinct y and z pencil indices touched by the footprint
+
+      ny = nz = 0;
+      int m0 = static_cast<int> (phi[1]/delgrid[1]);
+      for (m = m0-msp+1; m <= m0+msp; m++) {
+        int owner = yowner[(m+ngrid[1]) % ngrid[1]];
+        for (k = 0; k < ny; k++) if (ylist[k] == owner) break;
+        if (k == ny) ylist[ny++] = owner;
+      }
+      m0 = static_cast<int> (phi[2]/delgrid[2]);
+      for (m = m0-msp+1; m <= m0+msp; m++) {
+        int owner = zowner[(m+ngrid[2]) % ngrid[2]];
+        for (k = 0; k < nz; k++) if (zlist[k] == owner) break;
+        if (k == nz) zlist[nz++] = owner;
+      }
+
+      for (iz = 0; iz < nz; iz++)
+        for (iy = 0; iy < ny; iy++) {
+          proc = zlist[iz]*npey + ylist[iy];
+          if (pass == 1) {
+            j = senddispls[proc] + sendcounts[proc];
+            sendbuf[j] = phi[0];
+            sendbuf[j+1] = phi[1];
+            sendbuf[j+2] = phi[2];
+            sendbuf[j+3] = type[i];
+          }
+          sendcounts[proc] += 4;
+        }
+    }
+  }
+
+  MPI_Alltoall(sendcounts,1,MPI_INT,recvcounts,1,MPI_INT,world);
+
+  int nrecv = 0;
+  for (proc = 0; proc < nprocs; proc++) {
+    recvdispls[proc] = nrecv;
+    nrecv += recvcounts[proc];
+  }
+  if (nrecv > maxrecv) {
+    maxrecv = nrecv + DELTA;
+    memory->destroy(recvbuf);
+    memory->create(recvbuf,maxrecv,"nufft:recvbuf");
+  }
+
+  MPI_Alltoallv(sendbuf,sendcounts,senddispls,MPI_DOUBLE,
+                recvbuf,recvcounts,recvdispls,MPI_DOUBLE,world);
+
+  return nrecv/4;
+}
+
+/* ----------------------------------------------------------------------
+   spread received atoms of type itype onto my grid pencils
+   with the periodic Gaussian exp(-(x - phi)^2 / 4 tau) per dimension
+------------------------------------------------------------------------- */
+
+void DiffractionNUFFT::spread(int nrecv, int itype)
+{
+  int i,d,m,ix,iy,iz,mx,my,mz;
+  int m0[3];
+  double dx,wyz;
+  double w[3][2*MAXSPREAD];
+
+  memset(grid,0,2*nbrick*sizeof(FFT_SCALAR));
+
+  const int nx = ngrid[0];
+  const int nyloc = nyhi - nylo + 1;
+  const int nw = 2*msp;
+
+  for (i = 0; i < nrecv; i++) {
+    const double *buf = &recvbuf[4*i];
+    if (static_cast<int> (buf[3]) != itype) continue;
+
+    for (d = 0; d < 3; d++) {
+      m0[d] = static_cast<int> (buf[d]/delgrid[d]);
+      double inv4tau = 0.25/tau[d];
+      for (m = 0; m < nw; m++) {
+        dx = (m0[d]-msp+1+m)*delgrid[d] - buf[d];
+        w[d][m] = exp(-dx*dx*inv4tau);
+      }
+    }
+
+    for (iz = 0; iz < nw; iz++) {
+      mz = (m0[2]-msp+1+iz + ngrid[2]) % ngrid[2];
+      if (mz < nzlo || mz > nzhi) continue;
+      for (iy = 0; iy < nw; iy++) {
+        my = (m0[1]-msp+1+iy + ngrid[1]) % ngrid[1];
+        if (my < nylo || my > nyhi) continue;
+        wyz = w[2][iz]*w[1][iy];
+        FFT_SCALAR *row = &grid[2*((mz-nzlo)*nyloc + (my-nylo))*nx];
+        mx = (m0[0]-msp+1 + nx) % nx;
+        for (ix = 0; ix < nw; ix++) {
+          row[2*mx] += wyz*w[0][ix];
+          if (++mx == nx) mx = 0;
+        }
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   smallest n >= nmin with no prime factors other than 2,3,5
+------------------------------------------------------------------------- */
+
+int DiffractionNUFFT::factorable(int nmin)
+{
+  for (int n = MAX(nmin,1); ; n++) {
+    int m = n;
+    while (m % 2 == 0) m /= 2;
+    while (m % 3 == 0) m /= 3;
+    while (m % 5 == 0) m /= 5;
+    if (m == 1) return n;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   map nprocs to NX by NY grid as PX by PY procs, same as PPPM
+------------------------------------------------------------------------- */
+
+void DiffractionNUFFT::procs2grid2d(int nprocs, int nx, int ny,
+                                    int *px, int *py)
+{
+  int bestsurf = 2 * (nx + ny);
+  int bestboxx = 0;
+  int bestboxy = 0;
+
+  int boxx,boxy,surf,ipx,ipy;
+
+  *px = 1;
+  *py = nprocs;
+
+  ipx = 1;
+  while (ipx <= nprocs) {
+    if (nprocs % ipx == 0) {
+      ipy = nprocs/ipx;
+      boxx = nx/ipx;
+      if (nx % ipx) boxx++;
+      boxy = ny/ipy;
+      if (ny % ipy) boxy++;
+      surf = boxx + boxy;
+      if (surf < bestsurf ||
+          (surf == bestsurf && boxx*boxy > bestboxx*bestboxy)) {
+        bestsurf = surf;
+        bestboxx = boxx;
+        bestboxy = boxy;
+        *px = ipx;
+        *py = ipy;
+      }
+    }
+    ipx++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of grid, buffers, and per-RELP arrays
+------------------------------------------------------------------------- */
+
+double DiffractionNUFFT::memory_usage()
+{
+  double bytes = 2.0 * nbrick * sizeof(FFT_SCALAR);
+  bytes += (double) (maxsend + maxrecv) * sizeof(double);
+  bytes += (double) nrelp * (2*sizeof(int) + sizeof(double));
+  bytes += 2.0 * ntypes_alloc * nrelp * sizeof(double);
+  bytes += (double) (ngrid[1] + ngrid[2] + 4*nprocs) * sizeof(int);
+  return bytes;
+}
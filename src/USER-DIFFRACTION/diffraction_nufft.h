@@ -0,0 +1,86 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_DIFFRACTION_NUFFT_H
+#define LMP_DIFFRACTION_NUFFT_H
+
+#include "pointers.h"
+
+#ifdef FFT_SINGLE
+typedef float FFT_SCALAR;
+#else
+typedef double FFT_SCALAR;
+#endif
+
+namespace LAMMPS_NS {
+
+// type-1 non-uniform FFT of per-type structure factors
+// S_t(h,k,l) = sum_j exp(2 pi i (h dK0 x_j + k dK1 y_j + l dK2 z_j))
+// via Gaussian gridding onto an oversampled, distributed FFT grid
+
+class DiffractionNUFFT : protected Pointers {
+ public:
+  DiffractionNUFFT(class LAMMPS *, int *, double *, double);
+  ~DiffractionNUFFT();
+  void setup(int, int *);
+  void compute(int, double *, int *, int);
+  double memory_usage();
+
+  int nrelp;                 // # of RELPs whose grid point is owned by me
+  int *relp;                 // row index of each owned RELP
+  double **sfac;             // per-type S_t (re,im) of each owned RELP
+
+  int msp;                   // spreading half-width in grid points
+  int ngrid[3];              // global FFT grid size
+
+ private:
+  int me,nprocs;
+  double dK[3];              // reciprocal lattice spacing
+  double tau[3];             // Gaussian spreading width per dimension
+  double delgrid[3];         // grid spacing in phase units (2 pi / ngrid)
+
+  int npey,npez;             // 2d proc grid for y,z pencils
+  int nylo,nyhi,nzlo,nzhi;   // my portion of the grid, full extent in x
+  int nbrick;                // # of complex grid points I own
+  int *yowner,*zowner;       // proc index in y,z owning each grid plane
+
+  FFT_SCALAR *grid;          // complex grid, x fastest
+  class FFT3d *fft;
+
+  int *relp_index;           // local grid index of each owned RELP
+  double *relp_scale;        // deconvolution factor of each owned RELP
+  int ntypes_alloc;
+
+  int maxsend,maxrecv;
+  double *sendbuf,*recvbuf;
+  int *sendcounts,*senddispls,*recvcounts,*recvdispls;
+
+  int factorable(int);
+  void procs2grid2d(int, int, int, int *, int *);
+  int route(int, double *, int *);
+  void spread(int, int);
+};
+
+}
+
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Diffraction nufft grid is too large
+
+The oversampled FFT grid needed to cover the requested reciprocal
+lattice has more points than fit in a 32-bit integer on one processor.
+Use coarser reciprocal spacing or more processors.
+
+*/
@@ -67,7 +67,7 @@ void AtomVecDPD::grow(int n)
   image = memory->grow(atom->image,nmax,"atom:image");
   x = memory->grow(atom->x,nmax,3,"atom:x");
   v = memory->grow(atom->v,nmax,3,"atom:v");
-  f = memory->grow(atom->f,nmax*comm->nthreads,3,"atom:f");
+  f = memory->grow(atom->f,nmax*comm->nthreads_force,3,"atom:f");
 
   rho = memory->grow(atom->rho, nmax, "atom:rho");
   dpdTheta = memory->grow(atom->dpdTheta, nmax, "atom:dpdTheta");
@@ -921,7 +921,7 @@ bigint AtomVecDPD::memory_usage()
   if (atom->memcheck("image")) bytes += memory->usage(image,nmax);
   if (atom->memcheck("x")) bytes += memory->usage(x,nmax,3);
   if (atom->memcheck("v")) bytes += memory->usage(v,nmax,3);
-  if (atom->memcheck("f")) bytes += memory->usage(f,nmax*comm->nthreads,3);
+  if (atom->memcheck("f")) bytes += memory->usage(f,nmax*comm->nthreads_force,3);
   if (atom->memcheck("rho")) bytes += memory->usage(rho,nmax);
   if (atom->memcheck("dpdTheta")) bytes += memory->usage(dpdTheta,nmax);
   if (atom->memcheck("uCond")) bytes += memory->usage(uCond,nmax);
@@ -28,8 +28,6 @@
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
-FixDrude *FixDrude::sptr = NULL;
-
 /* ---------------------------------------------------------------------- */
 
 FixDrude::FixDrude(LAMMPS *lmp, int narg, char **arg) :
@@ -106,12 +104,11 @@ int FixDrude::setmask()
 void FixDrude::build_drudeid(){
   int nlocal = atom->nlocal;
   int *type = atom->type;
+  tagint *tag = atom->tag;
 
-  std::vector<tagint> drude_vec; // list of my Drudes' tags
-  std::vector<tagint> core_drude_vec;
+  std::vector<tagint> core_drude_vec; // pairs of my atoms' bond partners
   partner_set = new std::set<tagint>[nlocal]; // Temporary sets of bond partner tags
 
-  sptr = this;
   if (atom->molecular == 1)
   {
     // Build list of my atoms' bond partners
@@ -119,7 +116,7 @@ void FixDrude::build_drudeid(){
       if (drudetype[type[i]] == NOPOL_TYPE) continue;
       drudeid[i] = 0;
       for (int k=0; k<atom->num_bond[i]; k++){
-        core_drude_vec.push_back(atom->tag[i]);
+        core_drude_vec.push_back(tag[i]);
         core_drude_vec.push_back(atom->bond_atom[i][k]);
       }
     }
@@ -135,93 +132,281 @@ void FixDrude::build_drudeid(){
       int imol = atom->molindex[i];
       int iatom = atom->molatom[i];
       tagint *batom = atommols[imol]->bond_atom[iatom];
-      tagint tagprev = atom->tag[i] - iatom - 1;
+      tagint tagprev = tag[i] - iatom - 1;
       int nbonds = atommols[imol]->num_bond[iatom];
 
       if (drudetype[type[i]] == NOPOL_TYPE) continue;
       drudeid[i] = 0;
       for (int k=0; k<nbonds; k++){
-        core_drude_vec.push_back(atom->tag[i]);
+        core_drude_vec.push_back(tag[i]);
         core_drude_vec.push_back(batom[k]+tagprev);
       }
     }
   }
-  // Loop on procs to fill my atoms' sets of bond partners
-  comm->ring(core_drude_vec.size(), sizeof(tagint),
-             (char *) core_drude_vec.data(),
-             4, ring_build_partner, NULL, 1);
 
-  // Build the list of my Drudes' tags
-  // The only bond partners of a Drude particle is its core,
+  // Fill my atoms' sets of bond partners.
+  // Each bond is stored by only one of its atoms, so the other atom
+  // is told about it, directly if I own it, else via its owning proc.
+  atom_owners();
+
+  std::vector<tagint> send_vec;
+  for (size_t k=0; k<core_drude_vec.size(); k+=2){
+    partner_set[atom->map(core_drude_vec[k])].insert(core_drude_vec[k+1]);
+    int j = atom->map(core_drude_vec[k+1]);
+    if (j >= 0 && j < nlocal)
+      partner_set[j].insert(core_drude_vec[k]);
+    else {
+      send_vec.push_back(core_drude_vec[k+1]);
+      send_vec.push_back(core_drude_vec[k]);
+    }
+  }
+
+  tagint *outbuf;
+  int nreturn = send_to_owners(send_vec.size()/2, send_vec.data(), 2,
+                               rendezvous_pairs, outbuf);
+  for (int m=0; m<nreturn; m++)
+    partner_set[atom->map(outbuf[2*m])].insert(outbuf[2*m+1]);
+  memory->sfree(outbuf);
+
+  // The only bond partner of a Drude particle is its core,
   // so fill drudeid for my Drudes.
+  // Then each of my Drudes tells its core about itself
+  // so that each core finds its Drude.
+  send_vec.clear();
   for (int i=0; i<nlocal; i++){
-    if (drudetype[type[i]] == DRUDE_TYPE){
-      drude_vec.push_back(atom->tag[i]);
-      drudeid[i] = *partner_set[i].begin(); // only one 1-2 neighbor, the core
+    if (drudetype[type[i]] != DRUDE_TYPE) continue;
+    drudeid[i] = *partner_set[i].begin(); // only one 1-2 neighbor, the core
+    int j = atom->map(drudeid[i]);
+    if (j >= 0 && j < nlocal) {
+      if (drudetype[type[j]] == CORE_TYPE && drudeid[j] == 0)
+        drudeid[j] = tag[i];
+    } else {
+      send_vec.push_back(drudeid[i]);
+      send_vec.push_back(tag[i]);
     }
   }
-  // At this point each of my Drudes knows its core.
-  // Send my list of Drudes to other procs and myself
-  // so that each core finds its Drude.
-  comm->ring(drude_vec.size(), sizeof(tagint),
-             (char *) drude_vec.data(),
-             3, ring_search_drudeid, NULL, 1);
+
+  nreturn = send_to_owners(send_vec.size()/2, send_vec.data(), 2,
+                           rendezvous_pairs, outbuf);
+  for (int m=0; m<nreturn; m++) {
+    int j = atom->map(outbuf[2*m]);
+    if (drudetype[type[j]] == CORE_TYPE && drudeid[j] == 0)
+      drudeid[j] = outbuf[2*m+1];
+  }
+  memory->sfree(outbuf);
+
+  delete procowner;
   delete [] partner_set;
 }
 
 /* ----------------------------------------------------------------------
- * when receive buffer, build the set of received Drude tags.
- * Look in my cores' bond partner tags if there is a Drude tag.
- * If so fill this core's dureid.
+ * setup owning proc of each atom ID in rendezvous decomposition.
+ * Each atom ID is sent to the proc it hashes to, which stores
+ * the owning proc of the atom in procowner.
 ------------------------------------------------------------------------- */
-void FixDrude::ring_search_drudeid(int size, char *cbuf){
-  // Search for the drude partner of my cores
-  Atom *atom = sptr->atom;
+void FixDrude::atom_owners(){
   int nlocal = atom->nlocal;
-  int *type = atom->type;
-  std::set<tagint> *partner_set = sptr->partner_set;
-  tagint *drudeid = sptr->drudeid;
-  int *drudetype = sptr->drudetype;
+  int nprocs = comm->nprocs;
+  tagint *tag = atom->tag;
 
-  tagint *first = (tagint *) cbuf;
-  tagint *last = first + size;
-  std::set<tagint> drude_set(first, last);
-  std::set<tagint>::iterator it;
+  int *proclist;
+  memory->create(proclist, nlocal, "fix_drude:proclist");
+  tagint *idbuf = (tagint *)
+    memory->smalloc((bigint) 2*nlocal*sizeof(tagint), "fix_drude:idbuf");
 
-  for (int i=0; i<nlocal; i++) {
-    if (drudetype[type[i]] != CORE_TYPE || drudeid[i] > 0) continue;
-    for (it = partner_set[i].begin(); it != partner_set[i].end(); it++) { // Drude-core are 1-2 neighbors
-      if (drude_set.count(*it) > 0){
-        drudeid[i] = *it;
-        break;
-      }
-    }
+  for (int i=0; i<nlocal; i++){
+    proclist[i] = tag[i] % nprocs;
+    idbuf[2*i] = tag[i];
+    idbuf[2*i+1] = comm->me;
   }
+
+  procowner = new std::map<tagint, int>();
+
+  char *buf;
+  comm->rendezvous(nlocal, proclist, (char *) idbuf, 2*sizeof(tagint),
+                   rendezvous_ids, buf, 0, (void *) this);
+
+  memory->destroy(proclist);
+  memory->sfree(idbuf);
+}
+
+/* ----------------------------------------------------------------------
+ * send N datums of nper tags each to the procs that own the atom
+ * whose tag is the first value of each datum, via rendezvous comm.
+ * outbuf = datums received by me, must be freed with memory->sfree().
+ * Return the number of datums received.
+------------------------------------------------------------------------- */
+int FixDrude::send_to_owners(int n, tagint *inbuf, int nper,
+                             int (*callback)(int, char *, int &, int *&,
+                                             char *&, void *),
+                             tagint *&outbuf){
+  int nprocs = comm->nprocs;
+  int *proclist;
+  memory->create(proclist, n, "fix_drude:proclist");
+  for (int i=0; i<n; i++)
+    proclist[i] = inbuf[i*nper] % nprocs;
+
+  char *buf;
+  int nreturn = comm->rendezvous(n, proclist, (char *) inbuf,
+                                 nper*sizeof(tagint), callback,
+                                 buf, nper*sizeof(tagint), (void *) this);
+  outbuf = (tagint *) buf;
+
+  memory->destroy(proclist);
+  return nreturn;
+}
+
+/* ----------------------------------------------------------------------
+ * look up the owning proc of the first tag of each datum in inbuf,
+ * set proclist and compress inbuf in place.
+ * Return the number of datums to send on.
+------------------------------------------------------------------------- */
+int FixDrude::owner_procs(int n, tagint *in, int nper, int *&proclist){
+  std::map<tagint, int>::iterator it;
+
+  memory->create(proclist, n, "fix_drude:proclist");
+
+  int nout = 0;
+  for (int i=0; i<n; i++) {
+    it = procowner->find(in[i*nper]);
+    if (it == procowner->end()) continue;
+    proclist[nout] = it->second;
+    if (nout < i)
+      memcpy(&in[nout*nper], &in[i*nper], nper*sizeof(tagint));
+    nout++;
+  }
+  return nout;
+}
+
+/* ----------------------------------------------------------------------
+ * callback from comm->rendezvous() in atom_owners().
+ * inbuf = list of (atom tag, owning proc), store them in procowner.
+------------------------------------------------------------------------- */
+int FixDrude::rendezvous_ids(int n, char *inbuf, int &flag, int *&proclist,
+                             char *&outbuf, void *ptr){
+  FixDrude *fdptr = (FixDrude *) ptr;
+  tagint *in = (tagint *) inbuf;
+
+  for (int i=0; i<n; i++)
+    (*fdptr->procowner)[in[2*i]] = (int) in[2*i+1];
+
+  flag = 0;
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
- * buffer contains bond partners. Look for my atoms and add their partner's
- * tag in its set of bond partners.
+ * callbacks from comm->rendezvous() in send_to_owners().
+ * Forward (atom tag, partner tag) pairs or (Drude tag, nspecial,
+ * special list) records to the owner of the first tag.
 ------------------------------------------------------------------------- */
-void FixDrude::ring_build_partner(int size, char *cbuf){
-  // Add partners from incoming list
-  Atom *atom = sptr->atom;
+int FixDrude::rendezvous_pairs(int n, char *inbuf, int &flag, int *&proclist,
+                               char *&outbuf, void *ptr){
+  FixDrude *fdptr = (FixDrude *) ptr;
+  int nout = fdptr->owner_procs(n, (tagint *) inbuf, 2, proclist);
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
+}
+
+int FixDrude::rendezvous_special(int n, char *inbuf, int &flag, int *&proclist,
+                                 char *&outbuf, void *ptr){
+  FixDrude *fdptr = (FixDrude *) ptr;
+  int nper = 4 + fdptr->atom->maxspecial;
+  int nout = fdptr->owner_procs(n, (tagint *) inbuf, nper, proclist);
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
+}
+
+/* ----------------------------------------------------------------------
+ * find the Drude status of the tags in query via rendezvous comm.
+ * Each proc sends the tags of its own cores (value = Drude tag) and
+ * Drudes (value = -1), as well as its queried tags, to the proc each
+ * tag hashes to. On return, query only contains the tags of cores and
+ * Drudes, with their value.
+------------------------------------------------------------------------- */
+void FixDrude::lookup_drudes(std::map<tagint, tagint> &query){
   int nlocal = atom->nlocal;
-  std::set<tagint> *partner_set = sptr->partner_set;
-  tagint *it = (tagint *) cbuf;
-  tagint *last = it + size;
+  int nprocs = comm->nprocs;
+  int *type = atom->type;
+  tagint *tag = atom->tag;
 
-  while (it < last) {
-    int j = atom->map(*it);
-    if (j >= 0 && j < nlocal)
-      partner_set[j].insert(*(it+1));
-    j = atom->map(*(it+1));
-    if (j >= 0 && j < nlocal)
-      partner_set[j].insert(*it);
-    it += 2;
+  int nsend = query.size();
+  for (int i=0; i<nlocal; i++)
+    if (drudetype[type[i]] != NOPOL_TYPE) nsend++;
+
+  int *proclist;
+  memory->create(proclist, nsend, "fix_drude:proclist");
+  LookupRvous *inbuf = (LookupRvous *)
+    memory->smalloc((bigint) nsend*sizeof(LookupRvous), "fix_drude:inbuf");
+
+  // proc = -1 flags the tag of a core or Drude, else it is the querying proc
+  nsend = 0;
+  for (int i=0; i<nlocal; i++) {
+    if (drudetype[type[i]] == NOPOL_TYPE) continue;
+    proclist[nsend] = tag[i] % nprocs;
+    inbuf[nsend].atomID = tag[i];
+    inbuf[nsend].value = (drudetype[type[i]] == DRUDE_TYPE) ? -1 : drudeid[i];
+    inbuf[nsend].proc = -1;
+    nsend++;
+  }
+  std::map<tagint, tagint>::iterator it;
+  for (it = query.begin(); it != query.end(); ++it) {
+    proclist[nsend] = it->first % nprocs;
+    inbuf[nsend].atomID = it->first;
+    inbuf[nsend].value = 0;
+    inbuf[nsend].proc = comm->me;
+    nsend++;
   }
+
+  char *buf;
+  int nreturn = comm->rendezvous(nsend, proclist, (char *) inbuf,
+                                 sizeof(LookupRvous), rendezvous_lookup,
+                                 buf, sizeof(LookupRvous), (void *) this);
+  LookupRvous *outbuf = (LookupRvous *) buf;
+
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+
+  query.clear();
+  for (int m=0; m<nreturn; m++)
+    query[outbuf[m].atomID] = outbuf[m].value;
+  memory->sfree(outbuf);
 }
 
+/* ----------------------------------------------------------------------
+ * callback from comm->rendezvous() in lookup_drudes().
+ * Build a map of core and Drude tags to their values, and return
+ * the value of each queried tag found in the map to the querying proc.
+------------------------------------------------------------------------- */
+int FixDrude::rendezvous_lookup(int n, char *inbuf, int &flag,
+                                int *&proclist, char *&outbuf, void *ptr){
+  FixDrude *fdptr = (FixDrude *) ptr;
+  Memory *memory = fdptr->memory;
+  LookupRvous *in = (LookupRvous *) inbuf;
+
+  std::map<tagint, tagint> drude_map;
+  for (int i=0; i<n; i++)
+    if (in[i].proc < 0) drude_map[in[i].atomID] = in[i].value;
+
+  memory->create(proclist, n, "fix_drude:proclist");
+
+  std::map<tagint, tagint>::iterator it;
+  int nout = 0;
+  for (int i=0; i<n; i++) {
+    if (in[i].proc < 0) continue;
+    it = drude_map.find(in[i].atomID);
+    if (it == drude_map.end()) continue;
+    proclist[nout] = in[i].proc;
+    in[nout] = in[i];
+    in[nout].value = it->second;
+    nout++;
+  }
+
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
+}
 
 /* ----------------------------------------------------------------------
    allocate atom-based array for drudeid
@@ -325,24 +510,20 @@ void FixDrude::rebuild_special(){
     if (logfile) fprintf(logfile, "Old max number of 1-2 to 1-4 neighbors: %d\n", nspecmax_old);
   }
 
-  // Build lists of drude and core-drude pairs
-  std::vector<tagint> drude_vec, core_drude_vec, core_special_vec;
+  // Find which tags in my atoms' special lists are Drudes or cores
+  // drude_map = tag -> -1 for Drudes, tag -> Drude tag for cores
+  std::map<tagint, tagint> drude_map;
   for (int i=0; i<nlocal; i++) {
-    if (drudetype[type[i]] == DRUDE_TYPE) {
-      drude_vec.push_back(atom->tag[i]);
-    } else if (drudetype[type[i]] == CORE_TYPE){
-      core_drude_vec.push_back(atom->tag[i]);
-      core_drude_vec.push_back(drudeid[i]);
-    }
+    if (drudetype[type[i]] == DRUDE_TYPE) continue;
+    for (int j=0; j<nspecial[i][2]; j++)
+      drude_map[special[i][j]] = 0;
   }
-  // Remove Drude particles from the special lists of each proc
-  comm->ring(drude_vec.size(), sizeof(tagint),
-             (char *) drude_vec.data(),
-             9, ring_remove_drude, NULL, 1);
+  lookup_drudes(drude_map);
+
+  // Remove Drude particles from the special lists of my atoms
+  remove_drude(drude_map);
   // Add back Drude particles in the lists just after their core
-  comm->ring(core_drude_vec.size(), sizeof(tagint),
-             (char *) core_drude_vec.data(),
-             10, ring_add_drude, NULL, 1);
+  add_drude(drude_map);
 
   // Check size of special list
   nspecmax_loc = 0;
@@ -360,42 +541,60 @@ void FixDrude::rebuild_special(){
     error->all(FLERR, str);
   }
 
-  // Build list of cores' special lists to communicate to ghost drude particles
+  // Copy cores' special lists into the lists of their Drude particles.
+  // Each record = Drude tag, nspecial of the core, special list of the
+  // core except its first entry, padded to maxspecial.
+  // Records for Drudes I do not own are sent to their owning proc.
+  int nper = 4 + atom->maxspecial;
+  std::vector<tagint> core_special_vec;
+  std::vector<tagint> record(nper);
+  atom_owners();
+
   for (int i=0; i<nlocal; i++) {
     if (drudetype[type[i]] != CORE_TYPE) continue;
-    core_special_vec.push_back(atom->tag[i]);
-    core_special_vec.push_back((tagint) nspecial[i][0]);
-    core_special_vec.push_back((tagint) nspecial[i][1]);
-    core_special_vec.push_back((tagint) nspecial[i][2]);
+    record[0] = drudeid[i];
+    record[1] = (tagint) nspecial[i][0];
+    record[2] = (tagint) nspecial[i][1];
+    record[3] = (tagint) nspecial[i][2];
     for (int j=1; j<nspecial[i][2]; j++)
-      core_special_vec.push_back(special[i][j]);
+      record[3+j] = special[i][j];
+    int k = atom->map(drudeid[i]);
+    if (k >= 0 && k < nlocal) copy_drude(k, atom->tag[i], &record[1]);
+    else core_special_vec.insert(core_special_vec.end(),
+                                 record.begin(), record.end());
+  }
+
+  tagint *outbuf;
+  int nreturn = send_to_owners(core_special_vec.size()/nper,
+                               core_special_vec.data(), nper,
+                               rendezvous_special, outbuf);
+  for (int m=0; m<nreturn; m++) {
+    tagint *rec = &outbuf[m*nper];
+    int k = atom->map(rec[0]);
+    copy_drude(k, drudeid[k], &rec[1]);
   }
-  // Copy core's list into their drude list
-  comm->ring(core_special_vec.size(), sizeof(tagint),
-             (char *) core_special_vec.data(),
-             11, ring_copy_drude, NULL, 1);
+  memory->sfree(outbuf);
+  delete procowner;
 }
 
 /* ----------------------------------------------------------------------
- * When receive buffer, build a set of drude tags, look into my atoms'
- * special list if some tags are drude particles. If so, remove it.
+ * drude_map = Drude status of the tags in my special lists.
+ * Look into my atoms' special list if some tags are drude particles.
+ * If so, remove it.
 ------------------------------------------------------------------------- */
-void FixDrude::ring_remove_drude(int size, char *cbuf){
+void FixDrude::remove_drude(std::map<tagint, tagint> &drude_map){
   // Remove all drude particles from special list
-  Atom *atom = sptr->atom;
   int nlocal = atom->nlocal;
   int **nspecial = atom->nspecial;
   tagint **special = atom->special;
   int *type = atom->type;
-  tagint *first = (tagint *) cbuf;
-  tagint *last = first + size;
-  std::set<tagint> drude_set(first, last);
-  int *drudetype = sptr->drudetype;
+  std::map<tagint, tagint>::iterator it;
 
   for (int i=0; i<nlocal; i++) {
     if (drudetype[type[i]] == DRUDE_TYPE) continue;
     for (int j=0; j<nspecial[i][2]; j++) {
-      if (drude_set.count(special[i][j]) > 0) { // I identify a drude in my special list, remove it
+      it = drude_map.find(special[i][j]);
+      if (it != drude_map.end() && it->second < 0) { // I identify a drude in my special list, remove it
         // left shift
         nspecial[i][2]--;
         for (int k=j; k<nspecial[i][2]; k++)
@@ -411,36 +610,22 @@ void FixDrude::ring_remove_drude(int size, char *cbuf){
 }
 
 /* ----------------------------------------------------------------------
- * When receive buffer, build a map core tag -> drude tag.
+ * drude_map = Drude status of the tags in my special lists.
  * Loop on my atoms' special list to find core tags. Insert their Drude
  * particle if they have one.
 ------------------------------------------------------------------------- */
-void FixDrude::ring_add_drude(int size, char *cbuf){
+void FixDrude::add_drude(std::map<tagint, tagint> &drude_map){
   // Assume special array size is big enough
   // Add all particle just after their core in the special list
-  Atom *atom = sptr->atom;
   int nlocal = atom->nlocal;
   int **nspecial = atom->nspecial;
   tagint **special = atom->special;
   int *type = atom->type;
-  tagint *drudeid = sptr->drudeid;
-  int *drudetype = sptr->drudetype;
-
-  tagint *first = (tagint *) cbuf;
-  tagint *last = first + size;
-  std::map<tagint, tagint> core_drude_map;
-
-  tagint *it = first;
-  while (it < last) {
-    tagint core_tag = *it;
-    it++;
-    core_drude_map[core_tag] = *it;
-    it++;
-  }
+  std::map<tagint, tagint>::iterator it;
 
   for (int i=0; i<nlocal; i++) {
     if (drudetype[type[i]] == DRUDE_TYPE) continue;
-    if (core_drude_map.count(atom->tag[i]) > 0) { // I identify myself as a core, add my own drude
+    if (drudetype[type[i]] == CORE_TYPE) { // I am a core, add my own drude
       // right shift
       for (int k=nspecial[i][2]-1; k>=0; k--)
         special[i][k+1] = special[i][k];
@@ -450,11 +635,12 @@ void FixDrude::ring_add_drude(int size, char *cbuf){
       nspecial[i][2]++;
     }
     for (int j=0; j<nspecial[i][2]; j++) {
-      if (core_drude_map.count(special[i][j]) > 0) { // I identify a core in my special list, add his drude
+      it = drude_map.find(special[i][j]);
+      if (it != drude_map.end() && it->second >= 0) { // I identify a core in my special list, add his drude
         // right shift
         for (int k=nspecial[i][2]-1; k>j; k--)
           special[i][k+1] = special[i][k];
-        special[i][j+1] = core_drude_map[special[i][j]];
+        special[i][j+1] = it->second;
         nspecial[i][2]++;
         if (j < nspecial[i][1]) {
           nspecial[i][1]++;
@@ -467,50 +653,19 @@ void FixDrude::ring_add_drude(int size, char *cbuf){
 }
 
 /* ----------------------------------------------------------------------
- * When receive buffer, build a map core tag -> pointer to special info
- * in the buffer. Loop on my Drude particles and copy their special
- * info from that of their core if the latter is found in the map.
+ * Copy special info of core into the special list of my Drude i.
+ * info = nspecial of the core, then its special list except itself.
 ------------------------------------------------------------------------- */
-void FixDrude::ring_copy_drude(int size, char *cbuf){
-  // Copy special list of drude from its core (except itself)
-  Atom *atom = sptr->atom;
-  int nlocal = atom->nlocal;
+void FixDrude::copy_drude(int i, tagint core, tagint *info){
   int **nspecial = atom->nspecial;
   tagint **special = atom->special;
-  int *type = atom->type;
-  tagint *drudeid = sptr->drudeid;
-  int *drudetype = sptr->drudetype;
-
-  tagint *first = (tagint *) cbuf;
-  tagint *last = first + size;
-  std::map<tagint, tagint*> core_special_map;
-
-  tagint *it = first;
-  while (it < last) {
-    tagint core_tag = *it;
-    it++;
-    core_special_map[core_tag] = it;
-    it += 2;
-    it += (int) *it;
-  }
 
-  for (int i=0; i<nlocal; i++) {
-    if (drudetype[type[i]] != DRUDE_TYPE) continue;
-    if (core_special_map.count(drudeid[i]) > 0) { // My core is in this list, copy its special info
-      it = core_special_map[drudeid[i]];
-      nspecial[i][0] = (int) *it;
-      it++;
-      nspecial[i][1] = (int) *it;
-      it++;
-      nspecial[i][2] = (int) *it;
-      it++;
-      special[i][0] = drudeid[i];
-      for (int k=1; k<nspecial[i][2]; k++) {
-        special[i][k] = *it;
-        it++;
-      }
-    }
-  }
+  nspecial[i][0] = (int) info[0];
+  nspecial[i][1] = (int) info[1];
+  nspecial[i][2] = (int) info[2];
+  special[i][0] = core;
+  for (int k=1; k<nspecial[i][2]; k++)
+    special[i][k] = info[2+k];
 }
 
 /* ----------------------------------------------------------------------
@@ -22,6 +22,7 @@ FixStyle(drude,FixDrude)
 
 #include "fix.h"
 #include <set>
+#include <map>
 
 #define NOPOL_TYPE 0
 #define CORE_TYPE  1
@@ -50,16 +51,32 @@ class FixDrude : public Fix {
 
 private:
   int rebuildflag;
-  static FixDrude *sptr;
   std::set<tagint> * partner_set;
+  std::map<tagint, int> * procowner; // owning proc of each atom tag
+
+  struct LookupRvous {
+    tagint atomID, value;
+    int proc;
+  };
 
   void build_drudeid();
-  static void ring_search_drudeid(int size, char *cbuf);
-  static void ring_build_partner(int size, char *cbuf);
   void rebuild_special();
-  static void ring_remove_drude(int size, char *cbuf);
-  static void ring_add_drude(int size, char *cbuf);
-  static void ring_copy_drude(int size, char *cbuf);
+  void remove_drude(std::map<tagint, tagint> &);
+  void add_drude(std::map<tagint, tagint> &);
+  void copy_drude(int, tagint, tagint *);
+
+  void atom_owners();
+  int send_to_owners(int, tagint *, int,
+                     int (*)(int, char *, int &, int *&, char *&, void *),
+                     tagint *&);
+  int owner_procs(int, tagint *, int, int *&);
+  void lookup_drudes(std::map<tagint, tagint> &);
+
+  // callback functions for rendezvous communication
+  static int rendezvous_ids(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_pairs(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_special(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_lookup(int, char *, int &, int *&, char *&, void *);
 };
 
 }
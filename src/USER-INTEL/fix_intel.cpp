@@ -220,6 +220,7 @@ FixIntel::FixIntel(LAMMPS *lmp, int narg, char **arg) :  Fix(lmp, narg, arg)
     nthreads = omp_get_num_threads();
     comm->nthreads = nthreads;
   }
+  comm->nthreads_force = comm->nthreads;
   #endif
 
   // set offload params
@@ -36,6 +36,8 @@ PairLJCutIntel::PairLJCutIntel(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::INTEL;
   respa_enable = 0;
+  mixed_enable = 0;
+  overlap_enable = 0;
   cut_respa = NULL;
 }
 
@@ -99,6 +99,10 @@ DumpNetCDFMPIIO::DumpNetCDFMPIIO(LAMMPS *lmp, int narg, char **arg) :
   binary = 1;
   flush_flag = 0;
 
+  // NetCDF files are written by write() of this class, never asynchronously
+
+  async_allow = 0;
+
   if (multiproc)
     error->all(FLERR,"Multi-processor writes are not supported.");
   if (multifile)
@@ -28,6 +28,8 @@
 
 #include "suffix.h"
 using namespace LAMMPS_NS;
+
+#define OWNED(i) (((i) >= afrom) && ((i) < ato))
 using namespace MathConst;
 
 #define SMALL 0.001
@@ -38,6 +40,7 @@ using namespace MathConst;
   : AngleCharmm(lmp), ThrOMP(lmp,THR_ANGLE)
 {
   suffix_flag |= Suffix::OMP;
+  owner_enable = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -53,6 +56,11 @@ void AngleCharmmOMP::compute(int eflag, int vflag)
   const int nthreads = comm->nthreads;
   const int inum = neighbor->nanglelist;
 
+  // package omp force owner: sort the list by the threads owning its atoms
+
+  if (inum > 0 && fix->get_owner())
+    owner_setup_thr(neighbor->anglelist[0],inum,4,3,nall,nthreads);
+
 #if defined(_OPENMP)
 #pragma omp parallel default(none) shared(eflag,vflag)
 #endif
@@ -64,7 +72,21 @@ void AngleCharmmOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, thr);
 
-    if (inum > 0) {
+    if (inum > 0 && fix->get_owner()) {
+      loop_setup_thr(ifrom, ito, tid, nall, nthreads);
+      if (evflag) {
+        if (eflag) {
+          if (force->newton_bond) eval_owner<1,1,1>(ifrom, ito, thr);
+          else eval_owner<1,1,0>(ifrom, ito, thr);
+        } else {
+          if (force->newton_bond) eval_owner<1,0,1>(ifrom, ito, thr);
+          else eval_owner<1,0,0>(ifrom, ito, thr);
+        }
+      } else {
+        if (force->newton_bond) eval_owner<0,0,1>(ifrom, ito, thr);
+        else eval_owner<0,0,0>(ifrom, ito, thr);
+      }
+    } else if (inum > 0) {
       if (evflag) {
         if (eflag) {
           if (force->newton_bond) eval<1,1,1>(ifrom, ito, thr);
@@ -198,3 +220,131 @@ void AngleCharmmOMP::eval(int nfrom, int nto, ThrData * const thr)
                              delx1,dely1,delz1,delx2,dely2,delz2,thr);
   }
 }
+
+/* ----------------------------------------------------------------------
+   package omp force owner: every thread visits only the entries of its
+   sublist from owner_setup_thr() and applies forces only to atoms in its
+   own range [afrom,ato) of local+ghost atoms.
+   energy and virial are tallied by the thread that owns atom I1.
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int NEWTON_BOND>
+void AngleCharmmOMP::eval_owner(int afrom, int ato, ThrData * const thr)
+{
+  int i1,i2,i3,n,nn,type;
+  double delx1,dely1,delz1,delx2,dely2,delz2;
+  double eangle,f1[3],f3[3];
+  double dtheta,tk;
+  double rsq1,rsq2,r1,r2,c,s,a,a11,a12,a22;
+  double delxUB,delyUB,delzUB,rsqUB,rUB,dr,rk,forceUB;
+
+  const dbl3_t * _noalias const x = (dbl3_t *) atom->x[0];
+  dbl3_t * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int4_t * _noalias const anglelist = (int4_t *) neighbor->anglelist[0];
+  const int nlocal = atom->nlocal;
+  const int tid = thr->get_tid();
+  const int * const olist = owner_list + owner_first[tid];
+  const int nlist = owner_first[tid+1] - owner_first[tid];
+  eangle = 0.0;
+
+  for (nn = 0; nn < nlist; nn++) {
+    n = olist[nn];
+    i1 = anglelist[n].a;
+    i2 = anglelist[n].b;
+    i3 = anglelist[n].c;
+    type = anglelist[n].t;
+
+    // 1st bond
+
+    delx1 = x[i1].x - x[i2].x;
+    dely1 = x[i1].y - x[i2].y;
+    delz1 = x[i1].z - x[i2].z;
+
+    rsq1 = delx1*delx1 + dely1*dely1 + delz1*delz1;
+    r1 = sqrt(rsq1);
+
+    // 2nd bond
+
+    delx2 = x[i3].x - x[i2].x;
+    dely2 = x[i3].y - x[i2].y;
+    delz2 = x[i3].z - x[i2].z;
+
+    rsq2 = delx2*delx2 + dely2*dely2 + delz2*delz2;
+    r2 = sqrt(rsq2);
+
+    // Urey-Bradley bond
+
+    delxUB = x[i3].x - x[i1].x;
+    delyUB = x[i3].y - x[i1].y;
+    delzUB = x[i3].z - x[i1].z;
+
+    rsqUB = delxUB*delxUB + delyUB*delyUB + delzUB*delzUB;
+    rUB = sqrt(rsqUB);
+
+    // Urey-Bradley force & energy
+
+    dr = rUB - r_ub[type];
+    rk = k_ub[type] * dr;
+
+    if (rUB > 0.0) forceUB = -2.0*rk/rUB;
+    else forceUB = 0.0;
+
+    if (EFLAG) eangle = rk*dr;
+
+    // angle (cos and sin)
+
+    c = delx1*delx2 + dely1*dely2 + delz1*delz2;
+    c /= r1*r2;
+
+    if (c > 1.0) c = 1.0;
+    if (c < -1.0) c = -1.0;
+
+    s = sqrt(1.0 - c*c);
+    if (s < SMALL) s = SMALL;
+    s = 1.0/s;
+
+    // harmonic force & energy
+
+    dtheta = acos(c) - theta0[type];
+    tk = k[type] * dtheta;
+
+    if (EFLAG) eangle += tk*dtheta;
+
+    a = -2.0 * tk * s;
+    a11 = a*c / rsq1;
+    a12 = -a / (r1*r2);
+    a22 = a*c / rsq2;
+
+    f1[0] = a11*delx1 + a12*delx2 - delxUB*forceUB;
+    f1[1] = a11*dely1 + a12*dely2 - delyUB*forceUB;
+    f1[2] = a11*delz1 + a12*delz2 - delzUB*forceUB;
+
+    f3[0] = a22*delx2 + a12*delx1 + delxUB*forceUB;
+    f3[1] = a22*dely2 + a12*dely1 + delyUB*forceUB;
+    f3[2] = a22*delz2 + a12*delz1 + delzUB*forceUB;
+
+    // apply force to each of 3 atoms
+
+    if ((NEWTON_BOND || i1 < nlocal) && OWNED(i1)) {
+      f[i1].x += f1[0];
+      f[i1].y += f1[1];
+      f[i1].z += f1[2];
+    }
+
+    if ((NEWTON_BOND || i2 < nlocal) && OWNED(i2)) {
+      f[i2].x -= f1[0] + f3[0];
+      f[i2].y -= f1[1] + f3[1];
+      f[i2].z -= f1[2] + f3[2];
+    }
+
+    if ((NEWTON_BOND || i3 < nlocal) && OWNED(i3)) {
+      f[i3].x += f3[0];
+      f[i3].y += f3[1];
+      f[i3].z += f3[2];
+    }
+
+    if (EVFLAG && OWNED(i1))
+      ev_tally_thr(this,i1,i2,i3,nlocal,NEWTON_BOND,eangle,f1,f3,
+                   delx1,dely1,delz1,delx2,dely2,delz2,thr);
+  }
+}
@@ -27,12 +27,15 @@
 #include "suffix.h"
 using namespace LAMMPS_NS;
 
+#define OWNED(i) (((i) >= afrom) && ((i) < ato))
+
 /* ---------------------------------------------------------------------- */
 
 BondHarmonicOMP::BondHarmonicOMP(class LAMMPS *lmp)
   : BondHarmonic(lmp), ThrOMP(lmp,THR_BOND)
 {
   suffix_flag |= Suffix::OMP;
+  owner_enable = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -48,6 +51,11 @@ void BondHarmonicOMP::compute(int eflag, int vflag)
   const int nthreads = comm->nthreads;
   const int inum = neighbor->nbondlist;
 
+  // package omp force owner: sort the list by the threads owning its atoms
+
+  if (inum > 0 && fix->get_owner())
+    owner_setup_thr(neighbor->bondlist[0],inum,3,2,nall,nthreads);
+
 #if defined(_OPENMP)
 #pragma omp parallel default(none) shared(eflag,vflag)
 #endif
@@ -59,7 +67,21 @@ void BondHarmonicOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, thr);
 
-    if (inum > 0) {
+    if (inum > 0 && fix->get_owner()) {
+      loop_setup_thr(ifrom, ito, tid, nall, nthreads);
+      if (evflag) {
+        if (eflag) {
+          if (force->newton_bond) eval_owner<1,1,1>(ifrom, ito, thr);
+          else eval_owner<1,1,0>(ifrom, ito, thr);
+        } else {
+          if (force->newton_bond) eval_owner<1,0,1>(ifrom, ito, thr);
+          else eval_owner<1,0,0>(ifrom, ito, thr);
+        }
+      } else {
+        if (force->newton_bond) eval_owner<0,0,1>(ifrom, ito, thr);
+        else eval_owner<0,0,0>(ifrom, ito, thr);
+      }
+    } else if (inum > 0) {
       if (evflag) {
         if (eflag) {
           if (force->newton_bond) eval<1,1,1>(ifrom, ito, thr);
@@ -130,3 +152,68 @@ void BondHarmonicOMP::eval(int nfrom, int nto, ThrData * const thr)
                              ebond,fbond,delx,dely,delz,thr);
   }
 }
+
+/* ----------------------------------------------------------------------
+   package omp force owner: every thread visits only the entries of its
+   sublist from owner_setup_thr() and applies forces only to atoms in its
+   own range [afrom,ato) of local+ghost atoms.
+   energy and virial are tallied by the thread that owns atom I1.
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int NEWTON_BOND>
+void BondHarmonicOMP::eval_owner(int afrom, int ato, ThrData * const thr)
+{
+  int i1,i2,n,nn,type;
+  double delx,dely,delz,ebond,fbond;
+  double rsq,r,dr,rk;
+
+  const dbl3_t * _noalias const x = (dbl3_t *) atom->x[0];
+  dbl3_t * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int3_t * _noalias const bondlist = (int3_t *) neighbor->bondlist[0];
+  const int nlocal = atom->nlocal;
+  const int tid = thr->get_tid();
+  const int * const olist = owner_list + owner_first[tid];
+  const int nlist = owner_first[tid+1] - owner_first[tid];
+  ebond = 0.0;
+
+  for (nn = 0; nn < nlist; nn++) {
+    n = olist[nn];
+    i1 = bondlist[n].a;
+    i2 = bondlist[n].b;
+    type = bondlist[n].t;
+
+    delx = x[i1].x - x[i2].x;
+    dely = x[i1].y - x[i2].y;
+    delz = x[i1].z - x[i2].z;
+
+    rsq = delx*delx + dely*dely + delz*delz;
+    r = sqrt(rsq);
+    dr = r - r0[type];
+    rk = k[type] * dr;
+
+    // force & energy
+
+    if (r > 0.0) fbond = -2.0*rk/r;
+    else fbond = 0.0;
+
+    if (EFLAG) ebond = rk*dr;
+
+    // apply force to each of 2 atoms
+
+    if ((NEWTON_BOND || i1 < nlocal) && OWNED(i1)) {
+      f[i1].x += delx*fbond;
+      f[i1].y += dely*fbond;
+      f[i1].z += delz*fbond;
+    }
+
+    if ((NEWTON_BOND || i2 < nlocal) && OWNED(i2)) {
+      f[i2].x -= delx*fbond;
+      f[i2].y -= dely*fbond;
+      f[i2].z -= delz*fbond;
+    }
+
+    if (EVFLAG && OWNED(i1))
+      ev_tally_thr(this,i1,i2,nlocal,NEWTON_BOND,
+                   ebond,fbond,delx,dely,delz,thr);
+  }
+}
@@ -38,6 +38,8 @@ class DihedralCharmmOMP : public DihedralCharmm, public ThrOMP {
  private:
   template <int EVFLAG, int EFLAG, int NEWTON_BOND>
   void eval(int ifrom, int ito, ThrData * const thr);
+  template <int EVFLAG, int EFLAG, int NEWTON_BOND>
+  void eval_owner(int afrom, int ato, ThrData * const thr);
 };
 
 }
@@ -62,7 +62,8 @@ static int get_tid()
 FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
   :  Fix(lmp, narg, arg),
      thr(NULL), last_omp_style(NULL), last_pair_hybrid(NULL),
-     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true)
+     _nthr(-1), _neighbor(true), _mixed(false), _reduced(true),
+     _owner(false)
 {
   if (narg < 4) error->all(FLERR,"Illegal package omp command");
 
@@ -99,25 +100,39 @@ FixOMP::FixOMP(LAMMPS *lmp, int narg, char **arg)
       else if (strcmp(arg[iarg+1],"no") == 0) _neighbor = false;
       else error->all(FLERR,"Illegal package omp command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"force") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal package omp command");
+      if (strcmp(arg[iarg+1],"private") == 0) _owner = false;
+      else if (strcmp(arg[iarg+1],"owner") == 0) _owner = true;
+      else error->all(FLERR,"Illegal package omp command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal package omp command");
   }
 
+  // with owner computes, all threads update the one shared force array
+  // so per-atom force arrays need no per-thread copies
+
+  comm->nthreads_force = _owner ? 1 : nthreads;
+
   // print summary of settings
 
   if (comm->me == 0) {
 #if defined(_OPENMP)
     const char * const nmode = _neighbor ? "multi-threaded" : "serial";
+    const char * const fmode = _owner ? "owner computes" : "per-thread";
 
     if (screen) {
       if (reset_thr)
 	fprintf(screen,"set %d OpenMP thread(s) per MPI task\n", nthreads);
       fprintf(screen,"using %s neighbor list subroutines\n", nmode);
+      fprintf(screen,"using %s force accumulation\n", fmode);
     }
 
     if (logfile) {
       if (reset_thr)
 	fprintf(logfile,"set %d OpenMP thread(s) per MPI task\n", nthreads);
       fprintf(logfile,"using %s neighbor list subroutines\n", nmode);
+      fprintf(logfile,"using %s force accumulation\n", fmode);
     }
 #else
     error->warning(FLERR,"OpenMP support not enabled during compilation; "
@@ -278,6 +293,41 @@ void FixOMP::init()
 
 #undef CheckStyleForOMP
 #undef CheckHybridForOMP
+
+  // with owner computes, every threaded force style must only update
+  // atoms owned by the thread, since there is no force reduction
+
+  if (_owner) {
+    if (strstr(update->integrate_style,"respa") != NULL)
+      error->all(FLERR,"Package omp force owner does not support "
+                 "run_style respa");
+
+#define CheckOwnerForOMP(name)                                          \
+    if (force->name) {                                                  \
+      if (strstr(force->name ## _style,"hybrid") != NULL)               \
+        error->all(FLERR,"Package omp force owner does not support "    \
+                   "hybrid styles");                                    \
+      if (force->name->suffix_flag & Suffix::OMP) {                     \
+        ThrOMP *style = dynamic_cast<ThrOMP *>(force->name);            \
+        if (!style || !style->owner_enable) {                           \
+          char str[128];                                                \
+          sprintf(str,"Package omp force owner is not supported by "    \
+                  #name " style %s",force->name ## _style);             \
+          error->all(FLERR,str);                                        \
+        }                                                               \
+      }                                                                 \
+    }
+
+    CheckOwnerForOMP(pair);
+    CheckOwnerForOMP(bond);
+    CheckOwnerForOMP(angle);
+    CheckOwnerForOMP(dihedral);
+    CheckOwnerForOMP(improper);
+    CheckOwnerForOMP(kspace);
+
+#undef CheckOwnerForOMP
+  }
+
   set_neighbor_omp();
 
   // diagnostic output
@@ -344,6 +394,24 @@ void FixOMP::pre_force(int)
   double *de = atom->de;
   double *drho = atom->drho;
 
+  // with owner computes, threads write directly into the shared arrays.
+  // each thread clears its own block of atoms and nothing is reduced.
+
+  if (_owner) {
+#if defined(_OPENMP)
+#pragma omp parallel default(none) shared(f,torque,erforce,de,drho)
+#endif
+    {
+      int ifrom, ito, tid;
+      loop_setup_thr(ifrom, ito, tid, nall, comm->nthreads);
+      thr[tid]->check_tid(tid);
+      thr[tid]->init_force_shared(ifrom,ito,f,torque,erforce,de,drho);
+    } // end of omp parallel region
+
+    _reduced = true;
+    return;
+  }
+
 #if defined(_OPENMP)
 #pragma omp parallel default(none) shared(f,torque,erforce,de,drho)
 #endif
@@ -64,12 +64,14 @@ class FixOMP : public Fix {
   bool get_neighbor() const { return _neighbor; }
   bool get_mixed()    const { return _mixed;    }
   bool get_reduced()  const { return _reduced;  }
+  bool get_owner()    const { return _owner;    }
 
  private:
   int  _nthr;       // number of currently active ThrData objects
   bool _neighbor;   // en/disable threads for neighbor list construction
   bool _mixed;      // whether to prefer mixed precision compute kernels
   bool _reduced;    // whether forces have been reduced for this step
+  bool _owner;      // threads update only their own atoms in shared arrays
 
   void set_neighbor_omp();
 };
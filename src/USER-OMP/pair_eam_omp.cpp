@@ -22,6 +22,7 @@
 #include "memory.h"
 #include "neighbor.h"
 #include "neigh_list.h"
+#include "neigh_request.h"
 
 #include "suffix.h"
 using namespace LAMMPS_NS;
@@ -33,6 +34,7 @@ PairEAMOMP::PairEAMOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  owner_enable = 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -49,12 +51,14 @@ void PairEAMOMP::compute(int eflag, int vflag)
 
   // grow energy and fp arrays if necessary
   // need to be atom->nmax in length
+  // rho has per-thread copies unless threads own their atoms
 
   if (atom->nmax > nmax) {
     memory->destroy(rho);
     memory->destroy(fp);
     nmax = atom->nmax;
-    memory->create(rho,nthreads*nmax,"pair:rho");
+    if (fix->get_owner()) memory->create(rho,nmax,"pair:rho");
+    else memory->create(rho,nthreads*nmax,"pair:rho");
     memory->create(fp,nmax,"pair:fp");
   }
 
@@ -69,22 +73,29 @@ void PairEAMOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, thr);
 
-    if (force->newton_pair)
-      thr->init_eam(nall, rho);
-    else
-      thr->init_eam(atom->nlocal, rho);
-
-    if (evflag) {
-      if (eflag) {
-        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
-        else eval<1,1,0>(ifrom, ito, thr);
+    if (fix->get_owner()) {
+      if (evflag) {
+        if (eflag) eval_owner<1,1>(ifrom, ito, thr);
+        else eval_owner<1,0>(ifrom, ito, thr);
+      } else eval_owner<0,0>(ifrom, ito, thr);
+    } else {
+      if (force->newton_pair)
+        thr->init_eam(nall, rho);
+      else
+        thr->init_eam(atom->nlocal, rho);
+
+      if (evflag) {
+        if (eflag) {
+          if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
+          else eval<1,1,0>(ifrom, ito, thr);
+        } else {
+          if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
+          else eval<1,0,0>(ifrom, ito, thr);
+        }
       } else {
-        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
-        else eval<1,0,0>(ifrom, ito, thr);
+        if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
+        else eval<0,0,0>(ifrom, ito, thr);
       }
-    } else {
-      if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
-      else eval<0,0,0>(ifrom, ito, thr);
     }
 
     thr->timer(Timer::PAIR);
@@ -297,6 +308,186 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
   }
 }
 
+/* ----------------------------------------------------------------------
+   package omp force owner: full neighbor list, update only atom I
+   rho is summed directly into the shared array, no reverse comm needed
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG>
+void PairEAMOMP::eval_owner(int iifrom, int iito, ThrData * const thr)
+{
+  int i,j,ii,jj,m,jnum,itype,jtype;
+  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
+  double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi,rhotmp;
+  double *coeff;
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  evdwl = 0.0;
+
+  const dbl3_t * _noalias const x = (dbl3_t *) atom->x[0];
+  dbl3_t * _noalias const f = (dbl3_t *) thr->get_f()[0];
+
+  const int * _noalias const type = atom->type;
+  const int nlocal = atom->nlocal;
+
+  double fxtmp,fytmp,fztmp;
+
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // rho = density at each atom
+  // loop over all neighbors of my atoms
+
+  for (ii = iifrom; ii < iito; ii++) {
+    i = ilist[ii];
+    xtmp = x[i].x;
+    ytmp = x[i].y;
+    ztmp = x[i].z;
+    itype = type[i];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    rhotmp = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j].x;
+      dely = ytmp - x[j].y;
+      delz = ztmp - x[j].z;
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutforcesq) {
+        jtype = type[j];
+        p = sqrt(rsq)*rdr + 1.0;
+        m = static_cast<int> (p);
+        m = MIN(m,nr-1);
+        p -= m;
+        p = MIN(p,1.0);
+        coeff = rhor_spline[type2rhor[jtype][itype]][m];
+        rhotmp += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+      }
+    }
+    rho[i] = rhotmp;
+  }
+
+  // fp = derivative of embedding energy at each atom
+  // phi = embedding energy at each atom
+  // if rho > rhomax (e.g. due to close approach of two atoms),
+  //   will exceed table, so add linear term to conserve energy
+
+  for (ii = iifrom; ii < iito; ii++) {
+    i = ilist[ii];
+    p = rho[i]*rdrho + 1.0;
+    m = static_cast<int> (p);
+    m = MAX(1,MIN(m,nrho-1));
+    p -= m;
+    p = MIN(p,1.0);
+    coeff = frho_spline[type2frho[type[i]]][m];
+    fp[i] = (coeff[0]*p + coeff[1])*p + coeff[2];
+    if (EFLAG) {
+      phi = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+      if (rho[i] > rhomax) phi += fp[i] * (rho[i]-rhomax);
+      e_tally_thr(this, i, i, nlocal, 1, scale[type[i]][type[i]]*phi, 0.0, thr);
+    }
+  }
+
+  // wait until all theads are done with computation
+  sync_threads();
+
+  // communicate derivative of embedding function
+  // MPI communication only on master thread
+#if defined(_OPENMP)
+#pragma omp master
+#endif
+  { comm->forward_comm_pair(this); }
+
+  // wait until master thread is done with communication
+  sync_threads();
+
+  // compute forces on each atom
+  // loop over all neighbors of my atoms
+
+  for (ii = iifrom; ii < iito; ii++) {
+    i = ilist[ii];
+    xtmp = x[i].x;
+    ytmp = x[i].y;
+    ztmp = x[i].z;
+    itype = type[i];
+    fxtmp = fytmp = fztmp = 0.0;
+    const double * _noalias const scale_i = scale[itype];
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j].x;
+      dely = ytmp - x[j].y;
+      delz = ztmp - x[j].z;
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutforcesq) {
+        jtype = type[j];
+        r = sqrt(rsq);
+        p = r*rdr + 1.0;
+        m = static_cast<int> (p);
+        m = MIN(m,nr-1);
+        p -= m;
+        p = MIN(p,1.0);
+
+        // see eval() for the meaning of these terms
+
+        coeff = rhor_spline[type2rhor[itype][jtype]][m];
+        rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+        coeff = rhor_spline[type2rhor[jtype][itype]][m];
+        rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+        coeff = z2r_spline[type2z2r[itype][jtype]][m];
+        z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+        z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+        recip = 1.0/r;
+        phi = z2*recip;
+        phip = z2p*recip - phi*recip;
+        psip = fp[i]*rhojp + fp[j]*rhoip + phip;
+        fpair = -scale_i[jtype]*psip*recip;
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+
+        if (EFLAG) evdwl = scale_i[jtype]*phi;
+        if (EVFLAG) ev_tally_xyz_full_thr(this,i,evdwl,0.0,delx*fpair,
+                                          dely*fpair,delz*fpair,
+                                          delx,dely,delz,thr);
+      }
+    }
+    f[i].x += fxtmp;
+    f[i].y += fytmp;
+    f[i].z += fztmp;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   package omp force owner needs a full neighbor list
+   and an explicitly tallied virial, since ghost atoms get no forces
+------------------------------------------------------------------------- */
+
+void PairEAMOMP::init_style()
+{
+  PairEAM::init_style();
+
+  if (fix->get_owner()) {
+    const int irequest = neighbor->nrequest - 1;
+    neighbor->requests[irequest]->half = 0;
+    neighbor->requests[irequest]->full = 1;
+    no_virial_fdotr_compute = 1;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 double PairEAMOMP::memory_usage()
@@ -35,11 +35,14 @@ class PairEAMOMP : public PairEAM, public ThrOMP {
   PairEAMOMP(class LAMMPS *);
 
   virtual void compute(int, int);
+  virtual void init_style();
   virtual double memory_usage();
 
  private:
   template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
   void eval(int iifrom, int iito, ThrData * const thr);
+  template <int EVFLAG, int EFLAG>
+  void eval_owner(int iifrom, int iito, ThrData * const thr);
 };
 
 }
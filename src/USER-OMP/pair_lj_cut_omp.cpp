@@ -19,6 +19,7 @@
 #include "force.h"
 #include "neighbor.h"
 #include "neigh_list.h"
+#include "neigh_request.h"
 
 #include "suffix.h"
 using namespace LAMMPS_NS;
@@ -30,6 +31,8 @@ PairLJCutOMP::PairLJCutOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  mixed_enable = 0;
+  owner_enable = 1;
   cut_respa = NULL;
 }
 
@@ -56,7 +59,12 @@ void PairLJCutOMP::compute(int eflag, int vflag)
     thr->timer(Timer::START);
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, thr);
 
-    if (evflag) {
+    if (fix->get_owner()) {
+      if (evflag) {
+        if (eflag) eval_owner<1,1>(ifrom, ito, thr);
+        else eval_owner<1,0>(ifrom, ito, thr);
+      } else eval_owner<0,0>(ifrom, ito, thr);
+    } else if (evflag) {
       if (eflag) {
         if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
         else eval<1,1,0>(ifrom, ito, thr);
@@ -152,6 +160,101 @@ void PairLJCutOMP::eval(int iifrom, int iito, ThrData * const thr)
   }
 }
 
+/* ----------------------------------------------------------------------
+   package omp force owner: full neighbor list, update only atom I
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG>
+void PairLJCutOMP::eval_owner(int iifrom, int iito, ThrData * const thr)
+{
+  const dbl3_t * _noalias const x = (dbl3_t *) atom->x[0];
+  dbl3_t * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int * _noalias const type = atom->type;
+  const double * _noalias const special_lj = force->special_lj;
+  const int * _noalias const ilist = list->ilist;
+  const int * _noalias const numneigh = list->numneigh;
+  const int * const * const firstneigh = list->firstneigh;
+
+  double xtmp,ytmp,ztmp,delx,dely,delz,fxtmp,fytmp,fztmp;
+  double rsq,r2inv,r6inv,forcelj,factor_lj,evdwl,fpair;
+
+  int j,jj,jnum,jtype;
+
+  evdwl = 0.0;
+
+  // loop over all neighbors of my atoms
+
+  for (int ii = iifrom; ii < iito; ++ii) {
+    const int i = ilist[ii];
+    const int itype = type[i];
+    const int    * _noalias const jlist = firstneigh[i];
+    const double * _noalias const cutsqi = cutsq[itype];
+    const double * _noalias const offseti = offset[itype];
+    const double * _noalias const lj1i = lj1[itype];
+    const double * _noalias const lj2i = lj2[itype];
+    const double * _noalias const lj3i = lj3[itype];
+    const double * _noalias const lj4i = lj4[itype];
+
+    xtmp = x[i].x;
+    ytmp = x[i].y;
+    ztmp = x[i].z;
+    jnum = numneigh[i];
+    fxtmp=fytmp=fztmp=0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j].x;
+      dely = ytmp - x[j].y;
+      delz = ztmp - x[j].z;
+      rsq = delx*delx + dely*dely + delz*delz;
+      jtype = type[j];
+
+      if (rsq < cutsqi[jtype]) {
+        r2inv = 1.0/rsq;
+        r6inv = r2inv*r2inv*r2inv;
+        forcelj = r6inv * (lj1i[jtype]*r6inv - lj2i[jtype]);
+        fpair = factor_lj*forcelj*r2inv;
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+
+        if (EFLAG) {
+          evdwl = r6inv*(lj3i[jtype]*r6inv-lj4i[jtype]) - offseti[jtype];
+          evdwl *= factor_lj;
+        }
+
+        if (EVFLAG) ev_tally_xyz_full_thr(this,i,evdwl,0.0,delx*fpair,
+                                          dely*fpair,delz*fpair,
+                                          delx,dely,delz,thr);
+      }
+    }
+    f[i].x += fxtmp;
+    f[i].y += fytmp;
+    f[i].z += fztmp;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   package omp force owner needs a full neighbor list
+   and an explicitly tallied virial, since ghost atoms get no forces
+------------------------------------------------------------------------- */
+
+void PairLJCutOMP::init_style()
+{
+  PairLJCut::init_style();
+
+  if (fix->get_owner()) {
+    const int irequest = neighbor->nrequest - 1;
+    neighbor->requests[irequest]->half = 0;
+    neighbor->requests[irequest]->full = 1;
+    no_virial_fdotr_compute = 1;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 double PairLJCutOMP::memory_usage()
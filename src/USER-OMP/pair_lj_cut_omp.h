@@ -35,11 +35,14 @@ class PairLJCutOMP : public PairLJCut, public ThrOMP {
   PairLJCutOMP(class LAMMPS *);
 
   virtual void compute(int, int);
+  virtual void init_style();
   virtual double memory_usage();
 
  private:
   template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
   void eval(int ifrom, int ito, ThrData * const thr);
+  template <int EVFLAG, int EFLAG>
+  void eval_owner(int ifrom, int ito, ThrData * const thr);
 };
 
 }
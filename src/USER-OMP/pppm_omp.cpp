@@ -49,6 +49,7 @@ PPPMOMP::PPPMOMP(LAMMPS *lmp, int narg, char **arg) :
 {
   triclinic_support = 0;
   suffix_flag |= Suffix::OMP;
+  owner_enable = 1;
 }
 
 /* ----------------------------------------------------------------------
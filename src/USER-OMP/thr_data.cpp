@@ -110,6 +110,44 @@ void ThrData::init_force(int nall, double **f, double **torque,
   } else _drho = NULL;
 }
 
+/* ----------------------------------------------------------------------
+   for package omp force owner: all threads use the shared force arrays,
+   each thread only updates the atoms it owns
+------------------------------------------------------------------------- */
+
+void ThrData::init_force_shared(int ifrom, int ito, double **f,
+                                double **torque, double *erforce,
+                                double *de, double *drho)
+{
+  eng_vdwl=eng_coul=eng_bond=eng_angle=eng_dihed=eng_imprp=eng_kspce=0.0;
+  memset(virial_pair,0,6*sizeof(double));
+  memset(virial_bond,0,6*sizeof(double));
+  memset(virial_angle,0,6*sizeof(double));
+  memset(virial_dihed,0,6*sizeof(double));
+  memset(virial_imprp,0,6*sizeof(double));
+  memset(virial_kspce,0,6*sizeof(double));
+
+  eatom_pair=eatom_bond=eatom_angle=eatom_dihed=eatom_imprp=eatom_kspce=NULL;
+  vatom_pair=vatom_bond=vatom_angle=vatom_dihed=vatom_imprp=vatom_kspce=NULL;
+
+  const int n = ito - ifrom;
+
+  _f = f;
+  if (f && n > 0) memset(&(f[ifrom][0]),0,n*3*sizeof(double));
+
+  _torque = torque;
+  if (torque && n > 0) memset(&(torque[ifrom][0]),0,n*3*sizeof(double));
+
+  _erforce = erforce;
+  if (erforce && n > 0) memset(&(erforce[ifrom]),0,n*sizeof(double));
+
+  _de = de;
+  if (de && n > 0) memset(&(de[ifrom]),0,n*sizeof(double));
+
+  _drho = drho;
+  if (drho && n > 0) memset(&(drho[ifrom]),0,n*sizeof(double));
+}
+
 /* ----------------------------------------------------------------------
    set up and clear out locally managed per atom arrays
 ------------------------------------------------------------------------- */
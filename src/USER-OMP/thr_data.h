@@ -47,6 +47,9 @@ class ThrData {
 
   // erase accumulator contents and hook up force arrays
   void init_force(int, double **, double **, double *, double *, double *);
+  // erase accumulators, clear own block of the shared force arrays
+  void init_force_shared(int, int, double **, double **,
+                         double *, double *, double *);
 
   // give access to per-thread offset arrays
   double **get_f() const { return _f; };
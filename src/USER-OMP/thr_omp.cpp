@@ -47,6 +47,12 @@ using namespace MathConst;
 ThrOMP::ThrOMP(LAMMPS *ptr, int style)
   : lmp(ptr), fix(NULL), thr_style(style), thr_error(0)
 {
+  owner_enable = 0;
+  owner_list = owner_first = NULL;
+  max_owner_list = max_owner_thr = 0;
+  owner_ncalls = -1;
+  owner_nlist = owner_nall = owner_nthreads = 0;
+
   // register fix omp with this class
   int ifix = lmp->modify->find_fix("package_omp");
   if (ifix < 0)
@@ -58,7 +64,81 @@ ThrOMP::ThrOMP(LAMMPS *ptr, int style)
 
 ThrOMP::~ThrOMP()
 {
-  // nothing to do?
+  lmp->memory->destroy(owner_list);
+  lmp->memory->destroy(owner_first);
+}
+
+/* ----------------------------------------------------------------------
+   package omp force owner: sort the entries of a bond, angle, dihedral,
+   or improper list by the threads that own their atoms, so each thread
+   only visits its own entries. an entry with atoms in the blocks of
+   several threads is listed for each of them.
+   the first natoms ints of each entry are atom indices, entries are
+   stride ints apart. sublists are rebuilt only after a neighbor build.
+------------------------------------------------------------------------- */
+
+void ThrOMP::owner_setup_thr(const int * const list, const int nlist,
+                             const int stride, const int natoms,
+                             const int nall, const int nthreads)
+{
+  if (owner_ncalls == lmp->neighbor->ncalls && owner_nlist == nlist &&
+      owner_nall == nall && owner_nthreads == nthreads) return;
+
+  owner_ncalls = lmp->neighbor->ncalls;
+  owner_nlist = nlist;
+  owner_nall = nall;
+  owner_nthreads = nthreads;
+
+  if (nthreads+1 > max_owner_thr) {
+    max_owner_thr = nthreads+1;
+    lmp->memory->destroy(owner_first);
+    lmp->memory->create(owner_first,max_owner_thr,"thr_omp:owner_first");
+  }
+
+  // same atom blocks as loop_setup_thr() over nall atoms
+
+  const int idelta = 1 + nall/nthreads;
+  int n,k,m,t,tlist[4];
+
+  // count entries per thread in owner_first[t+1]
+
+  for (t = 0; t <= nthreads; t++) owner_first[t] = 0;
+
+  for (n = 0; n < nlist; n++) {
+    const int * const entry = list + n*stride;
+    for (k = 0; k < natoms; k++) {
+      t = entry[k]/idelta;
+      tlist[k] = t;
+      for (m = 0; m < k; m++)
+        if (tlist[m] == t) break;
+      if (m == k) owner_first[t+1]++;
+    }
+  }
+
+  for (t = 0; t < nthreads; t++) owner_first[t+1] += owner_first[t];
+
+  if (owner_first[nthreads] > max_owner_list) {
+    max_owner_list = owner_first[nthreads];
+    lmp->memory->destroy(owner_list);
+    lmp->memory->create(owner_list,max_owner_list,"thr_omp:owner_list");
+  }
+
+  // fill, using owner_first[t] as insertion point of thread t,
+  // then shift it back to the start of each thread's entries
+
+  for (n = 0; n < nlist; n++) {
+    const int * const entry = list + n*stride;
+    for (k = 0; k < natoms; k++) {
+      t = entry[k]/idelta;
+      tlist[k] = t;
+      for (m = 0; m < k; m++)
+        if (tlist[m] == t) break;
+      if (m == k) owner_list[owner_first[t]++] = n;
+    }
+  }
+
+  for (t = nthreads; t > 0; t--) owner_first[t] = owner_first[t-1];
+  owner_first[0] = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -396,7 +476,9 @@ void ThrOMP::reduce_thr(void *style, const int eflag, const int vflag,
     break;
   }
 
-  if (style == fix->last_omp_style) {
+  // with package omp force owner, threads wrote to the shared arrays
+
+  if (style == fix->last_omp_style && !fix->get_owner()) {
     if (need_force_reduce) {
       data_reduce_thr(&(f[0][0]), nall, nthreads, 3, tid);
       fix->did_reduce();
@@ -574,7 +656,7 @@ void ThrOMP::ev_tally_xyz_full_thr(Pair * const pair, const int i,
 {
 
   if (pair->eflag_either)
-    e_tally_thr(pair,i,i,i+1,0,0.5*evdwl,ecoul,thr);
+    e_tally_thr(pair,i,i,i+1,0,0.5*evdwl,0.5*ecoul,thr);
 
   if (pair->vflag_either) {
     double v[6];
@@ -1220,5 +1302,8 @@ double ThrOMP::memory_usage_thr()
 {
   double bytes=0.0;
 
+  bytes += (double)max_owner_list * sizeof(int);
+  bytes += (double)max_owner_thr * sizeof(int);
+
   return bytes;
 }
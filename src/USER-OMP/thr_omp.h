@@ -43,12 +43,22 @@ class ThrOMP {
   const int thr_style;
   int thr_error;
 
+  // package omp force owner: per thread sublists of a bonded list
+  int *owner_list;        // entries of the list, grouped by thread
+  int *owner_first;       // owner_first[t] = first entry of thread t
+  int max_owner_list;     // allocated size of owner_list
+  int max_owner_thr;      // allocated size of owner_first
+  bigint owner_ncalls;    // neighbor build the sublists were made for
+  int owner_nlist,owner_nall,owner_nthreads;
+
  public:
   ThrOMP(LAMMPS *, int);
   virtual ~ThrOMP();
 
   double memory_usage_thr();
 
+  int owner_enable;   // 1 if style supports package omp force owner
+
   inline void sync_threads() {
 #if defined(_OPENMP)
 #pragma omp barrier
@@ -74,6 +84,10 @@ class ThrOMP {
   void reduce_thr(void * const style, const int eflag, const int vflag,
                   ThrData * const thr);
 
+  // sort a bonded list into per thread sublists for package omp force owner
+  void owner_setup_thr(const int * const, const int, const int, const int,
+                       const int, const int);
+
   // thread safe variant error abort support.
   // signals an error condition in any thread by making
   // thr_error > 0, if condition "cond" is true.
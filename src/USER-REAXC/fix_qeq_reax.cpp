@@ -49,6 +49,9 @@ using namespace FixConst;
 #define SQR(x) ((x)*(x))
 #define CUBE(x) ((x)*(x)*(x))
 #define MIN_NBRS 100
+#define MAXEXTRAP 8
+
+enum{JACOBI,SGS};
 
 static const char cite_fix_qeq_reax[] =
   "fix qeq/reax command:\n\n"
@@ -68,7 +71,7 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
 {
   if (lmp->citeme) lmp->citeme->add(cite_fix_qeq_reax);
 
-  if (narg != 8) error->all(FLERR,"Illegal fix qeq/reax command");
+  if (narg < 8) error->all(FLERR,"Illegal fix qeq/reax command");
 
   nevery = force->inumeric(FLERR,arg[3]);
   if (nevery <= 0) error->all(FLERR,"Illegal fix qeq/reax command");
@@ -78,6 +81,43 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
   tolerance = force->numeric(FLERR,arg[6]);
   pertype_parameters(arg[7]);
 
+  // optional keywords
+
+  dualflag = 0;
+  precond = JACOBI;
+  nextrap_s = 4;
+  nextrap_t = 3;
+
+  int iarg = 8;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"solver") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix qeq/reax command");
+      if (strcmp(arg[iarg+1],"separate") == 0) dualflag = 0;
+      else if (strcmp(arg[iarg+1],"dual") == 0) dualflag = 1;
+      else error->all(FLERR,"Illegal fix qeq/reax command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"precond") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix qeq/reax command");
+      if (strcmp(arg[iarg+1],"jacobi") == 0) precond = JACOBI;
+      else if (strcmp(arg[iarg+1],"sgs") == 0) precond = SGS;
+      else error->all(FLERR,"Illegal fix qeq/reax command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"extrap") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix qeq/reax command");
+      nextrap_s = force->inumeric(FLERR,arg[iarg+1]);
+      nextrap_t = force->inumeric(FLERR,arg[iarg+2]);
+      if (nextrap_s < 0 || nextrap_s > MAXEXTRAP ||
+          nextrap_t < 0 || nextrap_t > MAXEXTRAP)
+        error->all(FLERR,"Illegal fix qeq/reax command");
+      iarg += 3;
+    } else error->all(FLERR,"Illegal fix qeq/reax command");
+  }
+
+  vector_flag = 1;
+  size_vector = 2;
+  global_freq = nevery;
+  extvector = 0;
+
   shld = NULL;
 
   n = n_cap = 0;
@@ -86,7 +126,8 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
   pack_flag = 0;
   s = NULL;
   t = NULL;
-  nprev = 5;
+  nprev = MAX(MAX(nextrap_s,nextrap_t),1);
+  iter_s = iter_t = matvecs = 0;
 
   Hdia_inv = NULL;
   b_s = NULL;
@@ -100,6 +141,17 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
   r = NULL;
   d = NULL;
 
+  // dual CG
+  p2 = q2 = r2 = d2 = NULL;
+  w = w2 = NULL;
+
+  // local block of H for SGS preconditioner
+  L.firstnbr = NULL;
+  L.numnbrs = NULL;
+  L.jlist = NULL;
+  L.val = NULL;
+  L_nmax = L_mmax = 0;
+
   // H matrix
   H.firstnbr = NULL;
   H.numnbrs = NULL;
@@ -107,6 +159,7 @@ FixQEqReax::FixQEqReax(LAMMPS *lmp, int narg, char **arg) :
   H.val = NULL;
 
   comm_forward = comm_reverse = 1;
+  if (dualflag) comm_forward = comm_reverse = 2;
 
   // perform initial allocation of atom-based arrays
   // register with Atom class
@@ -231,6 +284,15 @@ void FixQEqReax::allocate_storage()
   memory->create(q,nmax,"qeq:q");
   memory->create(r,nmax,"qeq:r");
   memory->create(d,nmax,"qeq:d");
+
+  if (dualflag) {
+    memory->create(p2,nmax,"qeq:p2");
+    memory->create(q2,nmax,"qeq:q2");
+    memory->create(r2,nmax,"qeq:r2");
+    memory->create(d2,nmax,"qeq:d2");
+    memory->create(w,nmax,"qeq:w");
+    memory->create(w2,nmax,"qeq:w2");
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -250,6 +312,13 @@ void FixQEqReax::deallocate_storage()
   memory->destroy( q );
   memory->destroy( r );
   memory->destroy( d );
+
+  memory->destroy( p2 );
+  memory->destroy( q2 );
+  memory->destroy( r2 );
+  memory->destroy( d2 );
+  memory->destroy( w );
+  memory->destroy( w2 );
 }
 
 /* ---------------------------------------------------------------------- */
@@ -476,8 +545,12 @@ void FixQEqReax::pre_force(int vflag)
     reallocate_matrix();
 
   init_matvec();
-  matvecs = CG(b_s, s);    	// CG on s - parallel
-  matvecs += CG(b_t, t); 	// CG on t - parallel
+  if (dualflag) dual_CG(b_s, b_t, s, t);  // CG on s & t together - parallel
+  else {
+    iter_s = CG(b_s, s);    	// CG on s - parallel
+    iter_t = CG(b_t, t); 	// CG on t - parallel
+  }
+  matvecs = iter_s + iter_t;
   calculate_Q();
 
   if( comm->me == 0 ) {
@@ -500,6 +573,16 @@ void FixQEqReax::min_pre_force(int vflag)
   pre_force(vflag);
 }
 
+/* ----------------------------------------------------------------------
+   CG iterations for the s and t systems in the last QEq solve
+------------------------------------------------------------------------- */
+
+double FixQEqReax::compute_vector(int n)
+{
+  if (n == 0) return (double) iter_s;
+  return (double) iter_t;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReax::init_matvec()
@@ -527,24 +610,177 @@ void FixQEqReax::init_matvec()
       b_s[i]      = -chi[ atom->type[i] ];
       b_t[i]      = -1.0;
 
-      /* linear extrapolation for s & t from previous solutions */
-      //s[i] = 2 * s_hist[i][0] - s_hist[i][1];
-      //t[i] = 2 * t_hist[i][0] - t_hist[i][1];
+      /* polynomial extrapolation for s & t from previous solutions */
+      s[i] = extrapolate( s_hist[i], nextrap_s );
+      t[i] = extrapolate( t_hist[i], nextrap_t );
+    }
+  }
+
+  if (precond == SGS) setup_precond();
+
+  if (dualflag) {
+    pack_flag = 5;
+    comm->forward_comm_fix(this); //Dist_vector( s & t );
+  } else {
+    pack_flag = 2;
+    comm->forward_comm_fix(this); //Dist_vector( s );
+    pack_flag = 3;
+    comm->forward_comm_fix(this); //Dist_vector( t );
+  }
+}
+
+/* ----------------------------------------------------------------------
+   extrapolate a fictitious charge from its last k values
+   k = 1,2,3,4 is constant, linear, quadratic, cubic extrapolation
+   k = 0 starts the solver from zero
+------------------------------------------------------------------------- */
+
+double FixQEqReax::extrapolate(double *hist, int k)
+{
+  double value = 0.0;
+  double binom = k;     // binomial coefficient (k over j+1)
+  double sign = 1.0;
+
+  for (int j = 0; j < k; j++) {
+    value += sign * binom * hist[j];
+    binom = binom * (k-j-1) / (j+2);
+    sign = -sign;
+  }
+
+  return value;
+}
+
+/* ----------------------------------------------------------------------
+   copy the diagonal block of H coupling owned atoms of the group
+   into full (symmetric) row storage for the SGS preconditioner
+------------------------------------------------------------------------- */
 
-      /* quadratic extrapolation for s & t from previous solutions */
-      //s[i] = s_hist[i][2] + 3 * ( s_hist[i][0] - s_hist[i][1] );
-      t[i] = t_hist[i][2] + 3 * ( t_hist[i][0] - t_hist[i][1] );
+void FixQEqReax::setup_precond()
+{
+  int i,j,ii,jj,m;
+  int *mask = atom->mask;
 
-      /* cubic extrapolation for s & t from previous solutions */
-      s[i] = 4*(s_hist[i][0]+s_hist[i][2])-(6*s_hist[i][1]+s_hist[i][3]);
-      //t[i] = 4*(t_hist[i][0]+t_hist[i][2])-(6*t_hist[i][1]+t_hist[i][3]);
+  int nn;
+  int *ilist;
+  if (reaxc) {
+    nn = reaxc->list->inum;
+    ilist = reaxc->list->ilist;
+  } else {
+    nn = list->inum;
+    ilist = list->ilist;
+  }
+
+  if (n > L_nmax) {
+    L_nmax = atom->nmax;
+    memory->destroy(L.firstnbr);
+    memory->destroy(L.numnbrs);
+    memory->create(L.firstnbr,L_nmax,"qeq:L.firstnbr");
+    memory->create(L.numnbrs,L_nmax,"qeq:L.numnbrs");
+  }
+
+  // count entries per row, each stored pair of H contributes to 2 rows
+
+  for (i = 0; i < n; i++) L.numnbrs[i] = 0;
+
+  m = 0;
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if (!(mask[i] & groupbit)) continue;
+    for (jj = H.firstnbr[i]; jj < H.firstnbr[i]+H.numnbrs[i]; jj++) {
+      j = H.jlist[jj];
+      if (j >= n || !(mask[j] & groupbit)) continue;
+      L.numnbrs[i]++;
+      L.numnbrs[j]++;
+      m += 2;
     }
   }
 
-  pack_flag = 2;
-  comm->forward_comm_fix(this); //Dist_vector( s );
-  pack_flag = 3;
-  comm->forward_comm_fix(this); //Dist_vector( t );
+  if (m > L_mmax) {
+    L_mmax = MAX(m,H.m);
+    memory->destroy(L.jlist);
+    memory->destroy(L.val);
+    memory->create(L.jlist,L_mmax,"qeq:L.jlist");
+    memory->create(L.val,L_mmax,"qeq:L.val");
+  }
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    L.firstnbr[i] = m;
+    m += L.numnbrs[i];
+    L.numnbrs[i] = 0;
+  }
+
+  for (ii = 0; ii < nn; ii++) {
+    i = ilist[ii];
+    if (!(mask[i] & groupbit)) continue;
+    for (jj = H.firstnbr[i]; jj < H.firstnbr[i]+H.numnbrs[i]; jj++) {
+      j = H.jlist[jj];
+      if (j >= n || !(mask[j] & groupbit)) continue;
+      m = L.firstnbr[i] + L.numnbrs[i]++;
+      L.jlist[m] = j;
+      L.val[m] = H.val[jj];
+      m = L.firstnbr[j] + L.numnbrs[j]++;
+      L.jlist[m] = i;
+      L.val[m] = H.val[jj];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   z = M^-1 v for owned atoms
+   JACOBI: M = diagonal of H
+   SGS: block Jacobi across procs, each block is one symmetric
+     Gauss-Seidel sweep on the local part of H, M = (D+L) D^-1 (D+U)
+------------------------------------------------------------------------- */
+
+void FixQEqReax::apply_precond(double *v, double *z)
+{
+  int i,j,ii,jj;
+  double sum;
+  int *mask = atom->mask;
+
+  if (precond == JACOBI) {
+    int nn;
+    int *ilist;
+    if (reaxc) {
+      nn = reaxc->list->inum;
+      ilist = reaxc->list->ilist;
+    } else {
+      nn = list->inum;
+      ilist = list->ilist;
+    }
+
+    for (ii = 0; ii < nn; ++ii) {
+      i = ilist[ii];
+      if (mask[i] & groupbit)
+        z[i] = v[i] * Hdia_inv[i];
+    }
+    return;
+  }
+
+  // forward sweep: (D+L) z = v
+
+  for (i = 0; i < n; i++) {
+    if (!(mask[i] & groupbit)) continue;
+    sum = v[i];
+    for (jj = L.firstnbr[i]; jj < L.firstnbr[i]+L.numnbrs[i]; jj++) {
+      j = L.jlist[jj];
+      if (j < i) sum -= L.val[jj] * z[j];
+    }
+    z[i] = sum * Hdia_inv[i];
+  }
+
+  // backward sweep: (D+U) z = D z
+
+  for (i = n-1; i >= 0; i--) {
+    if (!(mask[i] & groupbit)) continue;
+    sum = 0.0;
+    for (jj = L.firstnbr[i]; jj < L.firstnbr[i]+L.numnbrs[i]; jj++) {
+      j = L.jlist[jj];
+      if (j > i) sum += L.val[jj] * z[j];
+    }
+    z[i] -= sum * Hdia_inv[i];
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -648,19 +884,13 @@ double FixQEqReax::calculate_H( double r, double gamma )
 
 int FixQEqReax::CG( double *b, double *x )
 {
-  int  i, j, imax;
+  int  i, imax;
   double tmp, alpha, beta, b_norm;
   double sig_old, sig_new;
 
-  int nn, jj;
-  int *ilist;
-  if (reaxc) {
-    nn = reaxc->list->inum;
-    ilist = reaxc->list->ilist;
-  } else {
-    nn = list->inum;
-    ilist = list->ilist;
-  }
+  int nn;
+  if (reaxc) nn = reaxc->list->inum;
+  else nn = list->inum;
 
   imax = 200;
 
@@ -670,11 +900,7 @@ int FixQEqReax::CG( double *b, double *x )
 
   vector_sum( r , 1.,  b, -1., q, nn );
 
-  for( jj = 0; jj < nn; ++jj ) {
-    j = ilist[jj];
-    if (atom->mask[j] & groupbit)
-      d[j] = r[j] * Hdia_inv[j]; //pre-condition
-  }
+  apply_precond( r, d ); //pre-condition
 
   b_norm = parallel_norm( b, nn );
   sig_new = parallel_dot( r, d, nn);
@@ -691,11 +917,7 @@ int FixQEqReax::CG( double *b, double *x )
     vector_add( r, -alpha, q, nn );
 
     // pre-conditioning
-    for( jj = 0; jj < nn; ++jj ) {
-      j = ilist[jj];
-      if (atom->mask[j] & groupbit)
-        p[j] = r[j] * Hdia_inv[j];
-    }
+    apply_precond( r, p );
 
     sig_old = sig_new;
     sig_new = parallel_dot( r, p, nn);
@@ -716,6 +938,152 @@ int FixQEqReax::CG( double *b, double *x )
 }
 
 
+/* ----------------------------------------------------------------------
+   solve H x1 = b1 and H x2 = b2 together with preconditioned CG
+   uses the Chronopoulos/Gear recurrences so that all dot products
+   of an iteration for both systems need a single MPI_Allreduce,
+   and H is applied to both systems in one pass over the matrix
+   a converged system is frozen while the other one keeps iterating
+------------------------------------------------------------------------- */
+
+int FixQEqReax::dual_CG( double *b1, double *b2, double *x1, double *x2 )
+{
+  int i, j, jj, imax;
+  int conv1, conv2;
+  double alpha1, alpha2, beta1, beta2;
+  double gamma1, gamma2, delta1, delta2;
+  double b_norm1, b_norm2;
+  double my_buf[6], buf[6];
+
+  int nn;
+  int *ilist;
+  int *mask = atom->mask;
+  if (reaxc) {
+    nn = reaxc->list->inum;
+    ilist = reaxc->list->ilist;
+  } else {
+    nn = list->inum;
+    ilist = list->ilist;
+  }
+
+  imax = 200;
+
+  // initial residuals r = b - H x, x was distributed by init_matvec()
+
+  pack_flag = 5;
+  sparse_matvec_dual( &H, x1, x2, q, q2 );
+  comm->reverse_comm_fix( this ); //Coll_Vector( q & q2 );
+
+  vector_sum( r , 1.,  b1, -1., q, nn );
+  vector_sum( r2 , 1.,  b2, -1., q2, nn );
+
+  // u = M^-1 r stored in p, w = H u
+
+  apply_precond( r, p );
+  apply_precond( r2, p2 );
+
+  pack_flag = 6;
+  comm->forward_comm_fix( this ); //Dist_vector( p & p2 );
+  sparse_matvec_dual( &H, p, p2, w, w2 );
+  comm->reverse_comm_fix( this ); //Coll_Vector( w & w2 );
+
+  for (i = 0; i < 6; i++) my_buf[i] = 0.0;
+  for( jj = 0; jj < nn; ++jj ) {
+    j = ilist[jj];
+    if (mask[j] & groupbit) {
+      my_buf[0] += b1[j] * b1[j];
+      my_buf[1] += b2[j] * b2[j];
+      my_buf[2] += r[j] * p[j];
+      my_buf[3] += r2[j] * p2[j];
+      my_buf[4] += w[j] * p[j];
+      my_buf[5] += w2[j] * p2[j];
+      d[j] = q[j] = d2[j] = q2[j] = 0.0;
+    }
+  }
+  MPI_Allreduce( my_buf, buf, 6, MPI_DOUBLE, MPI_SUM, world );
+
+  b_norm1 = sqrt( buf[0] );
+  b_norm2 = sqrt( buf[1] );
+  gamma1 = buf[2];
+  gamma2 = buf[3];
+  delta1 = buf[4];
+  delta2 = buf[5];
+
+  conv1 = (sqrt(gamma1) / b_norm1 <= tolerance);
+  conv2 = (sqrt(gamma2) / b_norm2 <= tolerance);
+  iter_s = iter_t = 1;
+
+  alpha1 = conv1 ? 0.0 : gamma1 / delta1;
+  alpha2 = conv2 ? 0.0 : gamma2 / delta2;
+  beta1 = beta2 = 0.0;
+
+  // search directions d and their products with H kept in q
+
+  for( i = 1; i < imax && !(conv1 && conv2); ++i ) {
+    for( jj = 0; jj < nn; ++jj ) {
+      j = ilist[jj];
+      if (mask[j] & groupbit) {
+        if (!conv1) {
+          d[j] = p[j] + beta1 * d[j];
+          q[j] = w[j] + beta1 * q[j];
+          x1[j] += alpha1 * d[j];
+          r[j] -= alpha1 * q[j];
+        }
+        if (!conv2) {
+          d2[j] = p2[j] + beta2 * d2[j];
+          q2[j] = w2[j] + beta2 * q2[j];
+          x2[j] += alpha2 * d2[j];
+          r2[j] -= alpha2 * q2[j];
+        }
+      }
+    }
+
+    // pre-conditioning
+    if (!conv1) apply_precond( r, p );
+    if (!conv2) apply_precond( r2, p2 );
+
+    comm->forward_comm_fix( this ); //Dist_vector( p & p2 );
+    sparse_matvec_dual( &H, p, p2, w, w2 );
+    comm->reverse_comm_fix( this ); //Coll_Vector( w & w2 );
+
+    for (j = 0; j < 4; j++) my_buf[j] = 0.0;
+    for( jj = 0; jj < nn; ++jj ) {
+      j = ilist[jj];
+      if (mask[j] & groupbit) {
+        my_buf[0] += r[j] * p[j];
+        my_buf[1] += r2[j] * p2[j];
+        my_buf[2] += w[j] * p[j];
+        my_buf[3] += w2[j] * p2[j];
+      }
+    }
+    MPI_Allreduce( my_buf, buf, 4, MPI_DOUBLE, MPI_SUM, world );
+
+    if (!conv1) {
+      beta1 = buf[0] / gamma1;
+      alpha1 = buf[0] / (buf[2] - beta1 * buf[0] / alpha1);
+      gamma1 = buf[0];
+      iter_s = i+1;
+      if (sqrt(gamma1) / b_norm1 <= tolerance) conv1 = 1;
+    }
+    if (!conv2) {
+      beta2 = buf[1] / gamma2;
+      alpha2 = buf[1] / (buf[3] - beta2 * buf[1] / alpha2);
+      gamma2 = buf[1];
+      iter_t = i+1;
+      if (sqrt(gamma2) / b_norm2 <= tolerance) conv2 = 1;
+    }
+  }
+
+  if (i >= imax && comm->me == 0) {
+    char str[128];
+    sprintf(str,"Fix qeq/reax CG convergence failed after %d iterations "
+            "at " BIGINT_FORMAT " step",i,update->ntimestep);
+    error->warning(FLERR,str);
+  }
+
+  return i;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReax::sparse_matvec( sparse_matrix *A, double *x, double *b )
@@ -759,6 +1127,57 @@ void FixQEqReax::sparse_matvec( sparse_matrix *A, double *x, double *b )
 
 }
 
+/* ----------------------------------------------------------------------
+   b1 = A x1 and b2 = A x2 in a single pass over A
+------------------------------------------------------------------------- */
+
+void FixQEqReax::sparse_matvec_dual( sparse_matrix *A, double *x1,
+                                     double *x2, double *b1, double *b2 )
+{
+  int i, j, itr_j;
+  int nn, NN, ii;
+  int *ilist;
+  double val;
+
+  if (reaxc) {
+    nn = reaxc->list->inum;
+    NN = reaxc->list->inum + reaxc->list->gnum;
+    ilist = reaxc->list->ilist;
+  } else {
+    nn = list->inum;
+    NN = list->inum + list->gnum;
+    ilist = list->ilist;
+  }
+
+  for( ii = 0; ii < nn; ++ii ) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      b1[i] = eta[ atom->type[i] ] * x1[i];
+      b2[i] = eta[ atom->type[i] ] * x2[i];
+    }
+  }
+
+  for( ii = nn; ii < NN; ++ii ) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit)
+      b1[i] = b2[i] = 0;
+  }
+
+  for( ii = 0; ii < nn; ++ii ) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      for( itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        val = A->val[itr_j];
+        b1[i] += val * x1[j];
+        b2[i] += val * x2[j];
+        b1[j] += val * x1[i];
+        b2[j] += val * x2[i];
+      }
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReax::calculate_Q()
@@ -778,8 +1197,21 @@ void FixQEqReax::calculate_Q()
     ilist = list->ilist;
   }
 
-  s_sum = parallel_vector_acc( s, nn );
-  t_sum = parallel_vector_acc( t, nn);
+  // sum of s and t with a single reduction
+
+  double my_acc[2], acc[2];
+  my_acc[0] = my_acc[1] = 0.0;
+  for( ii = 0; ii < nn; ++ii ) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      my_acc[0] += s[i];
+      my_acc[1] += t[i];
+    }
+  }
+  MPI_Allreduce( my_acc, acc, 2, MPI_DOUBLE, MPI_SUM, world );
+
+  s_sum = acc[0];
+  t_sum = acc[1];
   u = s_sum / t_sum;
 
   for( ii = 0; ii < nn; ++ii ) {
@@ -788,7 +1220,7 @@ void FixQEqReax::calculate_Q()
       q[i] = s[i] - u * t[i];
 
       /* backup s & t */
-      for( k = 4; k > 0; --k ) {
+      for( k = nprev-1; k > 0; --k ) {
         s_hist[i][k] = s_hist[i][k-1];
         t_hist[i][k] = t_hist[i][k-1];
       }
@@ -816,6 +1248,19 @@ int FixQEqReax::pack_forward_comm(int n, int *list, double *buf,
     for(m = 0; m < n; m++) buf[m] = t[list[m]];
   else if( pack_flag == 4 )
     for(m = 0; m < n; m++) buf[m] = atom->q[list[m]];
+  else if( pack_flag == 5 ) {
+    for(m = 0; m < n; m++) {
+      buf[2*m] = s[list[m]];
+      buf[2*m+1] = t[list[m]];
+    }
+    return 2*n;
+  } else if( pack_flag == 6 ) {
+    for(m = 0; m < n; m++) {
+      buf[2*m] = p[list[m]];
+      buf[2*m+1] = p2[list[m]];
+    }
+    return 2*n;
+  }
 
   return n;
 }
@@ -834,6 +1279,16 @@ void FixQEqReax::unpack_forward_comm(int n, int first, double *buf)
     for(m = 0, i = first; m < n; m++, i++) t[i] = buf[m];
   else if( pack_flag == 4)
     for(m = 0, i = first; m < n; m++, i++) atom->q[i] = buf[m];
+  else if( pack_flag == 5)
+    for(m = 0, i = first; m < n; m++, i++) {
+      s[i] = buf[2*m];
+      t[i] = buf[2*m+1];
+    }
+  else if( pack_flag == 6)
+    for(m = 0, i = first; m < n; m++, i++) {
+      p[i] = buf[2*m];
+      p2[i] = buf[2*m+1];
+    }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -841,6 +1296,21 @@ void FixQEqReax::unpack_forward_comm(int n, int first, double *buf)
 int FixQEqReax::pack_reverse_comm(int n, int first, double *buf)
 {
   int i, m;
+
+  if( pack_flag == 5 ) {
+    for(m = 0, i = first; m < n; m++, i++) {
+      buf[2*m] = q[i];
+      buf[2*m+1] = q2[i];
+    }
+    return 2*n;
+  } else if( pack_flag == 6 ) {
+    for(m = 0, i = first; m < n; m++, i++) {
+      buf[2*m] = w[i];
+      buf[2*m+1] = w2[i];
+    }
+    return 2*n;
+  }
+
   for(m = 0, i = first; m < n; m++, i++) buf[m] = q[i];
   return n;
 }
@@ -849,7 +1319,20 @@ int FixQEqReax::pack_reverse_comm(int n, int first, double *buf)
 
 void FixQEqReax::unpack_reverse_comm(int n, int *list, double *buf)
 {
-  for(int m = 0; m < n; m++) q[list[m]] += buf[m];
+  int m;
+
+  if( pack_flag == 5 ) {
+    for(m = 0; m < n; m++) {
+      q[list[m]] += buf[2*m];
+      q2[list[m]] += buf[2*m+1];
+    }
+  } else if( pack_flag == 6 ) {
+    for(m = 0; m < n; m++) {
+      w[list[m]] += buf[2*m];
+      w2[list[m]] += buf[2*m+1];
+    }
+  } else
+    for(m = 0; m < n; m++) q[list[m]] += buf[m];
 }
 
 /* ----------------------------------------------------------------------
@@ -862,6 +1345,9 @@ double FixQEqReax::memory_usage()
 
   bytes = atom->nmax*nprev*2 * sizeof(double); // s_hist & t_hist
   bytes += atom->nmax*11 * sizeof(double); // storage
+  if (dualflag) bytes += atom->nmax*6 * sizeof(double); // dual CG storage
+  bytes += L_nmax*2 * sizeof(int); // local block of H for SGS
+  bytes += L_mmax * (sizeof(int) + sizeof(double));
   bytes += n_cap*2 * sizeof(int); // matrix...
   bytes += m_cap * sizeof(int);
   bytes += m_cap * sizeof(double);
@@ -49,8 +49,10 @@ class FixQEqReax : public Fix {
   void pre_force_respa(int, int, int);
 
   void min_pre_force(int);
+  double compute_vector(int);
 
   int matvecs;
+  int iter_s, iter_t;   // CG iterations for s and t in last call
   double qeq_time;
 
  protected:
@@ -65,6 +67,9 @@ class FixQEqReax : public Fix {
   double swa, swb;      // lower/upper Taper cutoff radius
   double Tap[8];        // Taper function
   double tolerance;     // tolerance for the norm of the rel residual in CG
+  int dualflag;         // 1 = solve s and t together in one CG
+  int precond;          // JACOBI or SGS preconditioner
+  int nextrap_s, nextrap_t; // # of previous solutions used in extrapolation
 
   double *chi,*eta,*gamma;  // qeq parameters
   double **shld;
@@ -93,6 +98,15 @@ class FixQEqReax : public Fix {
   //CG storage
   double *p, *q, *r, *d;
 
+  // dual CG storage: t-system counterparts of p,q,r,d
+  // and H times the preconditioned residual of both systems
+  double *p2, *q2, *r2, *d2;
+  double *w, *w2;
+
+  // local diagonal block of H in full storage for SGS preconditioner
+  sparse_matrix L;
+  int L_nmax, L_mmax;
+
   //GMRES storage
   //double *g,*y;
   //double **v;
@@ -116,8 +130,13 @@ class FixQEqReax : public Fix {
   void calculate_Q();
 
   int CG(double*,double*);
+  int dual_CG(double*,double*,double*,double*);
   //int GMRES(double*,double*);
   void sparse_matvec(sparse_matrix*,double*,double*);
+  void sparse_matvec_dual(sparse_matrix*,double*,double*,double*,double*);
+  void setup_precond();
+  void apply_precond(double*,double*);
+  double extrapolate(double*,int);
 
   int pack_forward_comm(int, int *, double *, int, int *);
   void unpack_forward_comm(int, int, double *);
@@ -141,3 +160,30 @@ class FixQEqReax : public Fix {
 
 #endif
 #endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Fix qeq/reax requires atom attribute q
+
+Self-explanatory.
+
+E: Fix qeq/reax group has no atoms
+
+Self-explanatory.
+
+E: Fix qeq/reax has insufficient QEq matrix size
+
+Increase the safezone or mincap settings of pair_style reax/c.
+
+W: Fix qeq/reax CG convergence failed after %d iterations at %ld step
+
+The charges did not converge to the requested tolerance within the
+maximum number of iterations.  They are used as they are.
+
+*/
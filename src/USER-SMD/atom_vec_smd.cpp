@@ -109,8 +109,8 @@ void AtomVecSMD::grow(int n) {
 	x = memory->grow(atom->x, nmax, 3, "atom:x");
 	v = memory->grow(atom->v, nmax, 3, "atom:v");
 
-	f = memory->grow(atom->f, nmax * comm->nthreads, 3, "atom:f");
-	de = memory->grow(atom->de, nmax * comm->nthreads, "atom:de");
+	f = memory->grow(atom->f, nmax * comm->nthreads_force, 3, "atom:f");
+	de = memory->grow(atom->de, nmax * comm->nthreads_force, "atom:de");
 
 	vfrac = memory->grow(atom->vfrac, nmax, "atom:vfrac");
 	rmass = memory->grow(atom->rmass, nmax, "atom:rmass");
@@ -1248,7 +1248,7 @@ bigint AtomVecSMD::memory_usage() {
 	if (atom->memcheck("vest"))
 		bytes += memory->usage(vest, nmax, 3);
 	if (atom->memcheck("f"))
-		bytes += memory->usage(f, nmax * comm->nthreads, 3);
+		bytes += memory->usage(f, nmax * comm->nthreads_force, 3);
 
 	if (atom->memcheck("radius"))
 		bytes += memory->usage(radius, nmax);
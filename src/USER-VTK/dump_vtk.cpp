@@ -107,6 +107,10 @@ DumpVTK::DumpVTK(LAMMPS *lmp, int narg, char **arg) :
 {
   if (narg == 5) error->all(FLERR,"No dump vtk arguments specified");
 
+  // VTK files are written by write() of this class, never asynchronously
+
+  async_allow = 0;
+
   pack_choice.clear();
   vtype.clear();
   name.clear();
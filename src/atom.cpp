@@ -48,6 +48,11 @@ using namespace MathConst;
 #define EPSILON 1.0e-6
 
 enum{LAYOUT_UNIFORM,LAYOUT_NONUNIFORM,LAYOUT_TILED};    // several files
+enum{XYZ,MORTON,HILBERT};
+
+static bigint curve_key(int, int, int, int *);
+static int curve_bits(int, int);
+int compare_curve(const void *, const void *);
 
 /* ---------------------------------------------------------------------- */
 
@@ -63,9 +68,12 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
   sortfreq = 1000;
   nextsort = 0;
   userbinsize = 0.0;
-  maxbin = maxnext = 0;
+  sortcurve = XYZ;
+  maxbin = maxnext = maxcurve = 0;
   binhead = NULL;
   next = permute = NULL;
+  binorder = NULL;
+  curvesort = NULL;
 
   // initialize atom arrays
   // customize by adding new array
@@ -207,6 +215,9 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
   map_array = NULL;
   map_bucket = NULL;
   map_hash = NULL;
+  map_nrobin = map_robinbits = map_nrobinused = 0;
+  map_stamp = 0;
+  map_robin = NULL;
 
   atom_style = NULL;
   avec = NULL;
@@ -233,6 +244,8 @@ Atom::~Atom()
   memory->destroy(binhead);
   memory->destroy(next);
   memory->destroy(permute);
+  memory->destroy(binorder);
+  memory->sfree(curvesort);
 
   // delete atom arrays
   // customize by adding new array
@@ -374,6 +387,7 @@ void Atom::settings(Atom *old)
   map_style = old->map_style;
   sortfreq = old->sortfreq;
   userbinsize = old->userbinsize;
+  sortcurve = old->sortcurve;
   if (old->firstgroupname) {
     int n = strlen(old->firstgroupname) + 1;
     firstgroupname = new char[n];
@@ -578,6 +592,7 @@ void Atom::modify_params(int narg, char **arg)
                    "Atom_modify map command after simulation box is defined");
       if (strcmp(arg[iarg+1],"array") == 0) map_user = 1;
       else if (strcmp(arg[iarg+1],"hash") == 0) map_user = 2;
+      else if (strcmp(arg[iarg+1],"robin") == 0) map_user = 3;
       else error->all(FLERR,"Illegal atom_modify command");
       map_style = map_user;
       iarg += 2;
@@ -603,6 +618,13 @@ void Atom::modify_params(int narg, char **arg)
         error->all(FLERR,"Atom_modify sort and first options "
                    "cannot be used together");
       iarg += 3;
+    } else if (strcmp(arg[iarg],"curve") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal atom_modify command");
+      if (strcmp(arg[iarg+1],"xyz") == 0) sortcurve = XYZ;
+      else if (strcmp(arg[iarg+1],"morton") == 0) sortcurve = MORTON;
+      else if (strcmp(arg[iarg+1],"hilbert") == 0) sortcurve = HILBERT;
+      else error->all(FLERR,"Illegal atom_modify command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal atom_modify command");
   }
 }
@@ -804,10 +826,12 @@ void Atom::deallocate_topology()
 /* ----------------------------------------------------------------------
    unpack N lines from Atom section of data file
    call style-specific routine to parse line
+   ownall = 1 if lines were already routed to their owning proc,
+     then also allow for round-off at interior sub-domain bounds
 ------------------------------------------------------------------------- */
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, int type_offset,
-                      int shiftflag, double *shift)
+                      int shiftflag, double *shift, int ownall)
 {
   int m,xptr,iptr;
   imageint imagedata;
@@ -879,6 +903,28 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, int type_offset,
     }
   }
 
+  // if lines were routed to me by Comm::coord2proc(),
+  //   an atom near an interior sub-domain bound may be just outside mine
+  // atoms outside a non-periodic box are still not owned by any proc
+
+  if (ownall) {
+    if (comm->layout != LAYOUT_TILED) {
+      if (comm->myloc[0] > 0) sublo[0] -= epsilon[0];
+      if (comm->myloc[0] < comm->procgrid[0]-1) subhi[0] += epsilon[0];
+      if (comm->myloc[1] > 0) sublo[1] -= epsilon[1];
+      if (comm->myloc[1] < comm->procgrid[1]-1) subhi[1] += epsilon[1];
+      if (comm->myloc[2] > 0) sublo[2] -= epsilon[2];
+      if (comm->myloc[2] < comm->procgrid[2]-1) subhi[2] += epsilon[2];
+    } else {
+      if (comm->mysplit[0][0] > 0.0) sublo[0] -= epsilon[0];
+      if (comm->mysplit[0][1] < 1.0) subhi[0] += epsilon[0];
+      if (comm->mysplit[1][0] > 0.0) sublo[1] -= epsilon[1];
+      if (comm->mysplit[1][1] < 1.0) subhi[1] += epsilon[1];
+      if (comm->mysplit[2][0] > 0.0) sublo[2] -= epsilon[2];
+      if (comm->mysplit[2][1] < 1.0) subhi[2] += epsilon[2];
+    }
+  }
+
   // xptr = which word in line starts xyz coords
   // iptr = which word in line starts ix,iy,iz image flags
 
@@ -1792,10 +1838,12 @@ void Atom::sort()
 
   // permute = desired permutation of atoms
   // permute[I] = J means Ith new atom will be Jth old atom
+  // bins are visited in space-filling curve order if requested
 
   n = 0;
   for (m = 0; m < nbins; m++) {
-    i = binhead[m];
+    if (sortcurve == XYZ) i = binhead[m];
+    else i = binhead[binorder[m]];
     while (i >= 0) {
       permute[n++] = i;
       i = next[i];
@@ -1891,9 +1939,186 @@ void Atom::setup_sort_bins()
 
   if (nbins > maxbin) {
     memory->destroy(binhead);
+    memory->destroy(binorder);
     maxbin = nbins;
     memory->create(binhead,maxbin,"atom:binhead");
+    if (sortcurve != XYZ) memory->create(binorder,maxbin,"atom:binorder");
+  }
+
+  // binorder = bins sorted by position along Morton or Hilbert curve
+  // curve is over smallest power-of-2 cube that holds all bins
+
+  if (sortcurve == XYZ) return;
+  if (binorder == NULL) memory->create(binorder,maxbin,"atom:binorder");
+
+  int dimension = domain->dimension;
+  int nbits = curve_bits(MAX(MAX(nbinx,nbiny),nbinz),dimension);
+  int c[3];
+
+  grow_curve(nbins);
+
+  int ibin = 0;
+  for (int iz = 0; iz < nbinz; iz++)
+    for (int iy = 0; iy < nbiny; iy++)
+      for (int ix = 0; ix < nbinx; ix++) {
+        c[0] = ix;
+        c[1] = iy;
+        c[2] = iz;
+        curvesort[ibin].key = curve_key(sortcurve,dimension,nbits,c);
+        curvesort[ibin].index = ibin;
+        ibin++;
+      }
+
+  qsort(curvesort,nbins,sizeof(CurveSort),compare_curve);
+  for (ibin = 0; ibin < nbins; ibin++) binorder[ibin] = curvesort[ibin].index;
+}
+
+/* ----------------------------------------------------------------------
+   reorder a list of owned or ghost atom indices by position
+     along the space-filling curve used by sort()
+   used by Comm::borders() so ghost atoms arrive in curve order
+   curve cells are sort bins tiling the box plus ghost cutoff,
+     so the ordering is the same on all procs
+   no-op if sorting is off or bins are in plain xyz order
+------------------------------------------------------------------------- */
+
+void Atom::curve_order(int n, int *list)
+{
+  if (sortfreq == 0 || sortcurve == XYZ || n <= 1) return;
+
+  double binsize;
+  if (userbinsize > 0.0) binsize = userbinsize;
+  else binsize = 0.5 * neighbor->cutneighmax;
+  if (binsize == 0.0) return;
+  double bininv = 1.0/binsize;
+
+  double *boxlo,*boxhi;
+  if (domain->triclinic) {
+    boxlo = domain->boxlo_bound;
+    boxhi = domain->boxhi_bound;
+  } else {
+    boxlo = domain->boxlo;
+    boxhi = domain->boxhi;
   }
+
+  int dimension = domain->dimension;
+  double cut = neighbor->cutneighmax;
+  double lo[3];
+  int ncell[3];
+  for (int d = 0; d < 3; d++) {
+    lo[d] = boxlo[d] - cut;
+    ncell[d] = static_cast<int> ((boxhi[d]-boxlo[d] + 2.0*cut) * bininv) + 1;
+  }
+  if (dimension == 2) ncell[2] = 1;
+  int nbits = curve_bits(MAX(MAX(ncell[0],ncell[1]),ncell[2]),dimension);
+  int cmax = (1 << nbits) - 1;
+
+  grow_curve(n);
+
+  int c[3];
+  for (int i = 0; i < n; i++) {
+    int j = list[i];
+    for (int d = 0; d < 3; d++) {
+      c[d] = static_cast<int> ((x[j][d]-lo[d])*bininv);
+      c[d] = MAX(c[d],0);
+      c[d] = MIN(c[d],cmax);
+    }
+    if (dimension == 2) c[2] = 0;
+    curvesort[i].key = curve_key(sortcurve,dimension,nbits,c);
+    curvesort[i].index = j;
+  }
+
+  qsort(curvesort,n,sizeof(CurveSort),compare_curve);
+  for (int i = 0; i < n; i++) list[i] = curvesort[i].index;
+}
+
+/* ----------------------------------------------------------------------
+   grow curvesort to hold at least N entries
+------------------------------------------------------------------------- */
+
+void Atom::grow_curve(int n)
+{
+  if (n <= maxcurve) return;
+  maxcurve = n;
+  curvesort = (CurveSort *)
+    memory->srealloc(curvesort,maxcurve*sizeof(CurveSort),"atom:curvesort");
+}
+
+/* ----------------------------------------------------------------------
+   # of bits per dimension for a curve over a cube of N cells on a side
+   capped so that the interleaved key fits in a non-negative bigint
+------------------------------------------------------------------------- */
+
+static int curve_bits(int n, int dimension)
+{
+  int nbits = 0;
+  while ((1 << nbits) < n) nbits++;
+  int maxbits = (8*sizeof(bigint)-1) / dimension;
+  return MIN(nbits,maxbits);
+}
+
+/* ----------------------------------------------------------------------
+   position of integer cell coords C along a Morton or Hilbert curve
+   Hilbert uses the transpose algorithm of J. Skilling,
+     AIP Conf Proc 707, 381 (2004), then interleaves bits like Morton
+------------------------------------------------------------------------- */
+
+static bigint curve_key(int curve, int dimension, int nbits, int *c)
+{
+  unsigned int h[3],p,q,t;
+  int d;
+
+  for (d = 0; d < dimension; d++) h[d] = c[d];
+
+  if (curve == HILBERT && nbits > 0) {
+    unsigned int m = 1U << (nbits-1);
+
+    // inverse undo
+
+    for (q = m; q > 1; q >>= 1) {
+      p = q - 1;
+      for (d = 0; d < dimension; d++) {
+        if (h[d] & q) h[0] ^= p;
+        else {
+          t = (h[0] ^ h[d]) & p;
+          h[0] ^= t;
+          h[d] ^= t;
+        }
+      }
+    }
+
+    // Gray encode
+
+    for (d = 1; d < dimension; d++) h[d] ^= h[d-1];
+    t = 0;
+    for (q = m; q > 1; q >>= 1)
+      if (h[dimension-1] & q) t ^= q - 1;
+    for (d = 0; d < dimension; d++) h[d] ^= t;
+  }
+
+  // interleave bits, most significant first, z slowest within a level
+
+  bigint key = 0;
+  for (int b = nbits-1; b >= 0; b--)
+    for (d = dimension-1; d >= 0; d--)
+      key = (key << 1) | ((h[d] >> b) & 1);
+  return key;
+}
+
+/* ----------------------------------------------------------------------
+   comparison function invoked by qsort() to order by curve key
+   ties broken by index so ordering is deterministic
+------------------------------------------------------------------------- */
+
+int compare_curve(const void *iptr, const void *jptr)
+{
+  const Atom::CurveSort *i = (const Atom::CurveSort *) iptr;
+  const Atom::CurveSort *j = (const Atom::CurveSort *) jptr;
+  if (i->key < j->key) return -1;
+  if (i->key > j->key) return 1;
+  if (i->index < j->index) return -1;
+  if (i->index > j->index) return 1;
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -2166,11 +2391,14 @@ bigint Atom::memory_usage()
   else if (map_style == 2) {
     bytes += map_nbucket*sizeof(int);
     bytes += map_nhash*sizeof(HashElem);
-  }
+  } else if (map_style == 3)
+    bytes += map_nrobin*sizeof(RobinElem);
   if (maxnext) {
     bytes += memory->usage(next,maxnext);
     bytes += memory->usage(permute,maxnext);
   }
+  if (binorder) bytes += memory->usage(binorder,maxbin);
+  bytes += maxcurve*sizeof(CurveSort);
 
   return bytes;
 }
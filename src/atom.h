@@ -181,7 +181,8 @@ class Atom : protected Pointers {
   int nextra_store;
 
   int map_style;                  // style of atom map: 0=none, 1=array, 2=hash
-  int map_user;                   // user selected style = same 0,1,2
+                                  // 3=robin (open-addressing hash)
+  int map_user;                   // user selected style = same 0,1,2,3
   tagint map_tag_max;             // max atom ID that map() is setup for
 
   // spatial sorting of atoms
@@ -189,6 +190,7 @@ class Atom : protected Pointers {
   int sortfreq;             // sort atoms every this many steps, 0 = off
   bigint nextsort;          // next timestep to sort on
   double userbinsize;       // requested sort bin size
+  int sortcurve;            // sort order, 0 = xyz, 1 = Morton, 2 = Hilbert
 
   // indices of atoms with same ID
 
@@ -223,7 +225,7 @@ class Atom : protected Pointers {
 
   void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, int, int, double *);
+  void data_atoms(int, char *, tagint, int, int, double *, int ownall = 0);
   void data_vels(int, char *, tagint);
   void data_bonds(int, char *, int *, tagint, int);
   void data_angles(int, char *, int *, tagint, int);
@@ -249,6 +251,12 @@ class Atom : protected Pointers {
 
   void first_reorder();
   virtual void sort();
+  void curve_order(int, int *);
+
+  struct CurveSort {        // curve key and index of an atom or sort bin
+    bigint key;
+    int index;
+  };
 
   void add_callback(int);
   void delete_callback(const char *, int);
@@ -275,6 +283,7 @@ class Atom : protected Pointers {
   inline int map(tagint global) {
     if (map_style == 1) return map_array[global];
     else if (map_style == 2) return map_find_hash(global);
+    else if (map_style == 3) return map_find_robin(global);
     else return -1;
   };
 
@@ -286,6 +295,25 @@ class Atom : protected Pointers {
   void map_delete();
   int map_find_hash(tagint);
 
+  // lookup in open-addressing table, linear probing so a lookup
+  //   touches one or two adjacent cache lines
+  // robin-hood ordering allows early exit for missing keys:
+  //   stop at empty slot or at entry closer to its home than we are
+  // entries from an older map_stamp are stale and report -1
+
+  inline int map_find_robin(tagint global) {
+    const int mask = map_nrobin - 1;
+    int index = map_home_robin(global);
+    for (int dist = 0; ; dist++) {
+      const RobinElem &e = map_robin[index];
+      if (e.global == global)
+        return (e.stamp == map_stamp) ? e.local : -1;
+      if (e.global == 0 || ((index - map_home_robin(e.global)) & mask) < dist)
+        return -1;
+      index = (index+1) & mask;
+    }
+  };
+
  protected:
 
   // global to local ID mapping
@@ -305,6 +333,27 @@ class Atom : protected Pointers {
   int *map_bucket;      // ptr to 1st entry in each bucket
   HashElem *map_hash;   // hash table
 
+  struct RobinElem {    // open-addressing map
+    tagint global;      // key = global ID, 0 if slot is empty
+    int local;          // value = local index
+    int stamp;          // map_stamp when value was set, stale if older
+  };
+  int map_nrobin;       // # of slots in table, power of 2
+  int map_robinbits;    // log2(map_nrobin)
+  int map_nrobinused;   // # of occupied slots, current and stale
+  int map_stamp;        // current generation, map_clear() increments it
+  RobinElem *map_robin; // open-addressing table
+
+  // home slot via Fibonacci hashing, spreads consecutive IDs
+
+  inline int map_home_robin(tagint global) {
+    return static_cast<int>
+      ((static_cast<uint64_t>(global) * 11400714819323198485ULL) >>
+       (64 - map_robinbits));
+  };
+  int map_insert_robin(tagint, int);
+  void map_rehash_robin(int);
+
   int max_same;         // allocated size of sametag
 
   // spatial sorting of atoms
@@ -316,13 +365,18 @@ class Atom : protected Pointers {
   int *binhead;                   // 1st atom in each bin
   int *next;                      // next atom in bin
   int *permute;                   // permutation vector
+  int *binorder;                  // bins in space-filling curve order
+  int maxcurve;                   // max size of curvesort
   double bininvx,bininvy,bininvz; // inverse actual bin sizes
   double bboxlo[3],bboxhi[3];     // bounding box of my sub-domain
 
   int memlength;                  // allocated size of memstr
   char *memstr;                   // string of array names already counted
 
+  CurveSort *curvesort;           // keys to sort by curve position
+
   void setup_sort_bins();
+  void grow_curve(int);
   int next_prime(int);
 
  private:
@@ -363,6 +417,11 @@ E: Atom_modify map command after simulation box is defined
 The atom_modify map command cannot be used after a read_data,
 read_restart, or create_box command.
 
+E: Too many atoms for robin atom map
+
+The open-addressing atom map is limited to 2^30 slots per processor.
+Use more processors or atom_modify map hash.
+
 E: Atom_modify sort and first options cannot be used together
 
 Self-explanatory.
@@ -30,6 +30,8 @@ using namespace LAMMPS_NS;
      map_nhash = length of hash table
      map_nbucket = # of hash buckets, prime larger than map_nhash * 2
        so buckets will only be filled with 0 or 1 atoms on average
+   for robin option:
+     open-addressing table, grown by map_set() and map_one() as needed
 ------------------------------------------------------------------------- */
 
 void Atom::map_init(int check)
@@ -44,14 +46,18 @@ void Atom::map_init(int check)
 
   if (map_style == 1 && map_tag_max > map_maxarray) recreate = 1;
   else if (map_style == 2 && nlocal+nghost > map_nhash) recreate = 1;
+  else if (map_style == 3 && map_robin == NULL) recreate = 1;
 
   // if not recreating:
   // for array, initialize current map_tag_max values
   // for hash, set all buckets to empty, put all entries in free list
+  // for robin, invalidate all entries via map_clear()
 
   if (!recreate) {
     if (map_style == 1) {
       for (int i = 0; i <= map_tag_max; i++) map_array[i] = -1;
+    } else if (map_style == 3) {
+      map_clear();
     } else {
       for (int i = 0; i < map_nbucket; i++) map_bucket[i] = -1;
       map_nused = 0;
@@ -70,6 +76,19 @@ void Atom::map_init(int check)
       memory->create(map_array,map_maxarray+1,"atom:map_array");
       for (int i = 0; i <= map_tag_max; i++) map_array[i] = -1;
 
+    } else if (map_style == 3) {
+
+      // size table for same # of atoms as hash option,
+      // map_rehash_robin() adds headroom for a low load factor
+
+      int nper = static_cast<int> (natoms/comm->nprocs);
+      int nrobin = MAX(nper,nmax);
+      nrobin *= 2;
+      nrobin = MAX(nrobin,1000);
+
+      map_stamp = 1;
+      map_rehash_robin(nrobin);
+
     } else {
 
       // map_nhash = max # of atoms that can be hashed on this proc
@@ -108,6 +127,9 @@ void Atom::map_init(int check)
    clear global -> local map for all of my own and ghost atoms
    for hash table option:
      global ID may not be in table if image atom was already cleared
+   for robin option:
+     advance stamp so all entries become stale, no per-atom work
+     stale entries are updated in place when the same ID is set again
 ------------------------------------------------------------------------- */
 
 void Atom::map_clear()
@@ -119,6 +141,14 @@ void Atom::map_clear()
       map_array[tag[i]] = -1;
     }
 
+  } else if (map_style == 3) {
+    if (map_stamp == MAXSMALLINT) {
+      for (int i = 0; i < map_nrobin; i++) map_robin[i].global = 0;
+      map_nrobinused = 0;
+      map_stamp = 0;
+    }
+    map_stamp++;
+
   } else {
     int previous,ibucket,index;
     tagint global;
@@ -161,6 +191,10 @@ void Atom::map_clear()
    for hash table option:
      if hash table too small, re-init
      global ID may already be in table if image atom was set
+   for robin option:
+     IDs still present since the last map_set() update their slot in place,
+       only new IDs are inserted, departed IDs stay as stale entries
+     if table could exceed 3/4 load, rehash to drop stale entries and grow
 ------------------------------------------------------------------------- */
 
 void Atom::map_set()
@@ -183,6 +217,19 @@ void Atom::map_set()
       map_array[tag[i]] = i;
     }
 
+  } else if (map_style == 3) {
+
+    if (4*(static_cast<bigint>(map_nrobinused) + nall) >
+        3*static_cast<bigint>(map_nrobin)) map_rehash_robin(nall);
+    if (nall > max_same) {
+      max_same = nall + EXTRA;
+      memory->destroy(sametag);
+      memory->create(sametag,max_same,"atom:sametag");
+    }
+
+    for (int i = nall-1; i >= 0 ; i--)
+      sametag[i] = map_insert_robin(tag[i],i);
+
   } else {
 
     // if this proc has more atoms than hash table size, call map_init()
@@ -246,7 +293,12 @@ void Atom::map_set()
 void Atom::map_one(tagint global, int local)
 {
   if (map_style == 1) map_array[global] = local;
-  else {
+  else if (map_style == 3) {
+    if (4*(static_cast<bigint>(map_nrobinused)+1) >
+        3*static_cast<bigint>(map_nrobin))
+      map_rehash_robin(map_nrobinused);
+    map_insert_robin(global,local);
+  } else {
     // search for key
     // if found it, just overwrite local value with index
 
@@ -336,6 +388,12 @@ void Atom::map_delete()
     }
     map_nhash = 0;
   }
+
+  if (map_robin) {
+    memory->sfree(map_robin);
+    map_robin = NULL;
+  }
+  map_nrobin = map_nrobinused = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -357,6 +415,110 @@ int Atom::map_find_hash(tagint global)
   return local;
 }
 
+/* ----------------------------------------------------------------------
+   set local index for global ID in open-addressing table
+   return previous local index if ID was already set with current stamp,
+     else -1, so map_set() can chain images via sametag
+   robin-hood insertion: a new entry displaces any entry closer to its
+     home slot, which is then carried further along
+   a stale entry is only reused where it would be displaced,
+     so early exit in map_find_robin() stays valid
+------------------------------------------------------------------------- */
+
+int Atom::map_insert_robin(tagint global, int local)
+{
+  const int mask = map_nrobin - 1;
+  int index = map_home_robin(global);
+  int dist = 0;
+  int edist;
+
+  // search for key
+  // if found it, just overwrite local value and stamp
+
+  while (1) {
+    RobinElem &e = map_robin[index];
+    if (e.global == global) {
+      int previous = (e.stamp == map_stamp) ? e.local : -1;
+      e.local = local;
+      e.stamp = map_stamp;
+      return previous;
+    }
+    if (e.global == 0) break;
+    edist = (index - map_home_robin(e.global)) & mask;
+    if (edist < dist) break;
+    index = (index+1) & mask;
+    dist++;
+  }
+
+  // key not in table, insert it at index
+
+  RobinElem cur;
+  cur.global = global;
+  cur.local = local;
+  cur.stamp = map_stamp;
+
+  while (1) {
+    RobinElem &e = map_robin[index];
+    if (e.global == 0) {
+      e = cur;
+      map_nrobinused++;
+      return -1;
+    }
+    edist = (index - map_home_robin(e.global)) & mask;
+    if (edist < dist) {
+      if (e.stamp != map_stamp) {
+        e = cur;
+        return -1;
+      }
+      RobinElem tmp = e;
+      e = cur;
+      cur = tmp;
+      dist = edist;
+    }
+    index = (index+1) & mask;
+    dist++;
+  }
+
+  return -1;
+}
+
+/* ----------------------------------------------------------------------
+   reallocate open-addressing table with room for nextra more IDs
+   keep only entries with current stamp, drop stale ones
+   table length = power of 2 >= 4x # of entries, min 1024
+------------------------------------------------------------------------- */
+
+void Atom::map_rehash_robin(int nextra)
+{
+  RobinElem *old = map_robin;
+  int nold = map_nrobin;
+
+  bigint nkeep = 0;
+  for (int i = 0; i < nold; i++)
+    if (old[i].global && old[i].stamp == map_stamp) nkeep++;
+
+  bigint nwant = 4*(nkeep + nextra);
+  map_robinbits = 10;
+  while (((bigint) 1 << map_robinbits) < nwant) map_robinbits++;
+  if (map_robinbits > 30)
+    error->one(FLERR,"Too many atoms for robin atom map");
+  map_nrobin = 1 << map_robinbits;
+
+  map_robin = (RobinElem *)
+    memory->smalloc(map_nrobin*sizeof(RobinElem),"atom:map_robin");
+  for (int i = 0; i < map_nrobin; i++) {
+    map_robin[i].global = 0;
+    map_robin[i].local = -1;
+    map_robin[i].stamp = 0;
+  }
+  map_nrobinused = 0;
+
+  for (int i = 0; i < nold; i++)
+    if (old[i].global && old[i].stamp == map_stamp)
+      map_insert_robin(old[i].global,old[i].local);
+  memory->sfree(old);
+}
+
 /* ----------------------------------------------------------------------
    return next prime larger than n
 ------------------------------------------------------------------------- */
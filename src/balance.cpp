@@ -39,6 +39,7 @@
 #include "imbalance_neigh.h"
 #include "imbalance_store.h"
 #include "imbalance_var.h"
+#include "imbalance_cost.h"
 #include "timer.h"
 #include "memory.h"
 #include "error.h"
@@ -66,6 +67,8 @@ Balance::Balance(LAMMPS *lmp) : Pointers(lmp)
   nimbalance = 0;
   imbalances = NULL;
   fixstore = NULL;
+  maxwtone = 0;
+  wtone = NULL;
 
   fp = NULL;
   firststep = 1;
@@ -77,6 +80,7 @@ Balance::~Balance()
 {
   memory->destroy(proccost);
   memory->destroy(allproccost);
+  memory->destroy(wtone);
 
   delete [] user_xsplit;
   delete [] user_ysplit;
@@ -251,6 +255,8 @@ void Balance::command(int narg, char **arg)
   // process remaining optional args
 
   options(iarg,narg,arg);
+  if (multiflag && style != BISECTION)
+    error->all(FLERR,"Balance multi yes requires rcb style");
   if (wtflag) weight_storage(NULL);
 
   // insure particles are in current box & update box via shrink-wrap
@@ -458,6 +464,8 @@ void Balance::options(int iarg, int narg, char **arg)
 
   wtflag = 0;
   varflag = 0;
+  multiflag = 0;
+  int storeflag = 0;
   oldrcb = 0;
   outflag = 0;
   int outarg = 0;
@@ -470,30 +478,41 @@ void Balance::options(int iarg, int narg, char **arg)
       int nopt = 0;
       if (strcmp(arg[iarg+1],"group") == 0) {
         imb = new ImbalanceGroup(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"time") == 0) {
         imb = new ImbalanceTime(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"neigh") == 0) {
         imb = new ImbalanceNeigh(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"var") == 0) {
         varflag = 1;
         imb = new ImbalanceVar(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
+        imbalances[nimbalance++] = imb;
+      } else if (strcmp(arg[iarg+1],"cost") == 0) {
+        imb = new ImbalanceCost(lmp);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"store") == 0) {
+        storeflag = 1;
         imb = new ImbalanceStore(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else {
         error->all(FLERR,"Unknown (fix) balance weight method");
       }
       iarg += 2+nopt;
 
+    } else if (strcmp(arg[iarg],"multi") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal (fix) balance command");
+      if (strcmp(arg[iarg+1],"yes") == 0) multiflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) multiflag = 0;
+      else error->all(FLERR,"Illegal (fix) balance command");
+      iarg += 2;
     } else if (strcmp(arg[iarg],"old") == 0) {
       oldrcb = 1;
       iarg++;
@@ -505,6 +524,16 @@ void Balance::options(int iarg, int narg, char **arg)
     } else error->all(FLERR,"Illegal (fix) balance command");
   }
 
+  // multi-constraint balancing only if there are several weight styles
+
+  if (multiflag) {
+    if (storeflag)
+      error->all(FLERR,"Balance weight store cannot be used with multi yes");
+    if (nimbalance > RCB_MAXWEIGHT)
+      error->all(FLERR,"Too many weight styles for balance multi yes");
+    if (nimbalance < 2) multiflag = 0;
+  }
+
   // output file
 
   if (outflag && comm->me == 0) {
@@ -522,6 +551,7 @@ void Balance::options(int iarg, int narg, char **arg)
 void Balance::weight_storage(char *prefix)
 {
   char *fixargs[6];
+  char ncolumn[16];
 
   if (prefix) {
     int n = strlen(prefix) + 32;
@@ -534,9 +564,19 @@ void Balance::weight_storage(char *prefix)
   fixargs[2] = (char *) "STORE";
   fixargs[3] = (char *) "peratom";
   fixargs[4] = (char *) "0";
-  fixargs[5] = (char *) "1";
+
+  // one weight per particle, or one per weight style for multiflag
+
+  int nvalues = 1;
+  if (multiflag) nvalues = nimbalance;
+  sprintf(ncolumn,"%d",nvalues);
+  fixargs[5] = ncolumn;
 
   int ifix = modify->find_fix(fixargs[0]);
+  if (ifix >= 1 && ((FixStore *) modify->fix[ifix])->nvalues != nvalues) {
+    modify->delete_fix(fixargs[0]);
+    ifix = -1;
+  }
   if (ifix < 1) {
     modify->add_fix(6,fixargs);
     fixstore = (FixStore *) modify->fix[modify->nfix-1];
@@ -566,9 +606,27 @@ void Balance::init_imbalance(int flag)
 void Balance::set_weights()
 {
   if (!wtflag) return;
-  weight = fixstore->vstore;
 
   int nlocal = atom->nlocal;
+
+  // multiflag: each Imbalance class sets its own column of weights
+
+  if (multiflag) {
+    if (nlocal > maxwtone) {
+      maxwtone = atom->nmax;
+      memory->destroy(wtone);
+      memory->create(wtone,maxwtone,"balance:wtone");
+    }
+    double **weights = fixstore->astore;
+    for (int n = 0; n < nimbalance; n++) {
+      for (int i = 0; i < nlocal; i++) wtone[i] = 1.0;
+      imbalances[n]->compute(wtone);
+      for (int i = 0; i < nlocal; i++) weights[i][n] = wtone[i];
+    }
+    return;
+  }
+
+  weight = fixstore->vstore;
   for (int i = 0; i < nlocal; i++) weight[i] = 1.0;
   for (int n = 0; n < nimbalance; n++) imbalances[n]->compute(weight);
 }
@@ -577,12 +635,39 @@ void Balance::set_weights()
    calculate imbalance factor based on particle count or particle weights
    return max = max load per proc
    return imbalance = max load per proc / ave load per proc
+   for multiflag, use the weight style with the largest imbalance
 ------------------------------------------------------------------------- */
 
 double Balance::imbalance_factor(double &maxcost)
 {
   double mycost,totalcost;
 
+  if (multiflag) {
+    double mycosts[RCB_MAXWEIGHT],maxcosts[RCB_MAXWEIGHT];
+    double totalcosts[RCB_MAXWEIGHT];
+    double **weights = fixstore->astore;
+    int nlocal = atom->nlocal;
+
+    for (int n = 0; n < nimbalance; n++) mycosts[n] = 0.0;
+    for (int i = 0; i < nlocal; i++)
+      for (int n = 0; n < nimbalance; n++) mycosts[n] += weights[i][n];
+
+    MPI_Allreduce(mycosts,maxcosts,nimbalance,MPI_DOUBLE,MPI_MAX,world);
+    MPI_Allreduce(mycosts,totalcosts,nimbalance,MPI_DOUBLE,MPI_SUM,world);
+
+    double imbalance = 1.0;
+    maxcost = maxcosts[0];
+    for (int n = 0; n < nimbalance; n++) {
+      if (maxcosts[n] <= 0.0) continue;
+      double imbone = maxcosts[n] / (totalcosts[n]/nprocs);
+      if (imbone > imbalance) {
+        imbalance = imbone;
+        maxcost = maxcosts[n];
+      }
+    }
+    return imbalance;
+  }
+
   if (wtflag) {
     weight = fixstore->vstore;
     int nlocal = atom->nlocal;
@@ -650,7 +735,10 @@ int *Balance::bisection(int sortflag)
   // NOTE: (3/2017) can remove undocumented "old" option at some point
   //       ditto in rcb.cpp
 
-  if (oldrcb) {
+  if (multiflag) {
+    rcb->compute_multi(dim,atom->nlocal,atom->x,nimbalance,fixstore->astore,
+                       shrinklo,shrinkhi);
+  } else if (oldrcb) {
     if (wtflag) {
       weight = fixstore->vstore;
       rcb->compute_old(dim,atom->nlocal,atom->x,weight,shrinklo,shrinkhi);
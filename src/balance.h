@@ -31,6 +31,8 @@ class Balance : protected Pointers {
   class FixStore *fixstore;       // per-atom weights stored in FixStore
   int wtflag;                     // 1 if particle weighting is used
   int varflag;                    // 1 if weight style var(iable) is used
+  int multiflag;                  // 1 if each weight style is balanced
+                                  //   separately by multi-constraint RCB
   int outflag;                    // 1 for output of balance results to file
 
   Balance(class LAMMPS *);
@@ -77,6 +79,8 @@ class Balance : protected Pointers {
   int nimbalance;                 // number of user-specified weight styles
   class Imbalance **imbalances;   // list of Imb classes, one per weight style
   double *weight;                 // ptr to FixStore weight vector
+  int maxwtone;                   // allocated size of wtone
+  double *wtone;                  // weights of one style for multiflag
 
   FILE *fp;                  // balance output file
   int firststep;
@@ -129,6 +133,20 @@ E: Lost atoms via balance: original %ld current %ld
 
 This should not occur.  Report the problem to the developers.
 
+E: Balance multi yes requires rcb style
+
+Only the recursive coordinate bisectioning can balance multiple
+weights at once.
+
+E: Too many weight styles for balance multi yes
+
+Multi-constraint balancing supports up to 4 weight styles.
+
+E: Balance weight store cannot be used with multi yes
+
+With multi yes, each weight style produces a separate weight, so there
+is no combined weight to store.
+
 E: Balance produced bad splits
 
 This should not occur.  It means two or more cutting plane locations
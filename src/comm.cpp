@@ -28,6 +28,7 @@
 #include "dump.h"
 #include "group.h"
 #include "procmap.h"
+#include "irregular.h"
 #include "accelerator_kokkos.h"
 #include "memory.h"
 #include "error.h"
@@ -58,6 +59,7 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   cutghostuser = 0.0;
   cutusermulti = NULL;
   ghost_velocity = 0;
+  overlap = 0;
 
   user_procgrid[0] = user_procgrid[1] = user_procgrid[2] = 0;
   coregrid[0] = coregrid[1] = coregrid[2] = 1;
@@ -106,6 +108,8 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   }
 #endif
 
+  nthreads_force = nthreads;
+
 }
 
 /* ---------------------------------------------------------------------- */
@@ -302,6 +306,12 @@ void Comm::modify_params(int narg, char **arg)
       else if (strcmp(arg[iarg+1],"no") == 0) ghost_velocity = 0;
       else error->all(FLERR,"Illegal comm_modify command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"overlap") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal comm_modify command");
+      if (strcmp(arg[iarg+1],"yes") == 0) overlap = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) overlap = 0;
+      else error->all(FLERR,"Illegal comm_modify command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal comm_modify command");
   }
 }
@@ -721,6 +731,84 @@ void Comm::ring(int n, int nper, void *inbuf, int messtag,
   memory->destroy(bufcopy);
 }
 
+/* ----------------------------------------------------------------------
+   rendezvous communication operation
+   three stages:
+     first comm sends inbuf from caller decomp to rvous decomp
+     callback operates on data in rendevous decomp
+     second comm sends outbuf from rvous decomp back to caller decomp
+   meant for situations where no proc knows which procs own the data
+     a datum is typically sent to the proc that owns its atom ID
+     modulo nprocs, so cost scales with data size, not # of procs
+   n = # of datums in inbuf
+   proclist = proc to send each datum to, can include self
+   inbuf = vector of input datums
+   insize = byte size of each input datum
+   callback = caller function to invoke in rendezvous decomposition
+     takes n,inbuf and ptr as args, returns nout,flag,proclist,outbuf
+       nout = # of output datums, also length of proclist
+       flag = 0 for no second comm, 1 if outbuf is inbuf, 2 if new outbuf
+       proclist = proc to send each output datum to
+       outbuf = vector of output datums, allocated with memory->smalloc()
+     callback allocates proclist with memory->create(), comm frees it
+   outbuf = vector of output datums received back in caller decomp
+     allocated here with memory->smalloc(), caller must free it
+   outsize = byte size of each output datum
+   ptr = pointer to caller class, passed to callback()
+   received datums are ordered by sending proc, so result is reproducible
+   return # of datums in outbuf
+------------------------------------------------------------------------- */
+
+int Comm::rendezvous(int n, int *proclist, char *inbuf, int insize,
+                     int (*callback)(int, char *, int &, int *&, char *&,
+                                     void *),
+                     char *&outbuf, int outsize, void *ptr)
+{
+  // comm inbuf from caller decomposition to rendezvous decomposition
+
+  Irregular *irregular = new Irregular(lmp);
+
+  int nrvous = irregular->create_data(n,proclist,1);
+  char *inbuf_rvous = (char *)
+    memory->smalloc((bigint) nrvous*insize,"rendezvous:inbuf");
+  irregular->exchange_data(inbuf,insize,inbuf_rvous);
+
+  irregular->destroy_data();
+  delete irregular;
+
+  // peform rendezvous computation via callback()
+  // callback() allocates/populates proclist_rvous and outbuf_rvous
+
+  int flag;
+  int *proclist_rvous;
+  char *outbuf_rvous;
+
+  int nout_rvous =
+    callback(nrvous,inbuf_rvous,flag,proclist_rvous,outbuf_rvous,ptr);
+
+  if (flag != 1) memory->sfree(inbuf_rvous);
+  if (flag == 0) {
+    outbuf = NULL;
+    return 0;
+  }
+
+  // comm outbuf from rendezvous decomposition back to caller
+
+  irregular = new Irregular(lmp);
+
+  int nout = irregular->create_data(nout_rvous,proclist_rvous,1);
+  outbuf = (char *) memory->smalloc((bigint) nout*outsize,"rendezvous:outbuf");
+  irregular->exchange_data(outbuf_rvous,outsize,outbuf);
+
+  irregular->destroy_data();
+  delete irregular;
+
+  memory->destroy(proclist_rvous);
+  memory->sfree(outbuf_rvous);
+
+  return nout;
+}
+
 /* ----------------------------------------------------------------------
    proc 0 reads Nlines from file into buf and bcasts buf to all procs
    caller allocates buf to max size needed
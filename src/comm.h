@@ -28,6 +28,8 @@ class Comm : protected Pointers {
 
   int me,nprocs;                    // proc info
   int ghost_velocity;               // 1 if ghost atoms have velocity, 0 if not
+  int overlap;                      // 1 if forward comm may overlap with
+                                    //   interior pair computation
   double cutghost[3];               // cutoffs used for acquiring ghost atoms
   double cutghostuser;              // user-specified ghost cutoff (mode == 0)
   double *cutusermulti;            // per type user ghost cutoff (mode == 1)
@@ -39,6 +41,8 @@ class Comm : protected Pointers {
   int maxexchange_atom;             // max contribution to exchange from AtomVec
   int maxexchange_fix;              // max contribution to exchange from Fixes
   int nthreads;                     // OpenMP threads per MPI process
+  int nthreads_force;               // copies of per-atom force arrays,
+                                    //   nthreads or 1 if threads share one
 
   // public settings specific to layout = UNIFORM, NONUNIFORM
 
@@ -70,6 +74,8 @@ class Comm : protected Pointers {
 
   virtual void setup() = 0;                      // setup 3d comm pattern
   virtual void forward_comm(int dummy = 0) = 0;  // forward comm of atom coords
+  virtual void forward_comm_start() {forward_comm();}  // non-blocking variant
+  virtual void forward_comm_finish() {}                //   of forward_comm()
   virtual void reverse_comm() = 0;               // reverse comm of forces
   virtual void exchange() = 0;                   // move atoms to new procs
   virtual void borders() = 0;                    // setup list of atoms to comm
@@ -107,6 +113,9 @@ class Comm : protected Pointers {
 
   void ring(int, int, void *, int, void (*)(int, char *),
             void *, int self = 1);
+  int rendezvous(int, int *, char *, int,
+                 int (*)(int, char *, int &, int *&, char *&, void *),
+                 char *&, int, void *);
   int read_lines_from_file(FILE *, int, int, char *);
   int read_lines_from_file_universe(FILE *, int, int, char *);
 
@@ -58,7 +58,9 @@ CommBrick::CommBrick(LAMMPS *lmp) :
   size_reverse_send(NULL), size_reverse_recv(NULL), 
   slablo(NULL), slabhi(NULL), multilo(NULL), multihi(NULL),
   cutghostmulti(NULL), pbc_flag(NULL), pbc(NULL), firstrecv(NULL), 
-  sendlist(NULL), maxsendlist(NULL), buf_send(NULL), buf_recv(NULL)
+  sendlist(NULL), maxsendlist(NULL), needswap(NULL), buf_send(NULL),
+  buf_recv(NULL), sendoffset(NULL), recvoffset(NULL), buf_overlap(NULL),
+  sendrequest(NULL), recvrequest(NULL)
 {
   style = 0;
   layout = LAYOUT_UNIFORM;
@@ -82,6 +84,7 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+  memory->destroy(buf_overlap);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -124,6 +127,10 @@ void CommBrick::init_buffers()
   maxrecv = BUFMIN;
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 
+  npost = nwait = 0;
+  maxoverlap = 0;
+  buf_overlap = NULL;
+
   maxswap = 6;
   allocate_swap(maxswap);
 
@@ -522,6 +529,128 @@ void CommBrick::forward_comm(int dummy)
   }
 }
 
+/* ----------------------------------------------------------------------
+   begin forward communication of atom coords without blocking
+   post every swap whose send list only holds atoms already up-to-date,
+     i.e. owned atoms or ghosts from swaps already completed
+   remaining swaps are posted by forward_comm_finish()
+   caller may only access owned atom coords until forward_comm_finish()
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_start()
+{
+  // each swap gets its own send (and recv) region in buf_overlap
+  // so multiple swaps can be in flight at once
+
+  int n = 0;
+  for (int iswap = 0; iswap < nswap; iswap++) {
+    sendoffset[iswap] = n;
+    n += sendnum[iswap]*size_forward;
+    if (!comm_x_only) {
+      recvoffset[iswap] = n;
+      n += recvnum[iswap]*size_forward;
+    }
+  }
+
+  if (n > maxoverlap) {
+    maxoverlap = static_cast<int> (BUFFACTOR * n);
+    memory->destroy(buf_overlap);
+    memory->create(buf_overlap,maxoverlap,"comm:buf_overlap");
+  }
+
+  nwait = 0;
+  for (npost = 0; npost < nswap; npost++) {
+    if (needswap[npost] >= nwait) break;
+    forward_comm_post(npost);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   complete forward communication begun by forward_comm_start()
+   post the remaining swaps as the ghosts they depend on arrive
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_finish()
+{
+  for (; npost < nswap; npost++) {
+    forward_comm_wait(needswap[npost]);
+    forward_comm_post(npost);
+  }
+  forward_comm_wait(nswap-1);
+  MPI_Waitall(nswap,sendrequest,MPI_STATUSES_IGNORE);
+}
+
+/* ----------------------------------------------------------------------
+   post non-blocking send/recv for a single swap
+   if other proc is self, just copy, swap is complete on return
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_post(int iswap)
+{
+  int n;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+  double *buf;
+
+  if (sendproc[iswap] != me) {
+    if (size_forward_recv[iswap]) {
+      if (comm_x_only) buf = x[firstrecv[iswap]];
+      else buf = &buf_overlap[recvoffset[iswap]];
+      MPI_Irecv(buf,size_forward_recv[iswap],MPI_DOUBLE,
+                recvproc[iswap],iswap,world,&recvrequest[iswap]);
+    } else recvrequest[iswap] = MPI_REQUEST_NULL;
+
+    buf = &buf_overlap[sendoffset[iswap]];
+    if (ghost_velocity)
+      n = avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],
+                              buf,pbc_flag[iswap],pbc[iswap]);
+    else
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                          buf,pbc_flag[iswap],pbc[iswap]);
+    if (n) MPI_Isend(buf,n,MPI_DOUBLE,sendproc[iswap],iswap,world,
+                     &sendrequest[iswap]);
+    else sendrequest[iswap] = MPI_REQUEST_NULL;
+
+  } else {
+    if (comm_x_only) {
+      if (sendnum[iswap])
+        avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                        x[firstrecv[iswap]],pbc_flag[iswap],pbc[iswap]);
+    } else if (ghost_velocity) {
+      avec->pack_comm_vel(sendnum[iswap],sendlist[iswap],
+                          buf_send,pbc_flag[iswap],pbc[iswap]);
+      avec->unpack_comm_vel(recvnum[iswap],firstrecv[iswap],buf_send);
+    } else {
+      avec->pack_comm(sendnum[iswap],sendlist[iswap],
+                      buf_send,pbc_flag[iswap],pbc[iswap]);
+      avec->unpack_comm(recvnum[iswap],firstrecv[iswap],buf_send);
+    }
+    recvrequest[iswap] = sendrequest[iswap] = MPI_REQUEST_NULL;
+    if (nwait == iswap) nwait++;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   wait for recvs of all posted swaps up to and including swap last
+   unpack recv buffer unless comm_x_only received directly into x
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_wait(int last)
+{
+  AtomVec *avec = atom->avec;
+
+  for (; nwait <= last; nwait++) {
+    MPI_Wait(&recvrequest[nwait],MPI_STATUS_IGNORE);
+    if (sendproc[nwait] == me || comm_x_only) continue;
+    if (ghost_velocity)
+      avec->unpack_comm_vel(recvnum[nwait],firstrecv[nwait],
+                            &buf_overlap[recvoffset[nwait]]);
+    else
+      avec->unpack_comm(recvnum[nwait],firstrecv[nwait],
+                        &buf_overlap[recvoffset[nwait]]);
+  }
+}
+
 /* ----------------------------------------------------------------------
    reverse communication of forces on atoms every timestep
    other per-atom attributes may also be sent via pack/unpack routines
@@ -816,6 +945,21 @@ void CommBrick::borders()
         }
       }
 
+      // order send list by space-filling curve if atom sorting uses one
+      // receiver then stores these ghosts in curve order
+
+      atom->curve_order(nsend,sendlist[iswap]);
+
+      // needswap = last earlier swap whose ghosts are in this send list
+
+      needswap[iswap] = -1;
+      if (nsend) {
+        int ilast = 0;
+        for (i = 0; i < nsend; i++) ilast = MAX(ilast,sendlist[iswap][i]);
+        for (int k = 0; k < iswap; k++)
+          if (recvnum[k] && firstrecv[k] <= ilast) needswap[iswap] = k;
+      }
+
       // pack up list of border atoms
 
       if (nsend*size_border > maxsend) grow_send(nsend*size_border,0);
@@ -1430,6 +1574,11 @@ void CommBrick::allocate_swap(int n)
   memory->create(firstrecv,n,"comm:firstrecv");
   memory->create(pbc_flag,n,"comm:pbc_flag");
   memory->create(pbc,n,6,"comm:pbc");
+  memory->create(needswap,n,"comm:needswap");
+  memory->create(sendoffset,n,"comm:sendoffset");
+  memory->create(recvoffset,n,"comm:recvoffset");
+  sendrequest = new MPI_Request[n];
+  recvrequest = new MPI_Request[n];
 }
 
 /* ----------------------------------------------------------------------
@@ -1460,6 +1609,11 @@ void CommBrick::free_swap()
   memory->destroy(firstrecv);
   memory->destroy(pbc_flag);
   memory->destroy(pbc);
+  memory->destroy(needswap);
+  memory->destroy(sendoffset);
+  memory->destroy(recvoffset);
+  delete [] sendrequest;
+  delete [] recvrequest;
 }
 
 /* ----------------------------------------------------------------------
@@ -1485,5 +1639,6 @@ bigint CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += memory->usage(buf_overlap,maxoverlap);
   return bytes;
 }
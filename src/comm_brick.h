@@ -27,6 +27,8 @@ class CommBrick : public Comm {
   virtual void init();
   virtual void setup();                        // setup 3d comm pattern
   virtual void forward_comm(int dummy = 0);    // forward comm of atom coords
+  virtual void forward_comm_start();           // post non-blocking forward comm
+  virtual void forward_comm_finish();          // complete non-blocking comm
   virtual void reverse_comm();                 // reverse comm of forces
   virtual void exchange();                     // move atoms to new procs
   virtual void borders();                      // setup list of atoms to comm
@@ -68,6 +70,8 @@ class CommBrick : public Comm {
   int *firstrecv;                   // where to put 1st recv atom in each swap
   int **sendlist;                   // list of atoms to send in each swap
   int *maxsendlist;                 // max size of send list for each swap
+  int *needswap;                    // last swap whose ghosts are sent on
+                                    //   in each swap, -1 if only owned atoms
 
   double *buf_send;                 // send buffer for all comm
   double *buf_recv;                 // recv buffer for all comm
@@ -75,6 +79,15 @@ class CommBrick : public Comm {
   int bufextra;                     // extra space beyond maxsend in send buffer
   int smax,rmax;             // max size in atoms of single borders send/recv
 
+  // non-blocking forward comm via forward_comm_start/finish()
+
+  int npost,nwait;                  // # of swaps posted/completed so far
+  int *sendoffset,*recvoffset;      // offset of each swap in buf_overlap
+  double *buf_overlap;              // per-swap send/recv buffers
+  int maxoverlap;                   // current size of buf_overlap
+  MPI_Request *sendrequest;         // in-flight requests for each swap
+  MPI_Request *recvrequest;
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
@@ -84,6 +97,8 @@ class CommBrick : public Comm {
   virtual void grow_recv(int);              // free/allocate recv buffer
   virtual void grow_list(int, int);         // reallocate one sendlist
   virtual void grow_swap(int);              // grow swap and multi arrays
+  void forward_comm_post(int);              // post one non-blocking swap
+  void forward_comm_wait(int);              // complete swaps up to this one
   virtual void allocate_swap(int);          // allocate swap arrays
   virtual void allocate_multi(int);         // allocate multi arrays
   virtual void free_swap();                 // free swap arrays
@@ -828,6 +828,10 @@ void CommTiled::borders()
         }
       }
 
+      // order send list by space-filling curve if atom sorting uses one
+
+      atom->curve_order(ncount,sendlist[iswap][m]);
+
       sendnum[iswap][m] = ncount;
       smaxone = MAX(smaxone,ncount);
       ncountall += ncount;
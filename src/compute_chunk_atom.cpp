@@ -49,10 +49,6 @@ enum{LIMITMAX,LIMITEXACT};
 #define IDMAX 1024*1024
 #define INVOKED_PERATOM 8
 
-// allocate space for static class variable
-
-ComputeChunkAtom *ComputeChunkAtom::cptr;
-
 /* ---------------------------------------------------------------------- */
 
 ComputeChunkAtom::ComputeChunkAtom(LAMMPS *lmp, int narg, char **arg) :
@@ -1014,8 +1010,9 @@ void ComputeChunkAtom::assign_chunk_ids()
    current Nchunk = max ID
    operation:
      use hash to store list of populated IDs that I own
-     add new IDs to populated lists communicated from all other procs
-     final hash has global list of populated ideas
+     if many IDs, remove duplicates across procs via rendezvous comm
+     allgather populated lists from all procs into my hash
+     final hash has global list of populated IDs
    reset Nchunk = length of global list
    called by setup_chunks() when setting Nchunk
    remapping of chunk IDs to smaller Nchunk occurs later in compute_ichunk()
@@ -1051,47 +1048,61 @@ void ComputeChunkAtom::compress_chunk_ids()
   for (pos = hash->begin(); pos != hash->end(); ++pos)
     list[n++] = pos->first;
 
-  // if nall < 1M, just allgather all ID lists on every proc
-  // else perform ring comm
-  // add IDs from all procs to my hash
-
-  if (nball <= IDMAX) {
-
-    // setup for allgatherv
-
-    int nprocs = comm->nprocs;
-    int nall = nball;
-    int *recvcounts,*displs,*listall;
-    memory->create(recvcounts,nprocs,"chunk/atom:recvcounts");
-    memory->create(displs,nprocs,"chunk/atom:displs");
-    memory->create(listall,nall,"chunk/atom:listall");
+  // if nall > 1M, first remove duplicate IDs across procs
+  //   via rendezvous comm, each ID is sent to the proc it hashes to
+  //   callback resets my hash to the unique IDs I receive
+  //   list = those IDs, which are disjoint across procs
+
+  int nprocs = comm->nprocs;
+
+  if (nball > IDMAX) {
+    int *proclist;
+    memory->create(proclist,n,"chunk/atom:proclist");
+    for (int i = 0; i < n; i++) proclist[i] = list[i] % nprocs;
+
+    char *buf;
+    comm->rendezvous(n,proclist,(char *) list,sizeof(int),rendezvous_ids,
+                     buf,sizeof(int),(void *) this);
+    memory->destroy(proclist);
+    memory->destroy(list);
+
+    n = hash->size();
+    memory->create(list,n,"chunk/atom:list");
+    n = 0;
+    for (pos = hash->begin(); pos != hash->end(); ++pos)
+      list[n++] = pos->first;
+  }
 
-    MPI_Allgather(&n,1,MPI_INT,recvcounts,1,MPI_INT,world);
+  // allgather all ID lists on every proc
+  // add IDs from all procs to my hash
 
-    displs[0] = 0;
-    for (int iproc = 1; iproc < nprocs; iproc++)
-      displs[iproc] = displs[iproc-1] + recvcounts[iproc-1];
+  int nall;
+  int *recvcounts,*displs,*listall;
+  memory->create(recvcounts,nprocs,"chunk/atom:recvcounts");
+  memory->create(displs,nprocs,"chunk/atom:displs");
 
-    // allgatherv acquires list of populated IDs from all procs
+  MPI_Allgather(&n,1,MPI_INT,recvcounts,1,MPI_INT,world);
 
-    MPI_Allgatherv(list,n,MPI_INT,listall,recvcounts,displs,MPI_INT,world);
+  displs[0] = 0;
+  for (int iproc = 1; iproc < nprocs; iproc++)
+    displs[iproc] = displs[iproc-1] + recvcounts[iproc-1];
+  nall = displs[nprocs-1] + recvcounts[nprocs-1];
+  memory->create(listall,nall,"chunk/atom:listall");
 
-    // add all unique IDs in listall to my hash
+  // allgatherv acquires list of populated IDs from all procs
 
-    for (int i = 0; i < nall; i++)
-      if (hash->find(listall[i]) == hash->end()) (*hash)[listall[i]] = 0;
+  MPI_Allgatherv(list,n,MPI_INT,listall,recvcounts,displs,MPI_INT,world);
 
-    // clean up
+  // add all unique IDs in listall to my hash
 
-    memory->destroy(recvcounts);
-    memory->destroy(displs);
-    memory->destroy(listall);
+  for (int i = 0; i < nall; i++)
+    if (hash->find(listall[i]) == hash->end()) (*hash)[listall[i]] = 0;
 
-  } else {
-    cptr = this;
-    comm->ring(n,sizeof(int),list,1,idring,NULL,0);
-  }
+  // clean up
 
+  memory->destroy(recvcounts);
+  memory->destroy(displs);
+  memory->destroy(listall);
   memory->destroy(list);
 
   // nchunk = length of hash containing populated IDs from all procs
@@ -1115,17 +1126,26 @@ void ComputeChunkAtom::compress_chunk_ids()
 }
 
 /* ----------------------------------------------------------------------
-   callback from comm->ring()
-   cbuf = list of N chunk IDs from another proc
-   loop over the list, add each to my hash
-   hash ends up storing all unique IDs across all procs
+   callback from comm->rendezvous()
+   inbuf = list of N chunk IDs sent to me by all procs
+   reset my hash to the unique IDs in the list
+   hash IDs are then disjoint across procs
+   flag = 0, no data is sent back
 ------------------------------------------------------------------------- */
 
-void ComputeChunkAtom::idring(int n, char *cbuf)
+int ComputeChunkAtom::rendezvous_ids(int n, char *inbuf,
+                                     int &flag, int *&proclist, char *&outbuf,
+                                     void *ptr)
 {
-  tagint *list = (tagint *) cbuf;
+  ComputeChunkAtom *cptr = (ComputeChunkAtom *) ptr;
   std::map<tagint,int> *hash = cptr->hash;
+  int *list = (int *) inbuf;
+
+  hash->clear();
   for (int i = 0; i < n; i++) (*hash)[list[i]] = 0;
+
+  flag = 0;
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -33,10 +33,6 @@
 
 using namespace LAMMPS_NS;
 
-// allocate space for static class variable
-
-DeleteAtoms *DeleteAtoms::cptr;
-
 /* ---------------------------------------------------------------------- */
 
 DeleteAtoms::DeleteAtoms(LAMMPS *lmp) : Pointers(lmp) {}
@@ -442,33 +438,148 @@ void DeleteAtoms::delete_porosity(int narg, char **arg)
 
 void DeleteAtoms::delete_bond()
 {
-  // hash = for atom IDs being deleted by one processor
-  // list of these IDs is sent around ring
-  // at each stage of ring pass, hash is re-populated with received IDs
+  // set = IDs of atoms I deleted
+  // hash = unique atom IDs in topology lists of my atoms
+  // after query, hash = subset of those IDs deleted by any proc
 
+  std::map<tagint,int> *set = new std::map<tagint,int>();
   hash = new std::map<tagint,int>();
 
-  // list = set of unique molecule IDs from which I deleted atoms
-  // pass list to all other procs via comm->ring()
-
   tagint *tag = atom->tag;
   int nlocal = atom->nlocal;
 
-  int n = 0;
   for (int i = 0; i < nlocal; i++)
-    if (dlist[i]) n++;
-  tagint *list;
-  memory->create(list,n,"delete_atoms:list");
+    if (dlist[i]) (*set)[tag[i]] = 1;
 
-  n = 0;
-  for (int i = 0; i < nlocal; i++)
-    if (dlist[i]) list[n++] = tag[i];
+  int *num_bond = atom->num_bond;
+  int *num_angle = atom->num_angle;
+  int *num_dihedral = atom->num_dihedral;
+  int *num_improper = atom->num_improper;
+
+  int **bond_type = atom->bond_type;
+  tagint **bond_atom = atom->bond_atom;
+
+  int **angle_type = atom->angle_type;
+  tagint **angle_atom1 = atom->angle_atom1;
+  tagint **angle_atom2 = atom->angle_atom2;
+  tagint **angle_atom3 = atom->angle_atom3;
+
+  int **dihedral_type = atom->dihedral_type;
+  tagint **dihedral_atom1 = atom->dihedral_atom1;
+  tagint **dihedral_atom2 = atom->dihedral_atom2;
+  tagint **dihedral_atom3 = atom->dihedral_atom3;
+  tagint **dihedral_atom4 = atom->dihedral_atom4;
+
+  int **improper_type = atom->improper_type;
+  tagint **improper_atom1 = atom->improper_atom1;
+  tagint **improper_atom2 = atom->improper_atom2;
+  tagint **improper_atom3 = atom->improper_atom3;
+  tagint **improper_atom4 = atom->improper_atom4;
+
+  int m,n;
+  for (int i = 0; i < nlocal; i++) {
+    if (num_bond)
+      for (m = 0; m < num_bond[i]; m++)
+        (*hash)[bond_atom[i][m]] = 1;
+    if (num_angle)
+      for (m = 0; m < num_angle[i]; m++) {
+        (*hash)[angle_atom1[i][m]] = 1;
+        (*hash)[angle_atom2[i][m]] = 1;
+        (*hash)[angle_atom3[i][m]] = 1;
+      }
+    if (num_dihedral)
+      for (m = 0; m < num_dihedral[i]; m++) {
+        (*hash)[dihedral_atom1[i][m]] = 1;
+        (*hash)[dihedral_atom2[i][m]] = 1;
+        (*hash)[dihedral_atom3[i][m]] = 1;
+        (*hash)[dihedral_atom4[i][m]] = 1;
+      }
+    if (num_improper)
+      for (m = 0; m < num_improper[i]; m++) {
+        (*hash)[improper_atom1[i][m]] = 1;
+        (*hash)[improper_atom2[i][m]] = 1;
+        (*hash)[improper_atom3[i][m]] = 1;
+        (*hash)[improper_atom4[i][m]] = 1;
+      }
+  }
+
+  query_set(set,hash);
+  delete set;
+
+  // loop over my atoms and their bond topology lists
+  // if any atom in an interaction matches atom ID in hash, delete interaction
+
+  for (int i = 0; i < nlocal; i++) {
+    if (num_bond) {
+      m = 0;
+      n = num_bond[i];
+      while (m < n) {
+        if (hash->find(bond_atom[i][m]) != hash->end()) {
+          bond_type[i][m] = bond_type[i][n-1];
+          bond_atom[i][m] = bond_atom[i][n-1];
+          n--;
+        } else m++;
+      }
+      num_bond[i] = n;
+    }
 
-  cptr = this;
-  comm->ring(n,sizeof(tagint),list,1,bondring,NULL);
+    if (num_angle) {
+      m = 0;
+      n = num_angle[i];
+      while (m < n) {
+        if (hash->find(angle_atom1[i][m]) != hash->end() ||
+            hash->find(angle_atom2[i][m]) != hash->end() ||
+            hash->find(angle_atom3[i][m]) != hash->end()) {
+          angle_type[i][m] = angle_type[i][n-1];
+          angle_atom1[i][m] = angle_atom1[i][n-1];
+          angle_atom2[i][m] = angle_atom2[i][n-1];
+          angle_atom3[i][m] = angle_atom3[i][n-1];
+          n--;
+        } else m++;
+      }
+      num_angle[i] = n;
+    }
+
+    if (num_dihedral) {
+      m = 0;
+      n = num_dihedral[i];
+      while (m < n) {
+        if (hash->find(dihedral_atom1[i][m]) != hash->end() ||
+            hash->find(dihedral_atom2[i][m]) != hash->end() ||
+            hash->find(dihedral_atom3[i][m]) != hash->end() ||
+            hash->find(dihedral_atom4[i][m]) != hash->end()) {
+          dihedral_type[i][m] = dihedral_type[i][n-1];
+          dihedral_atom1[i][m] = dihedral_atom1[i][n-1];
+          dihedral_atom2[i][m] = dihedral_atom2[i][n-1];
+          dihedral_atom3[i][m] = dihedral_atom3[i][n-1];
+          dihedral_atom4[i][m] = dihedral_atom4[i][n-1];
+          n--;
+        } else m++;
+      }
+      num_dihedral[i] = n;
+    }
+
+    if (num_improper) {
+      m = 0;
+      n = num_improper[i];
+      while (m < n) {
+        if (hash->find(improper_atom1[i][m]) != hash->end() ||
+            hash->find(improper_atom2[i][m]) != hash->end() ||
+            hash->find(improper_atom3[i][m]) != hash->end() ||
+            hash->find(improper_atom4[i][m]) != hash->end()) {
+          improper_type[i][m] = improper_type[i][n-1];
+          improper_atom1[i][m] = improper_atom1[i][n-1];
+          improper_atom2[i][m] = improper_atom2[i][n-1];
+          improper_atom3[i][m] = improper_atom3[i][n-1];
+          improper_atom4[i][m] = improper_atom4[i][n-1];
+          n--;
+        } else m++;
+      }
+      num_improper[i] = n;
+    }
+  }
 
   delete hash;
-  memory->destroy(list);
 }
 
 /* ----------------------------------------------------------------------
@@ -479,8 +590,11 @@ void DeleteAtoms::delete_bond()
 
 void DeleteAtoms::delete_molecule()
 {
-  // hash = unique molecule IDs from which I deleted atoms
+  // set = unique molecule IDs from which I deleted atoms
+  // hash = unique molecule IDs of my other atoms
+  // after query, hash = subset of those molecules with deletions on any proc
 
+  std::map<tagint,int> *set = new std::map<tagint,int>();
   hash = new std::map<tagint,int>();
 
   tagint *molecule = atom->molecule;
@@ -488,26 +602,79 @@ void DeleteAtoms::delete_molecule()
 
   for (int i = 0; i < nlocal; i++) {
     if (molecule[i] == 0) continue;
-    if (dlist[i] && hash->find(molecule[i]) == hash->end())
-      (*hash)[molecule[i]] = 1;
+    if (dlist[i]) (*set)[molecule[i]] = 1;
+  }
+  for (int i = 0; i < nlocal; i++) {
+    if (molecule[i] == 0 || dlist[i]) continue;
+    if (set->find(molecule[i]) == set->end()) (*hash)[molecule[i]] = 1;
+  }
+
+  query_set(set,hash);
+
+  // loop over my atoms, if molecule ID is in either hash, delete that atom
+
+  for (int i = 0; i < nlocal; i++) {
+    if (molecule[i] == 0) continue;
+    if (set->find(molecule[i]) != set->end() ||
+        hash->find(molecule[i]) != hash->end()) dlist[i] = 1;
   }
 
-  // list = set of unique molecule IDs from which I deleted atoms
-  // pass list to all other procs via comm->ring()
+  delete set;
+  delete hash;
+}
+
+/* ----------------------------------------------------------------------
+   find which IDs in query are in the union of set across all procs
+   uses rendezvous comm to send both to the proc each ID hashes to
+   on return, query only contains IDs that are in the global set
+------------------------------------------------------------------------- */
+
+void DeleteAtoms::query_set(std::map<tagint,int> *set,
+                            std::map<tagint,int> *query)
+{
+  int me = comm->me;
+  int nprocs = comm->nprocs;
 
-  int n = hash->size();
-  tagint *list;
-  memory->create(list,n,"delete_atoms:list");
+  // proc = -1 flags an ID in set, else it is the querying proc
+
+  int nsend = set->size() + query->size();
+
+  int *proclist;
+  memory->create(proclist,nsend,"delete_atoms:proclist");
+  IDRvous *inbuf = (IDRvous *)
+    memory->smalloc((bigint) nsend*sizeof(IDRvous),"delete_atoms:inbuf");
 
-  n = 0;
   std::map<tagint,int>::iterator pos;
-  for (pos = hash->begin(); pos != hash->end(); ++pos) list[n++] = pos->first;
 
-  cptr = this;
-  comm->ring(n,sizeof(tagint),list,1,molring,NULL);
+  nsend = 0;
+  for (pos = set->begin(); pos != set->end(); ++pos) {
+    proclist[nsend] = pos->first % nprocs;
+    inbuf[nsend].id = pos->first;
+    inbuf[nsend].proc = -1;
+    nsend++;
+  }
+  for (pos = query->begin(); pos != query->end(); ++pos) {
+    proclist[nsend] = pos->first % nprocs;
+    inbuf[nsend].id = pos->first;
+    inbuf[nsend].proc = me;
+    nsend++;
+  }
 
-  delete hash;
-  memory->destroy(list);
+  // perform rendezvous operation
+  // returned datums are queried IDs that are in the set
+
+  char *buf;
+  int nreturn = comm->rendezvous(nsend,proclist,(char *) inbuf,
+                                 sizeof(IDRvous),rendezvous_query,
+                                 buf,sizeof(IDRvous),(void *) this);
+  IDRvous *outbuf = (IDRvous *) buf;
+
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+
+  query->clear();
+  for (int m = 0; m < nreturn; m++) (*query)[outbuf[m].id] = 1;
+  memory->sfree(outbuf);
 }
 
 /* ----------------------------------------------------------------------
@@ -573,142 +740,38 @@ void DeleteAtoms::recount_topology()
 }
 
 /* ----------------------------------------------------------------------
-   callback from comm->ring() in delete_bond()
+   callback from comm->rendezvous() in query_set()
+   inbuf = IDs in set (proc = -1) and queried IDs (proc >= 0)
+   return each queried ID that is in set to the proc that asked for it
+   outbuf = same as inbuf, compressed to the returned datums
 ------------------------------------------------------------------------- */
 
-void DeleteAtoms::bondring(int nbuf, char *cbuf)
+int DeleteAtoms::rendezvous_query(int n, char *inbuf,
+                                  int &flag, int *&proclist, char *&outbuf,
+                                  void *ptr)
 {
-  tagint *list = (tagint *) cbuf;
-  std::map<tagint,int> *hash = cptr->hash;
-
-  int *num_bond = cptr->atom->num_bond;
-  int *num_angle = cptr->atom->num_angle;
-  int *num_dihedral = cptr->atom->num_dihedral;
-  int *num_improper = cptr->atom->num_improper;
+  DeleteAtoms *daptr = (DeleteAtoms *) ptr;
+  Memory *memory = daptr->memory;
 
-  int **bond_type = cptr->atom->bond_type;
-  tagint **bond_atom = cptr->atom->bond_atom;
+  IDRvous *in = (IDRvous *) inbuf;
 
-  int **angle_type = cptr->atom->angle_type;
-  tagint **angle_atom1 = cptr->atom->angle_atom1;
-  tagint **angle_atom2 = cptr->atom->angle_atom2;
-  tagint **angle_atom3 = cptr->atom->angle_atom3;
+  std::map<tagint,int> set;
+  for (int i = 0; i < n; i++)
+    if (in[i].proc < 0) set[in[i].id] = 1;
 
-  int **dihedral_type = cptr->atom->dihedral_type;
-  tagint **dihedral_atom1 = cptr->atom->dihedral_atom1;
-  tagint **dihedral_atom2 = cptr->atom->dihedral_atom2;
-  tagint **dihedral_atom3 = cptr->atom->dihedral_atom3;
-  tagint **dihedral_atom4 = cptr->atom->dihedral_atom4;
-
-  int **improper_type = cptr->atom->improper_type;
-  tagint **improper_atom1 = cptr->atom->improper_atom1;
-  tagint **improper_atom2 = cptr->atom->improper_atom2;
-  tagint **improper_atom3 = cptr->atom->improper_atom3;
-  tagint **improper_atom4 = cptr->atom->improper_atom4;
-
-  int nlocal = cptr->atom->nlocal;
-
-  // cbuf = list of N deleted atom IDs from other proc, put them in hash
-
-  hash->clear();
-  for (int i = 0; i < nbuf; i++) (*hash)[list[i]] = 1;
-
-  // loop over my atoms and their bond topology lists
-  // if any atom in an interaction matches atom ID in hash, delete interaction
-
-  int m,n;
-  for (int i = 0; i < nlocal; i++) {
-    if (num_bond) {
-      m = 0;
-      n = num_bond[i];
-      while (m < n) {
-        if (hash->find(bond_atom[i][m]) != hash->end()) {
-          bond_type[i][m] = bond_type[i][n-1];
-          bond_atom[i][m] = bond_atom[i][n-1];
-          n--;
-        } else m++;
-      }
-      num_bond[i] = n;
-    }
+  memory->create(proclist,n,"delete_atoms:proclist");
 
-    if (num_angle) {
-      m = 0;
-      n = num_angle[i];
-      while (m < n) {
-        if (hash->find(angle_atom1[i][m]) != hash->end() ||
-            hash->find(angle_atom2[i][m]) != hash->end() ||
-            hash->find(angle_atom3[i][m]) != hash->end()) {
-          angle_type[i][m] = angle_type[i][n-1];
-          angle_atom1[i][m] = angle_atom1[i][n-1];
-          angle_atom2[i][m] = angle_atom2[i][n-1];
-          angle_atom3[i][m] = angle_atom3[i][n-1];
-          n--;
-        } else m++;
-      }
-      num_angle[i] = n;
-    }
-
-    if (num_dihedral) {
-      m = 0;
-      n = num_dihedral[i];
-      while (m < n) {
-        if (hash->find(dihedral_atom1[i][m]) != hash->end() ||
-            hash->find(dihedral_atom2[i][m]) != hash->end() ||
-            hash->find(dihedral_atom3[i][m]) != hash->end() ||
-            hash->find(dihedral_atom4[i][m]) != hash->end()) {
-          dihedral_type[i][m] = dihedral_type[i][n-1];
-          dihedral_atom1[i][m] = dihedral_atom1[i][n-1];
-          dihedral_atom2[i][m] = dihedral_atom2[i][n-1];
-          dihedral_atom3[i][m] = dihedral_atom3[i][n-1];
-          dihedral_atom4[i][m] = dihedral_atom4[i][n-1];
-          n--;
-        } else m++;
-      }
-      num_dihedral[i] = n;
-    }
-
-    if (num_improper) {
-      m = 0;
-      n = num_improper[i];
-      while (m < n) {
-        if (hash->find(improper_atom1[i][m]) != hash->end() ||
-            hash->find(improper_atom2[i][m]) != hash->end() ||
-            hash->find(improper_atom3[i][m]) != hash->end() ||
-            hash->find(improper_atom4[i][m]) != hash->end()) {
-          improper_type[i][m] = improper_type[i][n-1];
-          improper_atom1[i][m] = improper_atom1[i][n-1];
-          improper_atom2[i][m] = improper_atom2[i][n-1];
-          improper_atom3[i][m] = improper_atom3[i][n-1];
-          improper_atom4[i][m] = improper_atom4[i][n-1];
-          n--;
-        } else m++;
-      }
-      num_improper[i] = n;
-    }
+  int nout = 0;
+  for (int i = 0; i < n; i++) {
+    if (in[i].proc < 0) continue;
+    if (set.find(in[i].id) == set.end()) continue;
+    proclist[nout] = in[i].proc;
+    in[nout++] = in[i];
   }
-}
-
-/* ----------------------------------------------------------------------
-   callback from comm->ring() in delete_molecule()
-------------------------------------------------------------------------- */
 
-void DeleteAtoms::molring(int n, char *cbuf)
-{
-  tagint *list = (tagint *) cbuf;
-  int *dlist = cptr->dlist;
-  std::map<tagint,int> *hash = cptr->hash;
-  int nlocal = cptr->atom->nlocal;
-  tagint *molecule = cptr->atom->molecule;
-
-  // cbuf = list of N molecule IDs from other proc, put them in hash
-
-  hash->clear();
-  for (int i = 0; i < n; i++) (*hash)[list[i]] = 1;
-
-  // loop over my atoms, if matches molecule ID in hash, delete that atom
-
-  for (int i = 0; i < nlocal; i++)
-    if (hash->find(molecule[i]) != hash->end()) dlist[i] = 1;
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
 }
 
 /* ----------------------------------------------------------------------
@@ -42,6 +42,7 @@ class DeleteAtoms : protected Pointers {
 
   void delete_bond();
   void delete_molecule();
+  void query_set(std::map<tagint,int> *, std::map<tagint,int> *);
   void recount_topology();
   void options(int, char **);
 
@@ -49,12 +50,14 @@ class DeleteAtoms : protected Pointers {
     return j >> SBBITS & 3;
   }
 
-  // static variable for ring communication callback to access class data
-  // callback functions for ring communication
+  // rendezvous datum and callback for set membership queries
 
-  static DeleteAtoms *cptr;
-  static void bondring(int, char *);
-  static void molring(int, char *);
+  struct IDRvous {
+    tagint id;
+    int proc;
+  };
+
+  static int rendezvous_query(int, char *, int &, int *&, char *&, void *);
 };
 
 }
@@ -28,6 +28,10 @@
 #include "modify.h"
 #include "fix.h"
 
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
 using namespace LAMMPS_NS;
 
 // allocate space for static class variable
@@ -80,6 +84,8 @@ Dump::Dump(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
   padflag = 0;
   pbcflag = 0;
   
@@ -96,11 +102,19 @@ Dump::Dump(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
   xpbc = vpbc = NULL;
   imagepbc = NULL;
 
+  async_pending = 0;
+  async_thread = NULL;
+  async_buf = NULL;
+  async_size = 0;
+  async_fp = NULL;
+  async_close = async_flush = 0;
+
   // parse filename for special syntax
   // if contains '%', write one file per proc and replace % with proc-ID
   // if contains '*', write one file per timestep and replace * with timestep
   // check file suffixes
   //   if ends in .bin = binary file
+  //   else if ends in .lmpbin = indexed binary file, self-describing frames
   //   else if ends in .gz = gzipped text file
   //   else ASCII text file
 
@@ -108,6 +122,7 @@ Dump::Dump(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
   singlefile_opened = 0;
   compressed = 0;
   binary = 0;
+  indexed = 0;
   multifile = 0;
 
   multiproc = 0;
@@ -137,6 +152,10 @@ Dump::Dump(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
 
   char *suffix = filename + strlen(filename) - strlen(".bin");
   if (suffix > filename && strcmp(suffix,".bin") == 0) binary = 1;
+  suffix = filename + strlen(filename) - strlen(".lmpbin");
+  if (suffix > filename && strcmp(suffix,".lmpbin") == 0) binary = indexed = 1;
+  if (indexed && strcmp(style,"custom") != 0)
+    error->all(FLERR,"Dump indexed binary file requires dump style custom");
   suffix = filename + strlen(filename) - strlen(".gz");
   if (suffix > filename && strcmp(suffix,".gz") == 0) compressed = 1;
 }
@@ -145,6 +164,13 @@ Dump::Dump(LAMMPS *lmp, int narg, char **arg) : Pointers(lmp)
 
 Dump::~Dump()
 {
+  // let I/O thread finish writing last snapshot
+
+  async_wait();
+#if !defined(_WIN32)
+  delete (pthread_t *) async_thread;
+#endif
+
   delete [] id;
   delete [] style;
   delete [] filename;
@@ -305,6 +331,21 @@ void Dump::write()
 
   if (multifile) openfile();
 
+  // with asynchronous output, filewriter writes header and data
+  //   of this snapshot to a memory stream, not to the file
+  // fpfile = the file, passed to I/O thread at end of snapshot
+
+  FILE *fpfile = NULL;
+  char *snapbuf = NULL;
+  size_t snapsize = 0;
+
+  if (async_flag && filewriter) {
+    fpfile = fp;
+    fp = async_open(&snapbuf,&snapsize);
+    if (fp == NULL)
+      error->one(FLERR,"Cannot open memory stream for asynchronous dump");
+  }
+
   // simulation box bounds
 
   if (domain->triclinic == 0) {
@@ -475,6 +516,17 @@ void Dump::write()
     atom->image = imagehold;
   }
 
+  // hand formatted snapshot to I/O thread
+  // it also closes the file if file per timestep
+
+  if (async_flag && filewriter) {
+    fclose(fp);
+    fp = fpfile;
+    async_start(snapbuf,snapsize);
+    if (multifile) fp = NULL;
+    return;
+  }
+
   // if file per timestep, close file if I am filewriter
 
   if (multifile) {
@@ -792,6 +844,9 @@ void Dump::modify_params(int narg, char **arg)
       if (strcmp(arg[iarg+1],"yes") == 0) append_flag = 1;
       else if (strcmp(arg[iarg+1],"no") == 0) append_flag = 0;
       else error->all(FLERR,"Illegal dump_modify command");
+      if (append_flag && indexed)
+        error->all(FLERR,"Dump_modify append yes not allowed for "
+                   "indexed binary dump file");
       iarg += 2;
 
     } else if (strcmp(arg[iarg],"buffer") == 0) {
@@ -803,6 +858,20 @@ void Dump::modify_params(int narg, char **arg)
         error->all(FLERR,"Dump_modify buffer yes not allowed for this style");
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
+      async_wait();
+      if (strcmp(arg[iarg+1],"yes") == 0) async_flag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) async_flag = 0;
+      else error->all(FLERR,"Illegal dump_modify command");
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+#if defined(_WIN32)
+      if (async_flag)
+        error->all(FLERR,"Dump_modify async yes not supported on this platform");
+#endif
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"every") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal dump_modify command");
       int idump;
@@ -986,6 +1055,98 @@ void Dump::pbc_allocate()
   memory->create(imagepbc,maxpbc,"dump:imagebpc");
 }
 
+/* ----------------------------------------------------------------------
+   complete pending asynchronous write and flush file
+   called before restart files are written and at end of run
+------------------------------------------------------------------------- */
+
+void Dump::flush_async()
+{
+  if (!async_pending) return;
+  async_wait();
+  if (multifile == 0 && filewriter && fp) fflush(fp);
+}
+
+/* ----------------------------------------------------------------------
+   open memory stream that grows as snapshot is written to it
+   buffer ptr and size are valid after stream is closed
+------------------------------------------------------------------------- */
+
+FILE *Dump::async_open(char **ptr, size_t *size)
+{
+#if defined(_WIN32)
+  return NULL;
+#else
+  return open_memstream(ptr,size);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   start I/O thread that writes snapshot in buffer to file fp
+   waits for the previous snapshot to be written first,
+     so at most 2 snapshots are held in memory,
+     one being written and one being formatted
+   I/O thread takes ownership of buffer
+   if thread cannot be created, write snapshot directly
+------------------------------------------------------------------------- */
+
+void Dump::async_start(char *snapbuf, size_t snapsize)
+{
+  async_wait();
+
+  async_buf = snapbuf;
+  async_size = snapsize;
+  async_fp = fp;
+  async_close = 0;
+  if (multifile) async_close = compressed ? 2 : 1;
+  async_flush = flush_flag;
+
+#if !defined(_WIN32)
+  if (async_thread == NULL) async_thread = (void *) new pthread_t;
+  if (pthread_create((pthread_t *) async_thread,NULL,&Dump::async_write,
+                     (void *) this) == 0) {
+    async_pending = 1;
+    return;
+  }
+#endif
+
+  async_write((void *) this);
+}
+
+/* ----------------------------------------------------------------------
+   wait for I/O thread to finish current snapshot
+------------------------------------------------------------------------- */
+
+void Dump::async_wait()
+{
+  if (!async_pending) return;
+#if !defined(_WIN32)
+  pthread_join(*((pthread_t *) async_thread),NULL);
+#endif
+  async_pending = 0;
+}
+
+/* ----------------------------------------------------------------------
+   body of I/O thread, only performs file operations, no MPI calls
+------------------------------------------------------------------------- */
+
+void *Dump::async_write(void *ptr)
+{
+  Dump *dump = (Dump *) ptr;
+
+  if (dump->async_fp) {
+    fwrite(dump->async_buf,sizeof(char),dump->async_size,dump->async_fp);
+    if (dump->async_close == 1) fclose(dump->async_fp);
+    else if (dump->async_close == 2) pclose(dump->async_fp);
+    else if (dump->async_flush) fflush(dump->async_fp);
+  }
+
+  free(dump->async_buf);
+  dump->async_buf = NULL;
+  dump->async_fp = NULL;
+  return NULL;
+}
+
 /* ----------------------------------------------------------------------
    return # of bytes of allocated memory
 ------------------------------------------------------------------------- */
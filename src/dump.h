@@ -49,12 +49,14 @@ class Dump : protected Pointers {
 
   void modify_params(int, char **);
   virtual bigint memory_usage();
+  void flush_async();           // complete pending asynchronous file write
 
  protected:
   int me,nprocs;             // proc info
 
   int compressed;            // 1 if dump file is written compressed, 0 no
   int binary;                // 1 if dump file is written binary, 0 no
+  int indexed;               // 1 if binary file is self-describing + indexed
   int multifile;             // 0 = one big file, 1 = one file per timestep
   int multiproc;             // 0 = proc 0 writes for all,
                              // else # of procs writing files
@@ -70,6 +72,8 @@ class Dump : protected Pointers {
   int append_flag;           // 1 if open file in append mode, 0 if not
   int buffer_allow;          // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;           // 1 if buffer output as one big string, 0 if not
+  int async_allow;           // 1 if style allows for async_flag, 0 if not
+  int async_flag;            // 1 if file writes are done by an I/O thread
   int padflag;               // timestep padding in filename
   int pbcflag;               // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;     // 1 = one big file, already opened, else 0
@@ -123,6 +127,17 @@ class Dump : protected Pointers {
 
   class Irregular *irregular;
 
+  // asynchronous output: filewriter formats a snapshot into memory,
+  //   a separate thread writes it to the file while the run continues
+
+  int async_pending;         // 1 if I/O thread is running
+  void *async_thread;        // ptr to pthread_t of I/O thread
+  char *async_buf;           // snapshot being written by I/O thread
+  size_t async_size;         // # of bytes in async_buf
+  FILE *async_fp;            // file the I/O thread writes to
+  int async_close;           // 0 = leave open, 1 = fclose, 2 = pclose
+  int async_flush;           // 1 if I/O thread flushes file after write
+
   virtual void init_style() = 0;
   virtual void openfile();
   virtual int modify_param(int, char **) {return 0;}
@@ -132,6 +147,11 @@ class Dump : protected Pointers {
   virtual int convert_string(int, double *) {return 0;}
   virtual void write_data(int, double *) = 0;
   void pbc_allocate();
+
+  FILE *async_open(char **, size_t *);
+  void async_start(char *, size_t);
+  void async_wait();
+  static void *async_write(void *);
     
   void sort();
   static int idcompare(const void *, const void *);
@@ -150,6 +170,15 @@ E: Dump file MPI-IO output not allowed with % in filename
 This is because a % signifies one file per processor and MPI-IO
 creates one large file for all processors.
 
+E: Dump indexed binary file requires dump style custom
+
+Only dump style custom can write a file with the *.lmpbin suffix.
+
+E: Dump_modify append yes not allowed for indexed binary dump file
+
+A file with the *.lmpbin suffix starts with a header and ends with an
+index of all its snapshots, so it cannot be appended to.
+
 E: Cannot dump sort when multiple dump files are written
 
 In this mode, each processor dumps its atoms to a file, so
@@ -186,6 +215,11 @@ E: Cannot open dump file
 
 Self-explanatory.
 
+E: Cannot open memory stream for asynchronous dump
+
+The processor writing the dump file could not allocate memory to
+format a snapshot in.
+
 E: Illegal ... command
 
 Self-explanatory.  Check the input script syntax and compare to the
@@ -196,6 +230,15 @@ E: Dump_modify buffer yes not allowed for this style
 
 Self-explanatory.
 
+E: Dump_modify async yes not allowed for this style
+
+Only dump styles atom, cfg, custom, and local can write
+asynchronously.
+
+E: Dump_modify async yes not supported on this platform
+
+Asynchronous dump output requires POSIX threads.
+
 E: Cannot use dump_modify fileper without % in dump file name
 
 Self-explanatory.
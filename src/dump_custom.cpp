@@ -50,6 +50,15 @@ enum{INT,DOUBLE,STRING,BIGINT};    // same as in DumpCFG
 #define INVOKED_PERATOM 8
 #define ONEFIELD 32
 #define DELTA 1048576
+#define DELTA_INDEX 1024
+
+// indexed binary file format, also in reader_binary.cpp
+
+#define LMPBIN_MAGIC "LAMMPS BINDUMP\0\0"
+#define LMPBIN_MAGIC_LEN 16
+#define LMPBIN_REVISION 1
+#define LMPBIN_FOOTER "LMPINDEX"
+#define LMPBIN_FOOTER_LEN 8
 
 /* ---------------------------------------------------------------------- */
 
@@ -57,15 +66,23 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
   Dump(lmp, narg, arg),
   idregion(NULL), thresh_array(NULL), thresh_op(NULL), thresh_value(NULL),
   thresh_last(NULL), thresh_fix(NULL), thresh_fixID(NULL), thresh_first(NULL),
-  earg(NULL), vtype(NULL), vformat(NULL), columns(NULL), choose(NULL),
-  dchoose(NULL), clist(NULL), field2index(NULL), argindex(NULL), id_compute(NULL),
+  earg(NULL), vtype(NULL), vformat(NULL), columns(NULL), indexstep(NULL),
+  indexoffset(NULL), choose(NULL), dchoose(NULL), clist(NULL),
+  field2index(NULL), argindex(NULL), id_compute(NULL),
   compute(NULL), id_fix(NULL), fix(NULL), id_variable(NULL), variable(NULL),
-  vbuf(NULL), id_custom(NULL), flag_custom(NULL), typenames(NULL), pack_choice(NULL)
+  vbuf(NULL), id_custom(NULL), flag_custom(NULL), typenames(NULL),
+  pack_choice(NULL)
 {
   if (narg == 5) error->all(FLERR,"No dump custom arguments specified");
 
   clearstep = 1;
 
+  if (indexed && multiproc)
+    error->all(FLERR,"Dump custom indexed binary file cannot be "
+               "written by multiple procs");
+  fileoffset = 0;
+  nindex = maxindex = 0;
+
   nevery = force->inumeric(FLERR,arg[3]);
   if (nevery <= 0) error->all(FLERR,"Illegal dump custom command");
 
@@ -87,6 +104,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
   iregion = -1;
   idregion = NULL;
 
@@ -190,6 +208,20 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
 DumpCustom::~DumpCustom()
 {
+  // indexed binary file ends with frame index, written once file is complete
+  // last snapshot may still be in flight with asynchronous output
+
+  if (indexed && multifile == 0 && filewriter && fp && nindex) {
+    async_wait();
+    fwrite(indexstep,sizeof(bigint),nindex,fp);
+    fwrite(indexoffset,sizeof(bigint),nindex,fp);
+    bigint bnindex = nindex;
+    fwrite(&bnindex,sizeof(bigint),1,fp);
+    fwrite(LMPBIN_FOOTER,sizeof(char),LMPBIN_FOOTER_LEN,fp);
+  }
+  memory->destroy(indexstep);
+  memory->destroy(indexoffset);
+
   // if wildcard expansion occurred, free earg memory from expand_args()
   // could not do in constructor, b/c some derived classes process earg
 
@@ -310,7 +342,9 @@ void DumpCustom::init_style()
 
   // setup function ptrs
 
-  if (binary && domain->triclinic == 0)
+  if (indexed)
+    header_choice = &DumpCustom::header_indexed;
+  else if (binary && domain->triclinic == 0)
     header_choice = &DumpCustom::header_binary;
   else if (binary && domain->triclinic == 1)
     header_choice = &DumpCustom::header_binary_triclinic;
@@ -319,7 +353,8 @@ void DumpCustom::init_style()
   else if (!binary && domain->triclinic == 1)
     header_choice = &DumpCustom::header_item_triclinic;
 
-  if (binary) write_choice = &DumpCustom::write_binary;
+  if (indexed) write_choice = &DumpCustom::write_indexed;
+  else if (binary) write_choice = &DumpCustom::write_binary;
   else if (buffer_flag == 1) write_choice = &DumpCustom::write_string;
   else write_choice = &DumpCustom::write_lines;
 
@@ -419,6 +454,62 @@ void DumpCustom::header_binary_triclinic(bigint ndump)
   else fwrite(&nprocs,sizeof(int),1,fp);
 }
 
+/* ----------------------------------------------------------------------
+   frame header of indexed binary file, preceded by file header in new file
+   each frame is self-describing: size in bytes, box, column labels
+   only called on proc 0, which tracks byte offsets for the frame index
+------------------------------------------------------------------------- */
+
+void DumpCustom::header_indexed(bigint ndump)
+{
+  if (multifile || fileoffset == 0) {
+    int endian = 1;
+    int revision = LMPBIN_REVISION;
+    fwrite(LMPBIN_MAGIC,sizeof(char),LMPBIN_MAGIC_LEN,fp);
+    fwrite(&endian,sizeof(int),1,fp);
+    fwrite(&revision,sizeof(int),1,fp);
+    fileoffset = LMPBIN_MAGIC_LEN*sizeof(char) + 2*sizeof(int);
+    nindex = 0;
+  }
+
+  int nchar = strlen(columns) + 1;
+  bigint framesize = 3*sizeof(bigint) + 9*sizeof(int) + 9*sizeof(double) +
+    nchar*sizeof(char) + ndump*size_one*sizeof(double);
+
+  if (nindex == maxindex) {
+    maxindex += DELTA_INDEX;
+    memory->grow(indexstep,maxindex,"dump:indexstep");
+    memory->grow(indexoffset,maxindex,"dump:indexoffset");
+  }
+  indexstep[nindex] = update->ntimestep;
+  indexoffset[nindex] = fileoffset;
+  nindex++;
+  fileoffset += framesize;
+
+  // box in same layout as Reader::read_header(), tilt factors 0 if orthogonal
+
+  double box[3][3];
+  box[0][0] = boxxlo; box[0][1] = boxxhi;
+  box[1][0] = boxylo; box[1][1] = boxyhi;
+  box[2][0] = boxzlo; box[2][1] = boxzhi;
+  box[0][2] = box[1][2] = box[2][2] = 0.0;
+  if (domain->triclinic) {
+    box[0][2] = boxxy;
+    box[1][2] = boxxz;
+    box[2][2] = boxyz;
+  }
+
+  fwrite(&framesize,sizeof(bigint),1,fp);
+  fwrite(&update->ntimestep,sizeof(bigint),1,fp);
+  fwrite(&ndump,sizeof(bigint),1,fp);
+  fwrite(&domain->triclinic,sizeof(int),1,fp);
+  fwrite(&domain->boundary[0][0],6*sizeof(int),1,fp);
+  fwrite(&box[0][0],sizeof(double),9,fp);
+  fwrite(&size_one,sizeof(int),1,fp);
+  fwrite(&nchar,sizeof(int),1,fp);
+  fwrite(columns,sizeof(char),nchar,fp);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void DumpCustom::header_item(bigint ndump)
@@ -1120,6 +1211,16 @@ void DumpCustom::write_binary(int n, double *mybuf)
   fwrite(mybuf,sizeof(double),n,fp);
 }
 
+/* ----------------------------------------------------------------------
+   indexed binary file stores rows contiguously, no per-proc counts,
+   so a reader can seek directly to any atom of a frame
+------------------------------------------------------------------------- */
+
+void DumpCustom::write_indexed(int n, double *mybuf)
+{
+  fwrite(mybuf,sizeof(double),n*size_one,fp);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void DumpCustom::write_string(int n, double *mybuf)
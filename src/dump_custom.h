@@ -57,6 +57,11 @@ class DumpCustom : public Dump {
 
   char *columns;             // column labels
 
+  bigint fileoffset;         // byte offset of next frame in indexed file
+  int nindex,maxindex;       // # of frames in index of indexed file
+  bigint *indexstep;         // timestep of each frame
+  bigint *indexoffset;       // byte offset of each frame
+
   int nchoose;               // # of selected atoms
   int maxlocal;              // size of atom selection and variable arrays
   int *choose;               // local indices of selected atoms
@@ -111,6 +116,7 @@ class DumpCustom : public Dump {
   FnPtrHeader header_choice;           // ptr to write header functions
   void header_binary(bigint);
   void header_binary_triclinic(bigint);
+  void header_indexed(bigint);
   void header_item(bigint);
   void header_item_triclinic(bigint);
 
@@ -122,6 +128,7 @@ class DumpCustom : public Dump {
   typedef void (DumpCustom::*FnPtrWrite)(int, double *);
   FnPtrWrite write_choice;             // ptr to write data functions
   void write_binary(int, double *);
+  void write_indexed(int, double *);
   void write_string(int, double *);
   void write_lines(int, double *);
 
@@ -199,6 +206,11 @@ class DumpCustom : public Dump {
 
 /* ERROR/WARNING messages:
 
+E: Dump custom indexed binary file cannot be written by multiple procs
+
+A *.lmpbin file is always written by a single processor.  Do not use
+the "%" wildcard in its filename.
+
 E: No dump custom arguments specified
 
 The dump custom command requires that atom quantities be specified to
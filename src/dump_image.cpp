@@ -63,6 +63,10 @@ DumpImage::DumpImage(LAMMPS *lmp, int narg, char **arg) :
   binary = 1;
   multifile_override = 0;
 
+  // images are written by write() of this class, never asynchronously
+
+  async_allow = 0;
+
   // set filetype based on filename suffix
 
   int n = strlen(filename);
@@ -49,6 +49,8 @@ using namespace LAMMPS_NS;
 static void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
                         MPI_Comm world, const int nprocs, const int nthreads,
                         const int me, double time_loop, FILE *scr, FILE *log);
+static void region_timings(Timer *t, int i, MPI_Comm world, const int nprocs,
+                           const int me, double time_loop, FILE *scr, FILE *log);
 
 #ifdef LMP_USER_OMP
 static void omp_times(FixOMP *fix, const char *label, enum Timer::ttype which,
@@ -76,6 +78,10 @@ void Finish::end(int flag)
 
   const int nthreads = comm->nthreads;
 
+  // complete dump snapshots still being written by I/O threads
+
+  output->flush_async();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -523,6 +529,22 @@ void Finish::end(int flag)
       if (screen) fprintf(screen,fmt,time,time/time_loop*100.0);
       if (logfile) fprintf(logfile,fmt,time,time/time_loop*100.0);
     }
+
+    // time spent in individual fixes and thermo computes
+    // computes invoked by a fix are included in the time of that fix
+
+    if (timer->has_full() && timer->get_nregion()) {
+      const char hdr[] = "\nFix/compute timing breakdown:\n"
+        " min time  |  avg time  |  max time  |%varavg| %total | Name\n"
+        "-----------------------------------------------------------"
+        "-------------\n";
+      if (me == 0) {
+        if (screen)  fputs(hdr,screen);
+        if (logfile) fputs(hdr,logfile);
+      }
+      for (int i = 0; i < timer->get_nregion(); i++)
+        region_timings(timer,i,world,nprocs,me,time_loop,screen,logfile);
+    }
   }
 
 #ifdef LMP_USER_OMP
@@ -938,6 +960,39 @@ void mpi_timings(const char *label, Timer *t, enum Timer::ttype tt,
 
 /* ---------------------------------------------------------------------- */
 
+void region_timings(Timer *t, int i, MPI_Comm world, const int nprocs,
+                    const int me, double time_loop, FILE *scr, FILE *log)
+{
+  double tmp, time_max, time_min, time_sq;
+  double time = t->get_region_wall(i);
+
+  MPI_Allreduce(&time,&time_max,1,MPI_DOUBLE,MPI_MAX,world);
+  if (time_max == 0.0) return;     // not invoked during this run
+
+  MPI_Allreduce(&time,&time_min,1,MPI_DOUBLE,MPI_MIN,world);
+  time_sq = time*time;
+  MPI_Allreduce(&time,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+  time = tmp/nprocs;
+  MPI_Allreduce(&time_sq,&tmp,1,MPI_DOUBLE,MPI_SUM,world);
+  time_sq = tmp/nprocs;
+
+  if ((time > 0.001) && ((time_sq/time - time) > 1.0e-10))
+    time_sq = sqrt(time_sq/time - time)*100.0;
+  else
+    time_sq = 0.0;
+
+  if (me == 0) {
+    tmp = time/time_loop*100.0;
+    const char fmt[] = "%- 11.5g|%- 12.5g|%- 12.5g|%6.1f |%6.2f  | %s\n";
+    if (scr)
+      fprintf(scr,fmt,time_min,time,time_max,time_sq,tmp,t->get_region_name(i));
+    if (log)
+      fprintf(log,fmt,time_min,time,time_max,time_sq,tmp,t->get_region_name(i));
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
 #ifdef LMP_USER_OMP
 void omp_times(FixOMP *fix, const char *label, enum Timer::ttype which,
                       const int nthreads,FILE *scr, FILE *log)
@@ -46,7 +46,9 @@ enum{AUTO,UPPER,LOWER,AUTOUPPER,AUTOLOWER,FULL};
 FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
   Fix (lmp, narg, arg),
   nvalues(0), which(NULL), argindex(NULL), value2index(NULL), ids(NULL), fp(NULL),
-  count(NULL), values(NULL), corr(NULL), save_count(NULL), save_corr(NULL)
+  count(NULL), values(NULL), corr(NULL), save_count(NULL), save_corr(NULL),
+  lag(NULL), insertindex(NULL), nfill(NULL), naccum(NULL), shift(NULL),
+  accum(NULL), sample(NULL), block(NULL), pairi(NULL), pairj(NULL)
 {
   if (narg < 7) error->all(FLERR,"Illegal fix ave/correlate command");
 
@@ -114,6 +116,7 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
   prefactor = 1.0;
   fp = NULL;
   overwrite = 0;
+  multitau = 0;
   char *title1 = NULL;
   char *title2 = NULL;
   char *title3 = NULL;
@@ -157,6 +160,12 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
     } else if (strcmp(arg[iarg],"overwrite") == 0) {
       overwrite = 1;
       iarg += 1;
+    } else if (strcmp(arg[iarg],"multitau") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix ave/correlate command");
+      multitau = 1;
+      ptau = force->inumeric(FLERR,arg[iarg+1]);
+      mtau = force->inumeric(FLERR,arg[iarg+2]);
+      iarg += 3;
     } else if (strcmp(arg[iarg],"title1") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal fix ave/correlate command");
       delete [] title1;
@@ -192,6 +201,8 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
     error->all(FLERR,"Illegal fix ave/correlate command");
   if (ave != RUNNING && overwrite)
     error->all(FLERR,"Illegal fix ave/correlate command");
+  if (multitau && (ptau < 2 || mtau < 2 || ptau % mtau))
+    error->all(FLERR,"Fix ave/correlate multitau settings are invalid");
 
   for (int i = 0; i < nvalues; i++) {
     if (which[i] == COMPUTE) {
@@ -297,18 +308,83 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
     memory->sfree(earg);
   }
 
+  // time lags of correlation output
+  // ring of values: one lag per time sample in ring
+  // multiple-tau: ptau lags on level 0, then ptau-dmin lags on each level,
+  //   with spacing mtau^k on level k, until (Nrepeat-1) lags are covered
+
+  int i,j;
+
+  if (!multitau) {
+    nrows = nrepeat;
+    memory->create(lag,nrows,"ave/correlate:lag");
+    for (i = 0; i < nrows; i++) lag[i] = i;
+  } else {
+    dmin = ptau/mtau;
+    bigint spacing = 1;
+    nlevel = 1;
+    while ((ptau-1)*spacing < nrepeat-1) {
+      spacing *= mtau;
+      nlevel++;
+    }
+    nrows = ptau + (nlevel-1)*(ptau-dmin);
+    memory->create(lag,nrows,"ave/correlate:lag");
+    spacing = 1;
+    int m = 0;
+    for (int k = 0; k < nlevel; k++) {
+      for (j = (k ? dmin : 0); j < ptau; j++) lag[m++] = j*spacing;
+      spacing *= mtau;
+    }
+  }
+
   // allocate and initialize memory for averaging
   // set count and corr to zero since they accumulate
   // also set save versions to zero in case accessed via compute_array()
+  // multiple-tau correlator stores ptau values per level, not Nrepeat
+
+  if (!multitau)
+    memory->create(values,nrepeat,nvalues,"ave/correlate:values");
+  else {
+    memory->create(insertindex,nlevel,"ave/correlate:insertindex");
+    memory->create(nfill,nlevel,"ave/correlate:nfill");
+    memory->create(naccum,nlevel,"ave/correlate:naccum");
+    memory->create(shift,nlevel,ptau,nvalues,"ave/correlate:shift");
+    memory->create(accum,nlevel,nvalues,"ave/correlate:accum");
+    memory->create(sample,nvalues,"ave/correlate:sample");
+    memory->create(block,nvalues,"ave/correlate:block");
+    reset_multitau();
+
+    // value indices of each pair, same order as in accumulate()
+
+    memory->create(pairi,npair,"ave/correlate:pairi");
+    memory->create(pairj,npair,"ave/correlate:pairj");
+    int ipair = 0;
+    for (i = 0; i < nvalues; i++) {
+      if (type == AUTO) {
+        pairi[ipair] = pairj[ipair] = i;
+        ipair++;
+        continue;
+      }
+      int jfirst = 0;
+      int jlast = nvalues-1;
+      if (type == UPPER) jfirst = i+1;
+      else if (type == AUTOUPPER) jfirst = i;
+      else if (type == LOWER) jlast = i-1;
+      else if (type == AUTOLOWER) jlast = i;
+      for (j = jfirst; j <= jlast; j++) {
+        pairi[ipair] = i;
+        pairj[ipair] = j;
+        ipair++;
+      }
+    }
+  }
 
-  memory->create(values,nrepeat,nvalues,"ave/correlate:values");
-  memory->create(count,nrepeat,"ave/correlate:count");
-  memory->create(save_count,nrepeat,"ave/correlate:save_count");
-  memory->create(corr,nrepeat,npair,"ave/correlate:corr");
-  memory->create(save_corr,nrepeat,npair,"ave/correlate:save_corr");
+  memory->create(count,nrows,"ave/correlate:count");
+  memory->create(save_count,nrows,"ave/correlate:save_count");
+  memory->create(corr,nrows,npair,"ave/correlate:corr");
+  memory->create(save_corr,nrows,npair,"ave/correlate:save_corr");
 
-  int i,j;
-  for (i = 0; i < nrepeat; i++) {
+  for (i = 0; i < nrows; i++) {
     save_count[i] = count[i] = 0;
     for (j = 0; j < npair; j++)
       save_corr[i][j] = corr[i][j] = 0.0;
@@ -317,7 +393,7 @@ FixAveCorrelate::FixAveCorrelate(LAMMPS * lmp, int narg, char **arg):
   // this fix produces a global array
 
   array_flag = 1;
-  size_array_rows = nrepeat;
+  size_array_rows = nrows;
   size_array_cols = npair+2;
   extarray = 0;
 
@@ -350,6 +426,17 @@ FixAveCorrelate::~FixAveCorrelate()
   memory->destroy(corr);
   memory->destroy(save_corr);
 
+  memory->destroy(lag);
+  memory->destroy(insertindex);
+  memory->destroy(nfill);
+  memory->destroy(naccum);
+  memory->destroy(shift);
+  memory->destroy(accum);
+  memory->destroy(sample);
+  memory->destroy(block);
+  memory->destroy(pairi);
+  memory->destroy(pairj);
+
   if (fp && me == 0) fclose(fp);
 }
 
@@ -395,6 +482,7 @@ void FixAveCorrelate::init()
     lastindex = -1;
     firstindex = 0;
     nsample = 0;
+    if (multitau) reset_multitau();
     nvalid = nextvalid();
     modify->addstep_compute_all(nvalid);
   }
@@ -431,9 +519,15 @@ void FixAveCorrelate::end_of_step()
   modify->clearstep_compute();
 
   // lastindex = index in values ring of latest time sample
+  // multiple-tau correlator stores latest time sample separately
 
-  lastindex++;
-  if (lastindex == nrepeat) lastindex = 0;
+  double *latest;
+  if (multitau) latest = sample;
+  else {
+    lastindex++;
+    if (lastindex == nrepeat) lastindex = 0;
+    latest = values[lastindex];
+  }
 
   for (i = 0; i < nvalues; i++) {
     m = value2index[i];
@@ -479,16 +573,18 @@ void FixAveCorrelate::end_of_step()
       }
     }
 
-    values[lastindex][i] = scalar;
+    latest[i] = scalar;
   }
 
   // fistindex = index in values ring of earliest time sample
   // nsample = number of time samples in values ring
 
-  if (nsample < nrepeat) nsample++;
-  else {
-    firstindex++;
-    if (firstindex == nrepeat) firstindex = 0;
+  if (!multitau) {
+    if (nsample < nrepeat) nsample++;
+    else {
+      firstindex++;
+      if (firstindex == nrepeat) firstindex = 0;
+    }
   }
 
   nvalid += nevery;
@@ -496,12 +592,13 @@ void FixAveCorrelate::end_of_step()
 
   // calculate all Cij() enabled by latest values
 
-  accumulate();
+  if (multitau) accumulate_multitau();
+  else accumulate();
   if (ntimestep % nfreq) return;
 
   // save results in save_count and save_corr
 
-  for (i = 0; i < nrepeat; i++) {
+  for (i = 0; i < nrows; i++) {
     save_count[i] = count[i];
     if (count[i])
       for (j = 0; j < npair; j++)
@@ -516,9 +613,9 @@ void FixAveCorrelate::end_of_step()
   if (fp && me == 0) {
     clearerr(fp);
     if (overwrite) fseek(fp,filepos,SEEK_SET);
-    fprintf(fp,BIGINT_FORMAT " %d\n",ntimestep,nrepeat);
-    for (i = 0; i < nrepeat; i++) {
-      fprintf(fp,"%d %d %d",i+1,i*nevery,count[i]);
+    fprintf(fp,BIGINT_FORMAT " %d\n",ntimestep,nrows);
+    for (i = 0; i < nrows; i++) {
+      fprintf(fp,"%d " BIGINT_FORMAT " %d",i+1,lag[i]*nevery,count[i]);
       if (count[i])
         for (j = 0; j < npair; j++)
           fprintf(fp," %g",prefactor*corr[i][j]/count[i]);
@@ -540,15 +637,21 @@ void FixAveCorrelate::end_of_step()
 
   // zero accumulation if requested
   // recalculate Cij(0)
+  // multiple-tau correlator restarts from latest time sample
 
   if (ave == ONE) {
-    for (i = 0; i < nrepeat; i++) {
+    for (i = 0; i < nrows; i++) {
       count[i] = 0;
       for (j = 0; j < npair; j++)
         corr[i][j] = 0.0;
     }
-    nsample = 1;
-    accumulate();
+    if (multitau) {
+      reset_multitau();
+      accumulate_multitau();
+    } else {
+      nsample = 1;
+      accumulate();
+    }
   }
 }
 
@@ -625,13 +728,77 @@ void FixAveCorrelate::accumulate()
   }
 }
 
+/* ----------------------------------------------------------------------
+   accumulate correlation data with multiple-tau correlator
+   see Ramirez, Sukumaran, Vorselaars, Likhtman, J Chem Phys, 133, 154103
+   level 0 holds the last ptau time samples,
+     level k holds the last ptau averages of mtau values of level k-1,
+     so lags up to (ptau-1)*mtau^k are spanned with ptau values per level
+   latest value on each level is correlated with all earlier ones,
+     on levels > 0 only beyond dmin since shorter lags are on level below
+------------------------------------------------------------------------- */
+
+void FixAveCorrelate::accumulate_multitau()
+{
+  int i,j,k,n,row,ins,ipair;
+
+  double *w = sample;
+
+  for (k = 0; k < nlevel; k++) {
+    ins = insertindex[k];
+    for (i = 0; i < nvalues; i++) {
+      shift[k][ins][i] = w[i];
+      accum[k][i] += w[i];
+    }
+    if (nfill[k] < ptau) nfill[k]++;
+
+    double *wlast = shift[k][ins];
+    for (j = (k ? dmin : 0); j < nfill[k]; j++) {
+      n = ins - j;
+      if (n < 0) n += ptau;
+      double *wprev = shift[k][n];
+      if (k == 0) row = j;
+      else row = ptau + (k-1)*(ptau-dmin) + j-dmin;
+      count[row]++;
+      for (ipair = 0; ipair < npair; ipair++)
+        corr[row][ipair] += wprev[pairi[ipair]]*wlast[pairj[ipair]];
+    }
+
+    insertindex[k]++;
+    if (insertindex[k] == ptau) insertindex[k] = 0;
+
+    // pass average of mtau values to next level
+
+    naccum[k]++;
+    if (naccum[k] < mtau) break;
+    for (i = 0; i < nvalues; i++) {
+      block[i] = accum[k][i]/mtau;
+      accum[k][i] = 0.0;
+    }
+    naccum[k] = 0;
+    w = block;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   discard all values stored in multiple-tau correlator
+------------------------------------------------------------------------- */
+
+void FixAveCorrelate::reset_multitau()
+{
+  for (int k = 0; k < nlevel; k++) {
+    insertindex[k] = nfill[k] = naccum[k] = 0;
+    for (int i = 0; i < nvalues; i++) accum[k][i] = 0.0;
+  }
+}
+
 /* ----------------------------------------------------------------------
    return I,J array value
 ------------------------------------------------------------------------- */
 
 double FixAveCorrelate::compute_array(int i, int j)
 {
-  if (j == 0) return 1.0*i*nevery;
+  if (j == 0) return 1.0*lag[i]*nevery;
   else if (j == 1) return 1.0*save_count[i];
   else if (save_count[i]) return save_corr[i][j-2];
   return 0.0;
@@ -58,7 +58,26 @@ class FixAveCorrelate : public Fix {
   int *save_count;     // saved values at Nfreq for output via compute_array()
   double **save_corr;
 
+  int nrows;           // number of time lags in correlation output
+  bigint *lag;         // time lag of each row in units of Nevery
+
+  int multitau;        // 1 if multiple-tau correlator, 0 if ring of values
+  int ptau;            // # of points in each level of multiple-tau correlator
+  int mtau;            // # of values averaged into one of the next level
+  int dmin;            // first point correlated on levels > 0, ptau/mtau
+  int nlevel;          // # of levels in multiple-tau correlator
+  int *insertindex;    // index in shift of latest value on each level
+  int *nfill;          // # of values stored in shift on each level
+  int *naccum;         // # of values summed in accum on each level
+  double ***shift;     // values on each level, coarse-grained above level 0
+  double **accum;      // sum of values to be averaged for next level
+  double *sample;      // latest time sample
+  double *block;       // block average passed to next level
+  int *pairi,*pairj;   // value indices of each correlation pair
+
   void accumulate();
+  void accumulate_multitau();
+  void reset_multitau();
   bigint nextvalid();
 };
 
@@ -80,6 +99,11 @@ E: Cannot open fix ave/correlate file %s
 The specified file cannot be opened.  Check that the path and name are
 correct.
 
+E: Fix ave/correlate multitau settings are invalid
+
+Both values must be >= 2 and the number of points per level must be
+a multiple of the number of values averaged.
+
 E: Compute ID for fix ave/correlate does not exist
 
 Self-explanatory.
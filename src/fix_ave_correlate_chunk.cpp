@@ -0,0 +1,851 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "fix_ave_correlate_chunk.h"
+#include "atom.h"
+#include "update.h"
+#include "group.h"
+#include "modify.h"
+#include "compute.h"
+#include "compute_chunk_atom.h"
+#include "input.h"
+#include "variable.h"
+#include "memory.h"
+#include "error.h"
+#include "force.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+enum{V,F,COMPUTE,FIX,VARIABLE};
+enum{ONE,RUNNING};
+
+#define INVOKED_PERATOM 8
+
+#define MAX(A,B) ((A) > (B) ? (A) : (B))
+
+/* ---------------------------------------------------------------------- */
+
+FixAveCorrelateChunk::FixAveCorrelateChunk(LAMMPS * lmp, int narg, char **arg):
+  Fix (lmp, narg, arg),
+  nvalues(0), which(NULL), argindex(NULL), value2index(NULL), ids(NULL),
+  fp(NULL), idchunk(NULL), cchunk(NULL), lag(NULL), insertindex(NULL),
+  nfill(NULL), naccum(NULL), hist(NULL), atomvalues(NULL), varatom(NULL),
+  count(NULL), count_total(NULL), corr(NULL), corr_total(NULL),
+  save_count(NULL), save_corr(NULL)
+{
+  if (narg < 8) error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+
+  MPI_Comm_rank(world,&me);
+
+  nevery = force->inumeric(FLERR,arg[3]);
+  nrepeat = force->inumeric(FLERR,arg[4]);
+  nfreq = force->inumeric(FLERR,arg[5]);
+
+  int n = strlen(arg[6]) + 1;
+  idchunk = new char[n];
+  strcpy(idchunk,arg[6]);
+
+  global_freq = nfreq;
+  create_attribute = 1;
+
+  // expand args if any have wildcard character "*"
+
+  int expand = 0;
+  char **earg;
+  int nargnew = input->expand_args(narg-7,&arg[7],1,earg);
+
+  if (earg != &arg[7]) expand = 1;
+  arg = earg;
+
+  // parse values until one isn't recognized
+
+  which = new int[nargnew];
+  argindex = new int[nargnew];
+  ids = new char*[nargnew];
+  value2index = new int[nargnew];
+  nvalues = 0;
+
+  int iarg = 0;
+  while (iarg < nargnew) {
+    ids[nvalues] = NULL;
+
+    if (strcmp(arg[iarg],"vx") == 0) {
+      which[nvalues] = V;
+      argindex[nvalues++] = 0;
+    } else if (strcmp(arg[iarg],"vy") == 0) {
+      which[nvalues] = V;
+      argindex[nvalues++] = 1;
+    } else if (strcmp(arg[iarg],"vz") == 0) {
+      which[nvalues] = V;
+      argindex[nvalues++] = 2;
+
+    } else if (strcmp(arg[iarg],"fx") == 0) {
+      which[nvalues] = F;
+      argindex[nvalues++] = 0;
+    } else if (strcmp(arg[iarg],"fy") == 0) {
+      which[nvalues] = F;
+      argindex[nvalues++] = 1;
+    } else if (strcmp(arg[iarg],"fz") == 0) {
+      which[nvalues] = F;
+      argindex[nvalues++] = 2;
+
+    } else if (strncmp(arg[iarg],"c_",2) == 0 ||
+               strncmp(arg[iarg],"f_",2) == 0 ||
+               strncmp(arg[iarg],"v_",2) == 0) {
+      if (arg[iarg][0] == 'c') which[nvalues] = COMPUTE;
+      else if (arg[iarg][0] == 'f') which[nvalues] = FIX;
+      else if (arg[iarg][0] == 'v') which[nvalues] = VARIABLE;
+
+      int n = strlen(arg[iarg]);
+      char *suffix = new char[n];
+      strcpy(suffix,&arg[iarg][2]);
+
+      char *ptr = strchr(suffix,'[');
+      if (ptr) {
+        if (suffix[strlen(suffix)-1] != ']')
+          error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+        argindex[nvalues] = atoi(ptr+1);
+        *ptr = '\0';
+      } else argindex[nvalues] = 0;
+
+      n = strlen(suffix) + 1;
+      ids[nvalues] = new char[n];
+      strcpy(ids[nvalues],suffix);
+      nvalues++;
+      delete [] suffix;
+
+    } else break;
+
+    iarg++;
+  }
+
+  if (nvalues == 0)
+    error->all(FLERR,"No values in fix ave/correlate/chunk command");
+
+  // optional args
+
+  ave = ONE;
+  startstep = 0;
+  prefactor = 1.0;
+  overwrite = 0;
+  ptau = 16;
+  mtau = 2;
+  char *title1 = NULL;
+  char *title2 = NULL;
+  char *title3 = NULL;
+
+  while (iarg < nargnew) {
+    if (strcmp(arg[iarg],"ave") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      if (strcmp(arg[iarg+1],"one") == 0) ave = ONE;
+      else if (strcmp(arg[iarg+1],"running") == 0) ave = RUNNING;
+      else error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"start") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      startstep = force->inumeric(FLERR,arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"prefactor") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      prefactor = force->numeric(FLERR,arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"multitau") == 0) {
+      if (iarg+3 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      ptau = force->inumeric(FLERR,arg[iarg+1]);
+      mtau = force->inumeric(FLERR,arg[iarg+2]);
+      iarg += 3;
+    } else if (strcmp(arg[iarg],"file") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      if (me == 0) {
+        fp = fopen(arg[iarg+1],"w");
+        if (fp == NULL) {
+          char str[128];
+          sprintf(str,"Cannot open fix ave/correlate/chunk file %s",
+                  arg[iarg+1]);
+          error->one(FLERR,str);
+        }
+      }
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"overwrite") == 0) {
+      overwrite = 1;
+      iarg += 1;
+    } else if (strcmp(arg[iarg],"title1") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      delete [] title1;
+      int n = strlen(arg[iarg+1]) + 1;
+      title1 = new char[n];
+      strcpy(title1,arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"title2") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      delete [] title2;
+      int n = strlen(arg[iarg+1]) + 1;
+      title2 = new char[n];
+      strcpy(title2,arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"title3") == 0) {
+      if (iarg+2 > nargnew)
+        error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+      delete [] title3;
+      int n = strlen(arg[iarg+1]) + 1;
+      title3 = new char[n];
+      strcpy(title3,arg[iarg+1]);
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+  }
+
+  // setup and error check
+  // for fix inputs, check that fix frequency is acceptable
+
+  if (nevery <= 0 || nrepeat <= 0 || nfreq <= 0)
+    error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+  if (nfreq % nevery)
+    error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+  if (ave == ONE && nfreq < (nrepeat-1)*nevery)
+    error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+  if (ave != RUNNING && overwrite)
+    error->all(FLERR,"Illegal fix ave/correlate/chunk command");
+  if (ptau < 2 || mtau < 2 || ptau % mtau)
+    error->all(FLERR,"Fix ave/correlate/chunk multitau settings are invalid");
+
+  for (int i = 0; i < nvalues; i++) {
+    if (which[i] == COMPUTE) {
+      int icompute = modify->find_compute(ids[i]);
+      if (icompute < 0)
+        error->all(FLERR,
+                   "Compute ID for fix ave/correlate/chunk does not exist");
+      if (modify->compute[icompute]->peratom_flag == 0)
+        error->all(FLERR,"Fix ave/correlate/chunk compute does not "
+                   "calculate per-atom values");
+      if (argindex[i] == 0 &&
+          modify->compute[icompute]->size_peratom_cols != 0)
+        error->all(FLERR,"Fix ave/correlate/chunk compute does not "
+                   "calculate a per-atom vector");
+      if (argindex[i] && modify->compute[icompute]->size_peratom_cols == 0)
+        error->all(FLERR,"Fix ave/correlate/chunk compute does not "
+                   "calculate a per-atom array");
+      if (argindex[i] &&
+          argindex[i] > modify->compute[icompute]->size_peratom_cols)
+        error->all(FLERR,"Fix ave/correlate/chunk compute vector "
+                   "is accessed out-of-range");
+
+    } else if (which[i] == FIX) {
+      int ifix = modify->find_fix(ids[i]);
+      if (ifix < 0)
+        error->all(FLERR,"Fix ID for fix ave/correlate/chunk does not exist");
+      if (modify->fix[ifix]->peratom_flag == 0)
+        error->all(FLERR,"Fix ave/correlate/chunk fix does not "
+                   "calculate per-atom values");
+      if (argindex[i] == 0 && modify->fix[ifix]->size_peratom_cols != 0)
+        error->all(FLERR,"Fix ave/correlate/chunk fix does not "
+                   "calculate a per-atom vector");
+      if (argindex[i] && modify->fix[ifix]->size_peratom_cols == 0)
+        error->all(FLERR,"Fix ave/correlate/chunk fix does not "
+                   "calculate a per-atom array");
+      if (argindex[i] && argindex[i] > modify->fix[ifix]->size_peratom_cols)
+        error->all(FLERR,"Fix ave/correlate/chunk fix vector "
+                   "is accessed out-of-range");
+
+    } else if (which[i] == VARIABLE) {
+      int ivariable = input->variable->find(ids[i]);
+      if (ivariable < 0)
+        error->all(FLERR,
+                   "Variable name for fix ave/correlate/chunk does not exist");
+      if (input->variable->atomstyle(ivariable) == 0)
+        error->all(FLERR,"Fix ave/correlate/chunk variable is not "
+                   "atom-style variable");
+    }
+  }
+
+  // increment lock counter in compute chunk/atom
+  // correlations span all samples, so chunks are locked until fix is deleted
+
+  int icompute = modify->find_compute(idchunk);
+  if (icompute < 0)
+    error->all(FLERR,"Chunk/atom compute does not exist for "
+               "fix ave/correlate/chunk");
+  cchunk = (ComputeChunkAtom *) modify->compute[icompute];
+  if (strcmp(cchunk->style,"chunk/atom") != 0)
+    error->all(FLERR,"Fix ave/correlate/chunk does not use chunk/atom compute");
+  cchunk->lockcount++;
+
+  // print file comment lines
+
+  if (fp && me == 0) {
+    clearerr(fp);
+    if (title1) fprintf(fp,"%s\n",title1);
+    else fprintf(fp,"# Time-correlated chunk-averaged data for fix %s "
+                 "and group %s\n",id,group->names[igroup]);
+    if (title2) fprintf(fp,"%s\n",title2);
+    else fprintf(fp,"# Timestep Number-of-chunks Number-of-time-windows\n");
+    if (title3) fprintf(fp,"%s\n",title3);
+    else {
+      fprintf(fp,"# Chunk Index TimeDelta Ncount");
+      for (int i = 0; i < nvalues; i++)
+        fprintf(fp," %s*%s",earg[i],earg[i]);
+      fprintf(fp,"\n");
+    }
+    if (ferror(fp))
+      error->one(FLERR,"Error writing file header");
+
+    filepos = ftell(fp);
+  }
+
+  delete [] title1;
+  delete [] title2;
+  delete [] title3;
+
+  // if wildcard expansion occurred, free earg memory from expand_args()
+  // wait to do this until after file comment lines are printed
+
+  if (expand) {
+    for (int i = 0; i < nargnew; i++) delete [] earg[i];
+    memory->sfree(earg);
+  }
+
+  // time lags of multiple-tau correlator
+  // ptau lags on level 0, then ptau-dmin lags on each level,
+  //   with spacing mtau^k on level k, until (Nrepeat-1) lags are covered
+
+  int j,k;
+
+  dmin = ptau/mtau;
+  bigint spacing = 1;
+  nlevel = 1;
+  while ((ptau-1)*spacing < nrepeat-1) {
+    spacing *= mtau;
+    nlevel++;
+  }
+  nrows = ptau + (nlevel-1)*(ptau-dmin);
+  memory->create(lag,nrows,"ave/correlate/chunk:lag");
+  spacing = 1;
+  int m = 0;
+  for (k = 0; k < nlevel; k++) {
+    for (j = (k ? dmin : 0); j < ptau; j++) lag[m++] = j*spacing;
+    spacing *= mtau;
+  }
+
+  memory->create(insertindex,nlevel,"ave/correlate/chunk:insertindex");
+  memory->create(nfill,nlevel,"ave/correlate/chunk:nfill");
+  memory->create(naccum,nlevel,"ave/correlate/chunk:naccum");
+
+  // perform initial allocation of atom-based array
+  // register with Atom class
+
+  nhist = 1 + nlevel*(ptau+1)*nvalues;
+  grow_arrays(atom->nmax);
+  atom->add_callback(0);
+  reset();
+
+  maxatom = 0;
+
+  // this fix produces a global array
+  // size_array_rows is set on first sample when nchunk is known
+
+  nchunk = 0;
+  array_flag = 1;
+  size_array_rows = 0;
+  size_array_rows_variable = 1;
+  size_array_cols = nvalues + 3;
+  extarray = 0;
+
+  // nvalid = next step on which end_of_step does something
+  // add nvalid to all computes that store invocation times
+  // since don't know a priori which are invoked by this fix
+  // once in end_of_step() can set timestep for ones actually invoked
+
+  nvalid_last = -1;
+  nvalid = nextvalid();
+  modify->addstep_compute_all(nvalid);
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixAveCorrelateChunk::~FixAveCorrelateChunk()
+{
+  // unregister callback to this fix from Atom class
+
+  atom->delete_callback(id,0);
+
+  delete [] which;
+  delete [] argindex;
+  delete [] value2index;
+  for (int i = 0; i < nvalues; i++) delete [] ids[i];
+  delete [] ids;
+
+  memory->destroy(lag);
+  memory->destroy(insertindex);
+  memory->destroy(nfill);
+  memory->destroy(naccum);
+  memory->destroy(hist);
+  memory->destroy(atomvalues);
+  memory->destroy(varatom);
+  memory->destroy(count);
+  memory->destroy(count_total);
+  memory->destroy(corr);
+  memory->destroy(corr_total);
+  memory->destroy(save_count);
+  memory->destroy(save_corr);
+
+  if (fp && me == 0) fclose(fp);
+
+  // decrement lock counter in compute chunk/atom, it if still exists
+
+  int icompute = modify->find_compute(idchunk);
+  if (icompute >= 0) {
+    cchunk = (ComputeChunkAtom *) modify->compute[icompute];
+    cchunk->unlock(this);
+    cchunk->lockcount--;
+  }
+
+  delete [] idchunk;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixAveCorrelateChunk::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::init()
+{
+  // set current indices for all computes,fixes,variables
+
+  int icompute = modify->find_compute(idchunk);
+  if (icompute < 0)
+    error->all(FLERR,"Chunk/atom compute does not exist for "
+               "fix ave/correlate/chunk");
+  cchunk = (ComputeChunkAtom *) modify->compute[icompute];
+
+  for (int i = 0; i < nvalues; i++) {
+    if (which[i] == COMPUTE) {
+      int icompute = modify->find_compute(ids[i]);
+      if (icompute < 0)
+        error->all(FLERR,
+                   "Compute ID for fix ave/correlate/chunk does not exist");
+      value2index[i] = icompute;
+
+    } else if (which[i] == FIX) {
+      int ifix = modify->find_fix(ids[i]);
+      if (ifix < 0)
+        error->all(FLERR,"Fix ID for fix ave/correlate/chunk does not exist");
+      value2index[i] = ifix;
+
+      if (nevery % modify->fix[ifix]->peratom_freq)
+        error->all(FLERR,"Fix for fix ave/correlate/chunk "
+                   "not computed at compatible time");
+
+    } else if (which[i] == VARIABLE) {
+      int ivariable = input->variable->find(ids[i]);
+      if (ivariable < 0)
+        error->all(FLERR,
+                   "Variable name for fix ave/correlate/chunk does not exist");
+      value2index[i] = ivariable;
+
+    } else value2index[i] = -1;
+  }
+
+  // need to reset nvalid if nvalid < ntimestep b/c minimize was performed
+
+  if (nvalid < update->ntimestep) {
+    reset();
+    nvalid = nextvalid();
+    modify->addstep_compute_all(nvalid);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   only does something if nvalid = current timestep
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::setup(int vflag)
+{
+  end_of_step();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::end_of_step()
+{
+  int i,j,m,n,row;
+
+  // skip if not step which requires doing something
+  // error check if timestep was reset in an invalid manner
+
+  bigint ntimestep = update->ntimestep;
+  if (ntimestep < nvalid_last || ntimestep > nvalid)
+    error->all(FLERR,"Invalid timestep reset for fix ave/correlate/chunk");
+  if (ntimestep != nvalid) return;
+  nvalid_last = nvalid;
+
+  // on first sample, invoke setup_chunks() to determine nchunk
+  //   and lock it until fix is deleted, allocate per-chunk arrays
+  // wrap setup_chunks in clearstep/addstep b/c it may invoke computes
+
+  if (count == NULL) {
+    if (cchunk->computeflag) modify->clearstep_compute();
+    nchunk = cchunk->setup_chunks();
+    if (cchunk->computeflag) modify->addstep_compute(ntimestep+nevery);
+    cchunk->lock(this,ntimestep,-1);
+
+    size_array_rows = nchunk*nrows;
+    int nrow = MAX(size_array_rows,1);
+    memory->create(count,nrow,"ave/correlate/chunk:count");
+    memory->create(count_total,nrow,"ave/correlate/chunk:count_total");
+    memory->create(save_count,nrow,"ave/correlate/chunk:save_count");
+    memory->create(corr,nrow,nvalues,"ave/correlate/chunk:corr");
+    memory->create(corr_total,nrow,nvalues,"ave/correlate/chunk:corr_total");
+    memory->create(save_corr,nrow,nvalues,"ave/correlate/chunk:save_corr");
+    for (row = 0; row < nrow; row++) {
+      save_count[row] = count[row] = 0.0;
+      for (m = 0; m < nvalues; m++) save_corr[row][m] = corr[row][m] = 0.0;
+    }
+  }
+
+  // compute chunk/atom assigns atoms to chunk IDs
+  // extract ichunk index vector from compute
+  // ichunk = 1 to Nchunk for included atoms, 0 for excluded atoms
+  // wrap compute_ichunk in clearstep/addstep b/c it may invoke computes
+
+  if (cchunk->computeflag) modify->clearstep_compute();
+
+  cchunk->compute_ichunk();
+  int *ichunk = cchunk->ichunk;
+
+  if (cchunk->computeflag) modify->addstep_compute(ntimestep+nevery);
+
+  // store latest time sample of all owned atoms
+  // compute/fix/variable may invoke computes so wrap with clear/add
+
+  int nlocal = atom->nlocal;
+
+  if (atom->nmax > maxatom) {
+    maxatom = atom->nmax;
+    memory->destroy(atomvalues);
+    memory->destroy(varatom);
+    memory->create(atomvalues,maxatom,nvalues,"ave/correlate/chunk:values");
+    memory->create(varatom,maxatom,"ave/correlate/chunk:varatom");
+  }
+
+  modify->clearstep_compute();
+
+  for (m = 0; m < nvalues; m++) {
+    n = value2index[m];
+    j = argindex[m];
+
+    if (which[m] == V || which[m] == F) {
+      double **attribute;
+      if (which[m] == V) attribute = atom->v;
+      else attribute = atom->f;
+      for (i = 0; i < nlocal; i++) atomvalues[i][m] = attribute[i][j];
+
+    // invoke compute if not previously invoked
+
+    } else if (which[m] == COMPUTE) {
+      Compute *compute = modify->compute[n];
+      if (!(compute->invoked_flag & INVOKED_PERATOM)) {
+        compute->compute_peratom();
+        compute->invoked_flag |= INVOKED_PERATOM;
+      }
+      if (j == 0) {
+        double *vector = compute->vector_atom;
+        for (i = 0; i < nlocal; i++) atomvalues[i][m] = vector[i];
+      } else {
+        double **array = compute->array_atom;
+        int jm1 = j - 1;
+        for (i = 0; i < nlocal; i++) atomvalues[i][m] = array[i][jm1];
+      }
+
+    // access fix fields, guaranteed to be ready
+
+    } else if (which[m] == FIX) {
+      if (j == 0) {
+        double *vector = modify->fix[n]->vector_atom;
+        for (i = 0; i < nlocal; i++) atomvalues[i][m] = vector[i];
+      } else {
+        double **array = modify->fix[n]->array_atom;
+        int jm1 = j - 1;
+        for (i = 0; i < nlocal; i++) atomvalues[i][m] = array[i][jm1];
+      }
+
+    // evaluate atom-style variable
+
+    } else if (which[m] == VARIABLE) {
+      input->variable->compute_atom(n,igroup,varatom,1,0);
+      for (i = 0; i < nlocal; i++) atomvalues[i][m] = varatom[i];
+    }
+  }
+
+  nvalid += nevery;
+  modify->addstep_compute(nvalid);
+
+  // calculate all correlations enabled by latest values
+
+  accumulate(ichunk);
+  if (ntimestep % nfreq) return;
+
+  // sum correlations across procs
+  // save results in save_count and save_corr
+
+  int nrow = nchunk*nrows;
+  if (nrow) {
+    MPI_Allreduce(count,count_total,nrow,MPI_DOUBLE,MPI_SUM,world);
+    MPI_Allreduce(&corr[0][0],&corr_total[0][0],nrow*nvalues,
+                  MPI_DOUBLE,MPI_SUM,world);
+  }
+
+  for (row = 0; row < nrow; row++) {
+    save_count[row] = count_total[row];
+    if (count_total[row])
+      for (m = 0; m < nvalues; m++)
+        save_corr[row][m] = prefactor*corr_total[row][m]/count_total[row];
+    else
+      for (m = 0; m < nvalues; m++)
+        save_corr[row][m] = 0.0;
+  }
+
+  // output result to file
+
+  if (fp && me == 0) {
+    clearerr(fp);
+    if (overwrite) fseek(fp,filepos,SEEK_SET);
+    fprintf(fp,BIGINT_FORMAT " %d %d\n",ntimestep,nchunk,nrows);
+    for (row = 0; row < nrow; row++) {
+      fprintf(fp,"%d %d " BIGINT_FORMAT " %.15g",row/nrows+1,row%nrows+1,
+              lag[row%nrows]*nevery,save_count[row]);
+      for (m = 0; m < nvalues; m++) fprintf(fp," %g",save_corr[row][m]);
+      fprintf(fp,"\n");
+    }
+    if (ferror(fp))
+      error->one(FLERR,"Error writing out correlation data");
+
+    fflush(fp);
+
+    if (overwrite) {
+      long fileend = ftell(fp);
+      if (fileend > 0) ftruncate(fileno(fp),fileend);
+    }
+  }
+
+  // zero accumulation if requested
+  // correlator restarts from latest time sample
+
+  if (ave == ONE) {
+    for (row = 0; row < nrow; row++) {
+      count[row] = 0.0;
+      for (m = 0; m < nvalues; m++) corr[row][m] = 0.0;
+    }
+    reset();
+    accumulate(ichunk);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   accumulate per-chunk auto-correlation of per-atom values
+     with multiple-tau correlator, same scheme as in fix ave/correlate
+   each atom stores its own history, coarse-grained on levels > 0,
+     so memory grows with log of the longest lag
+   latest value on each level is correlated with all earlier ones,
+     on levels > 0 only beyond dmin since shorter lags are on level below
+   values from before an atom's history started are skipped,
+     e.g. for atoms created during the run
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::accumulate(int *ichunk)
+{
+  int i,j,k,m,n,ins,index,row,base,sum;
+  double *h,*wlast,*wprev;
+
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+
+  nsample++;
+  bigint spacing = 1;
+
+  for (k = 0; k < nlevel; k++) {
+    base = 1 + k*(ptau+1)*nvalues;
+    sum = base + ptau*nvalues;
+    ins = insertindex[k];
+
+    // store latest value on this level
+    // level 0 = time sample, level k = average of mtau values of level k-1
+
+    for (i = 0; i < nlocal; i++) {
+      h = hist[i];
+      wlast = &h[base + ins*nvalues];
+      if (k == 0)
+        for (m = 0; m < nvalues; m++) wlast[m] = atomvalues[i][m];
+      else {
+        double *below = &h[base - nvalues];
+        for (m = 0; m < nvalues; m++) {
+          wlast[m] = below[m]/mtau;
+          below[m] = 0.0;
+        }
+      }
+      for (m = 0; m < nvalues; m++) h[sum+m] += wlast[m];
+    }
+    if (nfill[k] < ptau) nfill[k]++;
+
+    // correlate for atoms in group and in a chunk
+
+    for (i = 0; i < nlocal; i++) {
+      if (!(mask[i] & groupbit) || ichunk[i] == 0) continue;
+      h = hist[i];
+      wlast = &h[base + ins*nvalues];
+      index = (ichunk[i]-1)*nrows;
+      for (j = (k ? dmin : 0); j < nfill[k]; j++) {
+        if (h[0] > nsample - (j+1)*spacing) break;
+        n = ins - j;
+        if (n < 0) n += ptau;
+        wprev = &h[base + n*nvalues];
+        if (k == 0) row = index + j;
+        else row = index + ptau + (k-1)*(ptau-dmin) + j-dmin;
+        count[row] += 1.0;
+        for (m = 0; m < nvalues; m++) corr[row][m] += wprev[m]*wlast[m];
+      }
+    }
+
+    insertindex[k]++;
+    if (insertindex[k] == ptau) insertindex[k] = 0;
+
+    // pass average of mtau values to next level
+    // discard sum on last level
+
+    naccum[k]++;
+    if (naccum[k] < mtau) break;
+    naccum[k] = 0;
+    if (k == nlevel-1)
+      for (i = 0; i < nlocal; i++)
+        for (m = 0; m < nvalues; m++) hist[i][sum+m] = 0.0;
+    spacing *= mtau;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   discard all values stored in correlator
+   history of all owned atoms starts with next sample
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::reset()
+{
+  for (int k = 0; k < nlevel; k++)
+    insertindex[k] = nfill[k] = naccum[k] = 0;
+  nsample = 0;
+
+  int nlocal = atom->nlocal;
+  for (int i = 0; i < nlocal; i++) set_arrays(i);
+}
+
+/* ----------------------------------------------------------------------
+   return I,J array value
+   row I = chunk I/nrows, time lag I%nrows
+------------------------------------------------------------------------- */
+
+double FixAveCorrelateChunk::compute_array(int i, int j)
+{
+  if (j == 0) return 1.0*(i/nrows + 1);
+  else if (j == 1) return 1.0*lag[i%nrows]*nevery;
+  else if (j == 2) return save_count[i];
+  else if (save_count[i]) return save_corr[i][j-3];
+  return 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   nvalid = next step on which end_of_step does something
+   this step if multiple of nevery, else next multiple
+   startstep is lower bound
+------------------------------------------------------------------------- */
+
+bigint FixAveCorrelateChunk::nextvalid()
+{
+  bigint nvalid = update->ntimestep;
+  if (startstep > nvalid) nvalid = startstep;
+  if (nvalid % nevery) nvalid = (nvalid/nevery)*nevery + nevery;
+  return nvalid;
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of per-atom history and per-chunk arrays
+------------------------------------------------------------------------- */
+
+double FixAveCorrelateChunk::memory_usage()
+{
+  double bytes = (double) atom->nmax*nhist * sizeof(double);
+  bytes += (double) maxatom*(nvalues+1) * sizeof(double);
+  bytes += (double) size_array_rows*3*(nvalues+1) * sizeof(double);
+  return bytes;
+}
+
+/* ----------------------------------------------------------------------
+   allocate atom-based array
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::grow_arrays(int nmax)
+{
+  memory->grow(hist,nmax,nhist,"ave/correlate/chunk:hist");
+}
+
+/* ----------------------------------------------------------------------
+   copy values within local atom-based array
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::copy_arrays(int i, int j, int delflag)
+{
+  memcpy(hist[j],hist[i],nhist*sizeof(double));
+}
+
+/* ----------------------------------------------------------------------
+   initialize history of a new atom, starts with next sample
+------------------------------------------------------------------------- */
+
+void FixAveCorrelateChunk::set_arrays(int i)
+{
+  hist[i][0] = nsample;
+  for (int m = 1; m < nhist; m++) hist[i][m] = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   pack values in local atom-based array for exchange with another proc
+------------------------------------------------------------------------- */
+
+int FixAveCorrelateChunk::pack_exchange(int i, double *buf)
+{
+  memcpy(buf,hist[i],nhist*sizeof(double));
+  return nhist;
+}
+
+/* ----------------------------------------------------------------------
+   unpack values in local atom-based array from exchange with another proc
+------------------------------------------------------------------------- */
+
+int FixAveCorrelateChunk::unpack_exchange(int nlocal, double *buf)
+{
+  memcpy(hist[nlocal],buf,nhist*sizeof(double));
+  return nhist;
+}
@@ -0,0 +1,196 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(ave/correlate/chunk,FixAveCorrelateChunk)
+
+#else
+
+#ifndef LMP_FIX_AVE_CORRELATE_CHUNK_H
+#define LMP_FIX_AVE_CORRELATE_CHUNK_H
+
+#include <stdio.h>
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixAveCorrelateChunk : public Fix {
+ public:
+  FixAveCorrelateChunk(class LAMMPS *, int, char **);
+  ~FixAveCorrelateChunk();
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  double compute_array(int,int);
+  double memory_usage();
+
+  void grow_arrays(int);
+  void copy_arrays(int, int, int);
+  void set_arrays(int);
+  int pack_exchange(int, double *);
+  int unpack_exchange(int, double *);
+
+ private:
+  int me,nvalues;
+  int nrepeat,nfreq;
+  bigint nvalid,nvalid_last;
+  int *which,*argindex,*value2index;
+  char **ids;
+  FILE *fp;
+
+  int ave,startstep,overwrite;
+  double prefactor;
+  long filepos;
+
+  char *idchunk;
+  class ComputeChunkAtom *cchunk;
+  int nchunk;
+
+  int ptau;            // # of points in each level of multiple-tau correlator
+  int mtau;            // # of values averaged into one of the next level
+  int dmin;            // first point correlated on levels > 0, ptau/mtau
+  int nlevel;          // # of levels in multiple-tau correlator
+  int nrows;           // # of time lags in correlation output for each chunk
+  bigint *lag;         // time lag of each row in units of Nevery
+  int *insertindex;    // index of latest value on each level
+  int *nfill;          // # of values stored on each level
+  int *naccum;         // # of values summed for next level on each level
+  bigint nsample;      // # of time samples since correlator was reset
+
+  // per-atom history: sample index when atom's history starts,
+  //   then for each level, ptau values + 1 sum for next level, per value
+
+  int nhist;
+  double **hist;
+
+  int maxatom;
+  double **atomvalues; // latest time sample of each atom
+  double *varatom;
+
+  double *count,*count_total;  // # of samples of each chunk and lag
+  double **corr,**corr_total;  // correlation sums of each chunk and lag
+  double *save_count;          // saved values at Nfreq for compute_array()
+  double **save_corr;
+
+  void accumulate(int *);
+  void reset();
+  bigint nextvalid();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: No values in fix ave/correlate/chunk command
+
+Self-explanatory.
+
+E: Cannot open fix ave/correlate/chunk file %s
+
+The specified file cannot be opened.  Check that the path and name are
+correct.
+
+E: Fix ave/correlate/chunk multitau settings are invalid
+
+Both values must be >= 2 and the number of points per level must be
+a multiple of the number of values averaged.
+
+E: Compute ID for fix ave/correlate/chunk does not exist
+
+Self-explanatory.
+
+E: Fix ave/correlate/chunk compute does not calculate per-atom values
+
+A compute used by fix ave/correlate/chunk must generate per-atom
+values.
+
+E: Fix ave/correlate/chunk compute does not calculate a per-atom vector
+
+A compute used by fix ave/correlate/chunk must generate per-atom
+values.
+
+E: Fix ave/correlate/chunk compute does not calculate a per-atom array
+
+Self-explanatory.
+
+E: Fix ave/correlate/chunk compute vector is accessed out-of-range
+
+Self-explanatory.
+
+E: Fix ID for fix ave/correlate/chunk does not exist
+
+Self-explanatory.
+
+E: Fix ave/correlate/chunk fix does not calculate per-atom values
+
+A fix used by fix ave/correlate/chunk must generate per-atom values.
+
+E: Fix ave/correlate/chunk fix does not calculate a per-atom vector
+
+A fix used by fix ave/correlate/chunk must generate per-atom values.
+
+E: Fix ave/correlate/chunk fix does not calculate a per-atom array
+
+Self-explanatory.
+
+E: Fix ave/correlate/chunk fix vector is accessed out-of-range
+
+Self-explanatory.
+
+E: Variable name for fix ave/correlate/chunk does not exist
+
+Self-explanatory.
+
+E: Fix ave/correlate/chunk variable is not atom-style variable
+
+A variable used by fix ave/correlate/chunk must generate per-atom
+values.
+
+E: Chunk/atom compute does not exist for fix ave/correlate/chunk
+
+Self-explanatory.
+
+E: Fix ave/correlate/chunk does not use chunk/atom compute
+
+The specified compute is not for a compute chunk/atom command.
+
+E: Fix for fix ave/correlate/chunk not computed at compatible time
+
+Fixes generate their values on specific timesteps.  Fix
+ave/correlate/chunk is requesting a value on a non-allowed timestep.
+
+E: Invalid timestep reset for fix ave/correlate/chunk
+
+Resetting the timestep has invalidated the sequence of timesteps this
+fix needs to process.
+
+E: Error writing file header
+
+Something in the output to the file triggered an error.
+
+E: Error writing out correlation data
+
+Something in the output to the file triggered an error.
+
+*/
@@ -104,6 +104,9 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
   balance->options(iarg,narg,arg);
   wtflag = balance->wtflag;
 
+  if (balance->multiflag && lbstyle != BISECTION)
+    error->all(FLERR,"Fix balance multi yes requires rcb style");
+
   if (balance->varflag && nevery == 0)
     error->all(FLERR,"Fix balance nevery = 0 cannot be used with weight var");
 
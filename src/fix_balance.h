@@ -82,6 +82,11 @@ E: Fix balance rcb cannot be used with comm_style brick
 
 Comm_style tiled must be used instead.
 
+E: Fix balance multi yes requires rcb style
+
+Only the recursive coordinate bisectioning can balance multiple
+weights at once.
+
 E: Cannot open fix balance output file
 
 Self-explanatory.
@@ -0,0 +1,310 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <mpi.h>
+#include <string.h>
+#include <stdlib.h>
+#include "fix_tune_skin.h"
+#include "update.h"
+#include "comm.h"
+#include "neighbor.h"
+#include "force.h"
+#include "pair.h"
+#include "kspace.h"
+#include "timer.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+#define NSCAN 40          // # of trial skins scanned by the cost model
+#define MAXRATIO 1.5      // max factor by which skin changes at once
+#define EVERYFRAC 0.2     // target every as fraction of list lifetime
+
+/* ---------------------------------------------------------------------- */
+
+FixTuneSkin::FixTuneSkin(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg)
+{
+  if (narg < 4) error->all(FLERR,"Illegal fix tune/skin command");
+
+  vector_flag = 1;
+  size_vector = 3;
+  global_freq = 1;
+  extvector = 0;
+
+  nevery = force->inumeric(FLERR,arg[3]);
+  if (nevery <= 0) error->all(FLERR,"Illegal fix tune/skin command");
+
+  skinmin = skinmax = -1.0;
+  tol = 0.02;
+  everyflag = 1;
+
+  int iarg = 4;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"min") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/skin command");
+      skinmin = force->numeric(FLERR,arg[iarg+1]);
+      if (skinmin <= 0.0) error->all(FLERR,"Illegal fix tune/skin command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"max") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/skin command");
+      skinmax = force->numeric(FLERR,arg[iarg+1]);
+      if (skinmax <= 0.0) error->all(FLERR,"Illegal fix tune/skin command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"tol") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/skin command");
+      tol = force->numeric(FLERR,arg[iarg+1]);
+      if (tol < 0.0) error->all(FLERR,"Illegal fix tune/skin command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"every") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix tune/skin command");
+      if (strcmp(arg[iarg+1],"yes") == 0) everyflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) everyflag = 0;
+      else error->all(FLERR,"Illegal fix tune/skin command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix tune/skin command");
+  }
+
+  if (skinmin > 0.0 && skinmax > 0.0 && skinmin > skinmax)
+    error->all(FLERR,"Illegal fix tune/skin command");
+
+  // force_reneighbor so pre_exchange() can trigger a rebuild
+  //   on the step after the skin is changed
+
+  force_reneighbor = 1;
+  next_reneighbor = -1;
+
+  firstflag = 1;
+  nchange = 0;
+  skin_new = neighbor->skin;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixTuneSkin::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTuneSkin::init()
+{
+  if (!force->pair) error->all(FLERR,"Fix tune/skin requires a pair style");
+  if (!neighbor->dist_check)
+    error->all(FLERR,"Fix tune/skin requires neigh_modify check yes");
+  if (!timer->has_normal())
+    error->all(FLERR,"Fix tune/skin requires timer level normal or full");
+  if (lmp->kokkos)
+    error->all(FLERR,"Fix tune/skin is not compatible with KOKKOS");
+
+  // default bounds are relative to the skin the run starts with
+
+  if (skinmin < 0.0) skinmin = 0.25*neighbor->skin;
+  if (skinmax < 0.0) skinmax = 4.0*neighbor->skin;
+  if (skinmin > skinmax) error->all(FLERR,"Illegal fix tune/skin command");
+
+  // every changes during the run, so delay must not constrain it
+
+  if (everyflag && neighbor->delay) {
+    if (comm->me == 0)
+      error->warning(FLERR,"Fix tune/skin resets neigh_modify delay to 0");
+    neighbor->delay = 0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   Timer and Neighbor counters are reset at start of each run
+   first end_of_step() of the run only records a baseline
+------------------------------------------------------------------------- */
+
+void FixTuneSkin::setup(int vflag)
+{
+  firstflag = 1;
+  next_reneighbor = -1;
+}
+
+/* ----------------------------------------------------------------------
+   measure cost of pair, neighbor, and comm since last measurement
+   choose skin that minimizes the modeled cost per timestep
+------------------------------------------------------------------------- */
+
+void FixTuneSkin::end_of_step()
+{
+  double wall[3];
+  wall[0] = timer->get_wall(Timer::PAIR);
+  wall[1] = timer->get_wall(Timer::NEIGH);
+  wall[2] = timer->get_wall(Timer::COMM);
+
+  bigint ntimestep = update->ntimestep;
+
+  if (firstflag) {
+    firstflag = 0;
+    laststep = ntimestep;
+    lastcalls = neighbor->ncalls;
+    lastdanger = neighbor->ndanger;
+    for (int m = 0; m < 3; m++) lastwall[m] = wall[m];
+    return;
+  }
+
+  // need at least 2 builds to estimate list lifetime and build cost
+  // else keep accumulating until the next invocation
+
+  bigint nsteps = ntimestep - laststep;
+  bigint nbuild = neighbor->ncalls - lastcalls;
+  if (nsteps <= 0 || nbuild < 2) return;
+
+  double delta[3],all[3];
+  for (int m = 0; m < 3; m++) delta[m] = wall[m] - lastwall[m];
+  MPI_Allreduce(delta,all,3,MPI_DOUBLE,MPI_SUM,world);
+  for (int m = 0; m < 3; m++) all[m] /= comm->nprocs;
+
+  bigint ndanger = neighbor->ndanger - lastdanger;
+
+  laststep = ntimestep;
+  lastcalls = neighbor->ncalls;
+  lastdanger = neighbor->ndanger;
+  for (int m = 0; m < 3; m++) lastwall[m] = wall[m];
+
+  // per-step pair cost, per-build neighbor cost, per-comm-call cost
+  // Comm timer mixes forward/reverse comm every step with
+  //   exchange/borders on reneighbor steps, borders ~ one forward comm
+  // life = average # of steps a list was reused
+
+  double skin = neighbor->skin;
+  double cutforce = neighbor->cutneighmax - skin;
+  double tpair = all[0] / nsteps;
+  double tneigh = all[1] / nbuild;
+  double tcomm = all[2] / (nsteps + nbuild);
+  double life = (double) nsteps / nbuild;
+
+  // scan trial skins within bounds and MAXRATIO of current skin
+  // only adopt new skin if predicted gain exceeds tol
+
+  double lo = MAX(skinmin,skin/MAXRATIO);
+  double hi = MIN(skinmax,skin*MAXRATIO);
+
+  double cost0 = cost(skin,skin,cutforce,tpair,tneigh,tcomm,life);
+  double costbest = cost0;
+  double skinbest = skin;
+
+  if (hi > lo) {
+    for (int i = 0; i <= NSCAN; i++) {
+      double trial = lo + i*(hi-lo)/NSCAN;
+      double c = cost(trial,skin,cutforce,tpair,tneigh,tcomm,life);
+      if (c < costbest) {
+        costbest = c;
+        skinbest = trial;
+      }
+    }
+  }
+
+  if (cost0 - costbest <= tol*cost0) skinbest = skin;
+
+  // tune every from predicted list lifetime at new skin
+  // dangerous builds mean check came too late, so back off quickly
+  // else grow by at most 1 so a transient long lifetime is not trusted
+
+  int every_old = neighbor->every;
+  int every_new = every_old;
+
+  if (everyflag) {
+    if (ndanger > 0) every_new = MAX(1,every_old/2);
+    else {
+      double lifenew = life * skinbest/skin;
+      int target = MAX(1,static_cast<int> (EVERYFRAC*lifenew));
+      if (target > every_old) every_new = every_old + 1;
+      else if (target < every_old) every_new = target;
+    }
+  }
+
+  if (skinbest == skin && every_new == every_old) return;
+
+  nchange++;
+  print_change(skinbest,every_old,every_new,neighbor->ndanger);
+
+  // a new every takes effect immediately
+  // a new skin is applied in pre_exchange() of next step,
+  //   which forces a reneighboring with the new cutoffs
+
+  neighbor->every = every_new;
+
+  if (skinbest != skin) {
+    skin_new = skinbest;
+    next_reneighbor = ntimestep + 1;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   apply new skin on the reneighboring step requested by end_of_step()
+   ghost cutoff, bins, and KSpace grid extent all depend on skin
+------------------------------------------------------------------------- */
+
+void FixTuneSkin::pre_exchange()
+{
+  if (update->ntimestep != next_reneighbor) return;
+  next_reneighbor = -1;
+
+  neighbor->reset_skin(skin_new);
+  comm->setup();
+  neighbor->setup_bins();
+  if (force->kspace) force->kspace->setup_grid();
+}
+
+/* ----------------------------------------------------------------------
+   modeled wall time per step for a skin of s, given measurements at s0
+   pair and neighbor cost scale with # of pairs ~ (cutforce+skin)^3
+   comm cost scales with ghost shell thickness ~ (cutforce+skin)
+   list lifetime scales linearly with skin (ballistic motion)
+------------------------------------------------------------------------- */
+
+double FixTuneSkin::cost(double s, double s0, double cutforce,
+                         double tpair, double tneigh, double tcomm,
+                         double life)
+{
+  double g = (cutforce + s) / (cutforce + s0);
+  double g3 = g*g*g;
+  double lifes = life * s/s0;
+  return tpair*g3 + tcomm*g + (tneigh*g3 + tcomm*g) / lifes;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixTuneSkin::print_change(double skinbest, int every_old, int every_new,
+                               bigint ndanger)
+{
+  if (comm->me) return;
+
+  char str[256];
+  sprintf(str,"Fix tune/skin: step " BIGINT_FORMAT
+          " skin %g -> %g every %d -> %d dangerous builds = " BIGINT_FORMAT
+          "\n",update->ntimestep,neighbor->skin,skinbest,
+          every_old,every_new,ndanger);
+  if (screen) fputs(str,screen);
+  if (logfile) fputs(str,logfile);
+}
+
+/* ----------------------------------------------------------------------
+   return current skin, every, or # of changes made
+------------------------------------------------------------------------- */
+
+double FixTuneSkin::compute_vector(int i)
+{
+  if (i == 0) return neighbor->skin;
+  if (i == 1) return (double) neighbor->every;
+  return (double) nchange;
+}
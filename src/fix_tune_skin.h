@@ -0,0 +1,91 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(tune/skin,FixTuneSkin)
+
+#else
+
+#ifndef LMP_FIX_TUNE_SKIN_H
+#define LMP_FIX_TUNE_SKIN_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixTuneSkin : public Fix {
+ public:
+  FixTuneSkin(class LAMMPS *, int, char **);
+  ~FixTuneSkin() {}
+  int setmask();
+  void init();
+  void setup(int);
+  void end_of_step();
+  void pre_exchange();
+  double compute_vector(int);
+
+ private:
+  double skinmin,skinmax;       // bounds on skin distance, -1 = not set
+  double tol;                   // min fractional gain to change skin
+  int everyflag;                // 1 if neigh_modify every is also tuned
+
+  int firstflag;                // 1 if next end_of_step() sets baseline
+  bigint laststep;              // timestep of last measurement
+  bigint lastcalls;             // neighbor->ncalls at last measurement
+  bigint lastdanger;            // neighbor->ndanger at last measurement
+  double lastwall[3];           // Pair,Neigh,Comm timers at last measurement
+  double skin_new;              // skin to apply in pre_exchange()
+  int nchange;                  // # of times skin or every was changed
+
+  double cost(double, double, double, double, double, double, double);
+  void print_change(double, int, int, bigint);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Fix tune/skin requires neigh_modify check yes
+
+The skin can only be adjusted safely if neighbor lists are rebuilt
+based on how far atoms have moved.
+
+E: Fix tune/skin requires timer level normal or full
+
+The cost model uses the Pair, Neigh, and Comm timers which are not
+accumulated with timer level off or loop.
+
+E: Fix tune/skin is not compatible with KOKKOS
+
+Self-explanatory.
+
+E: Fix tune/skin requires a pair style
+
+Self-explanatory.
+
+W: Fix tune/skin resets neigh_modify delay to 0
+
+The every setting is changed during the run, so a non-zero delay
+could become inconsistent with it.
+
+*/
@@ -45,10 +45,6 @@ enum{LT,LE,GT,GE,EQ,NEQ,BETWEEN};
 
 #define BIG 1.0e20
 
-// allocate space for static class variable
-
-Group *Group::cptr;
-
 /* ----------------------------------------------------------------------
    initialize group memory
 ------------------------------------------------------------------------- */
@@ -643,46 +639,101 @@ void Group::add_molecules(int igroup, int bit)
       if (hash->find(molecule[i]) == hash->end()) (*hash)[molecule[i]] = 1;
     }
 
-  // list = set of unique molecule IDs for atoms to add
-  // pass list to all other procs via comm->ring()
+  // query = unique molecule IDs of my other atoms, not yet known to be added
 
-  int n = hash->size();
-  tagint *list;
-  memory->create(list,n,"group:list");
+  std::map<tagint,int> *query = new std::map<tagint,int>();
 
-  n = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (molecule[i] == 0) continue;
+    if (hash->find(molecule[i]) != hash->end()) continue;
+    if (query->find(molecule[i]) == query->end()) (*query)[molecule[i]] = 1;
+  }
+
+  // send molecule IDs in group and queried IDs to rendezvous procs
+  // each molecule ID is sent to proc it hashes to
+  // proc = -1 flags an ID in group, else it is the querying proc
+
+  int nsend = hash->size() + query->size();
+
+  int *proclist;
+  memory->create(proclist,nsend,"group:proclist");
+  MolRvous *inbuf = (MolRvous *)
+    memory->smalloc((bigint) nsend*sizeof(MolRvous),"group:inbuf");
+
+  int nprocs = comm->nprocs;
   std::map<tagint,int>::iterator pos;
-  for (pos = hash->begin(); pos != hash->end(); ++pos) list[n++] = pos->first;
 
-  cptr = this;
-  molbit = bit;
-  comm->ring(n,sizeof(tagint),list,1,molring,NULL);
+  nsend = 0;
+  for (pos = hash->begin(); pos != hash->end(); ++pos) {
+    proclist[nsend] = pos->first % nprocs;
+    inbuf[nsend].molID = pos->first;
+    inbuf[nsend].proc = -1;
+    nsend++;
+  }
+  for (pos = query->begin(); pos != query->end(); ++pos) {
+    proclist[nsend] = pos->first % nprocs;
+    inbuf[nsend].molID = pos->first;
+    inbuf[nsend].proc = me;
+    nsend++;
+  }
+
+  // perform rendezvous operation
+  // returned datums are queried molecule IDs that are in group
+
+  char *buf;
+  int nreturn = comm->rendezvous(nsend,proclist,(char *) inbuf,
+                                 sizeof(MolRvous),rendezvous_molecules,
+                                 buf,sizeof(MolRvous),(void *) this);
+  MolRvous *outbuf = (MolRvous *) buf;
+
+  memory->destroy(proclist);
+  memory->sfree(inbuf);
+
+  for (int m = 0; m < nreturn; m++) (*hash)[outbuf[m].molID] = 1;
+  memory->sfree(outbuf);
+
+  // add my atoms whose molecule ID is in hash to group
+
+  for (int i = 0; i < nlocal; i++)
+    if (hash->find(molecule[i]) != hash->end()) mask[i] |= bit;
 
   delete hash;
-  memory->destroy(list);
+  delete query;
 }
 
 /* ----------------------------------------------------------------------
-   callback from comm->ring()
-   cbuf = list of N molecule IDs, put them in hash
-   loop over my atoms, if matches molecule ID in hash,
-     add atom to group flagged by molbit
+   callback from comm->rendezvous()
+   inbuf = molecule IDs in group (proc = -1) and queried IDs (proc >= 0)
+   return each queried ID that is in group to the proc that asked for it
+   outbuf = same as inbuf, compressed to the returned datums
 ------------------------------------------------------------------------- */
 
-void Group::molring(int n, char *cbuf)
+int Group::rendezvous_molecules(int n, char *inbuf,
+                                int &flag, int *&proclist, char *&outbuf,
+                                void *ptr)
 {
-  tagint *list = (tagint *) cbuf;
-  std::map<tagint,int> *hash = cptr->hash;
-  int nlocal = cptr->atom->nlocal;
-  tagint *molecule = cptr->atom->molecule;
-  int *mask = cptr->atom->mask;
-  int molbit = cptr->molbit;
+  Group *gptr = (Group *) ptr;
+  Memory *memory = gptr->memory;
 
-  hash->clear();
-  for (int i = 0; i < n; i++) (*hash)[list[i]] = 1;
+  MolRvous *in = (MolRvous *) inbuf;
 
-  for (int i = 0; i < nlocal; i++)
-    if (hash->find(molecule[i]) != hash->end()) mask[i] |= molbit;
+  std::map<tagint,int> ingroup;
+  for (int i = 0; i < n; i++)
+    if (in[i].proc < 0) ingroup[in[i].molID] = 1;
+
+  memory->create(proclist,n,"group:proclist");
+
+  int nout = 0;
+  for (int i = 0; i < n; i++) {
+    if (in[i].proc < 0) continue;
+    if (ingroup.find(in[i].molID) == ingroup.end()) continue;
+    proclist[nout] = in[i].proc;
+    in[nout++] = in[i];
+  }
+
+  flag = 1;
+  outbuf = inbuf;
+  return nout;
 }
 
 /* ----------------------------------------------------------------------
@@ -70,12 +70,14 @@ class Group : protected Pointers {
   int find_unused();
   void add_molecules(int, int);
 
-  // static variable for ring communication callback to access class data
-  // callback functions for ring communication
+  // rendezvous datum and callback for molecule membership queries
 
-  static Group *cptr;
-  static void molring(int, char *);
-  int molbit;
+  struct MolRvous {
+    tagint molID;
+    int proc;
+  };
+
+  static int rendezvous_molecules(int, char *, int &, int *&, char *&, void *);
 };
 
 }
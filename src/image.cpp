@@ -46,6 +46,9 @@ using namespace MathConst;
 #define NELEMENTS 109
 #define EPSILON 1.0e-6
 
+#define MIN(A,B) ((A) < (B) ? (A) : (B))
+#define MAX(A,B) ((A) > (B) ? (A) : (B))
+
 enum{NUMERIC,MINVALUE,MAXVALUE};
 enum{CONTINUOUS,DISCRETE,SEQUENTIAL};
 enum{ABSOLUTE,FRACTIONAL};
@@ -58,6 +61,9 @@ Image::Image(LAMMPS *lmp, int nmap_caller) : Pointers(lmp)
   MPI_Comm_rank(world,&me);
   MPI_Comm_size(world,&nprocs);
 
+  npow2 = 1;
+  while (2*npow2 <= nprocs) npow2 *= 2;
+
   // defaults for 3d viz
 
   width = height = 512;
@@ -130,9 +136,14 @@ Image::~Image()
   memory->destroy(depthBuffer);
   memory->destroy(surfaceBuffer);
   memory->destroy(imageBuffer);
-  memory->destroy(depthcopy);
-  memory->destroy(surfacecopy);
+  memory->destroy(runsend);
+  memory->destroy(runrecv);
+  memory->destroy(pixsend);
+  memory->destroy(pixrecv);
+  memory->destroy(rgbsend);
   memory->destroy(rgbcopy);
+  memory->destroy(tilecounts);
+  memory->destroy(tiledispls);
 
   if (random) delete random;
 }
@@ -148,9 +159,25 @@ void Image::buffers()
   memory->create(depthBuffer,npixels,"image:depthBuffer");
   memory->create(surfaceBuffer,2*npixels,"image:surfaceBuffer");
   memory->create(imageBuffer,3*npixels,"image:imageBuffer");
-  memory->create(depthcopy,npixels,"image:depthcopy");
-  memory->create(surfacecopy,2*npixels,"image:surfacecopy");
+  memory->create(runsend,npixels+1,"image:runsend");
+  memory->create(runrecv,npixels+1,"image:runrecv");
+  memory->create(pixsend,3*npixels,"image:pixsend");
+  memory->create(pixrecv,3*npixels,"image:pixrecv");
+  memory->create(rgbsend,3*npixels,"image:rgbsend");
   memory->create(rgbcopy,3*npixels,"image:rgbcopy");
+
+  // tile of the composite image each proc owns after merge()
+
+  memory->create(tilecounts,nprocs,"image:tilecounts");
+  memory->create(tiledispls,nprocs,"image:tiledispls");
+
+  int lo,hi;
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    tile_range(iproc,lo,hi);
+    tilecounts[iproc] = 3*(hi-lo);
+    tiledispls[iproc] = 3*lo;
+  }
+  tile_range(me,pixlo,pixhi);
 }
 
 /* ----------------------------------------------------------------------
@@ -288,66 +315,146 @@ void Image::clear()
 /* ----------------------------------------------------------------------
    merge image from each processor into one composite image
    done pixel by pixel, respecting depth buffer
-   hi procs send to lo procs, cascading down logarithmically
+   binary swap: procs beyond the largest power of 2 first fold their
+     image into a partner, then in each of log2(npow2) stages partners
+     split their current pixel range in half, swap the halves they give
+     up and composite the half they keep
+   only non-empty pixels are sent, as runs of consecutive pixels
+   each proc ends up owning one tile, tiles are gathered on proc 0
 ------------------------------------------------------------------------- */
 
 void Image::merge()
+{
+  if (me >= npow2) exchange_pixels(me-npow2,0,npixels,-1,0,0);
+  else if (me+npow2 < nprocs) exchange_pixels(-1,0,0,me+npow2,0,npixels);
+
+  if (me < npow2) {
+    int lo = 0;
+    int hi = npixels;
+    for (int bit = npow2/2; bit; bit /= 2) {
+      int mid = lo + (hi-lo)/2;
+      if (me & bit) {
+        exchange_pixels(me^bit,lo,mid,me^bit,mid,hi);
+        lo = mid;
+      } else {
+        exchange_pixels(me^bit,mid,hi,me^bit,lo,mid);
+        hi = mid;
+      }
+    }
+  }
+
+  // extra SSAO enhancement
+  // each proc works on its own tile
+
+  if (ssao) compute_SSAO();
+
+  if (nprocs == 1) {
+    writeBuffer = imageBuffer;
+    return;
+  }
+
+  MPI_Gatherv(imageBuffer+3*pixlo,3*(pixhi-pixlo),MPI_BYTE,
+              rgbcopy,tilecounts,tiledispls,MPI_BYTE,0,world);
+  writeBuffer = rgbcopy;
+}
+
+/* ----------------------------------------------------------------------
+   pixel range [lo,hi) of the composite image owned by proc after merge()
+   each binary swap stage halves the range, so the tiles of procs
+     0 to npow2-1 are contiguous and in rank order
+   procs beyond npow2 own no pixels
+------------------------------------------------------------------------- */
+
+void Image::tile_range(int proc, int &lo, int &hi)
+{
+  lo = hi = 0;
+  if (proc >= npow2) return;
+
+  hi = npixels;
+  for (int bit = npow2/2; bit; bit /= 2) {
+    int mid = lo + (hi-lo)/2;
+    if (proc & bit) lo = mid;
+    else hi = mid;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   send pixels [sendlo,sendhi) to sendproc and
+     composite pixels [recvlo,recvhi) received from recvproc
+   either proc can be -1 for a one-way transfer
+   pixels are sent as runs of non-empty pixels, so background is free
+------------------------------------------------------------------------- */
+
+void Image::exchange_pixels(int sendproc, int sendlo, int sendhi,
+                            int recvproc, int recvlo, int recvhi)
 {
   MPI_Request requests[3];
+  MPI_Status status;
 
-  int nhalf = 1;
-  while (nhalf < nprocs) nhalf *= 2;
-  nhalf /= 2;
-
-  while (nhalf) {
-    if (me < nhalf && me+nhalf < nprocs) {
-      MPI_Irecv(rgbcopy,npixels*3,MPI_BYTE,me+nhalf,0,world,&requests[0]);
-      MPI_Irecv(depthcopy,npixels,MPI_DOUBLE,me+nhalf,0,world,&requests[1]);
-      if (ssao)
-        MPI_Irecv(surfacecopy,npixels*2,MPI_DOUBLE,
-                  me+nhalf,0,world,&requests[2]);
-      if (ssao) MPI_Waitall(3,requests,MPI_STATUS_IGNORE);
-      else MPI_Waitall(2,requests,MPI_STATUS_IGNORE);
-
-      for (int i = 0; i < npixels; i++) {
-        if (depthBuffer[i] < 0 || (depthcopy[i] >= 0 &&
-                                   depthcopy[i] < depthBuffer[i])) {
-          depthBuffer[i] = depthcopy[i];
-          imageBuffer[i*3+0] = rgbcopy[i*3+0];
-          imageBuffer[i*3+1] = rgbcopy[i*3+1];
-          imageBuffer[i*3+2] = rgbcopy[i*3+2];
-          if (ssao) {
-            surfaceBuffer[i*2+0] = surfacecopy[i*2+0];
-            surfaceBuffer[i*2+1] = surfacecopy[i*2+1];
-          }
+  const int nper = ssao ? 3 : 1;
+  const int nrecv = recvhi - recvlo;
+
+  if (recvproc >= 0) {
+    MPI_Irecv(runrecv,nrecv+1,MPI_INT,recvproc,0,world,&requests[0]);
+    MPI_Irecv(pixrecv,nper*nrecv,MPI_DOUBLE,recvproc,1,world,&requests[1]);
+    MPI_Irecv(rgbcopy,3*nrecv,MPI_BYTE,recvproc,2,world,&requests[2]);
+  }
+
+  if (sendproc >= 0) {
+    int nrun = 0;
+    int m = 0;
+    int n = 0;
+    int i = sendlo;
+    while (i < sendhi) {
+      if (depthBuffer[i] < 0) {
+        i++;
+        continue;
+      }
+      runsend[nrun++] = i - sendlo;
+      while (i < sendhi && depthBuffer[i] >= 0) {
+        pixsend[m++] = depthBuffer[i];
+        if (ssao) {
+          pixsend[m++] = surfaceBuffer[i*2+0];
+          pixsend[m++] = surfaceBuffer[i*2+1];
         }
+        rgbsend[n++] = imageBuffer[i*3+0];
+        rgbsend[n++] = imageBuffer[i*3+1];
+        rgbsend[n++] = imageBuffer[i*3+2];
+        i++;
       }
-
-    } else if (me >= nhalf && me < 2*nhalf) {
-      MPI_Send(imageBuffer,npixels*3,MPI_BYTE,me-nhalf,0,world);
-      MPI_Send(depthBuffer,npixels,MPI_DOUBLE,me-nhalf,0,world);
-      if (ssao) MPI_Send(surfaceBuffer,npixels*2,MPI_DOUBLE,me-nhalf,0,world);
+      runsend[nrun] = i - sendlo - runsend[nrun-1];
+      nrun++;
     }
 
-    nhalf /= 2;
+    MPI_Send(runsend,nrun,MPI_INT,sendproc,0,world);
+    MPI_Send(pixsend,m,MPI_DOUBLE,sendproc,1,world);
+    MPI_Send(rgbsend,n,MPI_BYTE,sendproc,2,world);
   }
 
-  // extra SSAO enhancement
-  // bcast full image to all procs
-  // each works on subset of pixels
-  // gather result back to proc 0
-
-  if (ssao) {
-    MPI_Bcast(imageBuffer,npixels*3,MPI_BYTE,0,world);
-    MPI_Bcast(surfaceBuffer,npixels*2,MPI_DOUBLE,0,world);
-    MPI_Bcast(depthBuffer,npixels,MPI_DOUBLE,0,world);
-    compute_SSAO();
-    int pixelPart = height/nprocs * width*3;
-    MPI_Gather(imageBuffer+me*pixelPart,pixelPart,MPI_BYTE,
-               rgbcopy,pixelPart,MPI_BYTE,0,world);
-    writeBuffer = rgbcopy;
-  } else {
-    writeBuffer = imageBuffer;
+  if (recvproc < 0) return;
+
+  int nrun;
+  MPI_Wait(&requests[0],&status);
+  MPI_Get_count(&status,MPI_INT,&nrun);
+  MPI_Waitall(2,&requests[1],MPI_STATUSES_IGNORE);
+
+  int m = 0;
+  int n = 0;
+  for (int irun = 0; irun < nrun; irun += 2) {
+    int i = recvlo + runrecv[irun];
+    const int iend = i + runrecv[irun+1];
+    for (; i < iend; i++, m += nper, n += 3) {
+      if (depthBuffer[i] < 0 || pixrecv[m] < depthBuffer[i]) {
+        depthBuffer[i] = pixrecv[m];
+        imageBuffer[i*3+0] = rgbcopy[n+0];
+        imageBuffer[i*3+1] = rgbcopy[n+1];
+        imageBuffer[i*3+2] = rgbcopy[n+2];
+        if (ssao) {
+          surfaceBuffer[i*2+0] = pixrecv[m+1];
+          surfaceBuffer[i*2+1] = pixrecv[m+2];
+        }
+      }
+    }
   }
 }
 
@@ -881,110 +988,139 @@ void Image::compute_SSAO()
         -tanPerPixel / zoom;
   int pixelRadius = (int) trunc (SSAORadius / pixelWidth + 0.5);
 
-  int x,y,s;
-  int hPart = height / nprocs;
-  int index = me * hPart * width;
-  for (y = me * hPart; y < (me + 1) * hPart; y ++) {
-    for (x = 0; x < width; x ++, index ++) {
-      double cdepth = depthBuffer[index];
-      if (cdepth < 0) { continue; }
-
-      double sx = surfaceBuffer[index * 2 + 0];
-      double sy = surfaceBuffer[index * 2 + 1];
-      double sin_t = -sqrt(sx*sx + sy*sy);
-
-      double mytheta = random->uniform() * SSAOJitter;
-      double ao = 0.0;
-
-      for (s = 0; s < SSAOSamples; s ++) {
-        double hx = cos(mytheta);
-        double hy = sin(mytheta);
-        mytheta += delTheta;
-
-        // multiply by z cross surface tangent
-        // so that dot (aka cos) works here
-
-        double scaled_sin_t = sin_t * (hx*sy + hy*sx);
-
-        // Bresenham's line algorithm to march over depthBuffer
-
-        int dx = static_cast<int> (hx * pixelRadius);
-        int dy = static_cast<int> (hy * pixelRadius);
-        int ex = x + dx;
-        if (ex < 0) { ex = 0; } if (ex >= width) { ex = width - 1; }
-        int ey = y + dy;
-        if (ey < 0) { ey = 0; } if (ey >= height) { ey = height - 1; }
-        double delta;
-        int small, large;
-        double lenIncr;
-        if (fabs(hx) > fabs(hy)) {
-          small = (hx > 0) ? 1 : -1;
-          large = (hy > 0) ? width : -width;
-          delta = fabs(hy / hx);
-        } else {
-          small = (hy > 0) ? width : -width;
-          large = (hx > 0) ? 1 : -1;
-          delta = fabs(hx / hy);
+  // shading a pixel looks at depths up to pixelRadius rows and columns away
+  // get composite depths of that halo around my tile from the procs owning it
+
+  const int halo = (pixelRadius+1) * (width+1);
+  int lo,hi,qlo,qhi;
+  int nrequest = 0;
+  MPI_Request *requests = new MPI_Request[nprocs];
+
+  if (pixhi > pixlo) {
+    for (int iproc = 0; iproc < npow2; iproc++) {
+      if (iproc == me) continue;
+      tile_range(iproc,qlo,qhi);
+      lo = MAX(qlo,pixlo-halo);
+      hi = MIN(qhi,pixhi+halo);
+      if (hi > lo)
+        MPI_Irecv(&depthBuffer[lo],hi-lo,MPI_DOUBLE,iproc,0,world,
+                  &requests[nrequest++]);
+    }
+    for (int iproc = 0; iproc < npow2; iproc++) {
+      if (iproc == me) continue;
+      tile_range(iproc,qlo,qhi);
+      if (qhi == qlo) continue;
+      lo = MAX(pixlo,qlo-halo);
+      hi = MIN(pixhi,qhi+halo);
+      if (hi > lo) MPI_Send(&depthBuffer[lo],hi-lo,MPI_DOUBLE,iproc,0,world);
+    }
+  }
+  MPI_Waitall(nrequest,requests,MPI_STATUSES_IGNORE);
+  delete [] requests;
+
+  int x,y,s,index;
+  for (index = pixlo; index < pixhi; index++) {
+    x = index % width;
+    y = index / width;
+    double cdepth = depthBuffer[index];
+    if (cdepth < 0) { continue; }
+
+    double sx = surfaceBuffer[index * 2 + 0];
+    double sy = surfaceBuffer[index * 2 + 1];
+    double sin_t = -sqrt(sx*sx + sy*sy);
+
+    double mytheta = random->uniform() * SSAOJitter;
+    double ao = 0.0;
+
+    for (s = 0; s < SSAOSamples; s ++) {
+      double hx = cos(mytheta);
+      double hy = sin(mytheta);
+      mytheta += delTheta;
+
+      // multiply by z cross surface tangent
+      // so that dot (aka cos) works here
+
+      double scaled_sin_t = sin_t * (hx*sy + hy*sx);
+
+      // Bresenham's line algorithm to march over depthBuffer
+
+      int dx = static_cast<int> (hx * pixelRadius);
+      int dy = static_cast<int> (hy * pixelRadius);
+      int ex = x + dx;
+      if (ex < 0) { ex = 0; } if (ex >= width) { ex = width - 1; }
+      int ey = y + dy;
+      if (ey < 0) { ey = 0; } if (ey >= height) { ey = height - 1; }
+      double delta;
+      int small, large, nsteps;
+      double lenIncr;
+      if (fabs(hx) > fabs(hy)) {
+        small = (hx > 0) ? 1 : -1;
+        large = (hy > 0) ? width : -width;
+        delta = fabs(hy / hx);
+        nsteps = abs(ex - x);
+      } else {
+        small = (hy > 0) ? width : -width;
+        large = (hx > 0) ? 1 : -1;
+        delta = fabs(hx / hy);
+        nsteps = abs(ey - y);
+      }
+      lenIncr = sqrt (1 + delta * delta) * pixelWidth;
+
+      // initialize with one step
+      // because the center point doesn't need testing
+
+      int ind = index + small;
+      double len = lenIncr;
+      double err = delta;
+      if (err >= 1.0) {
+        ind += large;
+        err -= 1.0;
+      }
+
+      double minPeak = -1;
+      double peakLen = 0.0;
+      int stepsTaken = 1;
+      while (stepsTaken <= nsteps) {
+        if (ind < 0 || ind >= (width*height)) {
+          break;
         }
-        lenIncr = sqrt (1 + delta * delta) * pixelWidth;
 
-        // initialize with one step
-        // because the center point doesn't need testing
+        // cdepth - depthBuffer B/C we want it in the negative z direction
 
-        int end = ex + ey * width;
-        int ind = index + small;
-        double len = lenIncr;
-        double err = delta;
+        if (minPeak < 0 || (depthBuffer[ind] >= 0 &&
+                            depthBuffer[ind] < minPeak)) {
+          minPeak = depthBuffer[ind];
+          peakLen = len;
+        }
+        ind += small;
+        len += lenIncr;
+        err += delta;
         if (err >= 1.0) {
           ind += large;
           err -= 1.0;
         }
+        stepsTaken ++;
+      }
 
-        double minPeak = -1;
-        double peakLen = 0.0;
-        int stepsTaken = 1;
-        while ((small > 0 && ind <= end) || (small < 0 && ind >= end)) {
-          if (ind < 0 || ind >= (width*height)) {
-            break;
-          }
-
-          // cdepth - depthBuffer B/C we want it in the negative z direction
-
-          if (minPeak < 0 || (depthBuffer[ind] >= 0 &&
-                              depthBuffer[ind] < minPeak)) {
-            minPeak = depthBuffer[ind];
-            peakLen = len;
-          }
-          ind += small;
-          len += lenIncr;
-          err += delta;
-          if (err >= 1.0) {
-            ind += large;
-            err -= 1.0;
-          }
-          stepsTaken ++;
-        }
-
-        if (peakLen > 0) {
-          double h = atan ((cdepth - minPeak) / peakLen);
-          ao += saturate(sin (h) - scaled_sin_t);
-        } else {
-          ao += saturate(-scaled_sin_t);
-        }
+      if (peakLen > 0) {
+        double h = atan ((cdepth - minPeak) / peakLen);
+        ao += saturate(sin (h) - scaled_sin_t);
+      } else {
+        ao += saturate(-scaled_sin_t);
       }
-      ao /= (double)SSAOSamples;
-
-      double c[3];
-      c[0] = (double) (*(unsigned char *) &imageBuffer[index * 3 + 0]);
-      c[1] = (double) (*(unsigned char *) &imageBuffer[index * 3 + 1]);
-      c[2] = (double) (*(unsigned char *) &imageBuffer[index * 3 + 2]);
-      c[0] *= (1.0 - ao);
-      c[1] *= (1.0 - ao);
-      c[2] *= (1.0 - ao);
-      imageBuffer[index * 3 + 0] = (int) c[0];
-      imageBuffer[index * 3 + 1] = (int) c[1];
-      imageBuffer[index * 3 + 2] = (int) c[2];
     }
+    ao /= (double)SSAOSamples;
+
+    double c[3];
+    c[0] = (double) (*(unsigned char *) &imageBuffer[index * 3 + 0]);
+    c[1] = (double) (*(unsigned char *) &imageBuffer[index * 3 + 1]);
+    c[2] = (double) (*(unsigned char *) &imageBuffer[index * 3 + 2]);
+    c[0] *= (1.0 - ao);
+    c[1] *= (1.0 - ao);
+    c[2] *= (1.0 - ao);
+    imageBuffer[index * 3 + 0] = (int) c[0];
+    imageBuffer[index * 3 + 1] = (int) c[1];
+    imageBuffer[index * 3 + 2] = (int) c[2];
   }
 }
 
@@ -66,13 +66,23 @@ class Image : protected Pointers {
  private:
   int me,nprocs;
   int npixels;
+  int npow2;                    // largest power of 2 <= nprocs
+  int pixlo,pixhi;              // pixels this proc owns after merge()
+  int *tilecounts,*tiledispls;  // RGB bytes of each proc's tile for gather
 
   class ColorMap **maps;
   int nmap;
 
   double *depthBuffer,*surfaceBuffer;
-  double *depthcopy,*surfacecopy;
-  unsigned char *imageBuffer,*rgbcopy,*writeBuffer;
+  unsigned char *imageBuffer,*writeBuffer;
+
+  // run-length encoded pixels exchanged during merge()
+  // runs = offset/length pairs of non-empty pixels
+  // pix = depth, plus 2 surface values if SSAO, per non-empty pixel
+
+  int *runsend,*runrecv;
+  double *pixsend,*pixrecv;
+  unsigned char *rgbsend,*rgbcopy;
 
   // constant view params
 
@@ -119,6 +129,8 @@ class Image : protected Pointers {
   // internal methods
 
   void draw_pixel(int, int, double, double *, double*);
+  void tile_range(int, int &, int &);
+  void exchange_pixels(int, int, int, int, int, int);
   void compute_SSAO();
 
   // inline functions
@@ -0,0 +1,244 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <mpi.h>
+#include <string.h>
+#include "imbalance_cost.h"
+#include "atom.h"
+#include "comm.h"
+#include "force.h"
+#include "neighbor.h"
+#include "neigh_request.h"
+#include "neigh_list.h"
+#include "timer.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+enum{ALL,PAIR,OTHER};
+
+#define BIG 1.0e20
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceCost::ImbalanceCost(LAMMPS *lmp) : Imbalance(lmp)
+{
+  which = ALL;
+  did_warn = 0;
+  last[0] = last[1] = 0.0;
+  nmax = 0;
+  wtatom = NULL;
+}
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceCost::~ImbalanceCost()
+{
+  memory->destroy(wtatom);
+}
+
+/* -------------------------------------------------------------------- */
+
+int ImbalanceCost::options(int narg, char **arg)
+{
+  if (narg < 1) error->all(FLERR,"Illegal balance weight command");
+  factor = force->numeric(FLERR,arg[0]);
+  if (factor <= 0.0) error->all(FLERR,"Illegal balance weight command");
+
+  if (narg > 1) {
+    if (strcmp(arg[1],"pair") == 0) which = PAIR;
+    else if (strcmp(arg[1],"other") == 0) which = OTHER;
+    if (which != ALL) return 2;
+  }
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   reset last and timers if necessary, same as ImbalanceTime
+------------------------------------------------------------------------- */
+
+void ImbalanceCost::init(int flag)
+{
+  last[0] = last[1] = 0.0;
+  if (flag) timer->init();
+}
+
+/* ----------------------------------------------------------------------
+   per-atom cost model measured from the run
+   pair cost = pair + neighbor time since last invocation,
+     distributed to atoms in proportion to their # of neighbors
+   other cost = bond + kspace + fix time since last invocation,
+     distributed equally to atoms
+   if no time was tallied yet, one neighbor is one unit of pair cost
+------------------------------------------------------------------------- */
+
+void ImbalanceCost::compute(double *weight)
+{
+  int i,ii;
+  int nlocal = atom->nlocal;
+
+  // cost = wall time of pair and other parts since last invocation
+
+  double cost[2],now[2];
+  cost[0] = cost[1] = 0.0;
+  if (timer->has_normal()) {
+    now[0] = timer->get_wall(Timer::PAIR) + timer->get_wall(Timer::NEIGH);
+    now[1] = timer->get_wall(Timer::BOND) + timer->get_wall(Timer::KSPACE) +
+      timer->get_wall(Timer::MODIFY);
+    cost[0] = now[0] - last[0];
+    cost[1] = now[1] - last[1];
+    last[0] = now[0];
+    last[1] = now[1];
+  }
+
+  if (which == PAIR) cost[1] = 0.0;
+  if (which == OTHER) cost[0] = 0.0;
+
+  double mycost = cost[0] + cost[1];
+  double maxcost;
+  MPI_Allreduce(&mycost,&maxcost,1,MPI_DOUBLE,MPI_MAX,world);
+
+  // neighsum = total neigh count for atoms on this proc
+
+  NeighList *list = NULL;
+  if (which != OTHER) list = find_list();
+  bigint neighsum = 0;
+  if (list) {
+    const int inum = list->inum;
+    const int * const ilist = list->ilist;
+    const int * const numneigh = list->numneigh;
+    for (ii = 0; ii < inum; ii++) neighsum += numneigh[ilist[ii]];
+  }
+
+  // no time yet tallied: use neighbor counts, or equal weights
+
+  if (maxcost <= 0.0) {
+    if (which == OTHER) {
+      cost[0] = 0.0;
+      cost[1] = nlocal;
+    } else {
+      cost[0] = neighsum ? 1.0*neighsum : 1.0*nlocal;
+      cost[1] = 0.0;
+    }
+    mycost = cost[0] + cost[1];
+  }
+
+  // avecost = average cost per atom across all procs
+  // used for atoms on procs that had no cost in the last interval
+
+  double mine[2],all[2];
+  mine[0] = mycost;
+  mine[1] = nlocal;
+  MPI_Allreduce(mine,all,2,MPI_DOUBLE,MPI_SUM,world);
+  double avecost = 1.0;
+  if (all[0] > 0.0 && all[1] > 0.0) avecost = all[0]/all[1];
+
+  // wtatom = cost of each owned atom
+
+  if (nlocal > nmax) {
+    memory->destroy(wtatom);
+    nmax = atom->nmax;
+    memory->create(wtatom,nmax,"imbalance:wtatom");
+  }
+
+  if (nlocal && mycost <= 0.0) {
+    for (i = 0; i < nlocal; i++) wtatom[i] = avecost;
+  } else if (nlocal) {
+    double peratom = cost[1]/nlocal;
+    if (neighsum == 0) peratom += cost[0]/nlocal;
+    for (i = 0; i < nlocal; i++) wtatom[i] = peratom;
+
+    if (neighsum) {
+      double perneigh = cost[0]/neighsum;
+      const int inum = list->inum;
+      const int * const ilist = list->ilist;
+      const int * const numneigh = list->numneigh;
+      for (ii = 0; ii < inum; ii++) {
+        i = ilist[ii];
+        if (i < nlocal) wtatom[i] += perneigh*numneigh[i];
+      }
+    }
+
+    // atoms without neighbors or other cost still cost something
+
+    double wtmin = 0.01*avecost;
+    for (i = 0; i < nlocal; i++)
+      if (wtatom[i] < wtmin) wtatom[i] = wtmin;
+  }
+
+  // apply factor if specified != 1.0
+  // wtlo,wthi = lo/hi values across all owned atoms
+  // lo value does not change
+  // newhi = new hi value to give hi/lo ratio factor times larger/smaller
+  // expand/contract all wtatom values from lo->hi to lo->newhi
+
+  if (factor != 1.0) {
+    double mylo = BIG;
+    double myhi = 0.0;
+    for (i = 0; i < nlocal; i++) {
+      mylo = MIN(mylo,wtatom[i]);
+      myhi = MAX(myhi,wtatom[i]);
+    }
+    double wtlo,wthi;
+    MPI_Allreduce(&mylo,&wtlo,1,MPI_DOUBLE,MPI_MIN,world);
+    MPI_Allreduce(&myhi,&wthi,1,MPI_DOUBLE,MPI_MAX,world);
+
+    if (wtlo < wthi) {
+      double newhi = wthi*factor;
+      for (i = 0; i < nlocal; i++)
+        wtatom[i] = wtlo + ((wtatom[i]-wtlo)/(wthi-wtlo)) * (newhi-wtlo);
+    }
+  }
+
+  for (i = 0; i < nlocal; i++) weight[i] *= wtatom[i];
+}
+
+/* ----------------------------------------------------------------------
+   find a conventional half or full neighbor list with neighbor counts
+   return NULL if there is none or no lists were built yet
+------------------------------------------------------------------------- */
+
+NeighList *ImbalanceCost::find_list()
+{
+  int req;
+
+  if (neighbor->ago >= 0) {
+    for (req = 0; req < neighbor->old_nrequest; ++req)
+      if (neighbor->old_requests[req]->half &&
+          neighbor->old_requests[req]->skip == 0 &&
+          neighbor->lists[req] && neighbor->lists[req]->numneigh)
+        return neighbor->lists[req];
+    for (req = 0; req < neighbor->old_nrequest; ++req)
+      if (neighbor->old_requests[req]->full &&
+          neighbor->old_requests[req]->skip == 0 &&
+          neighbor->lists[req] && neighbor->lists[req]->numneigh)
+        return neighbor->lists[req];
+  }
+
+  if (comm->me == 0 && !did_warn)
+    error->warning(FLERR,"Balance weight cost uses no neighbor counts "
+                   "b/c no list found");
+  did_warn = 1;
+  return NULL;
+}
+
+/* -------------------------------------------------------------------- */
+
+void ImbalanceCost::info(FILE *fp)
+{
+  const char *part = "pair+other";
+  if (which == PAIR) part = "pair";
+  else if (which == OTHER) part = "other";
+  fprintf(fp,"  cost weight factor: %g (%s)\n",factor,part);
+}
@@ -0,0 +1,63 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_IMBALANCE_COST_H
+#define LMP_IMBALANCE_COST_H
+
+#include "imbalance.h"
+
+namespace LAMMPS_NS {
+
+class ImbalanceCost : public Imbalance {
+ public:
+  ImbalanceCost(class LAMMPS *);
+  virtual ~ImbalanceCost();
+
+ public:
+  // parse options, return number of arguments consumed
+  virtual int options(int, char **);
+  // reinitialize internal data
+  virtual void init(int);
+  // compute and apply weight factors to local atom array
+  virtual void compute(double *);
+  // print information about the state of this imbalance compute
+  virtual void info(FILE *);
+
+ private:
+  double factor;               // weight factor for cost imbalance
+  int which;                   // which part of the cost to use
+  double last[2];              // pair and other wall time from last call
+  int did_warn;                // 1 if warned about no suitable neighbor list
+  int nmax;                    // allocated size of wtatom
+  double *wtatom;              // cost of each owned atom
+
+  class NeighList *find_list();
+};
+
+}
+
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal balance weight command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+W: Balance weight cost uses no neighbor counts b/c no list found
+
+No suitable neighbor list was found, so the pair cost of each
+processor is distributed equally to its atoms.
+
+*/
@@ -103,7 +103,7 @@ static const char *varstyles[] = {
   "index", "loop", "world", "universe", "uloop", "string", "getenv",
   "file", "atomfile", "format", "equal", "atom", "python", "(unknown)"};
 
-static const char *mapstyles[] = { "none", "array", "hash" };
+static const char *mapstyles[] = { "none", "array", "hash", "robin" };
 
 static const char *commstyles[] = { "brick", "tiled" };
 static const char *commlayout[] = { "uniform", "nonuniform", "irregular" };
@@ -79,6 +79,8 @@ class KSpace : protected Pointers {
   int nx_msm_max,ny_msm_max,nz_msm_max;
 
   int group_group_enable;         // 1 if style supports group/group calculation
+  int mc_enable;                  // 1 if style supports incremental energies
+                                  // for Monte Carlo moves of charges
 
   // KOKKOS host/device flag and data masks
 
@@ -89,6 +91,7 @@ class KSpace : protected Pointers {
   int compute_flag;               // 0 if skip compute()
   int fftbench;                   // 0 if skip FFT timing
   int collective_flag;            // 1 if use MPI collectives for FFT/remap
+  int fft_pipeline;               // # of chunks per FFT remap, 0 = none
   int stagger_flag;               // 1 if using staggered PPPM grids
 
   double splittol;                // tolerance for when to truncate splitting
@@ -119,6 +122,14 @@ class KSpace : protected Pointers {
   virtual void compute(int, int) = 0;
   virtual void compute_group_group(int, int, int) {};
 
+  // incremental energy of trial charge moves, used by Monte Carlo fixes
+
+  virtual void setup_mc() {};
+  virtual double compute_mc_delta(int, double *, double **, double **)
+    {return 0.0;}
+  virtual double compute_mc_intra() {return 0.0;}
+  virtual void accept_mc() {};
+
   virtual void pack_forward(int, FFT_SCALAR *, int, int *) {};
   virtual void unpack_forward(int, FFT_SCALAR *, int, int *) {};
   virtual void pack_reverse(int, FFT_SCALAR *, int, int *) {};
@@ -31,6 +31,7 @@
 #include "style_region.h"
 #include "universe.h"
 #include "input.h"
+#include "variable.h"
 #include "atom.h"
 #include "update.h"
 #include "neighbor.h"
@@ -711,6 +712,7 @@ void LAMMPS::post_create()
 
 void LAMMPS::init()
 {
+  input->variable->init();  // variable discards compiled formulas
   update->init();
   force->init();         // pair must come after update due to minimizer
   domain->init();
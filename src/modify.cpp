@@ -25,6 +25,7 @@
 #include "domain.h"
 #include "input.h"
 #include "variable.h"
+#include "timer.h"
 #include "memory.h"
 #include "error.h"
 
@@ -65,6 +66,7 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
   list_min_energy = NULL;
 
   end_of_step_every = NULL;
+  fix_region = NULL;
 
   list_timeflag = NULL;
 
@@ -142,6 +144,7 @@ Modify::~Modify()
   delete [] list_min_energy;
 
   delete [] end_of_step_every;
+  delete [] fix_region;
   delete [] list_timeflag;
 
   restart_deallocate(0);
@@ -194,6 +197,19 @@ void Modify::init()
   list_init(MIN_POST_FORCE,n_min_post_force,list_min_post_force);
   list_init(MIN_ENERGY,n_min_energy,list_min_energy);
 
+  // register a timer sub-timer for each fix
+  // so time spent in its per-step callbacks is reported with timer full
+
+  delete [] fix_region;
+  fix_region = new int[nfix];
+  char *name;
+  for (i = 0; i < nfix; i++) {
+    name = new char[strlen(fix[i]->id)+strlen(fix[i]->style)+8];
+    sprintf(name,"fix %s (%s)",fix[i]->id,fix[i]->style);
+    fix_region[i] = timer->add_region(name);
+    delete [] name;
+  }
+
   // init each fix
   // not sure if now needs to come before compute init
   // used to b/c temperature computes called fix->dof() in their init,
@@ -364,8 +380,12 @@ void Modify::setup_pre_reverse(int eflag, int vflag)
 
 void Modify::initial_integrate(int vflag)
 {
-  for (int i = 0; i < n_initial_integrate; i++)
-    fix[list_initial_integrate[i]]->initial_integrate(vflag);
+  for (int i = 0; i < n_initial_integrate; i++) {
+    int ifix = list_initial_integrate[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->initial_integrate(vflag);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -374,8 +394,12 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
-  for (int i = 0; i < n_post_integrate; i++)
-    fix[list_post_integrate[i]]->post_integrate();
+  for (int i = 0; i < n_post_integrate; i++) {
+    int ifix = list_post_integrate[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->post_integrate();
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -384,8 +408,12 @@ void Modify::post_integrate()
 
 void Modify::pre_exchange()
 {
-  for (int i = 0; i < n_pre_exchange; i++)
-    fix[list_pre_exchange[i]]->pre_exchange();
+  for (int i = 0; i < n_pre_exchange; i++) {
+    int ifix = list_pre_exchange[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->pre_exchange();
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -394,8 +422,12 @@ void Modify::pre_exchange()
 
 void Modify::pre_neighbor()
 {
-  for (int i = 0; i < n_pre_neighbor; i++)
-    fix[list_pre_neighbor[i]]->pre_neighbor();
+  for (int i = 0; i < n_pre_neighbor; i++) {
+    int ifix = list_pre_neighbor[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->pre_neighbor();
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -404,8 +436,12 @@ void Modify::pre_neighbor()
 
 void Modify::pre_force(int vflag)
 {
-  for (int i = 0; i < n_pre_force; i++)
-    fix[list_pre_force[i]]->pre_force(vflag);
+  for (int i = 0; i < n_pre_force; i++) {
+    int ifix = list_pre_force[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->pre_force(vflag);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 /* ----------------------------------------------------------------------
    pre_reverse call, only for relevant fixes
@@ -413,8 +449,12 @@ void Modify::pre_force(int vflag)
 
 void Modify::pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_pre_reverse; i++)
-    fix[list_pre_reverse[i]]->pre_reverse(eflag,vflag);
+  for (int i = 0; i < n_pre_reverse; i++) {
+    int ifix = list_pre_reverse[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->pre_reverse(eflag,vflag);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -423,8 +463,12 @@ void Modify::pre_reverse(int eflag, int vflag)
 
 void Modify::post_force(int vflag)
 {
-  for (int i = 0; i < n_post_force; i++)
-    fix[list_post_force[i]]->post_force(vflag);
+  for (int i = 0; i < n_post_force; i++) {
+    int ifix = list_post_force[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->post_force(vflag);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -433,8 +477,12 @@ void Modify::post_force(int vflag)
 
 void Modify::final_integrate()
 {
-  for (int i = 0; i < n_final_integrate; i++)
-    fix[list_final_integrate[i]]->final_integrate();
+  for (int i = 0; i < n_final_integrate; i++) {
+    int ifix = list_final_integrate[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->final_integrate();
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -445,8 +493,12 @@ void Modify::final_integrate()
 void Modify::end_of_step()
 {
   for (int i = 0; i < n_end_of_step; i++)
-    if (update->ntimestep % end_of_step_every[i] == 0)
-      fix[list_end_of_step[i]]->end_of_step();
+    if (update->ntimestep % end_of_step_every[i] == 0) {
+      int ifix = list_end_of_step[i];
+      timer->region_start(fix_region[ifix]);
+      fix[ifix]->end_of_step();
+      timer->region_stop(fix_region[ifix]);
+    }
 }
 
 /* ----------------------------------------------------------------------
@@ -523,9 +575,12 @@ void Modify::setup_pre_force_respa(int vflag, int ilevel)
 
 void Modify::initial_integrate_respa(int vflag, int ilevel, int iloop)
 {
-  for (int i = 0; i < n_initial_integrate_respa; i++)
-    fix[list_initial_integrate_respa[i]]->
-      initial_integrate_respa(vflag,ilevel,iloop);
+  for (int i = 0; i < n_initial_integrate_respa; i++) {
+    int ifix = list_initial_integrate_respa[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->initial_integrate_respa(vflag,ilevel,iloop);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -534,8 +589,12 @@ void Modify::initial_integrate_respa(int vflag, int ilevel, int iloop)
 
 void Modify::post_integrate_respa(int ilevel, int iloop)
 {
-  for (int i = 0; i < n_post_integrate_respa; i++)
-    fix[list_post_integrate_respa[i]]->post_integrate_respa(ilevel,iloop);
+  for (int i = 0; i < n_post_integrate_respa; i++) {
+    int ifix = list_post_integrate_respa[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->post_integrate_respa(ilevel,iloop);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -544,8 +603,12 @@ void Modify::post_integrate_respa(int ilevel, int iloop)
 
 void Modify::pre_force_respa(int vflag, int ilevel, int iloop)
 {
-  for (int i = 0; i < n_pre_force_respa; i++)
-    fix[list_pre_force_respa[i]]->pre_force_respa(vflag,ilevel,iloop);
+  for (int i = 0; i < n_pre_force_respa; i++) {
+    int ifix = list_pre_force_respa[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->pre_force_respa(vflag,ilevel,iloop);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -554,8 +617,12 @@ void Modify::pre_force_respa(int vflag, int ilevel, int iloop)
 
 void Modify::post_force_respa(int vflag, int ilevel, int iloop)
 {
-  for (int i = 0; i < n_post_force_respa; i++)
-    fix[list_post_force_respa[i]]->post_force_respa(vflag,ilevel,iloop);
+  for (int i = 0; i < n_post_force_respa; i++) {
+    int ifix = list_post_force_respa[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->post_force_respa(vflag,ilevel,iloop);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -564,8 +631,12 @@ void Modify::post_force_respa(int vflag, int ilevel, int iloop)
 
 void Modify::final_integrate_respa(int ilevel, int iloop)
 {
-  for (int i = 0; i < n_final_integrate_respa; i++)
-    fix[list_final_integrate_respa[i]]->final_integrate_respa(ilevel,iloop);
+  for (int i = 0; i < n_final_integrate_respa; i++) {
+    int ifix = list_final_integrate_respa[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->final_integrate_respa(ilevel,iloop);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -574,8 +645,12 @@ void Modify::final_integrate_respa(int ilevel, int iloop)
 
 void Modify::min_pre_exchange()
 {
-  for (int i = 0; i < n_min_pre_exchange; i++)
-    fix[list_min_pre_exchange[i]]->min_pre_exchange();
+  for (int i = 0; i < n_min_pre_exchange; i++) {
+    int ifix = list_min_pre_exchange[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->min_pre_exchange();
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -584,8 +659,12 @@ void Modify::min_pre_exchange()
 
 void Modify::min_pre_neighbor()
 {
-  for (int i = 0; i < n_min_pre_neighbor; i++)
-    fix[list_min_pre_neighbor[i]]->min_pre_neighbor();
+  for (int i = 0; i < n_min_pre_neighbor; i++) {
+    int ifix = list_min_pre_neighbor[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->min_pre_neighbor();
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -594,8 +673,12 @@ void Modify::min_pre_neighbor()
 
 void Modify::min_pre_force(int vflag)
 {
-  for (int i = 0; i < n_min_pre_force; i++)
-    fix[list_min_pre_force[i]]->min_pre_force(vflag);
+  for (int i = 0; i < n_min_pre_force; i++) {
+    int ifix = list_min_pre_force[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->min_pre_force(vflag);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -604,8 +687,12 @@ void Modify::min_pre_force(int vflag)
 
 void Modify::min_pre_reverse(int eflag, int vflag)
 {
-  for (int i = 0; i < n_min_pre_reverse; i++)
-    fix[list_min_pre_reverse[i]]->min_pre_reverse(eflag,vflag);
+  for (int i = 0; i < n_min_pre_reverse; i++) {
+    int ifix = list_min_pre_reverse[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->min_pre_reverse(eflag,vflag);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -614,8 +701,12 @@ void Modify::min_pre_reverse(int eflag, int vflag)
 
 void Modify::min_post_force(int vflag)
 {
-  for (int i = 0; i < n_min_post_force; i++)
-    fix[list_min_post_force[i]]->min_post_force(vflag);
+  for (int i = 0; i < n_min_post_force; i++) {
+    int ifix = list_min_post_force[i];
+    timer->region_start(fix_region[ifix]);
+    fix[ifix]->min_post_force(vflag);
+    timer->region_stop(fix_region[ifix]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -132,6 +132,8 @@ class Modify : protected Pointers {
 
   int *end_of_step_every;
 
+  int *fix_region;           // timer sub-timer index of each fix
+
   int n_timeflag;            // list of computes that store time invocation
   int *list_timeflag;
 
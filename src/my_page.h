@@ -16,6 +16,8 @@ MyPage = templated class for storing chunks of datums in pages
   chunks are not returnable, can only reset and start over
   replaces many small mallocs with a few large mallocs
   pages are never freed, so can reuse w/out reallocs
+  pages are zeroed when allocated, so memory is placed by the OS
+    on the NUMA node of the thread that allocated them (first touch)
 usage:
   request one datum at a time, repeat, clear
   request chunks of datums in each get() or vget(), repeat, clear
@@ -33,6 +35,7 @@ methods:
    void init(maxchunk, pagesize, pagedelta)
      define allocation params and allocate first page(s)
      call right after constructor
+       call from the thread that will fill the pages, for NUMA locality
        can call again to reset allocation params and free previous pages
      maxchunk = max # of datums in one chunk, default = 1
      pagesize = # of datums in one page, default = 1024
@@ -53,6 +56,7 @@ methods:
 #endif
 
 #include <stdlib.h>
+#include <string.h>
 namespace LAMMPS_NS {
 
 template<class T>
@@ -209,6 +213,9 @@ class MyPage {
                   // 1 = chunk size exceeded maxchunk
                   // 2 = memory allocation error
 
+  // new pages are touched here, so with a first-touch memory policy
+  //   they reside on the NUMA node of the thread calling get()/vget()
+
   void allocate() {
     npage += pagedelta;
     pages = (T **) realloc(pages,npage*sizeof(T *));
@@ -220,13 +227,16 @@ class MyPage {
     for (int i = npage-pagedelta; i < npage; i++) {
 #if defined(LAMMPS_MEMALIGN)
       void *ptr;
-      if (posix_memalign(&ptr, LAMMPS_MEMALIGN, pagesize*sizeof(T)))
+      if (posix_memalign(&ptr, LAMMPS_MEMALIGN, pagesize*sizeof(T))) {
         errorflag = 2;
+        ptr = NULL;
+      }
       pages[i] = (T *) ptr;
 #else
       pages[i] = (T *) malloc(pagesize*sizeof(T));
       if (!pages[i]) errorflag = 2;
 #endif
+      if (pages[i]) memset(pages[i],0,pagesize*sizeof(T));
     }
   }
 };
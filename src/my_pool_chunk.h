@@ -17,6 +17,8 @@ MyPoolChunk = templated class for storing chunks of datums in pages
   chunks come in nbin different fixed sizes so can reuse
   replaces many small mallocs with a few large mallocs
   pages are never freed, so can reuse w/out reallocs
+  pages are zeroed when allocated, so memory is placed by the OS
+    on the NUMA node of the thread that allocated them (first touch)
 usage:
   continously get() and put() chunks as needed
   NOTE: could add a clear() if retain info on mapping of pages to bins
@@ -44,6 +46,7 @@ public variables:
 #define LAMMPS_MY_POOL_CHUNK_H
 
 #include <stdlib.h>
+#include <string.h>
 
 namespace LAMMPS_NS {
 
@@ -193,6 +196,7 @@ class MyPoolChunk {
       pages[i] = (T *) malloc(chunkperpage*chunksize[ibin]*sizeof(T));
       size += chunkperpage*chunksize[ibin];
       if (!pages[i]) errorflag = 2;
+      else memset(pages[i],0,chunkperpage*chunksize[ibin]*sizeof(T));
     }
 
     // reset free list for unused chunks on new pages
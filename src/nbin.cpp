@@ -13,6 +13,7 @@
 
 #include "nbin.h"
 #include "neighbor.h"
+#include "atom.h"
 #include "neigh_request.h"
 #include "domain.h"
 #include "update.h"
@@ -31,6 +32,13 @@ NBin::NBin(LAMMPS *lmp) : Pointers(lmp)
   bins = NULL;
   atom2bin = NULL;
 
+  nbinned = 0;
+  lastpack = -1;
+  maxpackbin = maxpack = 0;
+  maxbinatom = 0;
+  binpack = packatom = atom2pack = packtype = NULL;
+  packx = packy = packz = NULL;
+
   // geometry settings
 
   dimension = domain->dimension;
@@ -44,6 +52,14 @@ NBin::~NBin()
   memory->destroy(binhead);
   memory->destroy(bins);
   memory->destroy(atom2bin);
+
+  memory->destroy(binpack);
+  memory->destroy(packatom);
+  memory->destroy(atom2pack);
+  memory->destroy(packtype);
+  memory->destroy(packx);
+  memory->destroy(packy);
+  memory->destroy(packz);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -80,6 +96,10 @@ void NBin::copy_neighbor_info()
 
 void NBin::bin_atoms_setup(int nall)
 {
+  // invalidate packed bins, binning will change
+
+  nbinned++;
+
   // binhead = per-bin vector, mbins in length
   // add 1 bin for USER-INTEL package
 
@@ -101,6 +121,77 @@ void NBin::bin_atoms_setup(int nall)
   }
 }
 
+/* ----------------------------------------------------------------------
+   copy binned atoms into contiguous per-bin blocks of SoA arrays
+   used by NPair builds that stream over bins with vectorizable loops
+   only repacks if atoms were re-binned since last call,
+     else just refreshes coords, since lists built between re-binnings,
+     e.g. occasional lists, must see current coords
+   packed order within a bin = linked-list order, so owned before ghost
+------------------------------------------------------------------------- */
+
+void NBin::pack_bins()
+{
+  double **x = atom->x;
+  int nall = atom->nlocal + atom->nghost;
+
+  if (lastpack == nbinned) {
+    int npack = binpack[mbins];
+    for (int n = 0; n < npack; n++) {
+      int i = packatom[n];
+      packx[n] = x[i][0];
+      packy[n] = x[i][1];
+      packz[n] = x[i][2];
+    }
+    return;
+  }
+  lastpack = nbinned;
+
+  if (mbins+1 > maxpackbin) {
+    maxpackbin = mbins+1;
+    memory->destroy(binpack);
+    memory->create(binpack,maxpackbin,"neigh:binpack");
+  }
+
+  if (nall > maxpack) {
+    maxpack = nall;
+    memory->destroy(packatom);
+    memory->destroy(atom2pack);
+    memory->destroy(packtype);
+    memory->destroy(packx);
+    memory->destroy(packy);
+    memory->destroy(packz);
+    memory->create(packatom,maxpack,"neigh:packatom");
+    memory->create(atom2pack,maxpack,"neigh:atom2pack");
+    memory->create(packtype,maxpack,"neigh:packtype");
+    memory->create(packx,maxpack,"neigh:packx");
+    memory->create(packy,maxpack,"neigh:packy");
+    memory->create(packz,maxpack,"neigh:packz");
+  }
+
+  int *type = atom->type;
+
+  int i,nbin;
+  int n = 0;
+  maxbinatom = 0;
+
+  for (int ibin = 0; ibin < mbins; ibin++) {
+    binpack[ibin] = n;
+    for (i = binhead[ibin]; i >= 0; i = bins[i]) {
+      packatom[n] = i;
+      atom2pack[i] = n;
+      packtype[n] = type[i];
+      packx[n] = x[i][0];
+      packy[n] = x[i][1];
+      packz[n] = x[i][2];
+      n++;
+    }
+    nbin = n - binpack[ibin];
+    if (nbin > maxbinatom) maxbinatom = nbin;
+  }
+  binpack[mbins] = n;
+}
+
 /* ----------------------------------------------------------------------
    convert atom coords into local bin #
    for orthogonal, only ghost atoms will have coord >= bboxhi or coord < bboxlo
@@ -154,5 +245,8 @@ bigint NBin::memory_usage()
   bigint bytes = 0;
   bytes += maxbin*sizeof(int);
   bytes += 2*maxatom*sizeof(int);
+  bytes += maxpackbin*sizeof(int);
+  bytes += 3*maxpack*sizeof(int);
+  bytes += 3*maxpack*sizeof(double);
   return bytes;
 }
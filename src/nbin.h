@@ -35,6 +35,16 @@ class NBin : protected Pointers {
   int *bins;                   // index of next atom in same bin
   int *atom2bin;               // bin assignment for each atom (local+ghost)
 
+  // packed copy of binned atoms, created on request by pack_bins()
+  // atoms in each bin are contiguous and in linked-list order
+
+  int *binpack;                // index of 1st packed atom in each bin
+  int *packatom;               // atom index of each packed atom
+  int *atom2pack;              // packed index of each atom
+  int *packtype;               // type of each packed atom
+  double *packx,*packy,*packz; // coords of each packed atom
+  int maxbinatom;              // max # of atoms in any bin
+
   double cutoff_custom;        // cutoff set by requestor
 
   NBin(class LAMMPS *);
@@ -42,6 +52,7 @@ class NBin : protected Pointers {
   void post_constructor(class NeighRequest *);
   virtual void copy_neighbor_info();
   virtual void bin_atoms_setup(int);
+  void pack_bins();
   bigint memory_usage();
 
   virtual void setup_bins(int) = 0;
@@ -66,6 +77,11 @@ class NBin : protected Pointers {
   int maxbin;                       // size of binhead array
   int maxatom;                      // size of bins array
 
+  int nbinned;                      // # of times atoms were binned
+  int lastpack;                     // value of nbinned at last pack_bins()
+  int maxpackbin;                   // size of binpack array
+  int maxpack;                      // size of packed per-atom arrays
+
   // methods
 
   int coord2bin(double *);
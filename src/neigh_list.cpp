@@ -68,6 +68,10 @@ NeighList::NeighList(LAMMPS *lmp) : Pointers(lmp)
 
   fix_bond = NULL;
 
+  split = 0;
+  listinterior = NULL;
+  listboundary = NULL;
+
   ipage = NULL;
   dpage = NULL;
 
@@ -98,6 +102,9 @@ NeighList::~NeighList()
   delete [] iskip;
   memory->destroy(ijskip);
 
+  delete listinterior;
+  delete listboundary;
+
   if (ssa) {
     memory->sfree(ndxAIR_ssa);
   }
@@ -170,16 +177,22 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
   pgsize = pgsize_caller;
   oneatom = oneatom_caller;
 
+  // with threads, thread I fills pages I during a build
+  // so let thread I also allocate and first touch them,
+  //   which places them on the NUMA node of thread I
+
   int nmypage = comm->nthreads;
   ipage = new MyPage<int>[nmypage];
-  for (int i = 0; i < nmypage; i++)
-    ipage[i].init(oneatom,pgsize,PGDELTA);
+  if (dnum) dpage = new MyPage<double>[nmypage];
+  else dpage = NULL;
 
-  if (dnum) {
-    dpage = new MyPage<double>[nmypage];
-    for (int i = 0; i < nmypage; i++)
-      dpage[i].init(dnum*oneatom,dnum*pgsize,PGDELTA);
-  } else dpage = NULL;
+#if defined(_OPENMP)
+#pragma omp parallel for schedule(static,1) num_threads(nmypage)
+#endif
+  for (int i = 0; i < nmypage; i++) {
+    ipage[i].init(oneatom,pgsize,PGDELTA);
+    if (dnum) dpage[i].init(dnum*oneatom,dnum*pgsize,PGDELTA);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -188,6 +201,7 @@ void NeighList::setup_pages(int pgsize_caller, int oneatom_caller)
      also trigger grow in child list(s) which are not built themselves
      history calls grow() in listhistory
      respaouter calls grow() in respainner, respamiddle
+     split calls grow() in listinterior, listboundary
    triggered by neighbor list build
    not called if a copy list
 ------------------------------------------------------------------------- */
@@ -199,6 +213,10 @@ void NeighList::grow(int nlocal, int nall)
   if (listhistory) listhistory->grow(nlocal,nall);
   if (listinner) listinner->grow(nlocal,nall);
   if (listmiddle) listmiddle->grow(nlocal,nall);
+  if (split) {
+    listinterior->grow(nlocal,nall);
+    listboundary->grow(nlocal,nall);
+  }
 
   // skip if data structs are already big enough
 
@@ -230,6 +248,23 @@ void NeighList::grow(int nlocal, int nall)
   }
 }
 
+/* ----------------------------------------------------------------------
+   allocate interior/boundary lists that NPair::build_split() fills
+   interior list = all I atoms, only J neighbors that are owned atoms
+   boundary list = only I atoms with ghost J neighbors, only those J
+   both point into the neighbor pages of this list, which owns the pages
+------------------------------------------------------------------------- */
+
+void NeighList::enable_split()
+{
+  split = 1;
+  if (listinterior) return;
+
+  listinterior = new NeighList(lmp);
+  listboundary = new NeighList(lmp);
+  listinterior->index = listboundary->index = index;
+}
+
 /* ----------------------------------------------------------------------
    print attributes of this list and associated request
 ------------------------------------------------------------------------- */
@@ -73,6 +73,12 @@ class NeighList : protected Pointers {
 
   class Fix *fix_bond;          // fix that stores bond info
 
+  // split into interior and boundary lists, used by comm_modify overlap
+
+  int split;                    // 1 if list is split after each build
+  NeighList *listinterior;      // me = split list, point to owned J neighbors
+  NeighList *listboundary;      // me = split list, point to ghost J neighbors
+
   // Kokkos package
 
   int kokkos;                   // 1 if list stores Kokkos data
@@ -89,6 +95,7 @@ class NeighList : protected Pointers {
   void post_constructor(class NeighRequest *);
   void setup_pages(int, int);           // setup page data structures
   void grow(int,int);                   // grow all data structs
+  void enable_split();                  // create interior/boundary lists
   void print_attributes();              // debug routine
   int get_maxlocal() {return maxatom;}
   bigint memory_usage();
@@ -270,13 +270,8 @@ void Neighbor::init()
   }
 
   // set neighbor cutoffs (force cutoff + skin)
-  // trigger determines when atoms migrate and neighbor lists are rebuilt
-  //   needs to be non-zero for migration distance check
-  //   even if pair = NULL and no neighbor lists are used
-  // cutneigh = force cutoff + skin if cutforce > 0, else cutneigh = 0
-  // cutneighghost = pair cutghost if it requests it, else same as cutneigh
+  // boxcheck = 1 if box size can change and trigger must shrink with it
 
-  triggersq = 0.25*skin*skin;
   boxcheck = 0;
   if (domain->box_change && (domain->xperiodic || domain->yperiodic ||
                              (dimension == 3 && domain->zperiodic)))
@@ -291,48 +286,7 @@ void Neighbor::init()
     cuttypesq = new double[n+1];
   }
 
-  double cutoff,delta,cut;
-  cutneighmin = BIG;
-  cutneighmax = 0.0;
-
-  for (i = 1; i <= n; i++) {
-    cuttype[i] = cuttypesq[i] = 0.0;
-    for (j = 1; j <= n; j++) {
-      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
-      else cutoff = 0.0;
-      if (cutoff > 0.0) delta = skin;
-      else delta = 0.0;
-      cut = cutoff + delta;
-
-      cutneighsq[i][j] = cut*cut;
-      cuttype[i] = MAX(cuttype[i],cut);
-      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
-      cutneighmin = MIN(cutneighmin,cut);
-      cutneighmax = MAX(cutneighmax,cut);
-
-      if (force->pair && force->pair->ghostneigh) {
-        cut = force->pair->cutghost[i][j] + skin;
-        cutneighghostsq[i][j] = cut*cut;
-      } else cutneighghostsq[i][j] = cut*cut;
-    }
-  }
-  cutneighmaxsq = cutneighmax * cutneighmax;
-
-  // rRESPA cutoffs
-
-  int respa = 0;
-  if (update->whichflag == 1 && strstr(update->integrate_style,"respa")) {
-    if (((Respa *) update->integrate)->level_inner >= 0) respa = 1;
-    if (((Respa *) update->integrate)->level_middle >= 0) respa = 2;
-  }
-
-  if (respa) {
-    double *cut_respa = ((Respa *) update->integrate)->cutoff;
-    cut_inner_sq = (cut_respa[1] + skin) * (cut_respa[1] + skin);
-    cut_middle_sq = (cut_respa[3] + skin) * (cut_respa[3] + skin);
-    cut_middle_inside_sq = (cut_respa[0] - skin) * (cut_respa[0] - skin);
-    if (cut_respa[0]-skin < 0) cut_middle_inside_sq = 0.0;
-  }
+  set_cutoffs();
 
   // fixchecklist = other classes that can induce reneighboring in decide()
 
@@ -509,6 +463,95 @@ void Neighbor::init()
   init_topology();
 }
 
+/* ----------------------------------------------------------------------
+   set neighbor cutoffs and trigger distance from pair cutoffs and skin
+   trigger determines when atoms migrate and neighbor lists are rebuilt
+     needs to be non-zero for migration distance check
+     even if pair = NULL and no neighbor lists are used
+   cutneigh = force cutoff + skin if cutforce > 0, else cutneigh = 0
+   cutneighghost = pair cutghost if it requests it, else same as cutneigh
+------------------------------------------------------------------------- */
+
+void Neighbor::set_cutoffs()
+{
+  int i,j;
+  double cutoff,delta,cut;
+
+  triggersq = 0.25*skin*skin;
+
+  int n = atom->ntypes;
+  cutneighmin = BIG;
+  cutneighmax = 0.0;
+
+  for (i = 1; i <= n; i++) {
+    cuttype[i] = cuttypesq[i] = 0.0;
+    for (j = 1; j <= n; j++) {
+      if (force->pair) cutoff = sqrt(force->pair->cutsq[i][j]);
+      else cutoff = 0.0;
+      if (cutoff > 0.0) delta = skin;
+      else delta = 0.0;
+      cut = cutoff + delta;
+
+      cutneighsq[i][j] = cut*cut;
+      cuttype[i] = MAX(cuttype[i],cut);
+      cuttypesq[i] = MAX(cuttypesq[i],cut*cut);
+      cutneighmin = MIN(cutneighmin,cut);
+      cutneighmax = MAX(cutneighmax,cut);
+
+      if (force->pair && force->pair->ghostneigh) {
+        cut = force->pair->cutghost[i][j] + skin;
+        cutneighghostsq[i][j] = cut*cut;
+      } else cutneighghostsq[i][j] = cut*cut;
+    }
+  }
+  cutneighmaxsq = cutneighmax * cutneighmax;
+
+  // rRESPA cutoffs
+
+  int respa = 0;
+  if (update->whichflag == 1 && strstr(update->integrate_style,"respa")) {
+    if (((Respa *) update->integrate)->level_inner >= 0) respa = 1;
+    if (((Respa *) update->integrate)->level_middle >= 0) respa = 2;
+  }
+
+  if (respa) {
+    double *cut_respa = ((Respa *) update->integrate)->cutoff;
+    cut_inner_sq = (cut_respa[1] + skin) * (cut_respa[1] + skin);
+    cut_middle_sq = (cut_respa[3] + skin) * (cut_respa[3] + skin);
+    cut_middle_inside_sq = (cut_respa[0] - skin) * (cut_respa[0] - skin);
+    if (cut_respa[0]-skin < 0) cut_middle_inside_sq = 0.0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   change skin distance in the middle of a run
+   resets all cutoffs and the info copied to Bin,Stencil,Pair classes
+   caller must force a reneighboring and invoke comm->setup() and
+     setup_bins() before it, since ghost cutoff and bin sizes change
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_skin(double skin_new)
+{
+  skin = skin_new;
+  reset_cutoffs();
+}
+
+/* ----------------------------------------------------------------------
+   change cutoffs in the middle of a run after pair cutsq has changed
+   existing lists and their requests are kept
+   same requirements on the caller as for reset_skin()
+------------------------------------------------------------------------- */
+
+void Neighbor::reset_cutoffs()
+{
+  set_cutoffs();
+
+  for (int i = 0; i < nbin; i++) neigh_bin[i]->copy_neighbor_info();
+  for (int i = 0; i < nstencil; i++) neigh_stencil[i]->copy_neighbor_info();
+  for (int i = 0; i < nlist; i++)
+    if (neigh_pair[i]) neigh_pair[i]->copy_neighbor_info();
+}
+
 /* ----------------------------------------------------------------------
    create and initialize lists of Nbin, Nstencil, NPair classes
    lists have info on all classes in 3 style*.h files
@@ -2118,12 +2161,14 @@ void Neighbor::build(int topoflag)
 
   // build pairwise lists for all perpetual NPair/NeighList
   // grow() with nlocal/nall args so that only realloc if have to
+  // split lists into interior/boundary parts if requested by Verlet
 
   for (i = 0; i < npair_perpetual; i++) {
     m = plist[i];
     if (!lists[m]->copy) lists[m]->grow(nlocal,nall);
     neigh_pair[m]->build_setup();
     neigh_pair[m]->build(lists[m]);
+    if (lists[m]->split) neigh_pair[m]->build_split(lists[m]);
   }
 
   // build topology lists for bonds/angles/etc
@@ -118,6 +118,8 @@ class Neighbor : protected Pointers {
                                     // create a one-time pairwise neigh list
   void set(int, char **);           // set neighbor style and skin distance
   void reset_timestep(bigint);      // reset of timestep counter
+  void reset_skin(double);          // change skin distance during a run
+  void reset_cutoffs();             // change pair cutoffs during a run
   void modify_params(int, char**);  // modify params that control builds
 
   void exclusion_group_group_delete(int, int);  // rm a group-group exclusion
@@ -201,6 +203,7 @@ class Neighbor : protected Pointers {
   // including creator methods for Nbin,Nstencil,Npair instances
 
   void init_styles();
+  void set_cutoffs();
   int init_pair();
   virtual void init_topology();
 
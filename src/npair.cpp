@@ -17,6 +17,7 @@
 #include "neigh_request.h"
 #include "nbin.h"
 #include "nstencil.h"
+#include "neigh_list.h"
 #include "atom.h"
 #include "update.h"
 #include "memory.h"
@@ -32,6 +33,8 @@ NPair::NPair(LAMMPS *lmp)
   last_build = -1;
   mycutneighsq = NULL;
   molecular = atom->molecular;
+  cand = NULL;
+  maxcand = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -39,6 +42,7 @@ NPair::NPair(LAMMPS *lmp)
 NPair::~NPair()
 {
   memory->destroy(mycutneighsq);
+  memory->destroy(cand);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -133,6 +137,31 @@ void NPair::copy_bin_info()
   binhead = nb->binhead;
 }
 
+/* ----------------------------------------------------------------------
+   pack bins of NBin class into SoA blocks if needed, copy packed info
+   grow candidate list to hold atoms of largest bin
+   called from build() by NPair variants that use bin_candidates()
+------------------------------------------------------------------------- */
+
+void NPair::copy_pack_info()
+{
+  nb->pack_bins();
+
+  binpack = nb->binpack;
+  packatom = nb->packatom;
+  atom2pack = nb->atom2pack;
+  packtype = nb->packtype;
+  packx = nb->packx;
+  packy = nb->packy;
+  packz = nb->packz;
+
+  if (nb->maxbinatom > maxcand) {
+    maxcand = nb->maxbinatom;
+    memory->destroy(cand);
+    memory->create(cand,maxcand,"npair:cand");
+  }
+}
+
 /* ----------------------------------------------------------------------
    copy info from NStencil class to this build class
 ------------------------------------------------------------------------- */
@@ -161,6 +190,66 @@ void NPair::build_setup()
   last_build = update->ntimestep;
 }
 
+/* ----------------------------------------------------------------------
+   split a freshly built list into interior and boundary lists
+   reorder each J list in place so owned J atoms come before ghost J atoms
+   interior list = owned J portion of every I atom
+   boundary list = ghost J portion of I atoms that have one
+   special bits are masked off only for the owned/ghost test
+------------------------------------------------------------------------- */
+
+void NPair::build_split(NeighList *list)
+{
+  int i,j,ii,jj,n,jnum,itmp;
+  int *jlist;
+
+  int nlocal = atom->nlocal;
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  NeighList *inner = list->listinterior;
+  NeighList *outer = list->listboundary;
+  int *ilist_inner = inner->ilist;
+  int *ilist_outer = outer->ilist;
+  int *numneigh_inner = inner->numneigh;
+  int **firstneigh_inner = inner->firstneigh;
+  int *numneigh_outer = outer->numneigh;
+  int **firstneigh_outer = outer->firstneigh;
+  int inum_outer = 0;
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    n = 0;
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj] & NEIGHMASK;
+      if (j < nlocal) {
+        itmp = jlist[jj];
+        jlist[jj] = jlist[n];
+        jlist[n++] = itmp;
+      }
+    }
+
+    ilist_inner[ii] = i;
+    firstneigh_inner[i] = jlist;
+    numneigh_inner[i] = n;
+    if (n < jnum) {
+      ilist_outer[inum_outer++] = i;
+      firstneigh_outer[i] = &jlist[n];
+      numneigh_outer[i] = jnum - n;
+    }
+  }
+
+  inner->inum = inum;
+  inner->gnum = 0;
+  outer->inum = inum_outer;
+  outer->gnum = 0;
+}
+
 /* ----------------------------------------------------------------------
    test if atom pair i,j is excluded from neighbor list
    due to type, group, molecule settings from neigh_modify command
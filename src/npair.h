@@ -33,6 +33,7 @@ class NPair : protected Pointers {
   virtual void copy_neighbor_info();
   void build_setup();
   virtual void build(class NeighList *) = 0;
+  void build_split(class NeighList *);
 
  protected:
   double **mycutneighsq;         // per-type cutoffs when user specified
@@ -79,6 +80,14 @@ class NPair : protected Pointers {
   double bininvx,bininvy,bininvz;
   int *atom2bin,*bins;
   int *binhead;
+
+  // packed bin data from NBin class, only set by copy_pack_info()
+
+  int *binpack,*packatom,*atom2pack,*packtype;
+  double *packx,*packy,*packz;
+
+  int *cand;                     // candidate J atoms found in one bin
+  int maxcand;                   // size of cand array
   
   // data from NStencil class
 
@@ -97,12 +106,70 @@ class NPair : protected Pointers {
 
   virtual void copy_bin_info();
   virtual void copy_stencil_info();
+  void copy_pack_info();
 
   int exclusion(int, int, int,
                 int, int *, tagint *) const;   // test for pair exclusion
   int coord2bin(double *);                     // mapping atom coord to a bin
   int coord2bin(double *, int &, int &, int&); // ditto
 
+  // bin_candidates: gather packed atoms JFROM to JTO-1 within cutoff of
+  //   (xtmp,ytmp,ztmp) into list, return # of atoms stored
+  // JSKIP = packed index of an atom to skip, -1 if none
+  // branch-free loop over contiguous SoA data with a compressed store
+  //   so the compiler can vectorize the distance and cutoff test
+
+  inline int bin_candidates(const int jfrom, const int jto, const int jskip,
+                            const double xtmp, const double ytmp,
+                            const double ztmp, const double *cutsq,
+                            int *list) const {
+    const double * _noalias const px = packx;
+    const double * _noalias const py = packy;
+    const double * _noalias const pz = packz;
+    const int * _noalias const pt = packtype;
+    const int * _noalias const pa = packatom;
+    int nc = 0;
+
+    for (int jj = jfrom; jj < jto; jj++) {
+      const double delx = xtmp - px[jj];
+      const double dely = ytmp - py[jj];
+      const double delz = ztmp - pz[jj];
+      const double rsq = delx*delx + dely*dely + delz*delz;
+      list[nc] = pa[jj];
+      nc += (rsq <= cutsq[pt[jj]]) & (jj != jskip);
+    }
+    return nc;
+  }
+
+  // bin_candidates_upper: same as bin_candidates() for atoms in I's own bin
+  //   with packed index > I, only keep a ghost if its coords are
+  //   "above and to the right" of I, as for half Newton lists
+
+  inline int bin_candidates_upper(const int jfrom, const int jto,
+                                  const int nlocal, const double xtmp,
+                                  const double ytmp, const double ztmp,
+                                  const double *cutsq, int *list) const {
+    const double * _noalias const px = packx;
+    const double * _noalias const py = packy;
+    const double * _noalias const pz = packz;
+    const int * _noalias const pt = packtype;
+    const int * _noalias const pa = packatom;
+    int nc = 0;
+
+    for (int jj = jfrom; jj < jto; jj++) {
+      const double delx = xtmp - px[jj];
+      const double dely = ytmp - py[jj];
+      const double delz = ztmp - pz[jj];
+      const double rsq = delx*delx + dely*dely + delz*delz;
+      const int upper = (pz[jj] > ztmp) |
+        ((pz[jj] == ztmp) & ((py[jj] > ytmp) |
+                             ((py[jj] == ytmp) & (px[jj] >= xtmp))));
+      list[nc] = pa[jj];
+      nc += (rsq <= cutsq[pt[jj]]) & ((pa[jj] < nlocal) | upper);
+    }
+    return nc;
+  }
+
   // find_special: determine if atom j is in special list of atom i
   // if it is not, return 0
   // if it is and special flag is 0 (both coeffs are 0.0), return -1
@@ -34,9 +34,10 @@ NPairFullBin::NPairFullBin(LAMMPS *lmp) : NPair(lmp) {}
 
 void NPairFullBin::build(NeighList *list)
 {
-  int i,j,k,n,itype,jtype,ibin,which,imol,iatom,moltemplate;
+  int i,j,k,m,n,nc,itype,ibin,jbin,ipack,which,imol,iatom,moltemplate;
   tagint tagprev;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  double xtmp,ytmp,ztmp,delx,dely,delz;
+  double *cutsq;
   int *neighptr;
 
   double **x = atom->x;
@@ -60,6 +61,8 @@ void NPairFullBin::build(NeighList *list)
   int **firstneigh = list->firstneigh;
   MyPage<int> *ipage = list->ipage;
 
+  copy_pack_info();
+
   int inum = 0;
   ipage->reset();
 
@@ -79,36 +82,40 @@ void NPairFullBin::build(NeighList *list)
 
     // loop over all atoms in surrounding bins in stencil including self
     // skip i = j
+    // 1st pass gathers candidates within cutoff from packed bin,
+    //   2nd pass does exclusion and special checks only on candidates
 
     ibin = atom2bin[i];
+    ipack = atom2pack[i];
+    cutsq = cutneighsq[itype];
 
     for (k = 0; k < nstencil; k++) {
-      for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
-        if (i == j) continue;
-
-        jtype = type[j];
-        if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-
-        if (rsq <= cutneighsq[itype][jtype]) {
-          if (molecular) {
-            if (!moltemplate)
-              which = find_special(special[i],nspecial[i],tag[j]);
-            else if (imol >= 0)
-              which = find_special(onemols[imol]->special[iatom],
-                                   onemols[imol]->nspecial[iatom],
-                                   tag[j]-tagprev);
-            else which = 0;
-            if (which == 0) neighptr[n++] = j;
-            else if (domain->minimum_image_check(delx,dely,delz))
+      jbin = ibin + stencil[k];
+      nc = bin_candidates(binpack[jbin],binpack[jbin+1],ipack,
+                          xtmp,ytmp,ztmp,cutsq,cand);
+
+      for (m = 0; m < nc; m++) {
+        j = cand[m];
+        if (exclude && exclusion(i,j,itype,type[j],mask,molecule)) continue;
+
+        if (molecular) {
+          if (!moltemplate)
+            which = find_special(special[i],nspecial[i],tag[j]);
+          else if (imol >= 0)
+            which = find_special(onemols[imol]->special[iatom],
+                                 onemols[imol]->nspecial[iatom],
+                                 tag[j]-tagprev);
+          else which = 0;
+          if (which == 0) neighptr[n++] = j;
+          else {
+            delx = xtmp - x[j][0];
+            dely = ytmp - x[j][1];
+            delz = ztmp - x[j][2];
+            if (domain->minimum_image_check(delx,dely,delz))
               neighptr[n++] = j;
             else if (which > 0) neighptr[n++] = j ^ (which << SBBITS);
-          } else neighptr[n++] = j;
-        }
+          }
+        } else neighptr[n++] = j;
       }
     }
 
@@ -33,9 +33,10 @@ NPairFullBinAtomonly::NPairFullBinAtomonly(LAMMPS *lmp) : NPair(lmp) {}
 
 void NPairFullBinAtomonly::build(NeighList *list)
 {
-  int i,j,k,n,itype,jtype,ibin;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
-  int *neighptr;
+  int i,j,k,m,n,nc,itype,ibin,jbin,ipack;
+  double xtmp,ytmp,ztmp;
+  double *cutsq;
+  int *neighptr,*jstore;
 
   double **x = atom->x;
   int *type = atom->type;
@@ -49,6 +50,8 @@ void NPairFullBinAtomonly::build(NeighList *list)
   int **firstneigh = list->firstneigh;
   MyPage<int> *ipage = list->ipage;
 
+  copy_pack_info();
+
   int inum = 0;
   ipage->reset();
 
@@ -63,22 +66,28 @@ void NPairFullBinAtomonly::build(NeighList *list)
 
     // loop over all atoms in surrounding bins in stencil including self
     // skip i = j
+    // 1st pass gathers candidates within cutoff from packed bin,
+    //   2nd pass does exclusion check only on candidates
 
     ibin = atom2bin[i];
+    ipack = atom2pack[i];
+    cutsq = cutneighsq[itype];
 
     for (k = 0; k < nstencil; k++) {
-      for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
-        if (i == j) continue;
-
-        jtype = type[j];
-        if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
+      jbin = ibin + stencil[k];
+      jstore = exclude ? cand : &neighptr[n];
+      nc = bin_candidates(binpack[jbin],binpack[jbin+1],ipack,
+                          xtmp,ytmp,ztmp,cutsq,jstore);
+
+      if (!exclude) {
+        n += nc;
+        continue;
+      }
 
-        if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
+      for (m = 0; m < nc; m++) {
+        j = cand[m];
+        if (exclusion(i,j,itype,type[j],mask,molecule)) continue;
+        neighptr[n++] = j;
       }
     }
 
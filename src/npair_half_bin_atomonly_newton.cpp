@@ -36,9 +36,10 @@ NPairHalfBinAtomonlyNewton::NPairHalfBinAtomonlyNewton(LAMMPS *lmp) :
 
 void NPairHalfBinAtomonlyNewton::build(NeighList *list)
 {
-  int i,j,k,n,itype,jtype,ibin;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
-  int *neighptr;
+  int i,j,k,m,n,nc,itype,ibin,jbin;
+  double xtmp,ytmp,ztmp;
+  double *cutsq;
+  int *neighptr,*jstore;
 
   double **x = atom->x;
   int *type = atom->type;
@@ -52,6 +53,8 @@ void NPairHalfBinAtomonlyNewton::build(NeighList *list)
   int **firstneigh = list->firstneigh;
   MyPage<int> *ipage = list->ipage;
 
+  copy_pack_info();
+
   int inum = 0;
   ipage->reset();
 
@@ -64,45 +67,35 @@ void NPairHalfBinAtomonlyNewton::build(NeighList *list)
     ytmp = x[i][1];
     ztmp = x[i][2];
 
-    // loop over rest of atoms in i's bin, ghosts are at end of linked list
-    // if j is owned atom, store it, since j is beyond i in linked list
+    // loop over rest of atoms in i's bin, ghosts are at end of packed bin
+    // if j is owned atom, store it, since j is beyond i in packed bin
     // if j is ghost, only store if j coords are "above and to the right" of i
-
-    for (j = bins[i]; j >= 0; j = bins[j]) {
-      if (j >= nlocal) {
-        if (x[j][2] < ztmp) continue;
-        if (x[j][2] == ztmp) {
-          if (x[j][1] < ytmp) continue;
-          if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
-        }
-      }
-
-      jtype = type[j];
-      if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
-
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
-
-      if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
-    }
-
-    // loop over all atoms in other bins in stencil, store every pair
+    // then loop over all atoms in other bins in stencil, store every pair
+    // 1st pass gathers candidates within cutoff from packed bin,
+    //   2nd pass does exclusion check only on candidates
 
     ibin = atom2bin[i];
+    cutsq = cutneighsq[itype];
+
+    for (k = -1; k < nstencil; k++) {
+      jstore = exclude ? cand : &neighptr[n];
+      if (k < 0) nc = bin_candidates_upper(atom2pack[i]+1,binpack[ibin+1],
+                                           nlocal,xtmp,ytmp,ztmp,cutsq,jstore);
+      else {
+        jbin = ibin + stencil[k];
+        nc = bin_candidates(binpack[jbin],binpack[jbin+1],-1,
+                            xtmp,ytmp,ztmp,cutsq,jstore);
+      }
 
-    for (k = 0; k < nstencil; k++) {
-      for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
-        jtype = type[j];
-        if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
+      if (!exclude) {
+        n += nc;
+        continue;
+      }
 
-        if (rsq <= cutneighsq[itype][jtype]) neighptr[n++] = j;
+      for (m = 0; m < nc; m++) {
+        j = cand[m];
+        if (exclusion(i,j,itype,type[j],mask,molecule)) continue;
+        neighptr[n++] = j;
       }
     }
 
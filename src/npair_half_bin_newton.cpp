@@ -35,9 +35,10 @@ NPairHalfBinNewton::NPairHalfBinNewton(LAMMPS *lmp) : NPair(lmp) {}
 
 void NPairHalfBinNewton::build(NeighList *list)
 {
-  int i,j,k,n,itype,jtype,ibin,which,imol,iatom,moltemplate;
+  int i,j,k,m,n,nc,itype,ibin,jbin,which,imol,iatom,moltemplate;
   tagint tagprev;
-  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  double xtmp,ytmp,ztmp,delx,dely,delz;
+  double *cutsq;
   int *neighptr;
 
   double **x = atom->x;
@@ -61,6 +62,8 @@ void NPairHalfBinNewton::build(NeighList *list)
   int **firstneigh = list->firstneigh;
   MyPage<int> *ipage = list->ipage;
 
+  copy_pack_info();
+
   int inum = 0;
   ipage->reset();
 
@@ -78,28 +81,29 @@ void NPairHalfBinNewton::build(NeighList *list)
       tagprev = tag[i] - iatom - 1;
     }
 
-    // loop over rest of atoms in i's bin, ghosts are at end of linked list
-    // if j is owned atom, store it, since j is beyond i in linked list
+    // loop over rest of atoms in i's bin, ghosts are at end of packed bin
+    // if j is owned atom, store it, since j is beyond i in packed bin
     // if j is ghost, only store if j coords are "above and to the right" of i
+    // then loop over all atoms in other bins in stencil, store every pair
+    // 1st pass gathers candidates within cutoff from packed bin,
+    //   2nd pass does exclusion and special checks only on candidates
 
-    for (j = bins[i]; j >= 0; j = bins[j]) {
-      if (j >= nlocal) {
-        if (x[j][2] < ztmp) continue;
-        if (x[j][2] == ztmp) {
-          if (x[j][1] < ytmp) continue;
-          if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
-        }
+    ibin = atom2bin[i];
+    cutsq = cutneighsq[itype];
+
+    for (k = -1; k < nstencil; k++) {
+      if (k < 0) nc = bin_candidates_upper(atom2pack[i]+1,binpack[ibin+1],
+                                           nlocal,xtmp,ytmp,ztmp,cutsq,cand);
+      else {
+        jbin = ibin + stencil[k];
+        nc = bin_candidates(binpack[jbin],binpack[jbin+1],-1,
+                            xtmp,ytmp,ztmp,cutsq,cand);
       }
 
-      jtype = type[j];
-      if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
-
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx*delx + dely*dely + delz*delz;
+      for (m = 0; m < nc; m++) {
+        j = cand[m];
+        if (exclude && exclusion(i,j,itype,type[j],mask,molecule)) continue;
 
-      if (rsq <= cutneighsq[itype][jtype]) {
         if (molecular) {
           if (!moltemplate)
             which = find_special(special[i],nspecial[i],tag[j]);
@@ -109,43 +113,15 @@ void NPairHalfBinNewton::build(NeighList *list)
                                  tag[j]-tagprev);
           else which = 0;
           if (which == 0) neighptr[n++] = j;
-          else if (domain->minimum_image_check(delx,dely,delz))
-            neighptr[n++] = j;
-          else if (which > 0) neighptr[n++] = j ^ (which << SBBITS);
-          // OLD: if (which >= 0) neighptr[n++] = j ^ (which << SBBITS);
-        } else neighptr[n++] = j;
-      }
-    }
-
-    // loop over all atoms in other bins in stencil, store every pair
-
-    ibin = atom2bin[i];
-    for (k = 0; k < nstencil; k++) {
-      for (j = binhead[ibin+stencil[k]]; j >= 0; j = bins[j]) {
-        jtype = type[j];
-        if (exclude && exclusion(i,j,itype,jtype,mask,molecule)) continue;
-
-        delx = xtmp - x[j][0];
-        dely = ytmp - x[j][1];
-        delz = ztmp - x[j][2];
-        rsq = delx*delx + dely*dely + delz*delz;
-
-        if (rsq <= cutneighsq[itype][jtype]) {
-          if (molecular) {
-            if (!moltemplate)
-              which = find_special(special[i],nspecial[i],tag[j]);
-            else if (imol >= 0)
-              which = find_special(onemols[imol]->special[iatom],
-                                   onemols[imol]->nspecial[iatom],
-                                   tag[j]-tagprev);
-            else which = 0;
-            if (which == 0) neighptr[n++] = j;
-            else if (domain->minimum_image_check(delx,dely,delz))
+          else {
+            delx = xtmp - x[j][0];
+            dely = ytmp - x[j][1];
+            delz = ztmp - x[j][2];
+            if (domain->minimum_image_check(delx,dely,delz))
               neighptr[n++] = j;
             else if (which > 0) neighptr[n++] = j ^ (which << SBBITS);
-            // OLD: if (which >= 0) neighptr[n++] = j ^ (which << SBBITS);
-          } else neighptr[n++] = j;
-        }
+          }
+        } else neighptr[n++] = j;
       }
     }
 
@@ -30,6 +30,7 @@
 #include "force.h"
 #include "dump.h"
 #include "write_restart.h"
+#include "timer.h"
 #include "memory.h"
 #include "error.h"
 
@@ -377,11 +378,13 @@ void Output::write(bigint ntimestep)
 
   // insure next_thermo forces output on last step of run
   // thermo may invoke computes so wrap with clear/add
+  // also write buffered timer trace events with each thermo output
 
   if (next_thermo == ntimestep) {
     modify->clearstep_compute();
     if (last_thermo != ntimestep) thermo->compute(1);
     last_thermo = ntimestep;
+    timer->flush_trace();
     if (var_thermo) {
       next_thermo = static_cast<bigint>
         (input->variable->compute_equal(ivar_thermo));
@@ -412,6 +415,18 @@ void Output::write_dump(bigint ntimestep)
   }
 }
 
+/* ----------------------------------------------------------------------
+   wait for dumps and restart files with asynchronous output to finish
+   called at end of run and before a restart file is written
+------------------------------------------------------------------------- */
+
+void Output::flush_async()
+{
+  for (int idump = 0; idump < ndump; idump++)
+    dump[idump]->flush_async();
+  if (restart) restart->flush_async();
+}
+
 /* ----------------------------------------------------------------------
    force restart file(s) to be written
    called from PRD and TAD
@@ -62,6 +62,8 @@ Pair::Pair(LAMMPS *lmp) : Pointers(lmp)
   single_enable = 1;
   restartinfo = 1;
   respa_enable = 0;
+  mixed_enable = 0;
+  overlap_enable = 0;
   one_coeff = 0;
   no_virial_fdotr_compute = 0;
   writedata = 0;
@@ -78,6 +80,7 @@ Pair::Pair(LAMMPS *lmp) : Pointers(lmp)
   // pair_modify settingsx
 
   compute_flag = 1;
+  precision_flag = 0;
   manybody_flag = 0;
   offset_flag = 0;
   mix_flag = GEOMETRIC;
@@ -180,6 +183,12 @@ void Pair::modify_params(int narg, char **arg)
       else if (strcmp(arg[iarg+1],"no") == 0) compute_flag = 0;
       else error->all(FLERR,"Illegal pair_modify command");
       iarg += 2;
+    } else if (strcmp(arg[iarg],"precision") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal pair_modify command");
+      if (strcmp(arg[iarg+1],"double") == 0) precision_flag = 0;
+      else if (strcmp(arg[iarg+1],"mixed") == 0) precision_flag = 1;
+      else error->all(FLERR,"Illegal pair_modify command");
+      iarg += 2;
     } else error->all(FLERR,"Illegal pair_modify command");
   }
 }
@@ -202,6 +211,8 @@ void Pair::init()
   if (!compute_flag && offset_flag)
     error->warning(FLERR,"Using pair potential shift with "
                    "pair_modify compute no");
+  if (precision_flag && !mixed_enable)
+    error->all(FLERR,"Pair style does not support pair_modify precision mixed");
 
   // for manybody potentials
   // check if bonded exclusions could invalidate the neighbor list
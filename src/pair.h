@@ -49,6 +49,9 @@ class Pair : protected Pointers {
   int single_enable;             // 1 if single() routine exists
   int restartinfo;               // 1 if pair style writes restart info
   int respa_enable;              // 1 if inner/middle/outer rRESPA routines
+  int mixed_enable;              // 1 if compute() has a mixed precision path
+  int overlap_enable;            // 1 if compute() can be split into
+                                 //   interior/boundary passes over list
   int one_coeff;                 // 1 if allows only one coeff * * call
   int manybody_flag;             // 1 if a manybody potential
   int no_virial_fdotr_compute;   // 1 if does not invoke virial_fdotr_compute()
@@ -100,6 +103,7 @@ class Pair : protected Pointers {
   int allocated;                 // 0/1 = whether arrays are allocated
                                  //       public so external driver can check
   int compute_flag;              // 0 if skip compute()
+  int precision_flag;            // 1 if pair_modify precision mixed
 
   // KOKKOS host/device flag and data masks
 
@@ -289,6 +293,11 @@ W: Using pair potential shift with pair_modify compute no
 
 The shift effects will thus not be computed.
 
+E: Pair style does not support pair_modify precision mixed
+
+Only the lj/cut style without an accelerator suffix has a mixed
+precision compute path.
+
 W: Using a manybody potential with bonds/angles/dihedrals and special_bond exclusions
 
 This is likely not what you want to do.  The exclusion settings will
@@ -36,6 +36,7 @@ PairHybrid::PairHybrid(LAMMPS *lmp) : Pair(lmp),
   map(NULL), special_lj(NULL), special_coul(NULL), compute_tally(NULL)
 {
   nstyles = 0;
+  mixed_enable = 1;
   
   outerflag = 0;
   respaflag = 0;
@@ -482,6 +483,13 @@ void PairHybrid::init_style()
     if (used == 0) error->all(FLERR,"Pair hybrid sub-style is not used");
   }
 
+  // error if a sub-style cannot honor pair_modify precision mixed
+
+  for (istyle = 0; istyle < nstyles; istyle++)
+    if (styles[istyle]->precision_flag && !styles[istyle]->mixed_enable)
+      error->all(FLERR,"Pair hybrid sub-style does not support "
+                 "pair_modify precision mixed");
+
   // check if special_lj/special_coul overrides are compatible
 
   for (istyle = 0; istyle < nstyles; istyle++) {
@@ -26,6 +26,7 @@ PairStyle(hybrid,PairHybrid)
 namespace LAMMPS_NS {
 
 class PairHybrid : public Pair {
+  friend class FixGCMC;
   friend class FixGPU;
   friend class FixIntel;
   friend class FixOMP;
@@ -121,6 +122,11 @@ E: Pair hybrid sub-style is not used
 No pair_coeff command used a sub-style specified in the pair_style
 command.
 
+E: Pair hybrid sub-style does not support pair_modify precision mixed
+
+Only some sub-styles have a mixed precision compute path.  Use the
+pair keyword of pair_modify to set precision mixed for those only.
+
 E: Pair_modify special setting for pair hybrid incompatible with global special_bonds setting
 
 Cannot override a setting of 0.0 or 1.0 or change a setting between
@@ -41,13 +41,24 @@ using namespace MathConst;
 PairLJCut::PairLJCut(LAMMPS *lmp) : Pair(lmp)
 {
   respa_enable = 1;
+  mixed_enable = 1;
+  overlap_enable = 1;
   writedata = 1;
+
+  maxpack = 0;
+  pack = NULL;
+  cutsqf = lj1f = lj2f = NULL;
 }
 
 /* ---------------------------------------------------------------------- */
 
 PairLJCut::~PairLJCut()
 {
+  memory->destroy(pack);
+  memory->destroy(cutsqf);
+  memory->destroy(lj1f);
+  memory->destroy(lj2f);
+
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -76,6 +87,13 @@ void PairLJCut::compute(int eflag, int vflag)
   if (eflag || vflag) ev_setup(eflag,vflag);
   else evflag = vflag_fdotr = 0;
 
+  if (precision_flag) {
+    if (atom->ntypes == 1) eval_mixed<1>(eflag);
+    else eval_mixed<0>(eflag);
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
   double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
@@ -140,6 +158,173 @@ void PairLJCut::compute(int eflag, int vflag)
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
+/* ----------------------------------------------------------------------
+   pairwise math in single precision
+   for each I, the J separations and coeffs are packed into float arrays,
+     so the cutoff test and force math run as one branch-free loop
+     the compiler can vectorize
+   coords are subtracted in double before conversion to float,
+     forces, energy, virial are accumulated in double
+   ONETYPE = 1 skips the per-J coeff lookup when there is a single atom type
+------------------------------------------------------------------------- */
+
+template < int ONETYPE >
+void PairLJCut::eval_mixed(int eflag)
+{
+  int i,j,ii,jj,inum,jnum,itype,jtype;
+  double xtmp,ytmp,ztmp,fxtmp,fytmp,fztmp,delx,dely,delz,evdwl,fpair;
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int ntypes = atom->ntypes;
+  double *special_lj = force->special_lj;
+  int newton_pair = force->newton_pair;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // float copies of the coeffs, refreshed each call for fix adapt
+
+  if (!cutsqf) {
+    memory->create(cutsqf,ntypes+1,ntypes+1,"pair:cutsqf");
+    memory->create(lj1f,ntypes+1,ntypes+1,"pair:lj1f");
+    memory->create(lj2f,ntypes+1,ntypes+1,"pair:lj2f");
+  }
+  for (i = 1; i <= ntypes; i++)
+    for (j = 1; j <= ntypes; j++) {
+      cutsqf[i][j] = cutsq[i][j];
+      lj1f[i][j] = lj1[i][j];
+      lj2f[i][j] = lj2[i][j];
+    }
+
+  const float cutsqone = cutsqf[1][1];
+  const float lj1one = lj1f[1][1];
+  const float lj2one = lj2f[1][1];
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    if (jnum > maxpack) grow_pack(jnum);
+    float * _noalias const pdelx = pack[0];
+    float * _noalias const pdely = pack[1];
+    float * _noalias const pdelz = pack[2];
+    float * _noalias const pfactor = pack[3];
+    float * _noalias const pcutsq = pack[4];
+    float * _noalias const plj1 = pack[5];
+    float * _noalias const plj2 = pack[6];
+    float * _noalias const pfpair = pack[7];
+    const float * const cutsqi = cutsqf[itype];
+    const float * const lj1i = lj1f[itype];
+    const float * const lj2i = lj2f[itype];
+
+    // gather J separations and coeffs
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      pfactor[jj] = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+      pdelx[jj] = xtmp - x[j][0];
+      pdely[jj] = ytmp - x[j][1];
+      pdelz[jj] = ztmp - x[j][2];
+      if (!ONETYPE) {
+        jtype = type[j];
+        pcutsq[jj] = cutsqi[jtype];
+        plj1[jj] = lj1i[jtype];
+        plj2[jj] = lj2i[jtype];
+      }
+    }
+
+    // force math, fpair = 0 outside the cutoff
+
+    for (jj = 0; jj < jnum; jj++) {
+      const float rsq = pdelx[jj]*pdelx[jj] + pdely[jj]*pdely[jj] +
+        pdelz[jj]*pdelz[jj];
+      const float r2inv = 1.0f/rsq;
+      const float r6inv = r2inv*r2inv*r2inv;
+      float forcelj,cutsqj;
+      if (ONETYPE) {
+        forcelj = r6inv * (lj1one*r6inv - lj2one);
+        cutsqj = cutsqone;
+      } else {
+        forcelj = r6inv * (plj1[jj]*r6inv - plj2[jj]);
+        cutsqj = pcutsq[jj];
+      }
+      const float mask = (rsq < cutsqj) ? 1.0f : 0.0f;
+      pfpair[jj] = mask*pfactor[jj]*forcelj*r2inv;
+    }
+
+    // scatter forces in double
+
+    fxtmp = fytmp = fztmp = 0.0;
+    for (jj = 0; jj < jnum; jj++) {
+      fpair = pfpair[jj];
+      delx = pdelx[jj];
+      dely = pdely[jj];
+      delz = pdelz[jj];
+      fxtmp += delx*fpair;
+      fytmp += dely*fpair;
+      fztmp += delz*fpair;
+      j = jlist[jj] & NEIGHMASK;
+      if (newton_pair || j < nlocal) {
+        f[j][0] -= delx*fpair;
+        f[j][1] -= dely*fpair;
+        f[j][2] -= delz*fpair;
+      }
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+
+    if (!evflag) continue;
+
+    // energy and virial tallies for pairs inside the cutoff
+
+    for (jj = 0; jj < jnum; jj++) {
+      const float rsq = pdelx[jj]*pdelx[jj] + pdely[jj]*pdely[jj] +
+        pdelz[jj]*pdelz[jj];
+      j = jlist[jj] & NEIGHMASK;
+      jtype = type[j];
+      if (rsq >= (ONETYPE ? cutsqone : pcutsq[jj])) continue;
+      evdwl = 0.0;
+      if (eflag) {
+        const float r2inv = 1.0f/rsq;
+        const float r6inv = r2inv*r2inv*r2inv;
+        evdwl = r6inv*((float) lj3[itype][jtype]*r6inv -
+                       (float) lj4[itype][jtype]) -
+          (float) offset[itype][jtype];
+        evdwl *= pfactor[jj];
+      }
+      ev_tally(i,j,nlocal,newton_pair,evdwl,0.0,pfpair[jj],
+               pdelx[jj],pdely[jj],pdelz[jj]);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   grow the per-I float pack arrays to hold N neighbors
+   rows are padded to a multiple of 16 floats to keep them aligned
+------------------------------------------------------------------------- */
+
+void PairLJCut::grow_pack(int n)
+{
+  maxpack = (n + 15) & ~15;
+  memory->destroy(pack);
+  memory->create(pack,8,maxpack,"pair:pack");
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairLJCut::compute_inner()
@@ -490,6 +675,12 @@ void PairLJCut::init_style()
     if (((Respa *) update->integrate)->level_inner >= 0) respa = 1;
     if (((Respa *) update->integrate)->level_middle >= 0) respa = 2;
 
+    // compute_inner/middle/outer() have no mixed precision path
+
+    if (respa && precision_flag)
+      error->all(FLERR,"Pair_modify precision mixed is not supported "
+                 "with rRESPA inner/middle/outer levels");
+
     if (respa == 0) irequest = neighbor->request(this,instance_me);
     else if (respa == 1) {
       irequest = neighbor->request(this,instance_me);
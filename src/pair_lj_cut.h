@@ -54,7 +54,13 @@ class PairLJCut : public Pair {
   double **lj1,**lj2,**lj3,**lj4,**offset;
   double *cut_respa;
 
+  int maxpack;                     // size of per-I float pack arrays
+  float **pack;                    // packed J separations, coeffs, fpair
+  float **cutsqf,**lj1f,**lj2f;    // float copies of coeffs
+
   virtual void allocate();
+  template < int ONETYPE > void eval_mixed(int);
+  void grow_pack(int);
 };
 
 }
@@ -74,6 +80,13 @@ E: Incorrect args for pair coefficients
 
 Self-explanatory.  Check the input script or data file.
 
+E: Pair_modify precision mixed is not supported with rRESPA inner/middle/outer levels
+
+The inner, middle, and outer rRESPA force routines of this pair style
+only exist in double precision.  Use pair_modify precision double, or
+assign the whole pair style to one rRESPA level with the pair keyword
+of the run_style respa command.
+
 E: Pair cutoff < Respa interior cutoff
 
 One or more pairwise cutoffs are too short to use with the specified
@@ -32,6 +32,7 @@ using namespace MathConst;
 
 PairLJCutCoulCut::PairLJCutCoulCut(LAMMPS *lmp) : Pair(lmp)
 {
+  overlap_enable = 1;
   writedata = 1;
 }
 
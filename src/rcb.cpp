@@ -23,6 +23,7 @@ using namespace LAMMPS_NS;
 #define MYHUGE 1.0e30
 #define TINY 1.0e-6
 #define DELTA 16384
+#define MAXITER_MULTI 64
 
 // prototypes for non-class functions
 
@@ -47,6 +48,9 @@ RCB::RCB(LAMMPS *lmp) : Pointers(lmp)
   maxbuf = 0;
   buf = NULL;
 
+  maxmdot = maxmbuf = 0;
+  mdots = mbuf = NULL;
+
   maxrecv = maxsend = 0;
   recvproc = recvindex = sendproc = sendindex = NULL;
 
@@ -75,6 +79,8 @@ RCB::~RCB()
   memory->destroy(dotmark);
   memory->destroy(dotmark_select);
   memory->sfree(buf);
+  memory->sfree(mdots);
+  memory->sfree(mbuf);
 
   memory->destroy(recvproc);
   memory->destroy(recvindex);
@@ -1101,6 +1107,389 @@ void RCB::compute_old(int dimension, int n, double **x, double *wt,
   }
 }
 
+/* ----------------------------------------------------------------------
+   perform multi-constraint RCB balancing of N particles at coords X
+     in bounding box LO/HI
+   each particle has NWT weights in WTS, all weights >= 0.0
+   each cut is placed to balance all weights at once, which in general
+     is not possible exactly, so the cut minimizes the largest ratio
+     of weight to target weight in either half over all weights
+   that ratio increases with cut position in the lower half and
+     decreases in the upper half, so the cut is found by bisection
+   as in compute(), each cut is tested in all dimensions and the
+     dimension that produces 2 boxes with largest min size is selected
+   dimension = 2 or 3
+   as documented in rcb.h:
+     sets noriginal,nfinal,nkeep,recvproc,recvindex,lo,hi
+------------------------------------------------------------------------- */
+
+void RCB::compute_multi(int dimension, int n, double **x, int nwt,
+                        double **wts, double *bboxlo, double *bboxhi)
+{
+  int i,j,k,m;
+  int keep,outgoing,incoming,incoming2;
+  int dim,markactive,iter;
+  double frac,ratio,ratiolo,ratiohi;
+  double valuemin,valuemax,valuehalf,valuehalf_select,smaller;
+  double wtsum[RCB_MAXWEIGHT],wttot[RCB_MAXWEIGHT],wtlo[RCB_MAXWEIGHT];
+  double medme[RCB_MAXWEIGHT+2],med[RCB_MAXWEIGHT+2];
+  MPI_Comm comm,comm_half;
+  MPI_Request request,request2;
+
+  if (nwt < 1 || nwt > RCB_MAXWEIGHT)
+    error->all(FLERR,"Invalid number of weights for multi-constraint RCB");
+
+  // create list of my DotMultis
+
+  ndot = nkeep = noriginal = n;
+
+  if (ndot > maxmdot) {
+    maxmdot = ndot;
+    memory->sfree(mdots);
+    mdots = (DotMulti *)
+      memory->smalloc(ndot*sizeof(DotMulti),"RCB:mdots");
+  }
+
+  for (i = 0; i < ndot; i++) {
+    mdots[i].x[0] = x[i][0];
+    mdots[i].x[1] = x[i][1];
+    mdots[i].x[2] = x[i][2];
+    for (m = 0; m < nwt; m++) mdots[i].wt[m] = wts[i][m];
+    mdots[i].proc = me;
+    mdots[i].index = i;
+  }
+
+  // initial bounding box = simulation box
+  // includes periodic or shrink-wrapped boundaries
+
+  lo = bbox.lo;
+  hi = bbox.hi;
+
+  lo[0] = bboxlo[0];
+  lo[1] = bboxlo[1];
+  lo[2] = bboxlo[2];
+  hi[0] = bboxhi[0];
+  hi[1] = bboxhi[1];
+  hi[2] = bboxhi[2];
+
+  cut = 0.0;
+  cutdim = -1;
+
+  // initialize counters
+
+  counters[0] = 0;
+  counters[1] = 0;
+  counters[2] = 0;
+  counters[3] = ndot;
+  counters[4] = maxmdot;
+  counters[5] = 0;
+  counters[6] = 0;
+
+  // create communicator for use in recursion
+
+  MPI_Comm_dup(world,&comm);
+
+  // recurse until partition is a single proc = me
+  // proclower,procupper = lower,upper procs in partition
+  // procmid = 1st proc in upper half of partition
+
+  int procpartner,procpartner2;
+
+  int procmid;
+  int proclower = 0;
+  int procupper = nprocs - 1;
+
+  while (proclower != procupper) {
+
+    // if odd # of procs, lower partition gets extra one
+
+    procmid = proclower + (procupper - proclower) / 2 + 1;
+
+    // determine communication partner(s)
+    // readnumber = # of proc partners to read from
+
+    if (me < procmid)
+      procpartner = me + (procmid - proclower);
+    else
+      procpartner = me - (procmid - proclower);
+
+    int readnumber = 1;
+    if (procpartner > procupper) {
+      readnumber = 0;
+      procpartner--;
+    }
+    if (me == procupper && procpartner != procmid - 1) {
+      readnumber = 2;
+      procpartner2 = procpartner + 1;
+    }
+
+    // wttot = summed weights of entire partition
+    // frac = desired fraction of each weight in lower half of partition
+
+    for (m = 0; m < nwt; m++) wtsum[m] = 0.0;
+    for (i = 0; i < ndot; i++)
+      for (m = 0; m < nwt; m++) wtsum[m] += mdots[i].wt[m];
+    MPI_Allreduce(wtsum,wttot,nwt,MPI_DOUBLE,MPI_SUM,comm);
+
+    frac = 1.0 * (procmid - proclower) / (procupper + 1 - proclower);
+
+    // attempt a cut in each dimension, same as in compute()
+
+    int dim_select = -1;
+    double largest = 0.0;
+
+    for (dim = 0; dim < dimension; dim++) {
+
+      // create active list and mark array for dots
+      // initialize active list to all dots
+
+      if (ndot > maxlist) {
+        memory->destroy(dotlist);
+        memory->destroy(dotmark);
+        memory->destroy(dotmark_select);
+        maxlist = maxmdot;
+        memory->create(dotlist,maxlist,"RCB:dotlist");
+        memory->create(dotmark,maxlist,"RCB:dotmark");
+        memory->create(dotmark_select,maxlist,"RCB:dotmark_select");
+      }
+
+      nlist = ndot;
+      for (i = 0; i < nlist; i++) dotlist[i] = i;
+
+      // bisection iteration on cut position
+      // as each iteration begins, require:
+      //   all non-active dots are marked with 0/1 in dotmark
+      //   valuemin <= every active dot <= valuemax
+      //   wtlo = weights of non-active dots marked with 0
+      // medme/med = lower weights and lower/upper counts of active dots
+      // ratiolo = largest ratio of lower weight to its target
+      // ratiohi = largest ratio of upper weight to its target
+      // move cut towards the half with the larger ratio
+      // done when no active dots remain on the side that is kept
+      //   or the active interval has shrunk to nothing
+
+      for (m = 0; m < nwt; m++) wtlo[m] = 0.0;
+      valuemin = lo[dim];
+      valuemax = hi[dim];
+      valuehalf = 0.5 * (valuemin + valuemax);
+
+      for (iter = 0; iter < MAXITER_MULTI; iter++) {
+        valuehalf = 0.5 * (valuemin + valuemax);
+
+        for (m = 0; m < nwt+2; m++) medme[m] = 0.0;
+
+        for (j = 0; j < nlist; j++) {
+          i = dotlist[j];
+          if (mdots[i].x[dim] <= valuehalf) {
+            for (m = 0; m < nwt; m++) medme[m] += mdots[i].wt[m];
+            medme[nwt] += 1.0;
+            dotmark[i] = 0;
+          } else {
+            medme[nwt+1] += 1.0;
+            dotmark[i] = 1;
+          }
+        }
+
+        counters[0]++;
+        MPI_Allreduce(medme,med,nwt+2,MPI_DOUBLE,MPI_SUM,comm);
+
+        ratiolo = ratiohi = 0.0;
+        for (m = 0; m < nwt; m++) {
+          if (wttot[m] <= 0.0) continue;
+          ratio = (wtlo[m] + med[m]) / (frac * wttot[m]);
+          ratiolo = MAX(ratiolo,ratio);
+          ratio = (wttot[m] - wtlo[m] - med[m]) / ((1.0-frac) * wttot[m]);
+          ratiohi = MAX(ratiohi,ratio);
+        }
+
+        if (ratiolo > ratiohi) {                // lower half TOO LARGE
+          if (med[nwt] == 0.0) break;
+          valuemax = valuehalf;
+          markactive = 0;
+        } else if (ratiolo < ratiohi) {         // upper half TOO LARGE
+          if (med[nwt+1] == 0.0) break;
+          for (m = 0; m < nwt; m++) wtlo[m] += med[m];
+          valuemin = valuehalf;
+          markactive = 1;
+        } else break;                           // balanced
+
+        if (valuemax - valuemin <= TINY * (hi[dim] - lo[dim])) break;
+
+        // shrink the active list
+
+        k = 0;
+        for (j = 0; j < nlist; j++) {
+          i = dotlist[j];
+          if (dotmark[i] == markactive) dotlist[k++] = i;
+        }
+        nlist = k;
+      }
+
+      // cut produces 2 sub-boxes with reduced size in dim
+      // compare smaller of the 2 sizes to previous dims
+      // keep dim that has the largest smaller
+
+      smaller = MIN(valuehalf-lo[dim],hi[dim]-valuehalf);
+      if (smaller > largest) {
+        largest = smaller;
+        dim_select = dim;
+        valuehalf_select = valuehalf;
+        memcpy(dotmark_select,dotmark,ndot*sizeof(int));
+      }
+    }
+
+    // copy results for best dim cut into dim,valuehalf,dotmark
+    // if no dim produced a cut inside the box, use the first one
+
+    if (dim_select < 0) {
+      dim_select = 0;
+      valuehalf_select = lo[0];
+      for (i = 0; i < ndot; i++) dotmark_select[i] = 1;
+    }
+
+    dim = dim_select;
+    valuehalf = valuehalf_select;
+    memcpy(dotmark,dotmark_select,ndot*sizeof(int));
+
+    // store cut info only if I am procmid
+
+    if (me == procmid) {
+      cut = valuehalf;
+      cutdim = dim;
+    }
+
+    // use cut to shrink my RCB bounding box
+
+    if (me < procmid) hi[dim] = valuehalf;
+    else lo[dim] = valuehalf;
+
+    // outgoing = number of dots to ship to partner
+    // nkeep = number of dots that have never migrated
+
+    markactive = (me < procpartner);
+    for (i = 0, keep = 0, outgoing = 0; i < ndot; i++)
+      if (dotmark[i] == markactive) outgoing++;
+      else if (i < nkeep) keep++;
+    nkeep = keep;
+
+    // alert partner how many dots I'll send, read how many I'll recv
+
+    MPI_Send(&outgoing,1,MPI_INT,procpartner,0,world);
+    incoming = 0;
+    if (readnumber) {
+      MPI_Recv(&incoming,1,MPI_INT,procpartner,0,world,MPI_STATUS_IGNORE);
+      if (readnumber == 2) {
+        MPI_Recv(&incoming2,1,MPI_INT,procpartner2,0,world,MPI_STATUS_IGNORE);
+        incoming += incoming2;
+      }
+    }
+
+    // check if need to alloc more space
+
+    int ndotnew = ndot - outgoing + incoming;
+    if (ndotnew > maxmdot) {
+      while (maxmdot < ndotnew) maxmdot += DELTA;
+      mdots = (DotMulti *)
+        memory->srealloc(mdots,maxmdot*sizeof(DotMulti),"RCB::mdots");
+      counters[6]++;
+    }
+
+    counters[1] += outgoing;
+    counters[2] += incoming;
+    if (ndotnew > counters[3]) counters[3] = ndotnew;
+    if (maxmdot > counters[4]) counters[4] = maxmdot;
+
+    // malloc comm send buffer
+
+    if (outgoing > maxmbuf) {
+      memory->sfree(mbuf);
+      maxmbuf = outgoing;
+      mbuf = (DotMulti *)
+        memory->smalloc(maxmbuf*sizeof(DotMulti),"RCB:mbuf");
+    }
+
+    // fill buffer with dots that are marked for sending
+    // pack down the unmarked ones
+
+    keep = outgoing = 0;
+    for (i = 0; i < ndot; i++) {
+      if (dotmark[i] == markactive)
+        memcpy(&mbuf[outgoing++],&mdots[i],sizeof(DotMulti));
+      else
+        memcpy(&mdots[keep++],&mdots[i],sizeof(DotMulti));
+    }
+
+    // post receives for dots
+
+    if (readnumber > 0) {
+      MPI_Irecv(&mdots[keep],incoming*sizeof(DotMulti),MPI_CHAR,
+                procpartner,1,world,&request);
+      if (readnumber == 2) {
+        keep += incoming - incoming2;
+        MPI_Irecv(&mdots[keep],incoming2*sizeof(DotMulti),MPI_CHAR,
+                  procpartner2,1,world,&request2);
+      }
+    }
+
+    // handshake before sending dots to insure recvs have been posted
+
+    if (readnumber > 0) {
+      MPI_Send(NULL,0,MPI_INT,procpartner,0,world);
+      if (readnumber == 2) MPI_Send(NULL,0,MPI_INT,procpartner2,0,world);
+    }
+    MPI_Recv(NULL,0,MPI_INT,procpartner,0,world,MPI_STATUS_IGNORE);
+
+    // send dots to partner
+
+    MPI_Rsend(mbuf,outgoing*sizeof(DotMulti),MPI_CHAR,procpartner,1,world);
+
+    // wait until all dots are received
+
+    if (readnumber > 0) {
+      MPI_Wait(&request,MPI_STATUS_IGNORE);
+      if (readnumber == 2) MPI_Wait(&request2,MPI_STATUS_IGNORE);
+    }
+
+    ndot = ndotnew;
+
+    // cut partition in half, create new communicators of 1/2 size
+
+    int split;
+    if (me < procmid) {
+      procupper = procmid - 1;
+      split = 0;
+    } else {
+      proclower = procmid;
+      split = 1;
+    }
+
+    MPI_Comm_split(comm,split,me,&comm_half);
+    MPI_Comm_free(&comm);
+    comm = comm_half;
+  }
+
+  // clean up
+
+  MPI_Comm_free(&comm);
+
+  // set public variables with results of rebalance
+
+  nfinal = ndot;
+
+  if (nfinal > maxrecv) {
+    memory->destroy(recvproc);
+    memory->destroy(recvindex);
+    maxrecv = nfinal;
+    memory->create(recvproc,maxrecv,"RCB:recvproc");
+    memory->create(recvindex,maxrecv,"RCB:recvindex");
+  }
+
+  for (i = 0; i < nfinal; i++) {
+    recvproc[i] = mdots[i].proc;
+    recvindex[i] = mdots[i].index;
+  }
+}
+
 /* ----------------------------------------------------------------------
    custom MPI reduce operation
    merge of each component of an RCB bounding box
@@ -1244,6 +1633,8 @@ void RCB::invert(int sortflag)
 bigint RCB::memory_usage()
 {
   bigint bytes = 0;
+  bytes += (bigint) maxdot * sizeof(Dot);
+  bytes += (bigint) maxmdot * sizeof(DotMulti);
   if (irregular) bytes += irregular->memory_usage();
   return bytes;
 }
@@ -17,6 +17,10 @@
 #include <mpi.h>
 #include "pointers.h"
 
+// max # of weights per point for multi-constraint balancing
+
+#define RCB_MAXWEIGHT 4
+
 namespace LAMMPS_NS {
 
 class RCB : protected Pointers {
@@ -43,6 +47,7 @@ class RCB : protected Pointers {
   ~RCB();
   void compute(int, int, double **, double *, double *, double *);
   void compute_old(int, int, double **, double *, double *, double *);
+  void compute_multi(int, int, double **, int, double **, double *, double *);
   void invert(int sortflag = 0);
   bigint memory_usage();
 
@@ -76,6 +81,15 @@ class RCB : protected Pointers {
     int index;            // index on owning proc
   };
 
+  // point to balance on with multiple weights
+
+  struct DotMulti {
+    double x[3];                 // coord of point
+    double wt[RCB_MAXWEIGHT];    // weights of point
+    int proc;                    // owning proc
+    int index;                   // index on owning proc
+  };
+
   // tree of RCB cuts
 
   struct Tree {
@@ -105,6 +119,11 @@ class RCB : protected Pointers {
   int maxbuf;
   Dot *buf;
 
+  DotMulti *mdots;  // dots on this proc for compute_multi()
+  int maxmdot;      // allocated size of mdots
+  int maxmbuf;
+  DotMulti *mbuf;
+
   int maxrecv,maxsend;
 
   BBox bbox;
@@ -131,3 +150,12 @@ class RCB : protected Pointers {
 }
 
 #endif
+
+/* ERROR/WARNING messages:
+
+E: Invalid number of weights for multi-constraint RCB
+
+Balancing with multiple weights per particle supports up to 4
+weights.
+
+*/
@@ -51,6 +51,8 @@ using namespace LAMMPS_NS;
 #define MAXLINE 256
 #define LB_FACTOR 1.1
 #define CHUNK 1024
+#define PCHUNK 16384       // lines per reader per round for readers > 1
+#define BLOCK 1048576      // bytes per read when scanning Atoms section
 #define DELTA 4            // must be 2 or larger
 #define MAXBODY 32         // max # of lines in one body
 
@@ -132,6 +134,9 @@ void ReadData::command(int narg, char **arg)
     extra_dihedral_types = extra_improper_types = 0;
 
   groupbit = 0;
+  nreaders = 1;
+  datafile = arg[0];
+  atomsend = -1;
 
   nfix = 0;
   fix_index = NULL;
@@ -212,6 +217,12 @@ void ReadData::command(int narg, char **arg)
         error->all(FLERR,"Illegal read_data command");
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"readers") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal read_data command");
+      nreaders = force->inumeric(FLERR,arg[iarg+1]);
+      if (nreaders < 1) error->all(FLERR,"Illegal read_data command");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"group") == 0) {
       if (iarg+2 > narg) error->all(FLERR,"Illegal read_data command");
       int igroup = group->find_or_create(arg[iarg+1]);
@@ -455,6 +466,8 @@ void ReadData::command(int narg, char **arg)
             error->warning(FLERR,"Atom style in data file differs "
                            "from currently defined atom style");
           atoms();
+        } else if (atomsend >= 0) {
+          if (me == 0) fseek(fp,atomsend,SEEK_SET);
         } else skip_lines(natoms);
       } else if (strcmp(keyword,"Velocities") == 0) {
         if (atomflag == 0)
@@ -1085,12 +1098,15 @@ void ReadData::atoms()
 
   bigint nread = 0;
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms-nread,CHUNK);
-    eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
-    if (eof) error->all(FLERR,"Unexpected end of data file");
-    atom->data_atoms(nchunk,buffer,id_offset,toffset,shiftflag,shift);
-    nread += nchunk;
+  if (nreaders > 1 && comm->nprocs > 1) atoms_parallel();
+  else {
+    while (nread < natoms) {
+      nchunk = MIN(natoms-nread,CHUNK);
+      eof = comm->read_lines_from_file(fp,nchunk,MAXLINE,buffer);
+      if (eof) error->all(FLERR,"Unexpected end of data file");
+      atom->data_atoms(nchunk,buffer,id_offset,toffset,shiftflag,shift);
+      nread += nchunk;
+    }
   }
 
   // check that all atoms were assigned correctly
@@ -1120,6 +1136,269 @@ void ReadData::atoms()
   }
 }
 
+/* ----------------------------------------------------------------------
+   read all atoms with multiple reader procs
+   proc 0 scans the section for newlines only, to split it into
+     nreaders contiguous shares of lines and to find its end
+   each reader opens the file, seeks to its share and parses coords
+     of each line to find the owning proc
+   lines are sent to owners via irregular comm in rounds of PCHUNK lines,
+     owners store them per reader and parse them at the end,
+     so atoms are stored in the same order as when read by proc 0 alone
+------------------------------------------------------------------------- */
+
+void ReadData::atoms_parallel()
+{
+  int nprocs = comm->nprocs;
+  int nr = MIN(nreaders,nprocs);
+
+  MPI_Bcast(&compressed,1,MPI_INT,0,world);
+  if (compressed)
+    error->all(FLERR,"Cannot use read_data readers with gzipped data file");
+
+  // offsets[k] = file offset of 1st line of reader K
+  // offsets[nr] = file offset just past Atoms section
+  // reader K gets lines K*natoms/nr to (K+1)*natoms/nr - 1
+
+  bigint *offsets = new bigint[nr+1];
+  int eof = 0;
+
+  if (me == 0) {
+    bigint start = ftell(fp);
+    bigint pos = start;
+    bigint nline = 0;
+    int k = 1;
+    while (k < nr && k*natoms/nr == 0) offsets[k++] = start;
+    offsets[0] = start;
+
+    char *block = new char[BLOCK];
+    while (nline < natoms) {
+      size_t nbytes = fread(block,1,BLOCK,fp);
+      if (nbytes == 0) break;
+      char *ptr = block;
+      char *end = block + nbytes;
+      char *newline;
+      while (nline < natoms &&
+             (newline = (char *) memchr(ptr,'\n',end-ptr))) {
+        ptr = newline + 1;
+        nline++;
+        while (k < nr && k*natoms/nr == nline)
+          offsets[k++] = pos + (ptr-block);
+      }
+      pos += ptr - block;
+      if (nline < natoms) pos += end - ptr;
+      else break;
+    }
+    delete [] block;
+
+    // last line of file may not end in a newline
+
+    if (nline == natoms-1 && feof(fp)) nline++;
+    if (nline < natoms) eof = 1;
+    offsets[nr] = pos;
+    clearerr(fp);
+    fseek(fp,pos,SEEK_SET);
+  }
+
+  MPI_Bcast(&eof,1,MPI_INT,0,world);
+  if (eof) error->all(FLERR,"Unexpected end of data file");
+  MPI_Bcast(offsets,nr+1,MPI_LMP_BIGINT,0,world);
+  atomsend = offsets[nr];
+
+  // reader K is proc K*nprocs/nr
+
+  int ireader = -1;
+  for (int k = 0; k < nr; k++)
+    if (me == static_cast<int> ((bigint) k*nprocs/nr)) ireader = k;
+
+  FILE *fpr = NULL;
+  bigint nmine = 0;
+  if (ireader >= 0) {
+    nmine = (ireader+1)*natoms/nr - ireader*natoms/nr;
+    if (nmine) {
+      fpr = fopen(datafile,"r");
+      if (fpr == NULL) {
+        char str[128];
+        snprintf(str,128,"Cannot open file %s",datafile);
+        error->one(FLERR,str);
+      }
+      fseek(fpr,offsets[ireader],SEEK_SET);
+    }
+  }
+
+  // per-reader storage of received lines on each proc
+
+  char **rtext = new char*[nr];
+  bigint *rlen = new bigint[nr];
+  bigint *rmax = new bigint[nr];
+  bigint *rcount = new bigint[nr];
+  for (int k = 0; k < nr; k++) {
+    rtext[k] = NULL;
+    rlen[k] = rmax[k] = rcount[k] = 0;
+  }
+
+  int nwords_expect = atom->avec->size_data_atom;
+  int xptr = atom->avec->xcol_data - 1;
+  int triclinic = domain->triclinic;
+  char **values = new char*[nwords_expect+3];
+  double xdata[3],lamda[3];
+  double *coord;
+  imageint imagedata;
+  int igx,igy,igz;
+
+  char *text = new char[PCHUNK*MAXLINE];
+  int *proclist = new int[PCHUNK];
+  int *lens = new int[PCHUNK];
+  char *sendbuf = NULL;
+  char *recvbuf = NULL;
+  bigint maxsend = 0, maxrecv = 0;
+
+  comm->coord2proc_setup();
+  Irregular *irregular = new Irregular(lmp);
+
+  bigint maxcount = (natoms + nr - 1) / nr;
+  bigint nrounds = (maxcount + PCHUNK - 1) / PCHUNK;
+  bigint nread = 0;
+
+  for (bigint iround = 0; iround < nrounds; iround++) {
+
+    // reader reads next lines of its share and finds their owners
+
+    int nsend = 0;
+    int maxlen = 0;
+    if (ireader >= 0) {
+      int n = MIN(nmine-nread,PCHUNK);
+      for (int i = 0; i < n; i++) {
+        char *ptr = &text[i*MAXLINE];
+        if (fgets(ptr,MAXLINE,fpr) == NULL)
+          error->one(FLERR,"Unexpected end of data file");
+        int len = strlen(ptr);
+        while (len && (ptr[len-1] == '\n' || ptr[len-1] == '\r')) len--;
+        ptr[len] = '\0';
+        lens[i] = len;
+        maxlen = MAX(maxlen,len);
+
+        strcpy(copy,ptr);
+        char *comment = strchr(copy,'#');
+        if (comment) *comment = '\0';
+        int nwords = 0;
+        char *word = strtok(copy," \t\n\r\f");
+        while (word && nwords < nwords_expect+3) {
+          values[nwords++] = word;
+          word = strtok(NULL," \t\n\r\f");
+        }
+        if (word ||
+            (nwords != nwords_expect && nwords != nwords_expect+3))
+          error->one(FLERR,"Incorrect atom format in data file");
+
+        if (nwords > nwords_expect)
+          imagedata = ((imageint) (atoi(values[nwords-3]) + IMGMAX) & IMGMASK) |
+            (((imageint) (atoi(values[nwords-2]) + IMGMAX) & IMGMASK) << IMGBITS) |
+            (((imageint) (atoi(values[nwords-1]) + IMGMAX) & IMGMASK) << IMG2BITS);
+        else imagedata = ((imageint) IMGMAX << IMG2BITS) |
+               ((imageint) IMGMAX << IMGBITS) | IMGMAX;
+
+        xdata[0] = atof(values[xptr]);
+        xdata[1] = atof(values[xptr+1]);
+        xdata[2] = atof(values[xptr+2]);
+        if (shiftflag) {
+          xdata[0] += shift[0];
+          xdata[1] += shift[1];
+          xdata[2] += shift[2];
+        }
+
+        domain->remap(xdata,imagedata);
+        if (triclinic) {
+          domain->x2lamda(xdata,lamda);
+          coord = lamda;
+        } else coord = xdata;
+
+        proclist[i] = comm->coord2proc(coord,igx,igy,igz);
+      }
+      nsend = n;
+      nread += n;
+    }
+
+    // datum = reader index + line padded to longest line of this round
+
+    int maxlenall;
+    MPI_Allreduce(&maxlen,&maxlenall,1,MPI_INT,MPI_MAX,world);
+    int dsize = sizeof(int) + maxlenall + 1;
+
+    if ((bigint) nsend*dsize > maxsend) {
+      maxsend = (bigint) nsend*dsize;
+      memory->sfree(sendbuf);
+      sendbuf = (char *) memory->smalloc(maxsend,"read_data:sendbuf");
+    }
+    for (int i = 0; i < nsend; i++) {
+      char *ptr = &sendbuf[(bigint) i*dsize];
+      memcpy(ptr,&ireader,sizeof(int));
+      memcpy(ptr+sizeof(int),&text[i*MAXLINE],lens[i]+1);
+    }
+
+    int nrecv = irregular->create_data(nsend,proclist,1);
+    if ((bigint) nrecv*dsize > maxrecv) {
+      maxrecv = (bigint) nrecv*dsize;
+      memory->sfree(recvbuf);
+      recvbuf = (char *) memory->smalloc(maxrecv,"read_data:recvbuf");
+    }
+    irregular->exchange_data(sendbuf,dsize,recvbuf);
+    irregular->destroy_data();
+
+    // append received lines, newline-terminated, to storage of their reader
+
+    for (int i = 0; i < nrecv; i++) {
+      char *ptr = &recvbuf[(bigint) i*dsize];
+      int k;
+      memcpy(&k,ptr,sizeof(int));
+      ptr += sizeof(int);
+      int len = strlen(ptr);
+      if (rlen[k] + len + 2 > rmax[k]) {
+        rmax[k] = MAX(2*rmax[k],rlen[k] + len + 2);
+        rtext[k] = (char *)
+          memory->srealloc(rtext[k],rmax[k],"read_data:rtext");
+      }
+      memcpy(&rtext[k][rlen[k]],ptr,len);
+      rlen[k] += len;
+      rtext[k][rlen[k]++] = '\n';
+      rcount[k]++;
+    }
+  }
+
+  if (fpr) fclose(fpr);
+  delete irregular;
+  memory->sfree(sendbuf);
+  memory->sfree(recvbuf);
+  delete [] text;
+  delete [] proclist;
+  delete [] lens;
+  delete [] values;
+  delete [] offsets;
+
+  // parse my lines in file order, CHUNK lines at a time
+  // lines were already routed to their owner, which still checks bounds
+  //   so atoms outside a non-periodic box are caught by the count below
+
+  for (int k = 0; k < nr; k++) {
+    char *ptr = rtext[k];
+    bigint nleft = rcount[k];
+    while (nleft) {
+      int nchunk = MIN(nleft,CHUNK);
+      char *next = ptr;
+      for (int i = 0; i < nchunk; i++) next = strchr(next,'\n') + 1;
+      atom->data_atoms(nchunk,ptr,id_offset,toffset,shiftflag,shift,1);
+      ptr = next;
+      nleft -= nchunk;
+    }
+    memory->sfree(rtext[k]);
+  }
+
+  delete [] rtext;
+  delete [] rlen;
+  delete [] rmax;
+  delete [] rcount;
+}
+
 /* ----------------------------------------------------------------------
    read all velocities
    to find atoms, must build atom map if not a molecular system
@@ -71,6 +71,9 @@ class ReadData : protected Pointers {
   int extra_atom_types,extra_bond_types,extra_angle_types;
   int extra_dihedral_types,extra_improper_types;
   int groupbit;
+  int nreaders;                 // # of procs reading Atoms section
+  char *datafile;               // name of data file
+  bigint atomsend;              // file offset after Atoms section, -1 if unset
 
   int nfix;
   int *fix_index;
@@ -89,6 +92,7 @@ class ReadData : protected Pointers {
   int style_match(const char *, const char *);
 
   void atoms();
+  void atoms_parallel();
   void velocities();
 
   void bonds(int);
@@ -418,6 +422,11 @@ dimension.  When LAMMPS shrink-wraps the box atoms will be lost if the
 processor they are re-assigned to is too far away.  Choose a box
 size closer to the actual extent of the atoms.
 
+E: Cannot use read_data readers with gzipped data file
+
+The readers option requires each reader proc to seek to its part of
+the Atoms section, which is not possible for a compressed file.
+
 E: Unexpected end of data file
 
 LAMMPS hit the end of the data file while attempting to read a
@@ -75,6 +75,7 @@ ReadDump::ReadDump(LAMMPS *lmp) : Pointers(lmp)
 
   reader = NULL;
   fp = NULL;
+  procowner = NULL;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -467,16 +468,21 @@ void ReadDump::atoms()
 
   // read, broadcast, and process atoms from snapshot in chunks
 
+  // if reader allows it and no atoms are added, all procs read the snapshot
+
   addproc = -1;
 
-  int nchunk;
-  bigint nread = 0;
-  while (nread < nsnapatoms) {
-    nchunk = MIN(nsnapatoms-nread,CHUNK);
-    if (me == 0) reader->read_atoms(nchunk,nfield,fields);
-    MPI_Bcast(&fields[0][0],nchunk*nfield,MPI_DOUBLE,0,world);
-    process_atoms(nchunk);
-    nread += nchunk;
+  if (reader->parallel && !addflag) read_parallel();
+  else {
+    int nchunk;
+    bigint nread = 0;
+    while (nread < nsnapatoms) {
+      nchunk = MIN(nsnapatoms-nread,CHUNK);
+      if (me == 0) reader->read_atoms(nchunk,nfield,fields);
+      MPI_Bcast(&fields[0][0],nchunk*nfield,MPI_DOUBLE,0,world);
+      process_atoms(nchunk);
+      nread += nchunk;
+    }
   }
 
   // if addflag set, add tags to new atoms if possible
@@ -564,6 +570,147 @@ void ReadDump::atoms()
   atom->tag_check();
 }
 
+/* ----------------------------------------------------------------------
+   each proc reads an equal contiguous range of snapshot atoms
+   each atom is sent to the proc that owns its atom ID and processed there
+   two rendezvous operations, decomposition = atom ID modulo nprocs:
+     owned atom IDs are sent to setup an atom ID -> owning proc lookup,
+     snapshot atoms are sent and forwarded to their owning proc
+   snapshot atoms no proc owns are dropped, so only used if addflag = 0
+------------------------------------------------------------------------- */
+
+void ReadDump::read_parallel()
+{
+  int i,m;
+
+  MPI_Bcast(&currentfile,1,MPI_INT,0,world);
+  reader->setup_parallel(files[currentfile],nfield);
+
+  bigint first = me*nsnapatoms/nprocs;
+  bigint last = (me+1)*nsnapatoms/nprocs;
+  if (last-first > MAXSMALLINT)
+    error->one(FLERR,"Too many atoms per proc in dump snapshot");
+  int nrange = last - first;
+
+  double **rows;
+  memory->create(rows,MAX(nrange,1),nfield,"read_dump:rows");
+  reader->read_atoms_range(first,nrange,nfield,rows);
+
+  // setup atom ID -> owning proc lookup in rendezvous decomposition
+  // callback stores the lookup table, nothing is returned
+
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
+
+  int *proclist;
+  memory->create(proclist,MAX(nlocal,nrange),"read_dump:proclist");
+  IDRvous *idbuf = (IDRvous *)
+    memory->smalloc((bigint) nlocal*sizeof(IDRvous),"read_dump:idbuf");
+
+  for (i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    idbuf[i].me = me;
+    idbuf[i].atomID = tag[i];
+  }
+
+  char *buf;
+  comm->rendezvous(nlocal,proclist,(char *) idbuf,sizeof(IDRvous),
+                   rendezvous_ids,buf,0,(void *) this);
+  memory->sfree(idbuf);
+
+  // send each snapshot atom to the proc that owns its atom ID
+  // atom ID in 1st field, invalid IDs are dropped by callback
+
+  tagint itag;
+  for (i = 0; i < nrange; i++) {
+    itag = static_cast<tagint> (rows[i][0]);
+    proclist[i] = itag > 0 ? itag % nprocs : me;
+  }
+
+  int nrecv = comm->rendezvous(nrange,proclist,(char *) &rows[0][0],
+                               nfield*sizeof(double),rendezvous_rows,
+                               buf,nfield*sizeof(double),(void *) this);
+  double *recv = (double *) buf;
+
+  memory->destroy(proclist);
+  memory->destroy(rows);
+  delete procowner;
+  procowner = NULL;
+
+  // process received atoms in chunks, all are owned by this proc
+
+  int nchunk;
+  for (m = 0; m < nrecv; m += nchunk) {
+    nchunk = MIN(nrecv-m,CHUNK);
+    memcpy(&fields[0][0],&recv[(bigint) m*nfield],
+           (bigint) nchunk*nfield*sizeof(double));
+    process_atoms(nchunk);
+  }
+
+  memory->sfree(recv);
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() in read_parallel()
+   store owning proc of each atom ID in procowner map
+   nothing is returned to caller decomposition
+------------------------------------------------------------------------- */
+
+int ReadDump::rendezvous_ids(int n, char *inbuf,
+                             int &flag, int *&proclist, char *&outbuf,
+                             void *ptr)
+{
+  ReadDump *rptr = (ReadDump *) ptr;
+
+  std::map<tagint,int> *procowner = new std::map<tagint,int>();
+  IDRvous *in = (IDRvous *) inbuf;
+
+  for (int i = 0; i < n; i++)
+    (*procowner)[in[i].atomID] = in[i].me;
+
+  rptr->procowner = procowner;
+
+  proclist = NULL;
+  outbuf = NULL;
+  flag = 0;
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   callback from comm->rendezvous() in read_parallel()
+   send each snapshot atom to the proc that owns its atom ID
+   snapshot atoms with an atom ID no proc owns are dropped
+   input buffer is compacted in place and re-used as output buffer
+------------------------------------------------------------------------- */
+
+int ReadDump::rendezvous_rows(int n, char *inbuf,
+                              int &flag, int *&proclist, char *&outbuf,
+                              void *ptr)
+{
+  ReadDump *rptr = (ReadDump *) ptr;
+  Memory *memory = rptr->memory;
+  std::map<tagint,int> *procowner = rptr->procowner;
+  std::map<tagint,int>::iterator it;
+  int nfield = rptr->nfield;
+
+  double *in = (double *) inbuf;
+  memory->create(proclist,n,"read_dump:proclist");
+
+  int nout = 0;
+  for (int i = 0; i < n; i++) {
+    it = procowner->find(static_cast<tagint> (in[i*nfield]));
+    if (it == procowner->end()) continue;
+    proclist[nout] = it->second;
+    if (nout != i)
+      memcpy(&in[nout*nfield],&in[i*nfield],nfield*sizeof(double));
+    nout++;
+  }
+
+  outbuf = inbuf;
+  flag = 1;
+  return nout;
+}
+
 /* ----------------------------------------------------------------------
    process arg list for dump file fields and optional keywords
 ------------------------------------------------------------------------- */
@@ -23,6 +23,7 @@ CommandStyle(read_dump,ReadDump)
 #define LMP_READ_DUMP_H
 
 #include <stdio.h>
+#include <map>
 #include "pointers.h"
 
 namespace LAMMPS_NS {
@@ -82,13 +83,30 @@ private:
 
   class Reader *reader;           // class that reads dump file
 
+  // atom ID -> owning proc, for atom IDs in my rendezvous decomposition
+
+  std::map<tagint,int> *procowner;
+
+  // datum for rendezvous communication
+
+  struct IDRvous {
+    int me;
+    tagint atomID;
+  };
+
   int whichtype(char *);
+  void read_parallel();
   void process_atoms(int);
   void delete_atoms();
 
   double xfield(int, int);
   double yfield(int, int);
   double zfield(int, int);
+
+  // callback functions for rendezvous communication
+
+  static int rendezvous_ids(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_rows(int, char *, int &, int *&, char *&, void *);
 };
 
 }
@@ -140,6 +158,11 @@ For triclinic boxes and scaled coordinates you must specify all 3 of
 the x,y,z fields, else LAMMPS cannot reconstruct the unscaled
 coordinates.
 
+E: Too many atoms per proc in dump snapshot
+
+When all processors read a snapshot in parallel, each reads an equal
+share of its atoms, which must be fewer than 2^31.
+
 E: Too many total atoms
 
 See the setting for bigint in the src/lmptype.h file.
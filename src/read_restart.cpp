@@ -35,6 +35,7 @@
 #include "special.h"
 #include "universe.h"
 #include "mpiio.h"
+#include "restart_codec.h"
 #include "memory.h"
 #include "error.h"
 
@@ -62,7 +63,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
      MULTIPROC,MPIIO,PROCSPERFILE,PERPROC,
      IMAGEINT,BOUNDMIN,TIMESTEP,
      ATOM_ID,ATOM_MAP_STYLE,ATOM_MAP_USER,ATOM_SORTFREQ,ATOM_SORTBIN,
-     COMM_MODE,COMM_CUTOFF,COMM_VEL};
+     COMM_MODE,COMM_CUTOFF,COMM_VEL,COMPRESS};
 
 #define LB_FACTOR 1.1
 
@@ -183,6 +184,7 @@ void ReadRestart::command(int narg, char **arg)
 
   // read file layout info
 
+  compressflag = 0;
   file_layout();
 
   // close header file if in multiproc mode
@@ -198,6 +200,8 @@ void ReadRestart::command(int narg, char **arg)
 
   int maxbuf = 0;
   double *buf = NULL;
+  int maxcbuf = 0;
+  char *cbuf = NULL;
   int m,flag;
 
   // MPI-IO input from single file
@@ -238,12 +242,22 @@ void ReadRestart::command(int narg, char **arg)
         error->all(FLERR,"Invalid flag in peratom section of restart file");
 
       n = read_int();
-      if (n > maxbuf) {
-        maxbuf = n;
-        memory->destroy(buf);
-        memory->create(buf,maxbuf,"read_restart:buf");
+      if (compressflag) {
+        if (n > maxcbuf) {
+          maxcbuf = n;
+          memory->destroy(cbuf);
+          memory->create(cbuf,maxcbuf,"read_restart:cbuf");
+        }
+        read_char_vec(n,cbuf);
+        n = decode_chunk(n,cbuf,buf,maxbuf);
+      } else {
+        if (n > maxbuf) {
+          maxbuf = n;
+          memory->destroy(buf);
+          memory->create(buf,maxbuf,"read_restart:buf");
+        }
+        read_double_vec(n,buf);
       }
-      read_double_vec(n,buf);
 
       m = 0;
       while (m < n) {
@@ -305,12 +319,22 @@ void ReadRestart::command(int narg, char **arg)
           error->one(FLERR,"Invalid flag in peratom section of restart file");
 
         fread(&n,sizeof(int),1,fp);
-        if (n > maxbuf) {
-          maxbuf = n;
-          memory->destroy(buf);
-          memory->create(buf,maxbuf,"read_restart:buf");
+        if (compressflag) {
+          if (n > maxcbuf) {
+            maxcbuf = n;
+            memory->destroy(cbuf);
+            memory->create(cbuf,maxcbuf,"read_restart:cbuf");
+          }
+          fread(cbuf,sizeof(char),n,fp);
+          n = decode_chunk(n,cbuf,buf,maxbuf);
+        } else {
+          if (n > maxbuf) {
+            maxbuf = n;
+            memory->destroy(buf);
+            memory->create(buf,maxbuf,"read_restart:buf");
+          }
+          fread(buf,sizeof(double),n,fp);
         }
-        fread(buf,sizeof(double),n,fp);
 
         m = 0;
         while (m < n) m += avec->unpack_restart(&buf[m]);
@@ -387,12 +411,22 @@ void ReadRestart::command(int narg, char **arg)
           error->one(FLERR,"Invalid flag in peratom section of restart file");
 
         fread(&n,sizeof(int),1,fp);
-        if (n > maxbuf) {
-          maxbuf = n;
-          memory->destroy(buf);
-          memory->create(buf,maxbuf,"read_restart:buf");
+        if (compressflag) {
+          if (n > maxcbuf) {
+            maxcbuf = n;
+            memory->destroy(cbuf);
+            memory->create(cbuf,maxcbuf,"read_restart:cbuf");
+          }
+          fread(cbuf,sizeof(char),n,fp);
+          n = decode_chunk(n,cbuf,buf,maxbuf);
+        } else {
+          if (n > maxbuf) {
+            maxbuf = n;
+            memory->destroy(buf);
+            memory->create(buf,maxbuf,"read_restart:buf");
+          }
+          fread(buf,sizeof(double),n,fp);
         }
-        fread(buf,sizeof(double),n,fp);
 
         if (i % nclusterprocs) {
           iproc = me + (i % nclusterprocs);
@@ -430,6 +464,7 @@ void ReadRestart::command(int narg, char **arg)
 
   delete [] file;
   memory->destroy(buf);
+  memory->destroy(cbuf);
 
   // for multiproc or MPI-IO files:
   // perform irregular comm to migrate atoms to correct procs
@@ -989,6 +1024,9 @@ void ReadRestart::file_layout()
       if (multiproc && multiproc_file == 0)
         error->all(FLERR,"Restart file is a multi-proc file");
 
+    } else if (flag == COMPRESS) {
+      compressflag = read_int();
+
     } else if (flag == MPIIO) {
       int mpiioflag_file = read_int();
       if (mpiioflag == 0 && mpiioflag_file)
@@ -1119,6 +1157,30 @@ int ReadRestart::version_numeric()
   return 0;
 }
 
+/* ----------------------------------------------------------------------
+   decode compressed per-proc chunk of Nbytes in cbuf into buf
+   grow buf as needed, return # of doubles in chunk
+------------------------------------------------------------------------- */
+
+int ReadRestart::decode_chunk(int nbytes, char *cbuf, double *&buf,
+                              int &maxbuf)
+{
+  if (nbytes < (int) sizeof(int))
+    error->one(FLERR,"Invalid compressed peratom data in restart file");
+
+  int n = RestartCodec::count(cbuf);
+  if (n < 0 || RestartCodec::maxbytes(n) < nbytes)
+    error->one(FLERR,"Invalid compressed peratom data in restart file");
+  if (n > maxbuf) {
+    maxbuf = n;
+    memory->destroy(buf);
+    memory->create(buf,maxbuf,"read_restart:buf");
+  }
+  if (RestartCodec::decode(nbytes,cbuf,buf))
+    error->one(FLERR,"Invalid compressed peratom data in restart file");
+  return n;
+}
+
 /* ----------------------------------------------------------------------
    read an int from restart file and bcast it
 ------------------------------------------------------------------------- */
@@ -1194,3 +1256,14 @@ void ReadRestart::read_double_vec(int n, double *vec)
   if (me == 0) fread(vec,sizeof(double),n,fp);
   MPI_Bcast(vec,n,MPI_DOUBLE,0,world);
 }
+
+/* ----------------------------------------------------------------------
+   read vector of N chars from restart file and bcast them
+------------------------------------------------------------------------- */
+
+void ReadRestart::read_char_vec(int n, char *vec)
+{
+  if (n < 0) error->all(FLERR,"Illegal size char vector read requested");
+  if (me == 0) fread(vec,sizeof(char),n,fp);
+  MPI_Bcast(vec,n,MPI_CHAR,0,world);
+}
@@ -36,6 +36,7 @@ class ReadRestart : protected Pointers {
 
   int multiproc;             // 0 = proc 0 writes for all
                              // else # of procs writing files
+  int compressflag;          // 1 if per-atom data is compressed
 
   // MPI-IO values
 
@@ -53,6 +54,7 @@ class ReadRestart : protected Pointers {
   void endian();
   int version_numeric();
   void file_layout();
+  int decode_chunk(int, char *, double *&, int &);
 
   int read_int();
   bigint read_bigint();
@@ -60,6 +62,7 @@ class ReadRestart : protected Pointers {
   char *read_string();
   void read_int_vec(int, int *);
   void read_double_vec(int, double *);
+  void read_char_vec(int, char *);
 };
 
 }
@@ -232,4 +235,13 @@ E: Illegal size double vector read requested
 
 This error should not normally occur unless the restart file is invalid.
 
+E: Illegal size char vector read requested
+
+This error should not normally occur unless the restart file is invalid.
+
+E: Invalid compressed peratom data in restart file
+
+The compressed per-atom data of a restart file written with the
+compress option could not be decoded.  The file is probably corrupt.
+
 */
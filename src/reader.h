@@ -36,6 +36,12 @@ class Reader : protected Pointers {
   virtual void open_file(const char *);
   virtual void close_file();
 
+  // optional interface for readers where every proc can read the file
+
+  int parallel;            // 1 if all procs can read atoms of a snapshot
+  virtual void setup_parallel(const char *, int) {}
+  virtual void read_atoms_range(bigint, int, int, double **) {}
+
  protected:
   FILE *fp;                // pointer to opened file or pipe
   int compressed;          // flag for dump file compression
@@ -0,0 +1,384 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+// lmptype.h must be first b/c this file includes mpi.h
+
+#include "lmptype.h"
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include "reader_binary.h"
+#include "comm.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+#define CHUNK 1024          // # of rows read from file at a time
+#define DELTA 1024
+
+// indexed binary file format, also in dump_custom.cpp
+
+#define LMPBIN_MAGIC "LAMMPS BINDUMP\0\0"
+#define LMPBIN_MAGIC_LEN 16
+#define LMPBIN_REVISION 1
+#define LMPBIN_FOOTER "LMPINDEX"
+#define LMPBIN_FOOTER_LEN 8
+
+/* ----------------------------------------------------------------------
+   64-bit safe seek and tell, file offsets can exceed 2 GB
+------------------------------------------------------------------------- */
+
+static int seek_file(FILE *fp, bigint offset, int whence = SEEK_SET)
+{
+#if defined(_WIN32)
+  return _fseeki64(fp,offset,whence);
+#else
+  return fseeko(fp,(off_t) offset,whence);
+#endif
+}
+
+static bigint tell_file(FILE *fp)
+{
+#if defined(_WIN32)
+  return _ftelli64(fp);
+#else
+  return ftello(fp);
+#endif
+}
+
+/* ---------------------------------------------------------------------- */
+
+ReaderBinary::ReaderBinary(LAMMPS *lmp) : ReaderNative(lmp)
+{
+  parallel = 1;
+
+  nframe = maxframe = 0;
+  framestep = frameoffset = NULL;
+  ncurrent = iframe = 0;
+
+  size_one = 0;
+  data_offset = nread = 0;
+  maxbuf = 0;
+  buf = NULL;
+
+  pfp = NULL;
+  pfile = NULL;
+}
+
+/* ---------------------------------------------------------------------- */
+
+ReaderBinary::~ReaderBinary()
+{
+  memory->destroy(framestep);
+  memory->destroy(frameoffset);
+  memory->destroy(buf);
+  if (pfp) fclose(pfp);
+  delete [] pfile;
+}
+
+/* ----------------------------------------------------------------------
+   open file, check its file header, and load its frame index
+   frame index is read from end of file if it was closed normally,
+     else built by hopping from one snapshot header to the next
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderBinary::open_file(const char *file)
+{
+  char str[1024];
+
+  if (fp != NULL) close_file();
+
+  compressed = 0;
+  fp = fopen(file,"rb");
+  if (fp == NULL) {
+    snprintf(str,1024,"Cannot open file %s",file);
+    error->one(FLERR,str);
+  }
+
+  char magic[LMPBIN_MAGIC_LEN];
+  int endian,revision;
+  if (fread(magic,sizeof(char),LMPBIN_MAGIC_LEN,fp) != LMPBIN_MAGIC_LEN ||
+      memcmp(magic,LMPBIN_MAGIC,LMPBIN_MAGIC_LEN) != 0 ||
+      fread(&endian,sizeof(int),1,fp) != 1 ||
+      fread(&revision,sizeof(int),1,fp) != 1) {
+    snprintf(str,1024,
+             "Dump file %s is not a LAMMPS indexed binary dump file",file);
+    error->one(FLERR,str);
+  }
+  if (endian != 1) {
+    snprintf(str,1024,"Dump file %s was written on a machine with "
+             "different byte order",file);
+    error->one(FLERR,str);
+  }
+  if (revision != LMPBIN_REVISION)
+    error->one(FLERR,"Dump file is incorrectly formatted");
+
+  seek_file(fp,0,SEEK_END);
+  bigint filesize = tell_file(fp);
+
+  nframe = 0;
+  ncurrent = 0;
+  if (!read_index(filesize)) scan_frames(file,filesize);
+}
+
+/* ----------------------------------------------------------------------
+   read frame index stored at end of file
+   return 1 if success, 0 if file has no valid index
+------------------------------------------------------------------------- */
+
+int ReaderBinary::read_index(bigint filesize)
+{
+  bigint start = LMPBIN_MAGIC_LEN*sizeof(char) + 2*sizeof(int);
+  bigint footer = sizeof(bigint) + LMPBIN_FOOTER_LEN*sizeof(char);
+  if (filesize < start + footer) return 0;
+
+  bigint n;
+  char tag[LMPBIN_FOOTER_LEN];
+  seek_file(fp,filesize-footer);
+  if (fread(&n,sizeof(bigint),1,fp) != 1) return 0;
+  if (fread(tag,sizeof(char),LMPBIN_FOOTER_LEN,fp) != LMPBIN_FOOTER_LEN)
+    return 0;
+  if (memcmp(tag,LMPBIN_FOOTER,LMPBIN_FOOTER_LEN) != 0) return 0;
+  if (n <= 0 || n > MAXSMALLINT) return 0;
+
+  bigint indexstart = filesize - footer - 2*n*sizeof(bigint);
+  if (indexstart < start) return 0;
+
+  if (n > maxframe) {
+    maxframe = n;
+    memory->grow(framestep,maxframe,"read_dump:framestep");
+    memory->grow(frameoffset,maxframe,"read_dump:frameoffset");
+  }
+
+  seek_file(fp,indexstart);
+  if (fread(framestep,sizeof(bigint),n,fp) != (size_t) n) return 0;
+  if (fread(frameoffset,sizeof(bigint),n,fp) != (size_t) n) return 0;
+
+  for (int i = 0; i < n; i++)
+    if (frameoffset[i] < start || frameoffset[i] >= indexstart) return 0;
+
+  nframe = n;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   build frame index by hopping from one snapshot header to the next
+   each snapshot begins with its size in bytes and its timestep
+   stop at a snapshot that extends beyond end of file
+------------------------------------------------------------------------- */
+
+void ReaderBinary::scan_frames(const char *file, bigint filesize)
+{
+  bigint offset = LMPBIN_MAGIC_LEN*sizeof(char) + 2*sizeof(int);
+  bigint header[2];
+
+  nframe = 0;
+  while (offset + (bigint) (2*sizeof(bigint)) <= filesize) {
+    seek_file(fp,offset);
+    if (fread(header,sizeof(bigint),2,fp) != 2) break;
+    if (header[0] <= 0 || offset + header[0] > filesize) break;
+
+    if (nframe == maxframe) {
+      maxframe += DELTA;
+      memory->grow(framestep,maxframe,"read_dump:framestep");
+      memory->grow(frameoffset,maxframe,"read_dump:frameoffset");
+    }
+    framestep[nframe] = header[1];
+    frameoffset[nframe] = offset;
+    nframe++;
+    offset += header[0];
+  }
+
+  if (offset != filesize) {
+    char str[1024];
+    snprintf(str,1024,
+             "Dump file %s ends with an incomplete snapshot, which is ignored",
+             file);
+    error->warning(FLERR,str);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return time stamp of next snapshot from frame index
+   if no more snapshots, return 1 so caller can open next file
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+int ReaderBinary::read_time(bigint &ntimestep)
+{
+  if (ncurrent >= nframe) return 1;
+  iframe = ncurrent++;
+  ntimestep = framestep[iframe];
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   skip snapshot from timestamp onward
+   nothing to do, next read_time() moves to next snapshot in frame index
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderBinary::skip() {}
+
+/* ----------------------------------------------------------------------
+   read header of snapshot returned by last read_time()
+   same return values and field matching as ReaderNative::read_header()
+   column labels are stored in every snapshot header
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bigint ReaderBinary::read_header(double box[3][3], int &triclinic,
+                                 int fieldinfo, int nfield,
+                                 int *fieldtype, char **fieldlabel,
+                                 int scaleflag, int wrapflag, int &fieldflag,
+                                 int &xflag, int &yflag, int &zflag)
+{
+  bigint header[3];
+  int boundary[6];
+  int nchar;
+
+  seek_file(fp,frameoffset[iframe]);
+  if (fread(header,sizeof(bigint),3,fp) != 3 ||
+      fread(&triclinic,sizeof(int),1,fp) != 1 ||
+      fread(boundary,sizeof(int),6,fp) != 6 ||
+      fread(&box[0][0],sizeof(double),9,fp) != 9 ||
+      fread(&size_one,sizeof(int),1,fp) != 1 ||
+      fread(&nchar,sizeof(int),1,fp) != 1)
+    error->one(FLERR,"Unexpected end of dump file");
+  if (size_one <= 0 || nchar <= 0)
+    error->one(FLERR,"Dump file is incorrectly formatted");
+
+  char *columns = new char[nchar];
+  if (fread(columns,sizeof(char),nchar,fp) != (size_t) nchar)
+    error->one(FLERR,"Unexpected end of dump file");
+  columns[nchar-1] = '\0';
+
+  bigint natoms = header[2];
+  data_offset = frameoffset[iframe] + 3*sizeof(bigint) + 9*sizeof(int) +
+    9*sizeof(double) + nchar*sizeof(char);
+  nread = 0;
+
+  if (fieldinfo &&
+      match_fields(columns,nfield,fieldtype,fieldlabel,scaleflag,wrapflag,
+                   fieldflag,xflag,yflag,zflag))
+    error->one(FLERR,"Dump file is incorrectly formatted");
+  delete [] columns;
+
+  // columns must match those the fields were matched to
+
+  if (fieldindex && nwords != size_one)
+    error->one(FLERR,"Dump file is incorrectly formatted");
+
+  if (size_one*CHUNK > maxbuf) {
+    maxbuf = size_one*CHUNK;
+    memory->destroy(buf);
+    memory->create(buf,maxbuf,"read_dump:buf");
+  }
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   read next N atoms of snapshot
+   stores appropriate values in fields array
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+void ReaderBinary::read_atoms(int n, int nfield, double **fields)
+{
+  read_rows(fp,nread,n,nfield,fields);
+  nread += n;
+}
+
+/* ----------------------------------------------------------------------
+   make current snapshot readable by all procs
+   bcast location and layout of snapshot atoms from proc 0,
+     other procs open file themselves
+   called by all procs after read_header()
+------------------------------------------------------------------------- */
+
+void ReaderBinary::setup_parallel(const char *file, int nfield)
+{
+  MPI_Bcast(&size_one,1,MPI_INT,0,world);
+  MPI_Bcast(&data_offset,1,MPI_LMP_BIGINT,0,world);
+  if (fieldindex == NULL)
+    memory->create(fieldindex,nfield,"read_dump:fieldindex");
+  MPI_Bcast(fieldindex,nfield,MPI_INT,0,world);
+
+  if (size_one*CHUNK > maxbuf) {
+    maxbuf = size_one*CHUNK;
+    memory->destroy(buf);
+    memory->create(buf,maxbuf,"read_dump:buf");
+  }
+
+  if (comm->me == 0) return;
+  if (pfile && strcmp(pfile,file) == 0) return;
+
+  if (pfp) fclose(pfp);
+  delete [] pfile;
+  pfp = fopen(file,"rb");
+  if (pfp == NULL) {
+    char str[1024];
+    snprintf(str,1024,"Cannot open file %s",file);
+    error->one(FLERR,str);
+  }
+  int n = strlen(file) + 1;
+  pfile = new char[n];
+  strcpy(pfile,file);
+}
+
+/* ----------------------------------------------------------------------
+   read N atoms of snapshot starting at atom First
+   stores appropriate values in fields array
+   called by any proc after setup_parallel()
+------------------------------------------------------------------------- */
+
+void ReaderBinary::read_atoms_range(bigint first, int n, int nfield,
+                                    double **fields)
+{
+  if (comm->me == 0) read_rows(fp,first,n,nfield,fields);
+  else read_rows(pfp,first,n,nfield,fields);
+}
+
+/* ----------------------------------------------------------------------
+   read N rows of snapshot starting at row First from file fpread
+   rows are read in chunks, selected columns are copied to fields
+------------------------------------------------------------------------- */
+
+void ReaderBinary::read_rows(FILE *fpread, bigint first, int n, int nfield,
+                             double **fields)
+{
+  int i,j,m,nchunk;
+  double *row;
+
+  if (n <= 0) return;
+  if (seek_file(fpread,data_offset + first*size_one*sizeof(double)))
+    error->one(FLERR,"Unexpected end of dump file");
+
+  m = 0;
+  while (m < n) {
+    nchunk = MIN(n-m,CHUNK);
+    if (fread(buf,sizeof(double),(size_t) nchunk*size_one,fpread) !=
+        (size_t) nchunk*size_one)
+      error->one(FLERR,"Unexpected end of dump file");
+    for (i = 0; i < nchunk; i++) {
+      row = &buf[i*size_one];
+      for (j = 0; j < nfield; j++)
+        fields[m+i][j] = row[fieldindex[j]];
+    }
+    m += nchunk;
+  }
+}
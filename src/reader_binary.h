@@ -0,0 +1,103 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef READER_CLASS
+
+ReaderStyle(binary,ReaderBinary)
+
+#else
+
+#ifndef LMP_READER_BINARY_H
+#define LMP_READER_BINARY_H
+
+#include "reader_native.h"
+
+namespace LAMMPS_NS {
+
+class ReaderBinary : public ReaderNative {
+ public:
+  ReaderBinary(class LAMMPS *);
+  ~ReaderBinary();
+
+  int read_time(bigint &);
+  void skip();
+  bigint read_header(double [3][3], int &, int, int, int *, char **,
+                     int, int, int &, int &, int &, int &);
+  void read_atoms(int, int, double **);
+
+  void open_file(const char *);
+
+  void setup_parallel(const char *, int);
+  void read_atoms_range(bigint, int, int, double **);
+
+ private:
+  int nframe,maxframe;     // # of snapshots in frame index of current file
+  bigint *framestep;       // timestep of each snapshot
+  bigint *frameoffset;     // byte offset of each snapshot in file
+  int ncurrent;            // index of next snapshot to read
+  int iframe;              // index of snapshot returned by read_time()
+
+  int size_one;            // # of per-atom values in current snapshot
+  bigint data_offset;      // byte offset of per-atom data of snapshot
+  bigint nread;            // # of atoms read from snapshot so far
+
+  int maxbuf;              // size of buf
+  double *buf;             // rows of per-atom values read from file
+
+  FILE *pfp;               // file opened by procs other than proc 0
+  char *pfile;             // name of file opened as pfp
+
+  int read_index(bigint);
+  void scan_frames(const char *, bigint);
+  void read_rows(FILE *, bigint, int, int, double **);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Cannot open file %s
+
+The specified file cannot be opened.  Check that the path and name are
+correct.
+
+E: Dump file %s is not a LAMMPS indexed binary dump file
+
+The file does not start with the header written by dump custom for
+a file with the *.lmpbin suffix.
+
+E: Dump file %s was written on a machine with different byte order
+
+Indexed binary dump files store values in the native byte order of
+the machine that wrote them and cannot be read on a machine with
+different endianness.
+
+E: Dump file is incorrectly formatted
+
+Self-explanatory.
+
+E: Unexpected end of dump file
+
+A read operation from the file failed.
+
+W: Dump file %s ends with an incomplete snapshot, which is ignored
+
+The file has no frame index because it was not closed normally,
+e.g. the run that wrote it was interrupted.  Snapshots are located by
+scanning the file instead, and the partially written last one is
+skipped.
+
+*/
@@ -137,7 +137,28 @@ bigint ReaderNative::read_header(double box[3][3], int &triclinic,
   // exatract column labels and match to requested fields
 
   char *labelline = &line[strlen("ITEM: ATOMS ")];
+  if (match_fields(labelline,nfield,fieldtype,fieldlabel,scaleflag,wrapflag,
+                   fieldflag,xflag,yflag,zflag)) return 1;
 
+  // create internal vector of word ptrs for future parsing of per-atom lines
+
+  words = new char*[nwords];
+
+  return natoms;
+}
+
+/* ----------------------------------------------------------------------
+   match Nfield requested fields to per-atom column labels in labelline
+   sets nwords, fieldindex, fieldflag and xyz flags as in read_header()
+   labelline is modified by tokenizing it
+   return 0 if success, 1 if labelline is malformed
+------------------------------------------------------------------------- */
+
+int ReaderNative::match_fields(char *labelline, int nfield,
+                               int *fieldtype, char **fieldlabel,
+                               int scaleflag, int wrapflag, int &fieldflag,
+                               int &xflag, int &yflag, int &zflag)
+{
   nwords = atom->count_words(labelline);
   char **labels = new char*[nwords];
   labels[0] = strtok(labelline," \t\n\r\f");
@@ -158,6 +179,7 @@ bigint ReaderNative::read_header(double box[3][3], int &triclinic,
   // else infer one or more column matches from fieldtype
   // xyz flag set by scaleflag + wrapflag (if fieldlabel set) or column label
 
+  memory->destroy(fieldindex);
   memory->create(fieldindex,nfield,"read_dump:fieldindex");
 
   int s_index,u_index,su_index;
@@ -280,11 +302,7 @@ bigint ReaderNative::read_header(double box[3][3], int &triclinic,
   for (int i = 0; i < nfield; i++)
     if (fieldindex[i] < 0) fieldflag = -1;
 
-  // create internal vector of word ptrs for future parsing of per-atom lines
-
-  words = new char*[nwords];
-
-  return natoms;
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -37,13 +37,15 @@ class ReaderNative : public Reader {
                      int, int, int &, int &, int &, int &);
   void read_atoms(int, int, double **);
 
-private:
+protected:
   char *line;              // line read from dump file
 
   int nwords;              // # of per-atom columns in dump file
   char **words;            // ptrs to values in parsed per-atom line
-  int *fieldindex;         //
+  int *fieldindex;         // which column each requested field maps to
 
+  int match_fields(char *, int, int *, char **, int, int,
+                   int &, int &, int &, int &);
   int find_label(const char *, int, char **);
   void read_lines(int);
 };
@@ -0,0 +1,139 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <string.h>
+#include "restart_codec.h"
+
+using namespace LAMMPS_NS;
+
+/* ----------------------------------------------------------------------
+   stream layout:
+     int = # of encoded doubles N
+     groups of 2 values: 1 control byte with 2 4-bit codes,
+       then the non-zero low-order bytes of each value, high byte first
+   per-atom data is a sequence of records, 1st value = record length
+   value K is predicted by value K-L, L = length of previous record,
+     so the same field of the previous atom, 0.0 for the 1st record
+------------------------------------------------------------------------- */
+
+static inline uint64_t dbits(double value)
+{
+  uint64_t bits;
+  memcpy(&bits,&value,sizeof(uint64_t));
+  return bits;
+}
+
+/* ----------------------------------------------------------------------
+   length of record starting at value K, clamped to remaining N-K values
+------------------------------------------------------------------------- */
+
+static inline int reclength(double value, int k, int n)
+{
+  if (value >= 1.0 && value <= n-k) return static_cast<int> (value);
+  return n-k;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int RestartCodec::maxbytes(int n)
+{
+  return sizeof(int) + 8*n + (n+1)/2;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int RestartCodec::encode(int n, double *in, char *out)
+{
+  memcpy(out,&n,sizeof(int));
+  unsigned char *ptr = (unsigned char *) out + sizeof(int);
+  unsigned char *ctrl = NULL;
+
+  uint64_t x;
+  int z;
+  int start = 0;
+  int len = 0;
+  int prevlen = 0;
+
+  for (int k = 0; k < n; k++) {
+    if (k == start+len) {
+      prevlen = len;
+      start = k;
+      len = reclength(in[k],k,n);
+    }
+
+    x = dbits(in[k]);
+    if (prevlen) x ^= dbits(in[k-prevlen]);
+
+    z = 0;
+    if (x == 0) z = 8;
+    else while (!(x & (((uint64_t) 0xff) << 56 >> 8*z))) z++;
+
+    if (k % 2 == 0) {
+      ctrl = ptr++;
+      *ctrl = z;
+    } else *ctrl |= z << 4;
+
+    for (int b = 7-z; b >= 0; b--) *ptr++ = (x >> 8*b) & 0xff;
+  }
+
+  return ptr - (unsigned char *) out;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int RestartCodec::count(char *in)
+{
+  int n;
+  memcpy(&n,in,sizeof(int));
+  return n;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int RestartCodec::decode(int nbytes, char *in, double *out)
+{
+  int n = count(in);
+  unsigned char *ptr = (unsigned char *) in + sizeof(int);
+  unsigned char *end = (unsigned char *) in + nbytes;
+  unsigned char *ctrl = NULL;
+
+  uint64_t x;
+  int z;
+  int start = 0;
+  int len = 0;
+  int prevlen = 0;
+
+  for (int k = 0; k < n; k++) {
+    if (k == start+len) {
+      prevlen = len;
+      start = k;
+    }
+
+    if (k % 2 == 0) {
+      if (ptr >= end) return 1;
+      ctrl = ptr++;
+      z = *ctrl & 0xf;
+    } else z = *ctrl >> 4;
+    if (z > 8 || ptr + (8-z) > end) return 1;
+
+    x = 0;
+    for (int b = 7-z; b >= 0; b--) x |= ((uint64_t) *ptr++) << 8*b;
+    if (prevlen) x ^= dbits(out[k-prevlen]);
+    memcpy(&out[k],&x,sizeof(double));
+
+    if (k == start) len = reclength(out[k],k,n);
+  }
+
+  if (ptr != end) return 1;
+  return 0;
+}
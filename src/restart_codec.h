@@ -0,0 +1,48 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_RESTART_CODEC_H
+#define LMP_RESTART_CODEC_H
+
+#include "lmptype.h"
+
+namespace LAMMPS_NS {
+
+// lossless compression of per-atom restart data
+// each value is XORed with the same value of the previous atom record,
+//   leading zero bytes of the result are dropped and their count is
+//   stored in a 4-bit code, two codes per control byte
+// used by WriteRestart and ReadRestart with the compress option
+
+namespace RestartCodec {
+
+  // max # of bytes needed to encode N doubles
+
+  extern int maxbytes(int n);
+
+  // encode N doubles, return # of bytes written to out
+
+  extern int encode(int n, double *in, char *out);
+
+  // # of doubles encoded in stream
+
+  extern int count(char *in);
+
+  // decode stream of Nbytes, return 0 if successful, 1 if corrupt
+
+  extern int decode(int nbytes, char *in, double *out);
+}
+
+}
+
+#endif
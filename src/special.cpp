@@ -27,10 +27,6 @@
 
 using namespace LAMMPS_NS;
 
-// allocate space for static class variable
-
-Special *Special::sptr;
-
 /* ---------------------------------------------------------------------- */
 
 Special::Special(LAMMPS *lmp) : Pointers(lmp)
@@ -39,6 +35,7 @@ Special::Special(LAMMPS *lmp) : Pointers(lmp)
   MPI_Comm_size(world,&nprocs);
 
   onetwo = onethree = onefour = NULL;
+  procowner = NULL;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -58,19 +55,8 @@ Special::~Special()
 
 void Special::build()
 {
-  int i,j,k,size;
-  int max,maxall,nbuf;
-  tagint *buf;
-
   MPI_Barrier(world);
 
-  int nlocal = atom->nlocal;
-
-  tagint *tag = atom->tag;
-  int *num_bond = atom->num_bond;
-  tagint **bond_atom = atom->bond_atom;
-  int **nspecial = atom->nspecial;
-
   if (me == 0 && screen) {
     const double * const special_lj   = force->special_lj;
     const double * const special_coul = force->special_coul;
@@ -83,348 +69,398 @@ void Special::build()
 
   // initialize nspecial counters to 0
 
-  for (i = 0; i < nlocal; i++) {
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
+
+  for (int i = 0; i < nlocal; i++) {
     nspecial[i][0] = 0;
     nspecial[i][1] = 0;
     nspecial[i][2] = 0;
   }
 
-  // -----------------------------------------------------
-  // compute nspecial[i][0] = # of 1-2 neighbors of atom i
-  // -----------------------------------------------------
+  // setup atom ID -> owning proc lookup in rendezvous decomposition
 
-  // bond partners stored by atom itself
+  atom_owners();
 
-  for (i = 0; i < nlocal; i++) nspecial[i][0] = num_bond[i];
-
-  // if newton_bond off, then done
-  // else only counted 1/2 of all bonds, so count other half
+  // tally 1-2 neighbors of each atom and create onetwo lists
+  // if newton_bond off, each atom stores all its bonds
 
-  if (force->newton_bond) {
+  if (force->newton_bond) onetwo_build_newton();
+  else onetwo_build_newton_off();
 
-    // nbufmax = largest buffer needed to hold info from any proc
-    // info for each atom = global tag of 2nd atom in each bond
-
-    nbuf = 0;
-    for (i = 0; i < nlocal; i++) nbuf += num_bond[i];
-    memory->create(buf,nbuf,"special:buf");
+  // done if special_bond weights for 1-3, 1-4 are set to 1.0
 
-    // fill buffer with global tags of bond partners of my atoms
+  if (force->special_lj[2] == 1.0 && force->special_coul[2] == 1.0 &&
+      force->special_lj[3] == 1.0 && force->special_coul[3] == 1.0) {
+    dedup();
+    combine();
+    fix_alteration();
+    delete procowner;
+    return;
+  }
 
-    size = 0;
-    for (i = 0; i < nlocal; i++)
-      for (j = 0; j < num_bond[i]; j++)
-        buf[size++] = bond_atom[i][j];
+  // tally 1-3 neighbors of each atom and create onethree lists
 
-    // cycle buffer around ring of procs back to self
-    // when receive buffer, scan tags for atoms I own
-    // when find one, increment nspecial count for that atom
+  onethree_build();
 
-    sptr = this;
-    comm->ring(size,sizeof(tagint),buf,1,ring_one,NULL);
+  // done if special_bond weights for 1-4 are set to 1.0
 
-    memory->destroy(buf);
+  if (force->special_lj[3] == 1.0 && force->special_coul[3] == 1.0) {
+    dedup();
+    if (force->special_angle) angle_trim();
+    combine();
+    fix_alteration();
+    delete procowner;
+    return;
   }
 
-  // ----------------------------------------------------
-  // create onetwo[i] = list of 1-2 neighbors for atom i
-  // ----------------------------------------------------
+  // tally 1-4 neighbors of each atom and create onefour lists
 
-  max = 0;
-  for (i = 0; i < nlocal; i++) max = MAX(max,nspecial[i][0]);
+  onefour_build();
 
-  MPI_Allreduce(&max,&maxall,1,MPI_INT,MPI_MAX,world);
+  dedup();
+  if (force->special_angle) angle_trim();
+  if (force->special_dihedral) dihedral_trim();
+  combine();
+  fix_alteration();
+  delete procowner;
+}
 
-  if (me == 0) {
-    if (screen) fprintf(screen,"  %d = max # of 1-2 neighbors\n",maxall);
-    if (logfile) fprintf(logfile,"  %d = max # of 1-2 neighbors\n",maxall);
-  }
+/* ----------------------------------------------------------------------
+   setup procowner = map of atom IDs to the procs that own them
+   stored in rendezvous decomposition, atom ID modulo nprocs
+------------------------------------------------------------------------- */
 
-  memory->create(onetwo,nlocal,maxall,"special:onetwo");
+void Special::atom_owners()
+{
+  tagint *tag = atom->tag;
+  int nlocal = atom->nlocal;
 
-  // count = accumulating counter
+  int *proclist;
+  memory->create(proclist,nlocal,"special:proclist");
+  IDRvous *idbuf = (IDRvous *)
+    memory->smalloc((bigint) nlocal*sizeof(IDRvous),"special:idbuf");
 
-  memory->create(count,nlocal,"special:count");
-  for (i = 0; i < nlocal; i++) count[i] = 0;
+  // setup input buf for rendezvous comm
+  // one datum for each owned atom: datum = owning proc, atomID
+  // owning proc for each datum = atomID % nprocs
 
-  // add bond partners stored by atom to onetwo list
+  for (int i = 0; i < nlocal; i++) {
+    proclist[i] = tag[i] % nprocs;
+    idbuf[i].me = me;
+    idbuf[i].atomID = tag[i];
+  }
 
-  for (i = 0; i < nlocal; i++)
-    for (j = 0; j < num_bond[i]; j++)
-      onetwo[i][count[i]++] = bond_atom[i][j];
+  // perform rendezvous operation
+  // callback stores the lookup table, nothing is returned
 
-  // if newton_bond off, then done
-  // else only stored 1/2 of all bonds, so store other half
+  procowner = NULL;
+  char *buf;
+  comm->rendezvous(nlocal,proclist,(char *) idbuf,sizeof(IDRvous),
+                   rendezvous_ids,buf,0,(void *) this);
 
-  if (force->newton_bond) {
+  memory->destroy(proclist);
+  memory->sfree(idbuf);
+}
 
-    // nbufmax = largest buffer needed to hold info from any proc
-    // info for each atom = 2 global tags in each bond
+/* ----------------------------------------------------------------------
+   pass list of (atom ID, partner ID) pairs to the procs that own atom ID
+   via rendezvous decomposition, datums for unknown atom IDs are dropped
+   return # of pairs received, caller must free outbuf
+------------------------------------------------------------------------- */
 
-    nbuf = 0;
-    for (i = 0; i < nlocal; i++) nbuf += 2*num_bond[i];
-    memory->create(buf,nbuf,"special:buf");
+int Special::send_pairs(int nsend, PairRvous *inbuf, PairRvous *&outbuf)
+{
+  int *proclist;
+  memory->create(proclist,nsend,"special:proclist");
 
-    // fill buffer with global tags of both atoms in bond
+  for (int i = 0; i < nsend; i++) proclist[i] = inbuf[i].atomID % nprocs;
 
-    size = 0;
-    for (i = 0; i < nlocal; i++)
-      for (j = 0; j < num_bond[i]; j++) {
-        buf[size++] = tag[i];
-        buf[size++] = bond_atom[i][j];
-      }
+  char *buf;
+  int nreturn = comm->rendezvous(nsend,proclist,(char *) inbuf,
+                                 sizeof(PairRvous),rendezvous_pairs,
+                                 buf,sizeof(PairRvous),(void *) this);
+  outbuf = (PairRvous *) buf;
 
-    // cycle buffer around ring of procs back to self
-    // when receive buffer, scan 2nd-atom tags for atoms I own
-    // when find one, add 1st-atom tag to onetwo list for 2nd atom
+  memory->destroy(proclist);
+  return nreturn;
+}
 
-    sptr = this;
-    comm->ring(size,sizeof(tagint),buf,2,ring_two,NULL);
+/* ----------------------------------------------------------------------
+   onetwo build when newton_bond flag on
+   uses rendezvous comm to tell the other atom of each bond
+     about the atom that stores the bond
+------------------------------------------------------------------------- */
 
-    memory->destroy(buf);
-  }
+void Special::onetwo_build_newton()
+{
+  int i,j,m;
 
-  memory->destroy(count);
+  tagint *tag = atom->tag;
+  int *num_bond = atom->num_bond;
+  tagint **bond_atom = atom->bond_atom;
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
 
-  // -----------------------------------------------------
-  // done if special_bond weights for 1-3, 1-4 are set to 1.0
-  // -----------------------------------------------------
+  // nsend = # of my datums to send
 
-  if (force->special_lj[2] == 1.0 && force->special_coul[2] == 1.0 &&
-      force->special_lj[3] == 1.0 && force->special_coul[3] == 1.0) {
-    dedup();
-    combine();
-    fix_alteration();
-    return;
-  }
+  int nsend = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < num_bond[i]; j++) {
+      m = atom->map(bond_atom[i][j]);
+      if (m < 0 || m >= nlocal) nsend++;
+    }
 
-  // -----------------------------------------------------
-  // compute nspecial[i][1] = # of 1-3 neighbors of atom i
-  // -----------------------------------------------------
+  PairRvous *inbuf = (PairRvous *)
+    memory->smalloc((bigint) nsend*sizeof(PairRvous),"special:inbuf");
 
-  // nbufmax = largest buffer needed to hold info from any proc
-  // info for each atom = 2 scalars + list of 1-2 neighbors
+  // one datum for each unowned bond partner: bond partner ID, atomID
 
-  nbuf = 0;
-  for (i = 0; i < nlocal; i++) nbuf += 2 + nspecial[i][0];
-  memory->create(buf,nbuf,"special:buf");
+  nsend = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < num_bond[i]; j++) {
+      m = atom->map(bond_atom[i][j]);
+      if (m >= 0 && m < nlocal) continue;
+      inbuf[nsend].atomID = bond_atom[i][j];
+      inbuf[nsend].partnerID = tag[i];
+      nsend++;
+    }
 
-  // fill buffer with:
-  // (1) = counter for 1-3 neighbors, initialized to 0
-  // (2) = # of 1-2 neighbors
-  // (3:N) = list of 1-2 neighbors
+  PairRvous *outbuf;
+  int nreturn = send_pairs(nsend,inbuf,outbuf);
+  memory->sfree(inbuf);
 
-  size = 0;
-  for (i = 0; i < nlocal; i++) {
-    buf[size++] = 0;
-    buf[size++] = nspecial[i][0];
-    for (j = 0; j < nspecial[i][0]; j++) buf[size++] = onetwo[i][j];
-  }
+  // nspecial[i][0] = # of 1-2 neighbors of atom i
+  // bond partners stored by atom itself,
+  //   plus owned atoms that store a bond with it,
+  //   plus returned datums from unowned atoms that store a bond with it
 
-  // cycle buffer around ring of procs back to self
-  // when receive buffer, scan list of 1-2 neighbors for atoms I own
-  // when find one, increment 1-3 count by # of 1-2 neighbors of my atom,
-  //   subtracting one since my list will contain original atom
+  for (i = 0; i < nlocal; i++) nspecial[i][0] = num_bond[i];
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < num_bond[i]; j++) {
+      m = atom->map(bond_atom[i][j]);
+      if (m >= 0 && m < nlocal) nspecial[m][0]++;
+    }
+  for (m = 0; m < nreturn; m++) nspecial[atom->map(outbuf[m].atomID)][0]++;
 
-  sptr = this;
-  comm->ring(size,sizeof(tagint),buf,3,ring_three,buf);
+  // create onetwo[i] = list of 1-2 neighbors for atom i
 
-  // extract count from buffer that has cycled back to me
-  // nspecial[i][1] = # of 1-3 neighbors of atom i
+  int maxall = max_count(0,"1-2");
+  memory->create(onetwo,nlocal,maxall,"special:onetwo");
 
-  j = 0;
   for (i = 0; i < nlocal; i++) {
-    nspecial[i][1] = buf[j];
-    j += 2 + nspecial[i][0];
+    nspecial[i][0] = 0;
+    for (j = 0; j < num_bond[i]; j++)
+      onetwo[i][nspecial[i][0]++] = bond_atom[i][j];
+  }
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < num_bond[i]; j++) {
+      m = atom->map(bond_atom[i][j]);
+      if (m >= 0 && m < nlocal) onetwo[m][nspecial[m][0]++] = tag[i];
+    }
+  for (m = 0; m < nreturn; m++) {
+    i = atom->map(outbuf[m].atomID);
+    onetwo[i][nspecial[i][0]++] = outbuf[m].partnerID;
   }
 
-  memory->destroy(buf);
+  memory->sfree(outbuf);
+}
 
-  // ----------------------------------------------------
-  // create onethree[i] = list of 1-3 neighbors for atom i
-  // ----------------------------------------------------
+/* ----------------------------------------------------------------------
+   onetwo build when newton_bond flag off
+   no comm needed b/c onetwo = all bond partners stored by each atom
+------------------------------------------------------------------------- */
 
-  max = 0;
-  for (i = 0; i < nlocal; i++) max = MAX(max,nspecial[i][1]);
-  MPI_Allreduce(&max,&maxall,1,MPI_INT,MPI_MAX,world);
+void Special::onetwo_build_newton_off()
+{
+  int i,j;
 
-  if (me == 0) {
-    if (screen) fprintf(screen,"  %d = max # of 1-3 neighbors\n",maxall);
-    if (logfile) fprintf(logfile,"  %d = max # of 1-3 neighbors\n",maxall);
-  }
+  int *num_bond = atom->num_bond;
+  tagint **bond_atom = atom->bond_atom;
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
 
-  memory->create(onethree,nlocal,maxall,"special:onethree");
+  for (i = 0; i < nlocal; i++) nspecial[i][0] = num_bond[i];
 
-  // nbufmax = largest buffer needed to hold info from any proc
-  // info for each atom = 4 scalars + list of 1-2 neighs + list of 1-3 neighs
+  int maxall = max_count(0,"1-2");
+  memory->create(onetwo,nlocal,maxall,"special:onetwo");
 
-  nbuf = 0;
-  for (i = 0; i < nlocal; i++) nbuf += 4 + nspecial[i][0] + nspecial[i][1];
-  memory->create(buf,nbuf,"special:buf");
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < num_bond[i]; j++)
+      onetwo[i][j] = bond_atom[i][j];
+}
 
-  // fill buffer with:
-  // (1) = global tag of original atom
-  // (2) = # of 1-2 neighbors
-  // (3) = # of 1-3 neighbors
-  // (4) = counter for 1-3 neighbors, initialized to 0
-  // (5:N) = list of 1-2 neighbors
-  // (N+1:2N) space for list of 1-3 neighbors
+/* ----------------------------------------------------------------------
+   onethree build
+   each atom tells each of its 1-2 neighbors about its other 1-2 neighbors
+   uses rendezvous comm for 1-2 neighbors it does not own
+   may include duplicates and original atom but they will be culled later
+------------------------------------------------------------------------- */
 
-  size = 0;
-  for (i = 0; i < nlocal; i++) {
-    buf[size++] = tag[i];
-    buf[size++] = nspecial[i][0];
-    buf[size++] = nspecial[i][1];
-    buf[size++] = 0;
-    for (j = 0; j < nspecial[i][0]; j++) buf[size++] = onetwo[i][j];
-    size += nspecial[i][1];
-  }
+void Special::onethree_build()
+{
+  int i,j,k,m;
 
-  // cycle buffer around ring of procs back to self
-  // when receive buffer, scan list of 1-2 neighbors for atoms I own
-  // when find one, add its neighbors to 1-3 list
-  //   increment the count in buf(i+4)
-  //   exclude the atom whose tag = original
-  //   this process may include duplicates but they will be culled later
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
 
-  sptr = this;
-  comm->ring(size,sizeof(tagint),buf,4,ring_four,buf);
+  // nsend = # of my datums to send
 
-  // fill onethree with buffer values that have been returned to me
-  // sanity check: accumulated buf[i+3] count should equal
-  //   nspecial[i][1] for each atom
+  int nsend = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < nspecial[i][0]; j++) {
+      m = atom->map(onetwo[i][j]);
+      if (m < 0 || m >= nlocal) nsend += nspecial[i][0]-1;
+    }
 
-  j = 0;
-  for (i = 0; i < nlocal; i++) {
-    if (buf[j+3] != nspecial[i][1])
-      error->one(FLERR,"1-3 bond count is inconsistent");
-    j += 4 + nspecial[i][0];
-    for (k = 0; k < nspecial[i][1]; k++)
-      onethree[i][k] = buf[j++];
-  }
+  PairRvous *inbuf = (PairRvous *)
+    memory->smalloc((bigint) nsend*sizeof(PairRvous),"special:inbuf");
 
-  memory->destroy(buf);
+  // datums = pairs of unowned 1-2 neighbor J and other 1-2 neighbors K
 
-  // done if special_bond weights for 1-4 are set to 1.0
+  nsend = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < nspecial[i][0]; j++) {
+      m = atom->map(onetwo[i][j]);
+      if (m >= 0 && m < nlocal) continue;
+      for (k = 0; k < nspecial[i][0]; k++) {
+        if (j == k) continue;
+        inbuf[nsend].atomID = onetwo[i][j];
+        inbuf[nsend].partnerID = onetwo[i][k];
+        nsend++;
+      }
+    }
 
-  if (force->special_lj[3] == 1.0 && force->special_coul[3] == 1.0) {
-    dedup();
-    if (force->special_angle) angle_trim();
-    combine();
-    fix_alteration();
-    return;
-  }
+  PairRvous *outbuf;
+  int nreturn = send_pairs(nsend,inbuf,outbuf);
+  memory->sfree(inbuf);
 
-  // -----------------------------------------------------
-  // compute nspecial[i][2] = # of 1-4 neighbors of atom i
-  // -----------------------------------------------------
+  // nspecial[i][1] = # of 1-3 neighbors of atom i
 
-  // nbufmax = largest buffer needed to hold info from any proc
-  // info for each atom = 2 scalars + list of 1-3 neighbors
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < nspecial[i][0]; j++) {
+      m = atom->map(onetwo[i][j]);
+      if (m >= 0 && m < nlocal) nspecial[m][1] += nspecial[i][0]-1;
+    }
+  for (m = 0; m < nreturn; m++) nspecial[atom->map(outbuf[m].atomID)][1]++;
 
-  nbuf = 0;
-  for (i = 0; i < nlocal; i++) nbuf += 2 + nspecial[i][1];
-  memory->create(buf,nbuf,"special:buf");
+  // create onethree[i] = list of 1-3 neighbors for atom i
 
-  // fill buffer with:
-  // (1) = counter for 1-4 neighbors, initialized to 0
-  // (2) = # of 1-3 neighbors
-  // (3:N) = list of 1-3 neighbors
+  int maxall = max_count(1,"1-3");
+  memory->create(onethree,nlocal,maxall,"special:onethree");
 
-  size = 0;
-  for (i = 0; i < nlocal; i++) {
-    buf[size++] = 0;
-    buf[size++] = nspecial[i][1];
-    for (j = 0; j < nspecial[i][1]; j++) buf[size++] = onethree[i][j];
+  for (i = 0; i < nlocal; i++) nspecial[i][1] = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < nspecial[i][0]; j++) {
+      m = atom->map(onetwo[i][j]);
+      if (m < 0 || m >= nlocal) continue;
+      for (k = 0; k < nspecial[i][0]; k++) {
+        if (j == k) continue;
+        onethree[m][nspecial[m][1]++] = onetwo[i][k];
+      }
+    }
+  for (m = 0; m < nreturn; m++) {
+    i = atom->map(outbuf[m].atomID);
+    onethree[i][nspecial[i][1]++] = outbuf[m].partnerID;
   }
 
-  // cycle buffer around ring of procs back to self
-  // when receive buffer, scan list of 1-3 neighbors for atoms I own
-  // when find one, increment 1-4 count by # of 1-2 neighbors of my atom
-  //   may include duplicates and original atom but they will be culled later
+  memory->sfree(outbuf);
+}
 
-  sptr = this;
-  comm->ring(size,sizeof(tagint),buf,5,ring_five,buf);
+/* ----------------------------------------------------------------------
+   onefour build
+   each atom tells each of its 1-3 neighbors about its 1-2 neighbors
+   uses rendezvous comm for 1-3 neighbors it does not own
+   may include duplicates and original atom but they will be culled later
+------------------------------------------------------------------------- */
 
-  // extract count from buffer that has cycled back to me
-  // nspecial[i][2] = # of 1-4 neighbors of atom i
+void Special::onefour_build()
+{
+  int i,j,k,m;
 
-  j = 0;
-  for (i = 0; i < nlocal; i++) {
-    nspecial[i][2] = buf[j];
-    j += 2 + nspecial[i][1];
-  }
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
 
-  memory->destroy(buf);
+  // nsend = # of my datums to send
 
-  // ----------------------------------------------------
-  // create onefour[i] = list of 1-4 neighbors for atom i
-  // ----------------------------------------------------
+  int nsend = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < nspecial[i][1]; j++) {
+      m = atom->map(onethree[i][j]);
+      if (m < 0 || m >= nlocal) nsend += nspecial[i][0];
+    }
 
-  max = 0;
-  for (i = 0; i < nlocal; i++) max = MAX(max,nspecial[i][2]);
-  MPI_Allreduce(&max,&maxall,1,MPI_INT,MPI_MAX,world);
+  PairRvous *inbuf = (PairRvous *)
+    memory->smalloc((bigint) nsend*sizeof(PairRvous),"special:inbuf");
 
-  if (me == 0) {
-    if (screen) fprintf(screen,"  %d = max # of 1-4 neighbors\n",maxall);
-    if (logfile) fprintf(logfile,"  %d = max # of 1-4 neighbors\n",maxall);
-  }
+  // datums = pairs of unowned 1-3 neighbor J and 1-2 neighbors K
 
-  memory->create(onefour,nlocal,maxall,"special:onefour");
+  nsend = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < nspecial[i][1]; j++) {
+      m = atom->map(onethree[i][j]);
+      if (m >= 0 && m < nlocal) continue;
+      for (k = 0; k < nspecial[i][0]; k++) {
+        inbuf[nsend].atomID = onethree[i][j];
+        inbuf[nsend].partnerID = onetwo[i][k];
+        nsend++;
+      }
+    }
 
-  // nbufmax = largest buffer needed to hold info from any proc
-  // info for each atom = 3 scalars + list of 1-3 neighs + list of 1-4 neighs
+  PairRvous *outbuf;
+  int nreturn = send_pairs(nsend,inbuf,outbuf);
+  memory->sfree(inbuf);
+
+  // nspecial[i][2] = # of 1-4 neighbors of atom i
 
-  nbuf = 0;
   for (i = 0; i < nlocal; i++)
-    nbuf += 3 + nspecial[i][1] + nspecial[i][2];
-  memory->create(buf,nbuf,"special:buf");
+    for (j = 0; j < nspecial[i][1]; j++) {
+      m = atom->map(onethree[i][j]);
+      if (m >= 0 && m < nlocal) nspecial[m][2] += nspecial[i][0];
+    }
+  for (m = 0; m < nreturn; m++) nspecial[atom->map(outbuf[m].atomID)][2]++;
 
-  // fill buffer with:
-  // (1) = # of 1-3 neighbors
-  // (2) = # of 1-4 neighbors
-  // (3) = counter for 1-4 neighbors, initialized to 0
-  // (4:N) = list of 1-3 neighbors
-  // (N+1:2N) space for list of 1-4 neighbors
+  // create onefour[i] = list of 1-4 neighbors for atom i
 
-  size = 0;
-  for (i = 0; i < nlocal; i++) {
-    buf[size++] = nspecial[i][1];
-    buf[size++] = nspecial[i][2];
-    buf[size++] = 0;
-    for (j = 0; j < nspecial[i][1]; j++) buf[size++] = onethree[i][j];
-    size += nspecial[i][2];
+  int maxall = max_count(2,"1-4");
+  memory->create(onefour,nlocal,maxall,"special:onefour");
+
+  for (i = 0; i < nlocal; i++) nspecial[i][2] = 0;
+  for (i = 0; i < nlocal; i++)
+    for (j = 0; j < nspecial[i][1]; j++) {
+      m = atom->map(onethree[i][j]);
+      if (m < 0 || m >= nlocal) continue;
+      for (k = 0; k < nspecial[i][0]; k++)
+        onefour[m][nspecial[m][2]++] = onetwo[i][k];
+    }
+  for (m = 0; m < nreturn; m++) {
+    i = atom->map(outbuf[m].atomID);
+    onefour[i][nspecial[i][2]++] = outbuf[m].partnerID;
   }
 
-  // cycle buffer around ring of procs back to self
-  // when receive buffer, scan list of 1-3 neighbors for atoms I own
-  // when find one, add its neighbors to 1-4 list
-  //   incrementing the count in buf(i+4)
-  //   this process may include duplicates but they will be culled later
+  memory->sfree(outbuf);
+}
+
+/* ----------------------------------------------------------------------
+   return max of nspecial[i][which] across all procs, print it
+------------------------------------------------------------------------- */
 
-  sptr = this;
-  comm->ring(size,sizeof(tagint),buf,6,ring_six,buf);
+int Special::max_count(int which, const char *str)
+{
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
 
-  // fill onefour with buffer values that have been returned to me
-  // sanity check: accumulated buf[i+2] count should equal
-  //  nspecial[i][2] for each atom
+  int max = 0;
+  for (int i = 0; i < nlocal; i++) max = MAX(max,nspecial[i][which]);
+  int maxall;
+  MPI_Allreduce(&max,&maxall,1,MPI_INT,MPI_MAX,world);
 
-  j = 0;
-  for (i = 0; i < nlocal; i++) {
-    if (buf[j+2] != nspecial[i][2])
-      error->one(FLERR,"1-4 bond count is inconsistent");
-    j += 3 + nspecial[i][1];
-    for (k = 0; k < nspecial[i][2]; k++)
-      onefour[i][k] = buf[j++];
+  if (me == 0) {
+    if (screen) fprintf(screen,"  %d = max # of %s neighbors\n",maxall,str);
+    if (logfile) fprintf(logfile,"  %d = max # of %s neighbors\n",maxall,str);
   }
 
-  memory->destroy(buf);
-
-  dedup();
-  if (force->special_angle) angle_trim();
-  if (force->special_dihedral) dihedral_trim();
-  combine();
-  fix_alteration();
+  return maxall;
 }
 
 /* ----------------------------------------------------------------------
@@ -708,44 +744,59 @@ void Special::angle_trim()
       for (j = 0; j < n; j++) dflag[i][j] = 0;
     }
 
-    // nbufmax = largest buffer needed to hold info from any proc
-    // info for each atom = list of 1,3 atoms in each angle stored by atom
-    //   and list of 1,3 and 2,4 atoms in each dihedral stored by atom
+    // consider both atoms of each 1,3 pair in each angle stored by atom
+    //   and of the 1,3 and 2,4 pairs in each dihedral stored by atom
+    // flag pairs with an owned 1st atom directly
+    // nsend = # of other pairs, which are sent to owner of their 1st atom
 
-    int nbuf = 0;
-    for (i = 0; i < nlocal; i++) {
-      if (num_angle && atom->nangles) nbuf += 2*num_angle[i];
-      if (num_dihedral && atom->ndihedrals) nbuf += 2*2*num_dihedral[i];
-    }
-    int *buf;
-    memory->create(buf,nbuf,"special:buf");
+    int nsend = 0;
+    if (num_angle && atom->nangles)
+      for (i = 0; i < nlocal; i++)
+        for (j = 0; j < num_angle[i]; j++) {
+          nsend += trim_pair(angle_atom1[i][j],angle_atom3[i][j],1,NULL);
+          nsend += trim_pair(angle_atom3[i][j],angle_atom1[i][j],1,NULL);
+        }
+
+    if (num_dihedral && atom->ndihedrals)
+      for (i = 0; i < nlocal; i++)
+        for (j = 0; j < num_dihedral[i]; j++) {
+          nsend += trim_pair(dihedral_atom1[i][j],dihedral_atom3[i][j],1,NULL);
+          nsend += trim_pair(dihedral_atom3[i][j],dihedral_atom1[i][j],1,NULL);
+          nsend += trim_pair(dihedral_atom2[i][j],dihedral_atom4[i][j],1,NULL);
+          nsend += trim_pair(dihedral_atom4[i][j],dihedral_atom2[i][j],1,NULL);
+        }
+
+    // fill send buffer with pairs whose 1st atom is not owned
 
-    // fill buffer with list of 1,3 atoms in each angle
-    // and with list of 1,3 and 2,4 atoms in each dihedral
+    PairRvous *inbuf = (PairRvous *)
+      memory->smalloc((bigint) nsend*sizeof(PairRvous),"special:inbuf");
 
-    int size = 0;
+    nsend = 0;
     if (num_angle && atom->nangles)
       for (i = 0; i < nlocal; i++)
         for (j = 0; j < num_angle[i]; j++) {
-          buf[size++] = angle_atom1[i][j];
-          buf[size++] = angle_atom3[i][j];
+          trim_pair(angle_atom1[i][j],angle_atom3[i][j],1,inbuf,&nsend);
+          trim_pair(angle_atom3[i][j],angle_atom1[i][j],1,inbuf,&nsend);
         }
 
     if (num_dihedral && atom->ndihedrals)
       for (i = 0; i < nlocal; i++)
         for (j = 0; j < num_dihedral[i]; j++) {
-          buf[size++] = dihedral_atom1[i][j];
-          buf[size++] = dihedral_atom3[i][j];
-          buf[size++] = dihedral_atom2[i][j];
-          buf[size++] = dihedral_atom4[i][j];
+          trim_pair(dihedral_atom1[i][j],dihedral_atom3[i][j],1,inbuf,&nsend);
+          trim_pair(dihedral_atom3[i][j],dihedral_atom1[i][j],1,inbuf,&nsend);
+          trim_pair(dihedral_atom2[i][j],dihedral_atom4[i][j],1,inbuf,&nsend);
+          trim_pair(dihedral_atom4[i][j],dihedral_atom2[i][j],1,inbuf,&nsend);
         }
 
-    // cycle buffer around ring of procs back to self
-    // when receive buffer, scan list of 1,3 atoms looking for atoms I own
-    // when find one, scan its 1-3 neigh list and mark I,J as in an angle
+    // flag pairs returned by rendezvous comm, 1st atom is now owned
 
-    sptr = this;
-    comm->ring(size,sizeof(tagint),buf,7,ring_seven,NULL);
+    PairRvous *outbuf;
+    int nreturn = send_pairs(nsend,inbuf,outbuf);
+    memory->sfree(inbuf);
+
+    for (m = 0; m < nreturn; m++)
+      trim_pair(outbuf[m].atomID,outbuf[m].partnerID,1,NULL);
+    memory->sfree(outbuf);
 
     // delete 1-3 neighbors if they are not flagged in dflag
 
@@ -756,10 +807,7 @@ void Special::angle_trim()
       nspecial[i][1] = m;
     }
 
-    // clean up
-
     memory->destroy(dflag);
-    memory->destroy(buf);
 
   // if no angles or dihedrals are defined, delete all 1-3 neighs
 
@@ -829,29 +877,38 @@ void Special::dihedral_trim()
       for (j = 0; j < n; j++) dflag[i][j] = 0;
     }
 
-    // nbufmax = largest buffer needed to hold info from any proc
-    // info for each atom = list of 1,4 atoms in each dihedral stored by atom
+    // consider both atoms of the 1,4 pair in each dihedral stored by atom
+    // flag pairs with an owned 1st atom directly
+    // nsend = # of other pairs, which are sent to owner of their 1st atom
 
-    int nbuf = 0;
-    for (i = 0; i < nlocal; i++) nbuf += 2*num_dihedral[i];
-    int *buf;
-    memory->create(buf,nbuf,"special:buf");
+    int nsend = 0;
+    for (i = 0; i < nlocal; i++)
+      for (j = 0; j < num_dihedral[i]; j++) {
+        nsend += trim_pair(dihedral_atom1[i][j],dihedral_atom4[i][j],2,NULL);
+        nsend += trim_pair(dihedral_atom4[i][j],dihedral_atom1[i][j],2,NULL);
+      }
 
-    // fill buffer with list of 1,4 atoms in each dihedral
+    // fill send buffer with pairs whose 1st atom is not owned
 
-    int size = 0;
+    PairRvous *inbuf = (PairRvous *)
+      memory->smalloc((bigint) nsend*sizeof(PairRvous),"special:inbuf");
+
+    nsend = 0;
     for (i = 0; i < nlocal; i++)
       for (j = 0; j < num_dihedral[i]; j++) {
-        buf[size++] = dihedral_atom1[i][j];
-        buf[size++] = dihedral_atom4[i][j];
+        trim_pair(dihedral_atom1[i][j],dihedral_atom4[i][j],2,inbuf,&nsend);
+        trim_pair(dihedral_atom4[i][j],dihedral_atom1[i][j],2,inbuf,&nsend);
       }
 
-    // cycle buffer around ring of procs back to self
-    // when receive buffer, scan list of 1,4 atoms looking for atoms I own
-    // when find one, scan its 1-4 neigh list and mark I,J as in a dihedral
+    // flag pairs returned by rendezvous comm, 1st atom is now owned
+
+    PairRvous *outbuf;
+    int nreturn = send_pairs(nsend,inbuf,outbuf);
+    memory->sfree(inbuf);
 
-    sptr = this;
-    comm->ring(size,sizeof(tagint),buf,8,ring_eight,NULL);
+    for (m = 0; m < nreturn; m++)
+      trim_pair(outbuf[m].atomID,outbuf[m].partnerID,2,NULL);
+    memory->sfree(outbuf);
 
     // delete 1-4 neighbors if they are not flagged in dflag
 
@@ -862,10 +919,7 @@ void Special::dihedral_trim()
       nspecial[i][2] = m;
     }
 
-    // clean up
-
     memory->destroy(dflag);
-    memory->destroy(buf);
 
   // if no dihedrals are defined, delete all 1-4 neighs
 
@@ -890,254 +944,96 @@ void Special::dihedral_trim()
 }
 
 /* ----------------------------------------------------------------------
-   when receive buffer, scan tags for atoms I own
-   when find one, increment nspecial count for that atom
+   process one I,J pair of a defined angle or dihedral for a trim
+   which = 1 for 1-3 list, 2 for 1-4 list
+   if I is owned, flag J in its 1-3 or 1-4 list and return 0
+   else if inbuf is set, append pair to inbuf and return 1
+   else return 1 = pair must be sent to owner of I
 ------------------------------------------------------------------------- */
 
-void Special::ring_one(int ndatum, char *cbuf)
+int Special::trim_pair(tagint iglobal, tagint jglobal, int which,
+                       PairRvous *inbuf, int *nsend)
 {
-  Atom *atom = sptr->atom;
-  int **nspecial = atom->nspecial;
-  int nlocal = atom->nlocal;
-
-  tagint *buf = (tagint *) cbuf;
-  int m;
-
-  for (int i = 0; i < ndatum; i++) {
-    m = atom->map(buf[i]);
-    if (m >= 0 && m < nlocal) nspecial[m][0]++;
-  }
-}
+  int ilocal = atom->map(iglobal);
 
-/* ----------------------------------------------------------------------
-   when receive buffer, scan 2nd-atom tags for atoms I own
-   when find one, add 1st-atom tag to onetwo list for 2nd atom
-------------------------------------------------------------------------- */
-
-void Special::ring_two(int ndatum, char *cbuf)
-{
-  Atom *atom = sptr->atom;
-  int nlocal = atom->nlocal;
-
-  tagint **onetwo = sptr->onetwo;
-  int *count = sptr->count;
-
-  tagint *buf = (tagint *) cbuf;
-  int m;
-
-  for (int i = 1; i < ndatum; i += 2) {
-    m = atom->map(buf[i]);
-    if (m >= 0 && m < nlocal) onetwo[m][count[m]++] = buf[i-1];
-  }
-}
-
-/* ----------------------------------------------------------------------
-   when receive buffer, scan list of 1-2 neighbors for atoms I own
-   when find one, increment 1-3 count by # of 1-2 neighbors of my atom,
-     subtracting one since my list will contain original atom
-------------------------------------------------------------------------- */
-
-void Special::ring_three(int ndatum, char *cbuf)
-{
-  Atom *atom = sptr->atom;
-  int **nspecial = atom->nspecial;
-  int nlocal = atom->nlocal;
-
-  tagint *buf = (tagint *) cbuf;
-  int i,j,m,n,num12;
-
-  i = 0;
-  while (i < ndatum) {
-    n = buf[i];
-    num12 = buf[i+1];
-    for (j = 0; j < num12; j++) {
-      m = atom->map(buf[i+2+j]);
-      if (m >= 0 && m < nlocal)
-        n += nspecial[m][0] - 1;
+  if (ilocal < 0 || ilocal >= atom->nlocal) {
+    if (inbuf) {
+      inbuf[*nsend].atomID = iglobal;
+      inbuf[*nsend].partnerID = jglobal;
+      (*nsend)++;
     }
-    buf[i] = n;
-    i += 2 + num12;
+    return 1;
   }
-}
-
-/* ----------------------------------------------------------------------
-  when receive buffer, scan list of 1-2 neighbors for atoms I own
-  when find one, add its neighbors to 1-3 list
-    increment the count in buf(i+4)
-    exclude the atom whose tag = original
-    this process may include duplicates but they will be culled later
-------------------------------------------------------------------------- */
 
-void Special::ring_four(int ndatum, char *cbuf)
-{
-  Atom *atom = sptr->atom;
-  int **nspecial = atom->nspecial;
-  int nlocal = atom->nlocal;
+  if (inbuf) return 0;
 
-  tagint **onetwo = sptr->onetwo;
-
-  tagint *buf = (tagint *) cbuf;
-  tagint original;
-  int i,j,k,m,n,num12,num13;
-
-  i = 0;
-  while (i < ndatum) {
-    original = buf[i];
-    num12 = buf[i+1];
-    num13 = buf[i+2];
-    n = buf[i+3];
-    for (j = 0; j < num12; j++) {
-      m = atom->map(buf[i+4+j]);
-      if (m >= 0 && m < nlocal)
-        for (k = 0; k < nspecial[m][0]; k++)
-          if (onetwo[m][k] != original)
-            buf[i+4+num12+(n++)] = onetwo[m][k];
+  tagint *list = (which == 1) ? onethree[ilocal] : onefour[ilocal];
+  int n = atom->nspecial[ilocal][which];
+  for (int m = 0; m < n; m++)
+    if (jglobal == list[m]) {
+      dflag[ilocal][m] = 1;
+      break;
     }
-    buf[i+3] = n;
-    i += 4 + num12 + num13;
-  }
-}
-
-/* ----------------------------------------------------------------------
-   when receive buffer, scan list of 1-3 neighbors for atoms I own
-   when find one, increment 1-4 count by # of 1-2 neighbors of my atom
-     may include duplicates and original atom but they will be culled later
-------------------------------------------------------------------------- */
 
-void Special::ring_five(int ndatum, char *cbuf)
-{
-  Atom *atom = sptr->atom;
-  int **nspecial = atom->nspecial;
-  int nlocal = atom->nlocal;
-
-  tagint *buf = (tagint *) cbuf;
-  int i,j,m,n,num13;
-
-  i = 0;
-  while (i < ndatum) {
-    n = buf[i];
-    num13 = buf[i+1];
-    for (j = 0; j < num13; j++) {
-      m = atom->map(buf[i+2+j]);
-      if (m >= 0 && m < nlocal) n += nspecial[m][0];
-    }
-      buf[i] = n;
-      i += 2 + num13;
-  }
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
-   when receive buffer, scan list of 1-3 neighbors for atoms I own
-   when find one, add its neighbors to 1-4 list
-     incrementing the count in buf(i+4)
-     this process may include duplicates but they will be culled later
+   callback from comm->rendezvous() in atom_owners()
+   store owning proc of each atom ID in procowner map
+   nothing is returned to caller decomposition
 ------------------------------------------------------------------------- */
 
-void Special::ring_six(int ndatum, char *cbuf)
+int Special::rendezvous_ids(int n, char *inbuf,
+                            int &flag, int *&proclist, char *&outbuf,
+                            void *ptr)
 {
-  Atom *atom = sptr->atom;
-  int **nspecial = atom->nspecial;
-  int nlocal = atom->nlocal;
+  Special *sptr = (Special *) ptr;
 
-  tagint **onetwo = sptr->onetwo;
-
-  tagint *buf = (tagint *) cbuf;
-  int i,j,k,m,n,num13,num14;
-
-  i = 0;
-  while (i < ndatum) {
-    num13 = buf[i];
-    num14 = buf[i+1];
-    n = buf[i+2];
-    for (j = 0; j < num13; j++) {
-      m = atom->map(buf[i+3+j]);
-      if (m >= 0 && m < nlocal)
-        for (k = 0; k < nspecial[m][0]; k++)
-          buf[i+3+num13+(n++)] = onetwo[m][k];
-    }
-    buf[i+2] = n;
-    i += 3 + num13 + num14;
-  }
-}
+  std::map<tagint,int> *procowner = new std::map<tagint,int>();
+  IDRvous *in = (IDRvous *) inbuf;
 
-/* ----------------------------------------------------------------------
-   when receive buffer, scan list of 1,3 atoms looking for atoms I own
-   when find one, scan its 1-3 neigh list and mark I,J as in an angle
-------------------------------------------------------------------------- */
+  for (int i = 0; i < n; i++)
+    (*procowner)[in[i].atomID] = in[i].me;
 
-void Special::ring_seven(int ndatum, char *cbuf)
-{
-  Atom *atom = sptr->atom;
-  int **nspecial = atom->nspecial;
-  int nlocal = atom->nlocal;
+  sptr->procowner = procowner;
 
-  tagint **onethree = sptr->onethree;
-  int **dflag = sptr->dflag;
-
-  tagint *buf = (tagint *) cbuf;
-  tagint iglobal,jglobal;
-  int i,m,ilocal,jlocal;
-
-  i = 0;
-  while (i < ndatum) {
-    iglobal = buf[i];
-    jglobal = buf[i+1];
-    ilocal = atom->map(iglobal);
-    jlocal = atom->map(jglobal);
-    if (ilocal >= 0 && ilocal < nlocal)
-      for (m = 0; m < nspecial[ilocal][1]; m++)
-        if (jglobal == onethree[ilocal][m]) {
-          dflag[ilocal][m] = 1;
-          break;
-        }
-    if (jlocal >= 0 && jlocal < nlocal)
-      for (m = 0; m < nspecial[jlocal][1]; m++)
-        if (iglobal == onethree[jlocal][m]) {
-          dflag[jlocal][m] = 1;
-          break;
-        }
-    i += 2;
-  }
+  proclist = NULL;
+  outbuf = NULL;
+  flag = 0;
+  return 0;
 }
 
 /* ----------------------------------------------------------------------
-   when receive buffer, scan list of 1,4 atoms looking for atoms I own
-   when find one, scan its 1-4 neigh list and mark I,J as in a dihedral
+   callback from comm->rendezvous() in send_pairs()
+   send each pair to the proc that owns its atom ID
+   pairs with an atom ID that does not exist are dropped
+   input buffer is compacted in place and re-used as output buffer
 ------------------------------------------------------------------------- */
 
-void Special::ring_eight(int ndatum, char *cbuf)
+int Special::rendezvous_pairs(int n, char *inbuf,
+                              int &flag, int *&proclist, char *&outbuf,
+                              void *ptr)
 {
-  Atom *atom = sptr->atom;
-  int **nspecial = atom->nspecial;
-  int nlocal = atom->nlocal;
-
-  tagint **onefour = sptr->onefour;
-  int **dflag = sptr->dflag;
-
-  tagint *buf = (tagint *) cbuf;
-  tagint iglobal,jglobal;
-  int i,m,ilocal,jlocal;
-
-  i = 0;
-  while (i < ndatum) {
-    iglobal = buf[i];
-    jglobal = buf[i+1];
-    ilocal = atom->map(iglobal);
-    jlocal = atom->map(jglobal);
-    if (ilocal >= 0 && ilocal < nlocal)
-      for (m = 0; m < nspecial[ilocal][2]; m++)
-        if (jglobal == onefour[ilocal][m]) {
-          dflag[ilocal][m] = 1;
-          break;
-        }
-    if (jlocal >= 0 && jlocal < nlocal)
-      for (m = 0; m < nspecial[jlocal][2]; m++)
-        if (iglobal == onefour[jlocal][m]) {
-          dflag[jlocal][m] = 1;
-          break;
-        }
-    i += 2;
+  Special *sptr = (Special *) ptr;
+  Memory *memory = sptr->memory;
+  std::map<tagint,int> *procowner = sptr->procowner;
+  std::map<tagint,int>::iterator it;
+
+  PairRvous *in = (PairRvous *) inbuf;
+  memory->create(proclist,n,"special:proclist");
+
+  int nout = 0;
+  for (int i = 0; i < n; i++) {
+    it = procowner->find(in[i].atomID);
+    if (it == procowner->end()) continue;
+    proclist[nout] = it->second;
+    in[nout++] = in[i];
   }
+
+  outbuf = inbuf;
+  flag = 1;
+  return nout;
 }
 
 /* ----------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #ifndef LMP_SPECIAL_H
 #define LMP_SPECIAL_H
 
+#include <map>
 #include "pointers.h"
 
 namespace LAMMPS_NS {
@@ -28,29 +29,44 @@ class Special : protected Pointers {
   int me,nprocs;
   tagint **onetwo,**onethree,**onefour;
 
-  // data used by ring callback methods
+  // atom ID -> owning proc, for atom IDs in my rendezvous decomposition
+
+  std::map<tagint,int> *procowner;
+
+  // datums for rendezvous communication
+
+  struct IDRvous {
+    int me;
+    tagint atomID;
+  };
+
+  struct PairRvous {
+    tagint atomID,partnerID;
+  };
+
+  // data used by angle/dihedral trim
 
-  int *count;
   int **dflag;
 
+  void atom_owners();
+  int send_pairs(int, PairRvous *, PairRvous *&);
+  void onetwo_build_newton();
+  void onetwo_build_newton_off();
+  void onethree_build();
+  void onefour_build();
+  int max_count(int, const char *);
+
   void dedup();
   void angle_trim();
   void dihedral_trim();
+  int trim_pair(tagint, tagint, int, PairRvous *, int * = NULL);
   void combine();
   void fix_alteration();
 
-  // static variable for ring communication callback to access class data
-  // callback functions for ring communication
-
-  static Special *sptr;
-  static void ring_one(int, char *);
-  static void ring_two(int, char *);
-  static void ring_three(int, char *);
-  static void ring_four(int, char *);
-  static void ring_five(int, char *);
-  static void ring_six(int, char *);
-  static void ring_seven(int, char *);
-  static void ring_eight(int, char *);
+  // callback functions for rendezvous communication
+
+  static int rendezvous_ids(int, char *, int &, int *&, char *&, void *);
+  static int rendezvous_pairs(int, char *, int &, int *&, char *&, void *);
 };
 
 }
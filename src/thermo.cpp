@@ -280,6 +280,16 @@ void Thermo::init()
     computes[i] = modify->compute[icompute];
   }
 
+  // register a timer sub-timer for each Compute invoked by thermo
+
+  char *name;
+  for (i = 0; i < ncompute; i++) {
+    name = new char[strlen(computes[i]->id)+strlen(computes[i]->style)+12];
+    sprintf(name,"compute %s (%s)",computes[i]->id,computes[i]->style);
+    compute_region[i] = timer->add_region(name);
+    delete [] name;
+  }
+
   // find current ptr for each Fix ID
   // check that fix frequency is acceptable with thermo output frequency
 
@@ -348,17 +358,23 @@ void Thermo::compute(int flag)
   for (i = 0; i < ncompute; i++)
     if (compute_which[i] == SCALAR) {
       if (!(computes[i]->invoked_flag & INVOKED_SCALAR)) {
+        timer->region_start(compute_region[i]);
         computes[i]->compute_scalar();
+        timer->region_stop(compute_region[i]);
         computes[i]->invoked_flag |= INVOKED_SCALAR;
       }
     } else if (compute_which[i] == VECTOR) {
       if (!(computes[i]->invoked_flag & INVOKED_VECTOR)) {
+        timer->region_start(compute_region[i]);
         computes[i]->compute_vector();
+        timer->region_stop(compute_region[i]);
         computes[i]->invoked_flag |= INVOKED_VECTOR;
       }
     } else if (compute_which[i] == ARRAY) {
       if (!(computes[i]->invoked_flag & INVOKED_ARRAY)) {
+        timer->region_start(compute_region[i]);
         computes[i]->compute_array();
+        timer->region_stop(compute_region[i]);
         computes[i]->invoked_flag |= INVOKED_ARRAY;
       }
     }
@@ -659,6 +675,7 @@ void Thermo::allocate()
   id_compute = new char*[3*n];
   compute_which = new int[3*n];
   computes = new Compute*[3*n];
+  compute_region = new int[3*n];
 
   nfix = 0;
   id_fix = new char*[n];
@@ -694,6 +711,7 @@ void Thermo::deallocate()
   for (int i = 0; i < ncompute; i++) delete [] id_compute[i];
   delete [] id_compute;
   delete [] compute_which;
+  delete [] compute_region;
   delete [] computes;
 
   for (int i = 0; i < nfix; i++) delete [] id_fix[i];
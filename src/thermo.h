@@ -90,6 +90,7 @@ class Thermo : protected Pointers {
   char **id_compute;           // their IDs
   int *compute_which;          // 0/1/2 if should call scalar,vector,array
   class Compute **computes;    // list of ptrs to the Compute objects
+  int *compute_region;         // timer sub-timer index of each Compute
 
   int nfix;                    // # of Fix objects called by thermo
   char **id_fix;               // their IDs
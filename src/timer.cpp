@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include "timer.h"
 #include "comm.h"
+#include "update.h"
 #include "error.h"
 #include "force.h"
 #include "memory.h"
@@ -32,6 +33,15 @@
 
 using namespace LAMMPS_NS;
 
+#define DELTA_REGION 16
+#define DELTA_EVENT 16384
+
+// names of timer sections in trace file, in order of enum ttype
+
+static const char *timer_name[] = {
+  "Total","Pair","Bond","Kspace","Neigh","Comm","Modify","Output","Sync",
+  "All","Dephase","Dynamics","Quench","Neb","Repcomm","Repout"};
+
 // convert a timespec ([[HH:]MM:]SS) to seconds
 // the strings "off" and "unlimited" result in -1;
 
@@ -99,17 +109,42 @@ Timer::Timer(LAMMPS *lmp) : Pointers(lmp)
   _s_timeout = -1;
   _checkfreq = 10;
   _nextcheck = -1;
+
+  nregion = maxregion = 0;
+  region_name = NULL;
+  region_wall = region_begin = NULL;
+
+  _trace = 0;
+  _tracefreq = 1;
+  tracefp = NULL;
+  events = NULL;
+  nevent = maxevent = 0;
+  trace_step = -1;
+
   this->_stamp(RESET);
 }
 
 /* ---------------------------------------------------------------------- */
 
+Timer::~Timer()
+{
+  close_trace();
+  for (int i = 0; i < nregion; i++) delete [] region_name[i];
+  memory->sfree(region_name);
+  memory->destroy(region_wall);
+  memory->destroy(region_begin);
+  memory->sfree(events);
+}
+
+/* ---------------------------------------------------------------------- */
+
 void Timer::init()
 {
   for (int i = 0; i < NUM_TIMER; i++) {
     cpu_array[i] = 0.0;
     wall_array[i] = 0.0;
   }
+  for (int i = 0; i < nregion; i++) region_wall[i] = 0.0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -129,6 +164,8 @@ void Timer::_stamp(enum ttype which)
     wall_array[which] += delta_wall;
     cpu_array[ALL]    += delta_cpu;
     wall_array[ALL]   += delta_wall;
+
+    if (_trace) add_event(which,previous_wall,current_wall);
   }
 
   previous_cpu  = current_cpu;
@@ -186,6 +223,191 @@ void Timer::barrier_stop()
 
   cpu_array[TOTAL]  = current_cpu - cpu_array[TOTAL];
   wall_array[TOTAL] = current_wall - wall_array[TOTAL];
+
+  // close span of last step of the run and write all trace events
+
+  if (_trace) {
+    add_event(-1,0.0,0.0);
+    flush_trace();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return index of named sub-timer, create it if it does not exist
+   all procs must add the same regions in the same order
+------------------------------------------------------------------------- */
+
+int Timer::add_region(const char *name)
+{
+  for (int i = 0; i < nregion; i++)
+    if (strcmp(name,region_name[i]) == 0) return i;
+
+  if (nregion == maxregion) {
+    maxregion += DELTA_REGION;
+    region_name = (char **)
+      memory->srealloc(region_name,maxregion*sizeof(char *),"timer:name");
+    memory->grow(region_wall,maxregion,"timer:region_wall");
+    memory->grow(region_begin,maxregion,"timer:region_begin");
+  }
+
+  region_name[nregion] = new char[strlen(name)+1];
+  strcpy(region_name[nregion],name);
+  region_wall[nregion] = region_begin[nregion] = 0.0;
+  return nregion++;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Timer::_region_stop(int i)
+{
+  double current_wall = MPI_Wtime();
+  region_wall[i] += current_wall - region_begin[i];
+  if (_trace) add_event(NUM_TIMER+i,region_begin[i],current_wall);
+}
+
+/* ----------------------------------------------------------------------
+   buffer one trace event with begin/end wall times
+   also maintain a span covering all events of current timestep,
+     which is stored as its own event when the timestep changes
+   id = -1 only closes the current step span
+------------------------------------------------------------------------- */
+
+void Timer::add_event(int id, double begin, double end)
+{
+  if (nevent+2 > maxevent) {
+    maxevent += DELTA_EVENT;
+    events = (TraceEvent *)
+      memory->srealloc(events,maxevent*sizeof(TraceEvent),"timer:events");
+  }
+
+  bigint step = update->ntimestep;
+
+  if (trace_step >= 0 && (id < 0 || step != trace_step)) {
+    TraceEvent *e = &events[nevent++];
+    e->begin = step_begin;
+    e->end = step_end;
+    e->step = trace_step;
+    e->id = -1;
+    trace_step = -1;
+  }
+
+  if (id < 0 || step % _tracefreq) return;
+
+  if (trace_step < 0) {
+    trace_step = step;
+    step_begin = begin - trace_origin;
+  }
+  step_end = end - trace_origin;
+
+  TraceEvent *e = &events[nevent++];
+  e->begin = begin - trace_origin;
+  e->end = end - trace_origin;
+  e->step = step;
+  e->id = id;
+}
+
+/* ----------------------------------------------------------------------
+   send events of all procs to proc 0 which appends them to trace file
+   in Chrome trace event format, one row (tid) per MPI rank
+------------------------------------------------------------------------- */
+
+void Timer::flush_trace()
+{
+  if (!_trace) return;
+
+  int nmax;
+  MPI_Allreduce(&nevent,&nmax,1,MPI_INT,MPI_MAX,world);
+  if (nmax == 0) return;
+
+  if (comm->me == 0) {
+    TraceEvent *buf = (TraceEvent *)
+      memory->smalloc(nmax*sizeof(TraceEvent),"timer:buf");
+    MPI_Status status;
+    MPI_Request request;
+    int tmp,n;
+
+    for (int iproc = 0; iproc < comm->nprocs; iproc++) {
+      TraceEvent *e = events;
+      n = nevent;
+      if (iproc) {
+        MPI_Irecv(buf,nmax*sizeof(TraceEvent),MPI_BYTE,iproc,0,world,
+                  &request);
+        MPI_Send(&tmp,0,MPI_INT,iproc,0,world);
+        MPI_Wait(&request,&status);
+        MPI_Get_count(&status,MPI_BYTE,&n);
+        n /= sizeof(TraceEvent);
+        e = buf;
+      }
+
+      for (int m = 0; m < n; m++) {
+        const char *name;
+        if (e[m].id < 0) name = "Step";
+        else if (e[m].id < NUM_TIMER) name = timer_name[e[m].id];
+        else name = region_name[e[m].id-NUM_TIMER];
+        fprintf(tracefp,",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,"
+                "\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+                "\"args\":{\"step\":" BIGINT_FORMAT "}}",
+                name,iproc,1.0e6*e[m].begin,1.0e6*(e[m].end-e[m].begin),
+                e[m].step);
+      }
+    }
+
+    fflush(tracefp);
+    memory->sfree(buf);
+
+  } else {
+    int tmp;
+    MPI_Recv(&tmp,0,MPI_INT,0,0,world,MPI_STATUS_IGNORE);
+    MPI_Rsend(events,nevent*sizeof(TraceEvent),MPI_BYTE,0,0,world);
+  }
+
+  nevent = 0;
+}
+
+/* ----------------------------------------------------------------------
+   start recording trace events, proc 0 opens trace file
+   trace times are relative to a barrier, so procs are roughly aligned
+------------------------------------------------------------------------- */
+
+void Timer::open_trace(char *file)
+{
+  close_trace();
+
+  if (comm->me == 0) {
+    tracefp = fopen(file,"w");
+    if (tracefp == NULL) {
+      char str[128];
+      snprintf(str,128,"Cannot open timer trace file %s",file);
+      error->one(FLERR,str);
+    }
+    fprintf(tracefp,"[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+            "\"args\":{\"name\":\"LAMMPS\"}}");
+    for (int iproc = 0; iproc < comm->nprocs; iproc++)
+      fprintf(tracefp,",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+              "\"tid\":%d,\"args\":{\"name\":\"rank %d\"}}",iproc,iproc);
+  }
+
+  MPI_Barrier(world);
+  trace_origin = MPI_Wtime();
+  nevent = 0;
+  trace_step = -1;
+  _trace = 1;
+}
+
+/* ----------------------------------------------------------------------
+   stop recording trace events, proc 0 terminates and closes trace file
+------------------------------------------------------------------------- */
+
+void Timer::close_trace()
+{
+  if (tracefp) {
+    fprintf(tracefp,"\n]\n");
+    fclose(tracefp);
+    tracefp = NULL;
+  }
+  _trace = 0;
+  nevent = 0;
+  trace_step = -1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -300,6 +522,17 @@ void Timer::modify_params(int narg, char **arg)
       if (iarg < narg) {
         _timeout = timespec2seconds(arg[iarg]);
       } else error->all(FLERR,"Illegal timers command");
+    } else if (strcmp(arg[iarg],"trace") == 0) {
+      ++iarg;
+      if (iarg >= narg) error->all(FLERR,"Illegal timers command");
+      if (strcmp(arg[iarg],"off") == 0) close_trace();
+      else {
+        if (iarg+1 >= narg) error->all(FLERR,"Illegal timers command");
+        _tracefreq = force->inumeric(FLERR,arg[iarg+1]);
+        if (_tracefreq <= 0) error->all(FLERR,"Illegal timers command");
+        open_trace(arg[iarg]);
+        ++iarg;
+      }
     } else if (strcmp(arg[iarg],"every") == 0) {
       ++iarg;
       if (iarg < narg) {
@@ -328,4 +561,7 @@ void Timer::modify_params(int narg, char **arg)
     if (logfile)
       fprintf(logfile,timer_fmt,timer_style[_level],timer_mode[_sync],timebuf);
   }
+
+  if (_trace && _level < NORMAL && comm->me == 0)
+    error->warning(FLERR,"Timer trace requires timer level normal or full");
 }
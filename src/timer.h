@@ -28,7 +28,7 @@ class Timer : protected Pointers {
   enum tlevel {OFF=0,LOOP,NORMAL,FULL};
 
   Timer(class LAMMPS *);
-  ~Timer() {};
+  ~Timer();
   void init();
 
   // inline function to reduce overhead if we want no detailed timings
@@ -85,6 +85,25 @@ class Timer : protected Pointers {
 
   void modify_params(int, char **);
 
+  // named sub-timers, e.g. for individual fixes and computes
+  // only accumulated with timer level full
+
+  int add_region(const char *);
+  void region_start(int i) {
+    if (_level > NORMAL) region_begin[i] = MPI_Wtime();
+  }
+  void region_stop(int i) {
+    if (_level > NORMAL) _region_stop(i);
+  }
+  int get_nregion() const { return nregion; }
+  const char *get_region_name(int i) const { return region_name[i]; }
+  double get_region_wall(int i) const { return region_wall[i]; }
+
+  // write buffered per-step trace events of all procs to trace file
+  // must be called by all procs
+
+  void flush_trace();
+
  private:
   double cpu_array[NUM_TIMER];
   double wall_array[NUM_TIMER];
@@ -98,9 +117,42 @@ class Timer : protected Pointers {
   int _checkfreq; // frequency of timeout checking
   int _nextcheck; // loop number of next timeout check
 
+  int nregion,maxregion;  // # of named sub-timers
+  char **region_name;     // name of each sub-timer
+  double *region_wall;    // accumulated wall time of each sub-timer
+  double *region_begin;   // wall time when sub-timer was last started
+
+  // per-step trace of timed sections, one event per stamp() or region
+
+  struct TraceEvent {
+    double begin,end;     // wall time relative to trace_origin
+    bigint step;          // timestep the event belongs to
+    int id;               // ttype, NUM_TIMER+region, or -1 for whole step
+  };
+
+  int _trace;             // 1 if trace events are recorded
+  int _tracefreq;         // record events on steps that are multiple of this
+  FILE *tracefp;          // trace file, only open on proc 0
+  double trace_origin;    // wall time of trace start on this proc
+  TraceEvent *events;     // buffered events of this proc
+  int nevent,maxevent;
+  bigint trace_step;      // step of events in current step span
+  double step_begin;      // start and end of current step span
+  double step_end;
+
   // update one specific timer array
   void _stamp(enum ttype);
 
+  // accumulate sub-timer
+  void _region_stop(int);
+
+  // buffer trace event
+  void add_event(int, double, double);
+
+  // open and close trace file
+  void open_trace(char *);
+  void close_trace();
+
   // check for timeout
   bool _check_timeout();
 };
@@ -65,7 +65,18 @@ enum{DONE,ADD,SUBTRACT,MULTIPLY,DIVIDE,CARAT,MODULO,UNARY,
      RANDOM,NORMAL,CEIL,FLOOR,ROUND,RAMP,STAGGER,LOGFREQ,LOGFREQ2,
      STRIDE,STRIDE2,VDISPLACE,SWIGGLE,CWIGGLE,GMASK,RMASK,GRMASK,
      IS_ACTIVE,IS_DEFINED,IS_AVAILABLE,
-     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY};
+     VALUE,ATOMARRAY,TYPEARRAY,INTARRAY,BIGINTARRAY,VECTORARRAY,
+     CSCALAR,CVECTOR,CARRAY,CPERATOM,FSCALAR,FVECTOR,FARRAY,FPERATOM,
+     VINTERNAL,VSCALAR,VATOM,VATOMFILE,KEYWORD,ATOMVEC};
+
+// status of compiled program for a variable
+
+enum{NOTCOMPILED,COMPILED,FAILED,COMPILING};
+
+// atom vectors referenced by compiled programs
+
+enum{ATOMID,ATOMMASS,ATOMTYPE,ATOMMOL,ATOMX,ATOMY,ATOMZ,
+     ATOMVX,ATOMVY,ATOMVZ,ATOMFX,ATOMFY,ATOMFZ,ATOMQ};
 
 // customize by adding a special function
 
@@ -96,6 +107,7 @@ Variable::Variable(LAMMPS *lmp) : Pointers(lmp)
   vecs = NULL;
 
   eval_in_progress = NULL;
+  progs = NULL;
 
   randomequal = NULL;
   randomatom = NULL;
@@ -124,6 +136,7 @@ Variable::~Variable()
     else for (int j = 0; j < num[i]; j++) delete [] data[i][j];
     delete [] data[i];
     if (style[i] == VECTOR) memory->destroy(vecs[i].values);
+    free_program(&progs[i]);
   }
   memory->sfree(names);
   memory->destroy(style);
@@ -136,6 +149,7 @@ Variable::~Variable()
   memory->sfree(vecs);
 
   memory->destroy(eval_in_progress);
+  memory->sfree(progs);
 
   delete randomequal;
   delete randomatom;
@@ -150,6 +164,10 @@ void Variable::set(int narg, char **arg)
 {
   if (narg < 2) error->all(FLERR,"Illegal variable command");
 
+  // any formula may now refer to a new or changed variable
+
+  invalidate_programs();
+
   int replaceflag = 0;
 
   // DELETE
@@ -844,7 +862,9 @@ char *Variable::retrieve(char *name)
     strcpy(data[ivar][0],result);
     str = data[ivar][0];
   } else if (style[ivar] == EQUAL) {
-    double answer = evaluate(data[ivar][0],NULL);
+    double answer;
+    if (use_program(ivar)) answer = run_equal(&progs[ivar]);
+    else answer = evaluate(data[ivar][0],NULL);
     sprintf(data[ivar][1],"%.15g",answer);
     str = data[ivar][1];
   } else if (style[ivar] == FORMAT) {
@@ -899,8 +919,10 @@ double Variable::compute_equal(int ivar)
   eval_in_progress[ivar] = 1;
 
   double value = 0.0;
-  if (style[ivar] == EQUAL) value = evaluate(data[ivar][0],NULL);
-  else if (style[ivar] == INTERNAL) value = dvalue[ivar];
+  if (style[ivar] == EQUAL) {
+    if (use_program(ivar)) value = run_equal(&progs[ivar]);
+    else value = evaluate(data[ivar][0],NULL);
+  } else if (style[ivar] == INTERNAL) value = dvalue[ivar];
   else if (style[ivar] == PYTHON) {
     int ifunc = python->find(data[ivar][0]);
     if (ifunc < 0) error->all(FLERR,"Python variable has no function");
@@ -940,6 +962,30 @@ void Variable::compute_atom(int ivar, int igroup,
     error->all(FLERR,"Variable has circular dependency");
   eval_in_progress[ivar] = 1;
 
+  int groupbit = group->bitmask[igroup];
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+
+  // compiled program is run even if result is NULL,
+  //   so that computes it references are invoked on all procs
+
+  if (style[ivar] == ATOM && use_program(ivar)) {
+    double scalar;
+    double *vec = run_atom(&progs[ivar],groupbit,scalar);
+    if (result) {
+      int m = 0;
+      for (int i = 0; i < nlocal; i++) {
+        if (mask[i] & groupbit) {
+          if (sumflag) result[m] += vec ? vec[i] : scalar;
+          else result[m] = vec ? vec[i] : scalar;
+        } else if (sumflag == 0) result[m] = 0.0;
+        m += stride;
+      }
+    }
+    eval_in_progress[ivar] = 0;
+    return;
+  }
+
   if (style[ivar] == ATOM) {
     treetype = ATOM;
     evaluate(data[ivar][0],&tree);
@@ -947,14 +993,11 @@ void Variable::compute_atom(int ivar, int igroup,
   } else vstore = reader[ivar]->fixstore->vstore;
 
   if (result == NULL) {
+    if (style[ivar] == ATOM) free_tree(tree);
     eval_in_progress[ivar] = 0;
     return;
   }
 
-  int groupbit = group->bitmask[igroup];
-  int *mask = atom->mask;
-  int nlocal = atom->nlocal;
-
   if (style[ivar] == ATOM) {
     if (sumflag == 0) {
       int m = 0;
@@ -1059,6 +1102,7 @@ void Variable::internal_set(int ivar, double value)
 
 void Variable::remove(int n)
 {
+  free_program(&progs[n]);
   delete [] names[n];
   if (style[n] == LOOP || style[n] == ULOOP) delete [] data[n][0];
   else for (int i = 0; i < num[n]; i++) delete [] data[n][i];
@@ -1073,8 +1117,19 @@ void Variable::remove(int n)
     pad[i-1] = pad[i];
     reader[i-1] = reader[i];
     data[i-1] = data[i];
+    progs[i-1] = progs[i];
   }
+  progs[nvar-1].status = NOTCOMPILED;
+  progs[nvar-1].code = NULL;
+  progs[nvar-1].stack = NULL;
+  progs[nvar-1].vstack = NULL;
+  progs[nvar-1].abuf = NULL;
+  progs[nvar-1].n = progs[nvar-1].nmax = progs[nvar-1].maxatom = 0;
   nvar--;
+
+  // variable indices in compiled programs are now shifted
+
+  invalidate_programs();
 }
 
 /* ----------------------------------------------------------------------
@@ -1107,6 +1162,17 @@ void Variable::grow()
 
   memory->grow(eval_in_progress,maxvar,"var:eval_in_progress");
   for (int i = 0; i < maxvar; i++) eval_in_progress[i] = 0;
+
+  progs = (Program *)
+    memory->srealloc(progs,maxvar*sizeof(Program),"var:progs");
+  for (int i = old; i < maxvar; i++) {
+    progs[i].status = NOTCOMPILED;
+    progs[i].n = progs[i].nmax = progs[i].maxatom = 0;
+    progs[i].code = NULL;
+    progs[i].stack = NULL;
+    progs[i].vstack = NULL;
+    progs[i].abuf = NULL;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -3581,7 +3647,7 @@ int Variable::math_function(char *word, char *contents, Tree **tree,
       error->all(FLERR,"Invalid math function in variable formula");
     if (update->whichflag == 0)
       error->all(FLERR,"Cannot use swiggle in variable formula between runs");
-    if (tree) newtree->type = CWIGGLE;
+    if (tree) newtree->type = SWIGGLE;
     else {
       if (values[0] == 0.0)
         error->all(FLERR,"Invalid math function in variable formula");
@@ -4546,6 +4612,975 @@ char *Variable::find_next_comma(char *str)
   return NULL;
 }
 
+/* ----------------------------------------------------------------------
+   return 1 if equal-style or atom-style variable ivar can be evaluated
+     by its compiled program, compile it first if needed
+   only used during a run or minimization, between runs the formula
+     is always parsed so that "not current" compute checks are made
+------------------------------------------------------------------------- */
+
+int Variable::use_program(int ivar)
+{
+  if (update->whichflag == 0) return 0;
+  if (progs[ivar].status == NOTCOMPILED) compile(ivar);
+  return (progs[ivar].status == COMPILED);
+}
+
+/* ----------------------------------------------------------------------
+   discard all compiled programs
+   called when variables, computes, or fixes may have changed
+------------------------------------------------------------------------- */
+
+void Variable::init()
+{
+  invalidate_programs();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Variable::invalidate_programs()
+{
+  for (int i = 0; i < nvar; i++) free_program(&progs[i]);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Variable::free_program(Program *p)
+{
+  for (int m = 0; m < p->n; m++) delete [] p->code[m].word;
+  memory->sfree(p->code);
+  memory->destroy(p->stack);
+  if (p->abuf)
+    for (int m = 0; m < p->nstack; m++) memory->destroy(p->abuf[m]);
+  memory->sfree(p->abuf);
+  memory->sfree(p->vstack);
+
+  p->status = NOTCOMPILED;
+  p->n = p->nmax = p->depth = p->nstack = p->maxatom = 0;
+  p->code = NULL;
+  p->stack = NULL;
+  p->vstack = NULL;
+  p->abuf = NULL;
+}
+
+/* ----------------------------------------------------------------------
+   compile formula of variable ivar into a postfix program
+   program is evaluated by run_equal() or run_atom() with a value stack
+   formulas with features the compiler does not handle are marked FAILED
+     and are evaluated by evaluate() as before, which also flags errors
+   never generates an error itself
+------------------------------------------------------------------------- */
+
+int Variable::compile(int ivar)
+{
+  Program *p = &progs[ivar];
+  free_program(p);
+  p->status = COMPILING;
+
+  char *str = new char[strlen(data[ivar][0])+1];
+  strcpy(str,data[ivar][0]);
+  int flag = compile_formula(str,p,style[ivar] == ATOM);
+  delete [] str;
+
+  if (!flag || p->depth != 1) {
+    free_program(p);
+    p->status = FAILED;
+    return FAILED;
+  }
+
+  memory->create(p->stack,p->nstack,"var:stack");
+  if (style[ivar] == ATOM) {
+    p->vstack = (double **)
+      memory->smalloc(p->nstack*sizeof(double *),"var:vstack");
+    p->abuf = (double **)
+      memory->smalloc(p->nstack*sizeof(double *),"var:abuf");
+    for (int m = 0; m < p->nstack; m++) p->abuf[m] = NULL;
+  }
+
+  p->status = COMPILED;
+  return COMPILED;
+}
+
+/* ----------------------------------------------------------------------
+   append one instruction to program
+   delta = net change of stack depth when it is executed
+------------------------------------------------------------------------- */
+
+Variable::Instr *Variable::emit(Program *p, int op, int delta)
+{
+  if (p->n == p->nmax) {
+    p->nmax += CHUNK;
+    p->code = (Instr *)
+      memory->srealloc(p->code,p->nmax*sizeof(Instr),"var:code");
+  }
+
+  Instr *ip = &p->code[p->n++];
+  ip->op = op;
+  ip->index = ip->index1 = ip->index2 = 0;
+  ip->value = 0.0;
+  ip->word = NULL;
+
+  p->depth += delta;
+  p->nstack = MAX(p->nstack,p->depth);
+  return ip;
+}
+
+/* ----------------------------------------------------------------------
+   compile formula in str, appending to program p
+   same grammar and operator precedence as evaluate()
+   atomflag = 1 if formula of an atom-style variable
+   str is modified, so caller passes a copy
+   return 1 if successful, 0 if formula uses an unsupported feature
+     or has a syntax error
+------------------------------------------------------------------------- */
+
+int Variable::compile_formula(char *str, Program *p, int atomflag)
+{
+  int op,opprevious;
+  char onechar;
+  char word[MAXLINE];
+  Instr *ip;
+
+  int opstack[MAXLEVEL];
+  int nopstack = 0;
+  int depth0 = p->depth;
+
+  int i = 0;
+  int expect = ARG;
+
+  while (1) {
+    onechar = str[i];
+
+    if (isspace(onechar)) i++;
+
+    // parentheses: compile contents in place
+
+    else if (onechar == '(') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      int j = i+1;
+      int level = 1;
+      while (str[j] && level) {
+        if (str[j] == '(') level++;
+        else if (str[j] == ')') level--;
+        j++;
+      }
+      if (level) return 0;
+      str[j-1] = '\0';
+      int d = p->depth;
+      if (!compile_formula(&str[i+1],p,atomflag)) return 0;
+      if (p->depth != d+1) return 0;
+      i = j;
+
+    // number
+
+    } else if (isdigit(onechar) || onechar == '.') {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      int istart = i;
+      while (isdigit(str[i]) || str[i] == '.') i++;
+      if (str[i] == 'e' || str[i] == 'E') {
+        i++;
+        if (str[i] == '+' || str[i] == '-') i++;
+        while (isdigit(str[i])) i++;
+      }
+
+      int n = i - istart;
+      if (n >= MAXLINE) return 0;
+      strncpy(word,&str[istart],n);
+      word[n] = '\0';
+
+      ip = emit(p,VALUE,1);
+      ip->value = atof(word);
+
+    // word: compute, fix, variable, function, atom vector,
+    //   constant, or thermo keyword
+
+    } else if (isalpha(onechar)) {
+      if (expect == OP) return 0;
+      expect = OP;
+
+      int istart = i;
+      while (isalnum(str[i]) || str[i] == '_') i++;
+      int n = i - istart;
+      if (n >= MAXLINE) return 0;
+      strncpy(word,&str[istart],n);
+      word[n] = '\0';
+
+      // uppercase C_ and F_ force access of global vectors, not supported
+
+      if (strncmp(word,"C_",2) == 0 || strncmp(word,"F_",2) == 0) {
+        return 0;
+
+      // compute
+
+      } else if (strncmp(word,"c_",2) == 0) {
+        if (domain->box_exist == 0) return 0;
+        int icompute = modify->find_compute(word+2);
+        if (icompute < 0) return 0;
+        Compute *compute = modify->compute[icompute];
+
+        int nbracket,index1,index2;
+        if (!compile_brackets(str,i,nbracket,index1,index2)) return 0;
+
+        if (nbracket == 0 && compute->scalar_flag) {
+          ip = emit(p,CSCALAR,1);
+        } else if (nbracket == 1 && compute->vector_flag) {
+          if (index1 > compute->size_vector &&
+              compute->size_vector_variable == 0) return 0;
+          ip = emit(p,CVECTOR,1);
+        } else if (nbracket == 2 && compute->array_flag) {
+          if (index1 > compute->size_array_rows &&
+              compute->size_array_rows_variable == 0) return 0;
+          if (index2 > compute->size_array_cols) return 0;
+          ip = emit(p,CARRAY,1);
+        } else if (nbracket == 0 && compute->vector_flag) {
+          return 0;
+        } else if (nbracket == 1 && compute->array_flag) {
+          return 0;
+        } else if (nbracket == 0 && compute->peratom_flag &&
+                   compute->size_peratom_cols == 0 && atomflag) {
+          ip = emit(p,CPERATOM,1);
+        } else if (nbracket == 1 && compute->peratom_flag &&
+                   compute->size_peratom_cols > 0 && atomflag) {
+          if (index1 > compute->size_peratom_cols) return 0;
+          ip = emit(p,CPERATOM,1);
+        } else return 0;
+
+        ip->index = icompute;
+        ip->index1 = index1;
+        ip->index2 = index2;
+        ip->word = new char[n-1];
+        strcpy(ip->word,word+2);
+
+      // fix
+
+      } else if (strncmp(word,"f_",2) == 0) {
+        if (domain->box_exist == 0) return 0;
+        int ifix = modify->find_fix(word+2);
+        if (ifix < 0) return 0;
+        Fix *fix = modify->fix[ifix];
+
+        int nbracket,index1,index2;
+        if (!compile_brackets(str,i,nbracket,index1,index2)) return 0;
+
+        if (nbracket == 0 && fix->scalar_flag) {
+          ip = emit(p,FSCALAR,1);
+        } else if (nbracket == 1 && fix->vector_flag) {
+          if (index1 > fix->size_vector &&
+              fix->size_vector_variable == 0) return 0;
+          ip = emit(p,FVECTOR,1);
+        } else if (nbracket == 2 && fix->array_flag) {
+          if (index1 > fix->size_array_rows &&
+              fix->size_array_rows_variable == 0) return 0;
+          if (index2 > fix->size_array_cols) return 0;
+          ip = emit(p,FARRAY,1);
+        } else if (nbracket == 0 && fix->vector_flag) {
+          return 0;
+        } else if (nbracket == 1 && fix->array_flag) {
+          return 0;
+        } else if (nbracket == 0 && fix->peratom_flag &&
+                   fix->size_peratom_cols == 0 && atomflag) {
+          ip = emit(p,FPERATOM,1);
+        } else if (nbracket == 1 && fix->peratom_flag &&
+                   fix->size_peratom_cols > 0 && atomflag) {
+          if (index1 > fix->size_peratom_cols) return 0;
+          ip = emit(p,FPERATOM,1);
+        } else return 0;
+
+        ip->index = ifix;
+        ip->index1 = index1;
+        ip->index2 = index2;
+        ip->word = new char[n-1];
+        strcpy(ip->word,word+2);
+
+      // variable, nested atom-style variables are compiled as well
+      // a variable still being compiled means a circular dependency
+
+      } else if (strncmp(word,"v_",2) == 0) {
+        int jvar = find(word+2);
+        if (jvar < 0 || eval_in_progress[jvar]) return 0;
+        if (progs[jvar].status == COMPILING) return 0;
+        if (str[i] == '[') return 0;
+
+        if (style[jvar] == INTERNAL) {
+          ip = emit(p,VINTERNAL,1);
+        } else if (style[jvar] != ATOM && style[jvar] != ATOMFILE &&
+                   style[jvar] != VECTOR) {
+          ip = emit(p,VSCALAR,1);
+        } else if (style[jvar] == ATOM && atomflag) {
+          if (progs[jvar].status == NOTCOMPILED) compile(jvar);
+          if (progs[jvar].status != COMPILED) return 0;
+          ip = emit(p,VATOM,1);
+        } else if (style[jvar] == ATOMFILE && atomflag) {
+          ip = emit(p,VATOMFILE,1);
+        } else return 0;
+
+        ip->index = jvar;
+
+      // math function, only those without side effects
+
+      } else if (str[i] == '(') {
+        if      (strcmp(word,"sqrt") == 0) op = SQRT;
+        else if (strcmp(word,"exp") == 0) op = EXP;
+        else if (strcmp(word,"ln") == 0) op = LN;
+        else if (strcmp(word,"log") == 0) op = LOG;
+        else if (strcmp(word,"abs") == 0) op = ABS;
+        else if (strcmp(word,"sin") == 0) op = SIN;
+        else if (strcmp(word,"cos") == 0) op = COS;
+        else if (strcmp(word,"tan") == 0) op = TAN;
+        else if (strcmp(word,"asin") == 0) op = ASIN;
+        else if (strcmp(word,"acos") == 0) op = ACOS;
+        else if (strcmp(word,"atan") == 0) op = ATAN;
+        else if (strcmp(word,"atan2") == 0) op = ATAN2;
+        else if (strcmp(word,"ceil") == 0) op = CEIL;
+        else if (strcmp(word,"floor") == 0) op = FLOOR;
+        else if (strcmp(word,"round") == 0) op = ROUND;
+        else if (strcmp(word,"ramp") == 0) op = RAMP;
+        else if (strcmp(word,"vdisplace") == 0) op = VDISPLACE;
+        else if (strcmp(word,"swiggle") == 0) op = SWIGGLE;
+        else if (strcmp(word,"cwiggle") == 0) op = CWIGGLE;
+        else return 0;
+
+        int nexpect = 1;
+        if (op == ATAN2 || op == RAMP || op == VDISPLACE) nexpect = 2;
+        else if (op == SWIGGLE || op == CWIGGLE) nexpect = 3;
+
+        int j = i+1;
+        int level = 1;
+        while (str[j] && level) {
+          if (str[j] == '(') level++;
+          else if (str[j] == ')') level--;
+          j++;
+        }
+        if (level) return 0;
+        str[j-1] = '\0';
+
+        int narg = 0;
+        char *ptr = &str[i+1];
+        while (ptr) {
+          char *ptrnext = find_next_comma(ptr);
+          if (ptrnext) *ptrnext = '\0';
+          int d = p->depth;
+          if (!compile_formula(ptr,p,atomflag)) return 0;
+          if (p->depth != d+1) return 0;
+          narg++;
+          ptr = ptrnext;
+          if (ptr) ptr++;
+        }
+        if (narg != nexpect) return 0;
+
+        ip = emit(p,op,1-narg);
+        ip->index = narg;
+        i = j;
+
+      // atom value via atom ID, not supported
+
+      } else if (str[i] == '[') {
+        return 0;
+
+      // atom vector
+
+      } else if (is_atom_vector(word)) {
+        if (!atomflag || domain->box_exist == 0) return 0;
+        ip = emit(p,ATOMVEC,1);
+        if (strcmp(word,"id") == 0) ip->index = ATOMID;
+        else if (strcmp(word,"mass") == 0) ip->index = ATOMMASS;
+        else if (strcmp(word,"type") == 0) ip->index = ATOMTYPE;
+        else if (strcmp(word,"mol") == 0) {
+          if (!atom->molecule_flag) return 0;
+          ip->index = ATOMMOL;
+        }
+        else if (strcmp(word,"x") == 0) ip->index = ATOMX;
+        else if (strcmp(word,"y") == 0) ip->index = ATOMY;
+        else if (strcmp(word,"z") == 0) ip->index = ATOMZ;
+        else if (strcmp(word,"vx") == 0) ip->index = ATOMVX;
+        else if (strcmp(word,"vy") == 0) ip->index = ATOMVY;
+        else if (strcmp(word,"vz") == 0) ip->index = ATOMVZ;
+        else if (strcmp(word,"fx") == 0) ip->index = ATOMFX;
+        else if (strcmp(word,"fy") == 0) ip->index = ATOMFY;
+        else if (strcmp(word,"fz") == 0) ip->index = ATOMFZ;
+        else if (strcmp(word,"q") == 0) {
+          if (!atom->q_flag) return 0;
+          ip->index = ATOMQ;
+        }
+
+      // constant
+
+      } else if (is_constant(word)) {
+        ip = emit(p,VALUE,1);
+        ip->value = constant(word);
+
+      // thermo keyword, looked up when program is run
+
+      } else {
+        if (domain->box_exist == 0) return 0;
+        ip = emit(p,KEYWORD,1);
+        ip->word = new char[n+1];
+        strcpy(ip->word,word);
+      }
+
+    // math operator, including end-of-string
+
+    } else if (strchr("+-*/^<>=!&|%\0",onechar)) {
+      if (onechar == '+') op = ADD;
+      else if (onechar == '-') op = SUBTRACT;
+      else if (onechar == '*') op = MULTIPLY;
+      else if (onechar == '/') op = DIVIDE;
+      else if (onechar == '%') op = MODULO;
+      else if (onechar == '^') op = CARAT;
+      else if (onechar == '=') {
+        if (str[i+1] != '=') return 0;
+        op = EQ;
+        i++;
+      } else if (onechar == '!') {
+        if (str[i+1] == '=') {
+          op = NE;
+          i++;
+        } else op = NOT;
+      } else if (onechar == '<') {
+        if (str[i+1] != '=') op = LT;
+        else {
+          op = LE;
+          i++;
+        }
+      } else if (onechar == '>') {
+        if (str[i+1] != '=') op = GT;
+        else {
+          op = GE;
+          i++;
+        }
+      } else if (onechar == '&') {
+        if (str[i+1] != '&') return 0;
+        op = AND;
+        i++;
+      } else if (onechar == '|') {
+        if (str[i+1] == '|') op = OR;
+        else if (str[i+1] == '^') op = XOR;
+        else return 0;
+        i++;
+      } else op = DONE;
+
+      i++;
+
+      if ((op == SUBTRACT || op == NOT) && expect == ARG) {
+        if (nopstack == MAXLEVEL) return 0;
+        opstack[nopstack++] = (op == SUBTRACT) ? UNARY : NOT;
+        continue;
+      }
+
+      if (expect == ARG) return 0;
+      expect = ARG;
+
+      // emit stacked ops as deep as precedence allows
+
+      while (nopstack && precedence[opstack[nopstack-1]] >= precedence[op]) {
+        opprevious = opstack[--nopstack];
+        if (opprevious == UNARY || opprevious == NOT) emit(p,opprevious,0);
+        else emit(p,opprevious,-1);
+      }
+
+      if (op == DONE) break;
+      if (nopstack == MAXLEVEL) return 0;
+      opstack[nopstack++] = op;
+
+    } else return 0;
+  }
+
+  if (nopstack) return 0;
+  if (p->depth != depth0+1) return 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   parse zero, one, or two trailing brackets after word ending at str[i]
+   only literal positive integers are allowed, since an atom ID or
+     variable inside brackets is not supported by compiled programs
+   point i beyond last bracket
+   return 1 if successful, else 0
+------------------------------------------------------------------------- */
+
+int Variable::compile_brackets(char *str, int &i, int &nbracket,
+                               int &index1, int &index2)
+{
+  nbracket = 0;
+  index1 = index2 = 0;
+
+  while (str[i] == '[' && nbracket < 2) {
+    int j = i+1;
+    if (!isdigit(str[j])) return 0;
+    while (isdigit(str[j])) j++;
+    if (str[j] != ']' || j-i-1 > 9) return 0;
+    int index = atoi(&str[i+1]);
+    if (index <= 0) return 0;
+    if (nbracket == 0) index1 = index;
+    else index2 = index;
+    nbracket++;
+    i = j+1;
+  }
+
+  if (str[i] == '[') return 0;
+  return 1;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate scalar leaf of a compiled program
+   invokes computes and checks fixes the same way evaluate() does
+   compute and fix indices are checked against their IDs,
+     since they may have been deleted or re-ordered since compilation
+------------------------------------------------------------------------- */
+
+double Variable::scalar_operand(Instr *ip)
+{
+  double value = 0.0;
+  int op = ip->op;
+
+  if (op == VALUE) return ip->value;
+
+  if (op == CSCALAR || op == CVECTOR || op == CARRAY) {
+    if (ip->index >= modify->ncompute ||
+        strcmp(modify->compute[ip->index]->id,ip->word) != 0) {
+      ip->index = modify->find_compute(ip->word);
+      if (ip->index < 0)
+        error->all(FLERR,"Invalid compute ID in variable formula");
+    }
+    Compute *compute = modify->compute[ip->index];
+
+    if (op == CSCALAR) {
+      if (!(compute->invoked_flag & INVOKED_SCALAR)) {
+        compute->compute_scalar();
+        compute->invoked_flag |= INVOKED_SCALAR;
+      }
+      value = compute->scalar;
+    } else if (op == CVECTOR) {
+      if (!(compute->invoked_flag & INVOKED_VECTOR)) {
+        compute->compute_vector();
+        compute->invoked_flag |= INVOKED_VECTOR;
+      }
+      if (compute->size_vector_variable &&
+          ip->index1 > compute->size_vector) value = 0.0;
+      else value = compute->vector[ip->index1-1];
+    } else {
+      if (!(compute->invoked_flag & INVOKED_ARRAY)) {
+        compute->compute_array();
+        compute->invoked_flag |= INVOKED_ARRAY;
+      }
+      if (compute->size_array_rows_variable &&
+          ip->index1 > compute->size_array_rows) value = 0.0;
+      else value = compute->array[ip->index1-1][ip->index2-1];
+    }
+
+  } else if (op == FSCALAR || op == FVECTOR || op == FARRAY) {
+    if (ip->index >= modify->nfix ||
+        strcmp(modify->fix[ip->index]->id,ip->word) != 0) {
+      ip->index = modify->find_fix(ip->word);
+      if (ip->index < 0)
+        error->all(FLERR,"Invalid fix ID in variable formula");
+    }
+    Fix *fix = modify->fix[ip->index];
+
+    if (update->ntimestep % fix->global_freq)
+      error->all(FLERR,"Fix in variable not computed at compatible time");
+
+    if (op == FSCALAR) value = fix->compute_scalar();
+    else if (op == FVECTOR) value = fix->compute_vector(ip->index1-1);
+    else value = fix->compute_array(ip->index1-1,ip->index2-1);
+
+  } else if (op == VINTERNAL) {
+    value = dvalue[ip->index];
+
+  } else if (op == VSCALAR) {
+    if (eval_in_progress[ip->index])
+      error->all(FLERR,"Variable has circular dependency");
+    char *var = retrieve(names[ip->index]);
+    if (var == NULL)
+      error->all(FLERR,"Invalid variable evaluation in variable formula");
+    value = atof(var);
+
+  } else if (op == KEYWORD) {
+    int flag = output->thermo->evaluate_keyword(ip->word,&value);
+    if (flag) error->all(FLERR,"Invalid thermo keyword in variable formula");
+  }
+
+  return value;
+}
+
+/* ----------------------------------------------------------------------
+   run compiled program of an equal-style variable
+------------------------------------------------------------------------- */
+
+double Variable::run_equal(Program *p)
+{
+  double *stack = p->stack;
+  Instr *code = p->code;
+  int n = 0;
+
+  for (int m = 0; m < p->n; m++) {
+    Instr *ip = &code[m];
+    int op = ip->op;
+
+    if (op == VALUE) stack[n++] = ip->value;
+    else if (op >= CSCALAR) stack[n++] = scalar_operand(ip);
+    else if (op == UNARY || op == NOT)
+      stack[n-1] = apply_op(op,0.0,stack[n-1],0);
+    else if (op < SQRT) {
+      n--;
+      stack[n-1] = apply_op(op,stack[n-1],stack[n],0);
+    } else {
+      n -= ip->index;
+      stack[n] = apply_function(op,&stack[n],0);
+      n++;
+    }
+  }
+
+  return stack[0];
+}
+
+/* ----------------------------------------------------------------------
+   run compiled program of an atom-style variable
+   each stack slot is a scalar (vstack = NULL) or a per-atom vector
+   per-atom vectors point to atom or compute/fix data directly when
+     stored contiguously, else to a buffer owned by the slot
+   operations on vectors write into buffer of the lower slot
+   return per-atom vector, or NULL if result is a scalar in value
+   errors for per-atom values are only checked for atoms in group
+------------------------------------------------------------------------- */
+
+double *Variable::run_atom(Program *p, int groupbit, double &value)
+{
+  int i;
+
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+
+  if (atom->nmax > p->maxatom) {
+    p->maxatom = atom->nmax;
+    for (int m = 0; m < p->nstack; m++) {
+      memory->destroy(p->abuf[m]);
+      memory->create(p->abuf[m],p->maxatom,"var:abuf");
+    }
+  }
+
+  double *stack = p->stack;
+  double **vstack = p->vstack;
+  double **abuf = p->abuf;
+  Instr *code = p->code;
+  int n = 0;
+
+  for (int m = 0; m < p->n; m++) {
+    Instr *ip = &code[m];
+    int op = ip->op;
+
+    // scalar leaves
+
+    if (op == VALUE || (op >= CSCALAR && op != CPERATOM && op != FPERATOM &&
+                        op != VATOM && op != VATOMFILE && op != ATOMVEC)) {
+      vstack[n] = NULL;
+      stack[n++] = scalar_operand(ip);
+
+    // per-atom leaves
+
+    } else if (op == ATOMVEC) {
+      double *buf = abuf[n];
+      int which = ip->index;
+      double **x = NULL;
+      int dim = 0;
+
+      if (which == ATOMID) {
+        tagint *tag = atom->tag;
+        for (i = 0; i < nlocal; i++) buf[i] = tag[i];
+      } else if (which == ATOMTYPE) {
+        int *type = atom->type;
+        for (i = 0; i < nlocal; i++) buf[i] = type[i];
+      } else if (which == ATOMMOL) {
+        tagint *molecule = atom->molecule;
+        for (i = 0; i < nlocal; i++) buf[i] = molecule[i];
+      } else if (which == ATOMMASS) {
+        if (atom->rmass) buf = atom->rmass;
+        else {
+          double *mass = atom->mass;
+          int *type = atom->type;
+          for (i = 0; i < nlocal; i++) buf[i] = mass[type[i]];
+        }
+      } else if (which == ATOMQ) {
+        buf = atom->q;
+      } else {
+        if (which <= ATOMZ) x = atom->x;
+        else if (which <= ATOMVZ) x = atom->v;
+        else x = atom->f;
+        dim = (which - ATOMX) % 3;
+        for (i = 0; i < nlocal; i++) buf[i] = x[i][dim];
+      }
+      vstack[n++] = buf;
+
+    } else if (op == CPERATOM || op == FPERATOM) {
+      double *vector;
+      double **array;
+
+      if (op == CPERATOM) {
+        if (ip->index >= modify->ncompute ||
+            strcmp(modify->compute[ip->index]->id,ip->word) != 0) {
+          ip->index = modify->find_compute(ip->word);
+          if (ip->index < 0)
+            error->all(FLERR,"Invalid compute ID in variable formula");
+        }
+        Compute *compute = modify->compute[ip->index];
+        if (!(compute->invoked_flag & INVOKED_PERATOM)) {
+          compute->compute_peratom();
+          compute->invoked_flag |= INVOKED_PERATOM;
+        }
+        vector = compute->vector_atom;
+        array = compute->array_atom;
+      } else {
+        if (ip->index >= modify->nfix ||
+            strcmp(modify->fix[ip->index]->id,ip->word) != 0) {
+          ip->index = modify->find_fix(ip->word);
+          if (ip->index < 0)
+            error->all(FLERR,"Invalid fix ID in variable formula");
+        }
+        Fix *fix = modify->fix[ip->index];
+        if (update->ntimestep % fix->peratom_freq)
+          error->all(FLERR,"Fix in variable not computed at compatible time");
+        vector = fix->vector_atom;
+        array = fix->array_atom;
+      }
+
+      if (ip->index1 == 0) vstack[n++] = vector;
+      else {
+        double *buf = abuf[n];
+        int col = ip->index1-1;
+        for (i = 0; i < nlocal; i++) buf[i] = array[i][col];
+        vstack[n++] = buf;
+      }
+
+    } else if (op == VATOMFILE) {
+      vstack[n++] = reader[ip->index]->fixstore->vstore;
+
+    } else if (op == VATOM) {
+      double scalar;
+      double *vec = run_atom(&progs[ip->index],groupbit,scalar);
+      if (vec == NULL) {
+        vstack[n] = NULL;
+        stack[n++] = scalar;
+      } else {
+        double *buf = abuf[n];
+        for (i = 0; i < nlocal; i++) buf[i] = vec[i];
+        vstack[n++] = buf;
+      }
+
+    // unary operators
+
+    } else if (op == UNARY || op == NOT) {
+      double *a = vstack[n-1];
+      if (a == NULL) stack[n-1] = apply_op(op,0.0,stack[n-1],0);
+      else {
+        double *out = abuf[n-1];
+        if (op == UNARY)
+          for (i = 0; i < nlocal; i++) out[i] = -a[i];
+        else
+          for (i = 0; i < nlocal; i++) out[i] = (a[i] == 0.0) ? 1.0 : 0.0;
+        vstack[n-1] = out;
+      }
+
+    // binary operators
+    // add, subtract, multiply cannot fail and are done for all atoms
+
+    } else if (op < SQRT) {
+      n--;
+      double *a = vstack[n-1];
+      double *b = vstack[n];
+      double sa = stack[n-1];
+      double sb = stack[n];
+
+      if (a == NULL && b == NULL) {
+        stack[n-1] = apply_op(op,sa,sb,0);
+        continue;
+      }
+
+      double *out = abuf[n-1];
+
+      if (op == ADD) {
+        if (a && b) for (i = 0; i < nlocal; i++) out[i] = a[i] + b[i];
+        else if (a) for (i = 0; i < nlocal; i++) out[i] = a[i] + sb;
+        else for (i = 0; i < nlocal; i++) out[i] = sa + b[i];
+      } else if (op == SUBTRACT) {
+        if (a && b) for (i = 0; i < nlocal; i++) out[i] = a[i] - b[i];
+        else if (a) for (i = 0; i < nlocal; i++) out[i] = a[i] - sb;
+        else for (i = 0; i < nlocal; i++) out[i] = sa - b[i];
+      } else if (op == MULTIPLY) {
+        if (a && b) for (i = 0; i < nlocal; i++) out[i] = a[i] * b[i];
+        else if (a) for (i = 0; i < nlocal; i++) out[i] = a[i] * sb;
+        else for (i = 0; i < nlocal; i++) out[i] = sa * b[i];
+      } else {
+        for (i = 0; i < nlocal; i++) {
+          if (mask[i] & groupbit)
+            out[i] = apply_op(op,a ? a[i] : sa,b ? b[i] : sb,1);
+          else out[i] = 0.0;
+        }
+      }
+      vstack[n-1] = out;
+
+    // math functions with narg args
+
+    } else {
+      int narg = ip->index;
+      n -= narg;
+
+      int vecflag = 0;
+      for (int k = 0; k < narg; k++)
+        if (vstack[n+k]) vecflag = 1;
+
+      if (!vecflag) {
+        stack[n] = apply_function(op,&stack[n],0);
+        vstack[n++] = NULL;
+        continue;
+      }
+
+      double args[MAXFUNCARG];
+      double *out = abuf[n];
+      for (i = 0; i < nlocal; i++) {
+        if (mask[i] & groupbit) {
+          for (int k = 0; k < narg; k++)
+            args[k] = vstack[n+k] ? vstack[n+k][i] : stack[n+k];
+          out[i] = apply_function(op,args,1);
+        } else out[i] = 0.0;
+      }
+      vstack[n++] = out;
+    }
+  }
+
+  if (vstack[0] == NULL) {
+    value = stack[0];
+    return NULL;
+  }
+  return vstack[0];
+}
+
+/* ----------------------------------------------------------------------
+   apply binary or unary operator, unary operand is value2
+   atomflag = 1 if a per-atom value, then errors are flagged by one proc
+------------------------------------------------------------------------- */
+
+double Variable::apply_op(int op, double value1, double value2, int atomflag)
+{
+  switch (op) {
+  case ADD: return value1 + value2;
+  case SUBTRACT: return value1 - value2;
+  case MULTIPLY: return value1 * value2;
+  case DIVIDE:
+    if (value2 == 0.0) {
+      if (atomflag) error->one(FLERR,"Divide by 0 in variable formula");
+      error->all(FLERR,"Divide by 0 in variable formula");
+    }
+    return value1 / value2;
+  case MODULO:
+    if (value2 == 0.0) {
+      if (atomflag) error->one(FLERR,"Modulo 0 in variable formula");
+      error->all(FLERR,"Modulo 0 in variable formula");
+    }
+    return fmod(value1,value2);
+  case CARAT:
+    if (value2 == 0.0) {
+      if (atomflag) error->one(FLERR,"Power by 0 in variable formula");
+      error->all(FLERR,"Power by 0 in variable formula");
+    }
+    return pow(value1,value2);
+  case UNARY: return -value2;
+  case NOT: return (value2 == 0.0) ? 1.0 : 0.0;
+  case EQ: return (value1 == value2) ? 1.0 : 0.0;
+  case NE: return (value1 != value2) ? 1.0 : 0.0;
+  case LT: return (value1 < value2) ? 1.0 : 0.0;
+  case LE: return (value1 <= value2) ? 1.0 : 0.0;
+  case GT: return (value1 > value2) ? 1.0 : 0.0;
+  case GE: return (value1 >= value2) ? 1.0 : 0.0;
+  case AND: return (value1 != 0.0 && value2 != 0.0) ? 1.0 : 0.0;
+  case OR: return (value1 != 0.0 || value2 != 0.0) ? 1.0 : 0.0;
+  case XOR:
+    if ((value1 == 0.0 && value2 != 0.0) ||
+        (value1 != 0.0 && value2 == 0.0)) return 1.0;
+    return 0.0;
+  }
+  return 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   apply math function to its args
+   atomflag = 1 if a per-atom value, then errors are flagged by one proc
+   customize by adding a math function supported by compile_formula()
+------------------------------------------------------------------------- */
+
+double Variable::apply_function(int op, double *args, int atomflag)
+{
+  const char *errstr = NULL;
+  double value = 0.0;
+  double delta,omega;
+
+  switch (op) {
+  case SQRT:
+    if (args[0] < 0.0) errstr = "Sqrt of negative value in variable formula";
+    else value = sqrt(args[0]);
+    break;
+  case EXP: value = exp(args[0]); break;
+  case LN:
+    if (args[0] <= 0.0)
+      errstr = "Log of zero/negative value in variable formula";
+    else value = log(args[0]);
+    break;
+  case LOG:
+    if (args[0] <= 0.0)
+      errstr = "Log of zero/negative value in variable formula";
+    else value = log10(args[0]);
+    break;
+  case ABS: value = fabs(args[0]); break;
+  case SIN: value = sin(args[0]); break;
+  case COS: value = cos(args[0]); break;
+  case TAN: value = tan(args[0]); break;
+  case ASIN:
+    if (args[0] < -1.0 || args[0] > 1.0)
+      errstr = "Arcsin of invalid value in variable formula";
+    else value = asin(args[0]);
+    break;
+  case ACOS:
+    if (args[0] < -1.0 || args[0] > 1.0)
+      errstr = "Arccos of invalid value in variable formula";
+    else value = acos(args[0]);
+    break;
+  case ATAN: value = atan(args[0]); break;
+  case ATAN2: value = atan2(args[0],args[1]); break;
+  case CEIL: value = ceil(args[0]); break;
+  case FLOOR: value = floor(args[0]); break;
+  case ROUND: value = MYROUND(args[0]); break;
+  case RAMP:
+    delta = update->ntimestep - update->beginstep;
+    if (delta != 0.0) delta /= update->endstep - update->beginstep;
+    value = args[0] + delta*(args[1]-args[0]);
+    break;
+  case VDISPLACE:
+    delta = update->ntimestep - update->beginstep;
+    value = args[0] + args[1]*delta*update->dt;
+    break;
+  case SWIGGLE:
+  case CWIGGLE:
+    if (args[2] == 0.0) {
+      errstr = "Invalid math function in variable formula";
+      break;
+    }
+    delta = update->ntimestep - update->beginstep;
+    omega = 2.0*MY_PI/args[2];
+    if (op == SWIGGLE) value = args[0] + args[1]*sin(omega*delta*update->dt);
+    else value = args[0] + args[1]*(1.0-cos(omega*delta*update->dt));
+    break;
+  }
+
+  if (errstr) {
+    if (atomflag) error->one(FLERR,errstr);
+    error->all(FLERR,errstr);
+  }
+  return value;
+}
+
 /* ----------------------------------------------------------------------
    debug routine for printing formula tree recursively
 ------------------------------------------------------------------------- */
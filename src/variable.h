@@ -24,6 +24,7 @@ class Variable : protected Pointers {
  public:
   Variable(class LAMMPS *);
   ~Variable();
+  void init();
   void set(int, char **);
   void set(char *, int, char **);
   int set_string(char *, char *);
@@ -93,6 +94,45 @@ class Variable : protected Pointers {
     Tree **extra;          // ptrs further down tree for nextra args
   };
 
+  // compiled form of an equal-style or atom-style formula
+  // postfix program run on a stack of scalars or per-atom vectors
+  // references to computes, fixes, variables are resolved when compiled
+
+  struct Instr {
+    int op;                // operation or operand, see enum{} in variable.cpp
+    int index;             // compute/fix/variable/atom vector index,
+                           //   or # of args of a math function
+    int index1,index2;     // 1-based indices in brackets, 0 if none
+    double value;          // constant operand
+    char *word;            // thermo keyword or compute/fix ID
+  };
+
+  struct Program {
+    int status;            // NOTCOMPILED, COMPILED, FAILED, or COMPILING
+    int n,nmax;            // # of instructions and allocated length
+    int depth;             // current stack depth while compiling
+    int nstack;            // max depth of evaluation stack
+    Instr *code;           // instructions in postfix order
+    double *stack;         // scalar value of each stack entry
+    double **vstack;       // ptr to per-atom values of each stack entry
+    double **abuf;         // per-atom storage for each stack entry
+    int maxatom;           // allocated length of each abuf
+  };
+  Program *progs;          // compiled program for each variable
+
+  int use_program(int);
+  int compile(int);
+  int compile_formula(char *, Program *, int);
+  int compile_brackets(char *, int &, int &, int &, int &);
+  Instr *emit(Program *, int, int);
+  void free_program(Program *);
+  void invalidate_programs();
+  double run_equal(Program *);
+  double *run_atom(Program *, int, double &);
+  double scalar_operand(Instr *);
+  double apply_op(int, double, double, int);
+  double apply_function(int, double *, int);
+
   int compute_python(int);
   void remove(int);
   void grow();
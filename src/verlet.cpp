@@ -25,6 +25,7 @@
 #include "dihedral.h"
 #include "improper.h"
 #include "kspace.h"
+#include "neigh_list.h"
 #include "output.h"
 #include "update.h"
 #include "modify.h"
@@ -39,7 +40,10 @@ using namespace LAMMPS_NS;
 /* ---------------------------------------------------------------------- */
 
 Verlet::Verlet(LAMMPS *lmp, int narg, char **arg) :
-  Integrate(lmp, narg, arg) {}
+  Integrate(lmp, narg, arg)
+{
+  overlap = 0;
+}
 
 /* ----------------------------------------------------------------------
    initialization before run
@@ -102,6 +106,7 @@ void Verlet::setup(int flag)
     error->all(FLERR,"KOKKOS package requires run_style verlet/kk");
 
   update->setupflag = 1;
+  setup_overlap(1);
 
   // setup domain, communication and neighboring
   // acquire ghosts
@@ -164,6 +169,7 @@ void Verlet::setup(int flag)
 void Verlet::setup_minimal(int flag)
 {
   update->setupflag = 1;
+  setup_overlap(flag);
 
   // setup domain, communication and neighboring
   // acquire ghosts
@@ -231,6 +237,7 @@ void Verlet::run(int n)
   int n_pre_reverse = modify->n_pre_reverse;
   int n_post_force = modify->n_post_force;
   int n_end_of_step = modify->n_end_of_step;
+  int overlapflag;
 
   if (atom->sortfreq > 0) sortflag = 1;
   else sortflag = 0;
@@ -255,11 +262,17 @@ void Verlet::run(int n)
 
     nflag = neighbor->decide();
 
+    // overlap forward comm with interior pairs if no reneighboring
+    // and no per-atom energy/virial, which the split compute cannot sum
+
     if (nflag == 0) {
+      overlapflag = overlap && eflag/2 == 0 && vflag/4 == 0;
       timer->stamp();
-      comm->forward_comm();
+      if (overlapflag) comm->forward_comm_start();
+      else comm->forward_comm();
       timer->stamp(Timer::COMM);
     } else {
+      overlapflag = 0;
       if (n_pre_exchange) {
         timer->stamp();
         modify->pre_exchange();
@@ -301,7 +314,8 @@ void Verlet::run(int n)
     }
 
     if (pair_compute_flag) {
-      force->pair->compute(eflag,vflag);
+      if (overlapflag) pair_compute_overlap();
+      else force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
     }
 
@@ -356,6 +370,79 @@ void Verlet::cleanup()
   update->update_time();
 }
 
+/* ----------------------------------------------------------------------
+   decide if forward comm can overlap with the pair computation this run
+   requires a pair style that can split compute() over the interior and
+     boundary parts of its one neighbor list, and no pre_force fixes
+     since they are invoked between comm and pair and may use ghost atoms
+   flag = 0 if lists are not rebuilt in setup, only reuse an existing split
+------------------------------------------------------------------------- */
+
+void Verlet::setup_overlap(int flag)
+{
+  overlap = 0;
+
+  Pair *pair = force->pair;
+  NeighList *list = NULL;
+  if (pair_compute_flag) list = pair->list;
+
+  if (comm->overlap) {
+    if (list && pair->overlap_enable && !list->copy && !list->ghost &&
+        !list->dnum && !list->listhistory && modify->n_pre_force == 0)
+      overlap = 1;
+    if (!overlap && comm->me == 0)
+      error->warning(FLERR,"Comm overlap is not supported by pair style "
+                     "or fixes in use");
+  }
+
+  if (list && !flag && !list->split) overlap = 0;
+
+  if (overlap) list->enable_split();
+  else if (list) list->split = 0;
+}
+
+/* ----------------------------------------------------------------------
+   pair computation overlapped with forward comm from forward_comm_start()
+   interior pairs only involve owned atoms and are computed first,
+     then wait for ghost coords and compute pairs with a ghost J atom
+   each pair->compute() resets the pair energy/virial accumulators,
+     so add the interior tallies back in after the boundary pass
+   F dot r virial is deferred to the boundary pass, since it sums all forces
+------------------------------------------------------------------------- */
+
+void Verlet::pair_compute_overlap()
+{
+  Pair *pair = force->pair;
+  NeighList *list = pair->list;
+
+  int vflag_interior = vflag;
+  if (vflag % 4 == 2 && !pair->no_virial_fdotr_compute)
+    vflag_interior = vflag/4 * 4;
+
+  pair->list = list->listinterior;
+  pair->compute(eflag,vflag_interior);
+
+  double eng_vdwl = pair->eng_vdwl;
+  double eng_coul = pair->eng_coul;
+  double virial[6];
+  for (int i = 0; i < 6; i++) virial[i] = pair->virial[i];
+
+  timer->stamp(Timer::PAIR);
+  comm->forward_comm_finish();
+  timer->stamp(Timer::COMM);
+
+  pair->list = list->listboundary;
+  pair->compute(eflag,vflag);
+  pair->list = list;
+
+  if (eflag % 2) {
+    pair->eng_vdwl += eng_vdwl;
+    pair->eng_coul += eng_coul;
+  }
+  if (vflag_interior % 4)
+    for (int i = 0; i < 6; i++) pair->virial[i] += virial[i];
+}
+
 /* ----------------------------------------------------------------------
    clear force on own & ghost atoms
    clear other arrays as needed
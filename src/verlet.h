@@ -37,8 +37,11 @@ class Verlet : public Integrate {
  protected:
   int triclinic;                    // 0 if domain is orthog, 1 if triclinic
   int torqueflag,extraflag;
+  int overlap;                      // 1 if forward comm overlaps pair compute
 
   virtual void force_clear();
+  void setup_overlap(int);
+  void pair_compute_overlap();
 };
 
 }
@@ -53,6 +56,13 @@ W: No fixes defined, atoms won't move
 If you are not using a fix like nve, nvt, npt then atom velocities and
 coordinates will not be updated during timestepping.
 
+W: Comm overlap is not supported by pair style or fixes in use
+
+The comm_modify overlap option requires a pair style that can compute
+its interior and boundary pairs separately and no fixes that are
+invoked before the pair forces are computed.  Communication will not
+be overlapped for this run.
+
 E: KOKKOS package requires run_style verlet/kk
 
 The KOKKOS package requires the Kokkos version of run_style verlet; the
@@ -12,6 +12,7 @@
 ------------------------------------------------------------------------- */
 
 #include <mpi.h>
+#include <stdlib.h>
 #include <string.h>
 #include "write_restart.h"
 #include "atom.h"
@@ -34,9 +35,14 @@
 #include "output.h"
 #include "thermo.h"
 #include "mpiio.h"
+#include "restart_codec.h"
 #include "memory.h"
 #include "error.h"
 
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
 using namespace LAMMPS_NS;
 
 // same as read_restart.cpp
@@ -61,7 +67,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
      MULTIPROC,MPIIO,PROCSPERFILE,PERPROC,
      IMAGEINT,BOUNDMIN,TIMESTEP,
      ATOM_ID,ATOM_MAP_STYLE,ATOM_MAP_USER,ATOM_SORTFREQ,ATOM_SORTBIN,
-     COMM_MODE,COMM_CUTOFF,COMM_VEL};
+     COMM_MODE,COMM_CUTOFF,COMM_VEL,COMPRESS};
 
 enum{IGNORE,WARN,ERROR};                    // same as thermo.cpp
 
@@ -74,6 +80,22 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Pointers(lmp)
   multiproc = 0;
   noinit = 0;
   fp = NULL;
+
+  compressflag = 0;
+  asyncflag = 0;
+  async_pending = 0;
+  async_thread = NULL;
+  async_nfile = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+WriteRestart::~WriteRestart()
+{
+  async_wait();
+#if !defined(_WIN32)
+  delete (pthread_t *) async_thread;
+#endif
 }
 
 /* ----------------------------------------------------------------------
@@ -109,6 +131,13 @@ void WriteRestart::command(int narg, char **arg)
 
   multiproc_options(multiproc,mpiioflag,narg-1,&arg[1]);
 
+  // a single restart file written asynchronously would be waited for
+  //   right away by the destructor, so only allow async for periodic files
+
+  if (asyncflag)
+    error->all(FLERR,"Write_restart async yes is only allowed "
+               "with the restart command");
+
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
 
@@ -226,8 +255,32 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
+
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      if (strcmp(arg[iarg+1],"yes") == 0) asyncflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) asyncflag = 0;
+      else error->all(FLERR,"Illegal write_restart command");
+#if defined(_WIN32)
+      if (asyncflag)
+        error->all(FLERR,
+                   "Write_restart async yes not supported on this platform");
+#endif
+      iarg += 2;
+
+    } else if (strcmp(arg[iarg],"compress") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      if (strcmp(arg[iarg+1],"yes") == 0) compressflag = 1;
+      else if (strcmp(arg[iarg+1],"no") == 0) compressflag = 0;
+      else error->all(FLERR,"Illegal write_restart command");
+      iarg += 2;
+
     } else error->all(FLERR,"Illegal write_restart command");
   }
+
+  if (mpiioflag && (asyncflag || compressflag))
+    error->all(FLERR,"Restart file MPI-IO output not allowed "
+               "with async or compress");
 }
 
 /* ----------------------------------------------------------------------
@@ -246,6 +299,12 @@ void WriteRestart::write(char *file)
 
   if (neighbor->build_once) domain->reset_box();
 
+  // dump files are complete up to this timestep when restart is written
+  // previous asynchronous restart file is complete before a new one starts
+
+  output->flush_async();
+  async_wait();
+
   // natoms = sum of nlocal = value to write into restart file
   // if unequal and thermo lostflag is "error", don't write restart file
 
@@ -265,7 +324,7 @@ void WriteRestart::write(char *file)
       sprintf(hfile,"%s%s%s",file,"base",ptr+1);
       *ptr = '%';
     } else hfile = file;
-    fp = fopen(hfile,"wb");
+    fp = open_file(hfile);
     if (fp == NULL) {
       char str[128];
       sprintf(str,"Cannot open restart file %s",hfile);
@@ -318,10 +377,7 @@ void WriteRestart::write(char *file)
   //   write PROCSPERFILE into new file
 
   if (multiproc) {
-    if (me == 0 && fp) {
-      fclose(fp);
-      fp = NULL;
-    }
+    if (me == 0 && fp) close_file();
 
     char *multiname = new char[strlen(file) + 16];
     char *ptr = strchr(file,'%');
@@ -330,7 +386,7 @@ void WriteRestart::write(char *file)
     *ptr = '%';
 
     if (filewriter) {
-      fp = fopen(multiname,"wb");
+      fp = open_file(multiname);
       if (fp == NULL) {
         char str[128];
         sprintf(str,"Cannot open restart file %s",multiname);
@@ -413,6 +469,37 @@ void WriteRestart::write(char *file)
   // filewriter = 1 = this proc writes to file
   // ping each proc in my cluster, receive its data, write data to file
   // else wait for ping from fileproc, send my data to fileproc
+  // if compressed, each proc encodes its own data before sending it
+
+  else if (compressflag) {
+    int tmp,recv_size;
+    int max_bytes = RestartCodec::maxbytes(max_size);
+    char *cbuf;
+    memory->create(cbuf,max_bytes,"write_restart:cbuf");
+    int send_bytes = RestartCodec::encode(send_size,buf,cbuf);
+
+    if (filewriter) {
+      MPI_Status status;
+      MPI_Request request;
+      for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+        if (iproc) {
+          MPI_Irecv(cbuf,max_bytes,MPI_CHAR,me+iproc,0,world,&request);
+          MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
+          MPI_Wait(&request,&status);
+          MPI_Get_count(&status,MPI_CHAR,&recv_size);
+        } else recv_size = send_bytes;
+
+        write_char_vec(PERPROC,recv_size,cbuf);
+      }
+      close_file();
+
+    } else {
+      MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
+      MPI_Rsend(cbuf,send_bytes,MPI_CHAR,fileproc,0,world);
+    }
+
+    memory->destroy(cbuf);
+  }
 
   else {
     int tmp,recv_size;
@@ -430,8 +517,7 @@ void WriteRestart::write(char *file)
 
         write_double_vec(PERPROC,recv_size,buf);
       }
-      fclose(fp);
-      fp = NULL;
+      close_file();
 
     } else {
       MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
@@ -440,8 +526,10 @@ void WriteRestart::write(char *file)
   }
 
   // clean up
+  // hand completed memory streams to I/O thread
 
   memory->destroy(buf);
+  if (async_nfile) async_start();
 
   // invoke any fixes that write their own restart file
 
@@ -591,6 +679,7 @@ void WriteRestart::file_layout(int send_size)
   if (me == 0) {
     write_int(MULTIPROC,multiproc);
     write_int(MPIIO,mpiioflag);
+    if (compressflag) write_int(COMPRESS,compressflag);
   }
 
   if (mpiioflag) {
@@ -617,6 +706,101 @@ void WriteRestart::file_layout(int send_size)
   }
 }
 
+/* ----------------------------------------------------------------------
+   open restart file for writing
+   if async, return memory stream that is copied to the file by I/O thread
+------------------------------------------------------------------------- */
+
+FILE *WriteRestart::open_file(const char *name)
+{
+  FILE *fpfile = fopen(name,"wb");
+  if (fpfile == NULL || asyncflag == 0) return fpfile;
+
+  FILE *fpmem = NULL;
+#if !defined(_WIN32)
+  fpmem = open_memstream(&async_buf[async_nfile],&async_size[async_nfile]);
+#endif
+  if (fpmem == NULL)
+    error->one(FLERR,"Cannot open memory stream for asynchronous restart file");
+  async_fp[async_nfile] = fpfile;
+  return fpmem;
+}
+
+/* ----------------------------------------------------------------------
+   close restart file or memory stream
+   stream buffer is valid after fclose() and is queued for I/O thread
+------------------------------------------------------------------------- */
+
+void WriteRestart::close_file()
+{
+  fclose(fp);
+  fp = NULL;
+  if (asyncflag) async_nfile++;
+}
+
+/* ----------------------------------------------------------------------
+   complete pending asynchronous restart file
+   called before dumps or restart files are written and at end of run
+------------------------------------------------------------------------- */
+
+void WriteRestart::flush_async()
+{
+  async_wait();
+}
+
+/* ----------------------------------------------------------------------
+   start I/O thread that copies completed memory streams to their files
+   I/O thread takes ownership of stream buffers
+   if thread cannot be created, write streams directly
+------------------------------------------------------------------------- */
+
+void WriteRestart::async_start()
+{
+#if !defined(_WIN32)
+  if (async_thread == NULL) async_thread = (void *) new pthread_t;
+  if (pthread_create((pthread_t *) async_thread,NULL,
+                     &WriteRestart::async_write,(void *) this) == 0) {
+    async_pending = 1;
+    return;
+  }
+#endif
+
+  async_write((void *) this);
+}
+
+/* ----------------------------------------------------------------------
+   wait for I/O thread to finish writing files
+------------------------------------------------------------------------- */
+
+void WriteRestart::async_wait()
+{
+  if (!async_pending) return;
+#if !defined(_WIN32)
+  pthread_join(*((pthread_t *) async_thread),NULL);
+#endif
+  async_pending = 0;
+}
+
+/* ----------------------------------------------------------------------
+   body of I/O thread, only performs file operations, no MPI calls
+------------------------------------------------------------------------- */
+
+void *WriteRestart::async_write(void *ptr)
+{
+  WriteRestart *wr = (WriteRestart *) ptr;
+
+  for (int i = 0; i < wr->async_nfile; i++) {
+    fwrite(wr->async_buf[i],sizeof(char),wr->async_size[i],wr->async_fp[i]);
+    fclose(wr->async_fp[i]);
+    free(wr->async_buf[i]);
+    wr->async_buf[i] = NULL;
+    wr->async_fp[i] = NULL;
+  }
+
+  wr->async_nfile = 0;
+  return NULL;
+}
+
 // ----------------------------------------------------------------------
 // ----------------------------------------------------------------------
 // low-level fwrite methods
@@ -713,3 +897,14 @@ void WriteRestart::write_double_vec(int flag, int n, double *vec)
   fwrite(&n,sizeof(int),1,fp);
   fwrite(vec,sizeof(double),n,fp);
 }
+
+/* ----------------------------------------------------------------------
+   write a flag and vector of N chars into restart file
+------------------------------------------------------------------------- */
+
+void WriteRestart::write_char_vec(int flag, int n, char *vec)
+{
+  fwrite(&flag,sizeof(int),1,fp);
+  fwrite(&n,sizeof(int),1,fp);
+  fwrite(vec,sizeof(char),n,fp);
+}
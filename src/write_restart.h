@@ -28,9 +28,11 @@ namespace LAMMPS_NS {
 class WriteRestart : protected Pointers {
  public:
   WriteRestart(class LAMMPS *);
+  ~WriteRestart();
   void command(int, char **);
   void multiproc_options(int, int, int, char **);
   void write(char *);
+  void flush_async();
 
  private:
   int me,nprocs;
@@ -51,6 +53,25 @@ class WriteRestart : protected Pointers {
   class RestartMPIIO *mpiio;   // MPIIO for restart file output
   MPI_Offset headerOffset;
 
+  int compressflag;          // 1 if per-atom data is compressed
+
+  // asynchronous output: file writers write into memory streams,
+  // an I/O thread copies them to the restart files while the run continues
+
+  int asyncflag;             // 1 if file writes are done by an I/O thread
+  int async_pending;         // 1 if I/O thread is running
+  void *async_thread;        // ptr to pthread_t of I/O thread
+  int async_nfile;           // # of completed memory streams, at most 2
+  char *async_buf[2];        // contents of each memory stream
+  size_t async_size[2];      // # of bytes in each memory stream
+  FILE *async_fp[2];         // restart file each stream is copied to
+
+  FILE *open_file(const char *);
+  void close_file();
+  void async_start();
+  void async_wait();
+  static void *async_write(void *);
+
   void header();
   void type_arrays();
   void force_fields();
@@ -66,6 +87,7 @@ class WriteRestart : protected Pointers {
   void write_string(int, const char *);
   void write_int_vec(int, int, int *);
   void write_double_vec(int, int, double *);
+  void write_char_vec(int, int, char *);
 };
 
 }
@@ -112,4 +134,24 @@ E: Cannot open restart file %s
 
 Self-explanatory.
 
+E: Restart file MPI-IO output not allowed with async or compress
+
+MPI-IO restart files are written collectively at fixed offsets,
+which requires uncompressed data written by all procs.
+
+E: Write_restart async yes is only allowed with the restart command
+
+A single restart file cannot be written in the background, since
+LAMMPS would wait for it before executing the next command.  Use the
+async keyword with the restart command for periodic restart files.
+
+E: Write_restart async yes not supported on this platform
+
+Asynchronous output requires POSIX threads and memory streams.
+
+E: Cannot open memory stream for asynchronous restart file
+
+The memory stream that buffers the restart file could not be
+created, probably because the system is out of memory.
+
 */